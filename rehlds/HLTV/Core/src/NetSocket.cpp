@@ -28,16 +28,95 @@
 
 #include "precompiled.h"
 
+NetSocket::NetSocket() : m_netSplitSequenceNumber(0)
+{
+	Q_memset(m_ChannelHash, 0, sizeof(m_ChannelHash));
+}
+
+NetSocket::~NetSocket()
+{
+	ClearChannelHash();
+}
+
+unsigned int NetSocket::ChannelHashIndex(uint32 ip, uint16 port)
+{
+	uint32 h = (ip ^ (port << 16) ^ port) * 2654435761u;
+	return (h >> 16) & (CHANNEL_HASH_SIZE - 1);
+}
+
+void NetSocket::ClearChannelHash()
+{
+	for (int i = 0; i < CHANNEL_HASH_SIZE; i++)
+	{
+		channelhash_t *entry = m_ChannelHash[i];
+		while (entry)
+		{
+			channelhash_t *next = entry->next;
+			delete entry;
+			entry = next;
+		}
+
+		m_ChannelHash[i] = nullptr;
+	}
+}
+
 bool NetSocket::AddChannel(INetChannel *channel)
 {
-	return m_Channels.AddTail(channel);
+	if (!m_Channels.AddTail(channel))
+		return false;
+
+	NetAddress *adr = channel->GetTargetAddress();
+
+	channelhash_t *entry = new channelhash_t;
+	entry->channel = channel;
+	entry->ip = *(uint32 *)&adr->m_IP;
+	entry->port = adr->m_Port;
+	entry->next = nullptr;
+
+	// append, so the channel added first wins as it did with the list walk
+	channelhash_t **link = &m_ChannelHash[ChannelHashIndex(entry->ip, entry->port)];
+	while (*link)
+		link = &(*link)->next;
+
+	*link = entry;
+	return true;
 }
 
 bool NetSocket::RemoveChannel(INetChannel *channel)
 {
+	NetAddress *adr = channel->GetTargetAddress();
+
+	channelhash_t **link = &m_ChannelHash[ChannelHashIndex(*(uint32 *)&adr->m_IP, adr->m_Port)];
+	while (*link)
+	{
+		channelhash_t *entry = *link;
+		if (entry->channel == channel)
+		{
+			*link = entry->next;
+			delete entry;
+			break;
+		}
+
+		link = &entry->next;
+	}
+
 	return m_Channels.Remove(channel);
 }
 
+INetChannel *NetSocket::FindChannel(NetAddress *adr)
+{
+	uint32 ip = *(uint32 *)&adr->m_IP;
+	uint16 port = adr->m_Port;
+
+	for (channelhash_t *entry = m_ChannelHash[ChannelHashIndex(ip, port)]; entry; entry = entry->next)
+	{
+		if (entry->ip == ip && entry->port == port)
+			return entry->channel;
+	}
+
+	return nullptr;
+}
+
 int NetSocket::DispatchIncoming()
 {
 	int length = 0;
@@ -49,15 +128,9 @@ int NetSocket::DispatchIncoming()
 		if (length == -1)
 			break;
 
-		INetChannel *channel = (INetChannel *)m_Channels.GetFirst();
-		while (channel)
-		{
-			if (from.Equal(channel->GetTargetAddress())) {
-				channel->ProcessIncoming(m_Buffer, length);
-				break;
-			}
-
-			channel = (INetChannel *)m_Channels.GetNext();
+		INetChannel *channel = FindChannel(&from);
+		if (channel) {
+			channel->ProcessIncoming(m_Buffer, length);
 		}
 
 		// not found an existing channel for this address.
@@ -208,6 +281,8 @@ void NetSocket::Close()
 		channel->Close();
 	}
 
+	ClearChannelHash();
+
 	Flush();
 	m_Network->RemoveSocket(this);
 
@@ -35,8 +35,8 @@ class IBaseSytem;
 
 class NetSocket: public INetSocket {
 public:
-	NetSocket() : m_netSplitSequenceNumber(0) {}
-	virtual ~NetSocket() {}
+	NetSocket();
+	virtual ~NetSocket();
 
 	EXT_FUNC NetPacket *ReceivePacket();
 	EXT_FUNC void FreePacket(NetPacket *packet);
@@ -58,6 +58,7 @@ public:
 	void UpdateStats(double time);
 	int DrainChannels();
 	int DispatchIncoming();
+	INetChannel *FindChannel(NetAddress *adr);
 
 private:
 	int ReceivePacketIntern(NetAddress *fromHost);
@@ -71,6 +72,21 @@ protected:
 
 	ObjectList m_IncomingPackets;
 	ObjectList m_Channels;
+
+	// Channels by remote address, each chain keeps the order of m_Channels
+	enum { CHANNEL_HASH_SIZE = 1024 };
+	typedef struct channelhash_s
+	{
+		INetChannel *channel;
+		uint32 ip;
+		uint16 port;
+		struct channelhash_s *next;
+	} channelhash_t;
+
+	channelhash_t *m_ChannelHash[CHANNEL_HASH_SIZE];
+
+	static unsigned int ChannelHashIndex(uint32 ip, uint16 port);
+	void ClearChannelHash();
 	SOCKET m_Socket;
 	Network *m_Network;
 	IBaseSystem *m_System;
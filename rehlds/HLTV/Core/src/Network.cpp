@@ -51,6 +51,7 @@ bool Network::Init(IBaseSystem *system, int serial, char *name)
 
 	m_Sockets.Init();
 	m_System->RegisterCommand("fakeloss", this, CMD_ID_FAKELOSS);
+	m_System->RegisterCommand("netbench", this, CMD_ID_NETBENCH);
 
 #ifdef _WIN32
 	// Startup winock
@@ -100,6 +101,11 @@ void Network::ExecuteCommand(int commandID, char *commandLine)
 		return;
 	}
 
+	if (commandID == CMD_ID_NETBENCH) {
+		CMD_NetBench(commandLine);
+		return;
+	}
+
 	m_System->Printf("ERROR! Network::ExecuteCommand: unknown command ID %i.\n", commandID);
 }
 
@@ -260,6 +266,83 @@ void Network::CMD_FakeLoss(char *cmdLine)
 	m_FakeLoss = Q_atof(params.GetToken(1));
 }
 
+// Times the address lookup done by NetSocket::DispatchIncoming for every packet.
+// The channels are bound to a socket object without a system socket, so nothing is sent or received.
+void Network::CMD_NetBench(char *cmdLine)
+{
+	TokenLine params(cmdLine);
+	int numChannels = (params.CountToken() > 1) ? Q_atoi(params.GetToken(1)) : 2000;
+	int numPackets = (params.CountToken() > 2) ? Q_atoi(params.GetToken(2)) : 200000;
+
+	if (numChannels <= 0 || numPackets <= 0)
+	{
+		m_System->Printf("Syntax: netbench [channels] [packets]\n");
+		return;
+	}
+
+	NetSocket *socket = new NetSocket;
+	NetChannel *channels = new NetChannel[numChannels];
+	NetAddress *from = new NetAddress[numChannels * 2];
+
+	for (int i = 0; i < numChannels; i++)
+	{
+		NetAddress adr;
+		adr.m_IP[0] = 10;
+		adr.m_IP[1] = (i >> 16) & 0xFF;
+		adr.m_IP[2] = (i >> 8) & 0xFF;
+		adr.m_IP[3] = i & 0xFF;
+		adr.m_Port = htons(27005);
+
+		channels[i].Create(m_System, socket, &adr);
+		from[i * 2].FromNetAddress(&adr);
+
+		// every other packet comes from an address without a channel
+		adr.m_Port = htons(27006);
+		from[i * 2 + 1].FromNetAddress(&adr);
+	}
+
+	int foundList = 0, foundHash = 0;
+	double start = m_System->GetTime();
+
+	for (int i = 0; i < numPackets; i++)
+	{
+		NetAddress *adr = &from[(i * 7919) % (numChannels * 2)];
+		for (int j = 0; j < numChannels; j++)
+		{
+			if (adr->Equal(channels[j].GetTargetAddress())) {
+				foundList++;
+				break;
+			}
+		}
+	}
+
+	double listTime = m_System->GetTime() - start;
+	start = m_System->GetTime();
+
+	for (int i = 0; i < numPackets; i++)
+	{
+		if (socket->FindChannel(&from[(i * 7919) % (numChannels * 2)])) {
+			foundHash++;
+		}
+	}
+
+	double hashTime = m_System->GetTime() - start;
+
+	m_System->Printf("netbench: %i channels, %i packets: list %.3f ms, hash %.3f ms\n", numChannels, numPackets, listTime * 1000.0, hashTime * 1000.0);
+
+	if (foundList != foundHash) {
+		m_System->Printf("WARNING! Network::CMD_NetBench: lookups differ (%i/%i).\n", foundList, foundHash);
+	}
+
+	for (int i = 0; i < numChannels; i++) {
+		channels[i].Close();
+	}
+
+	delete [] from;
+	delete [] channels;
+	delete socket;
+}
+
 int Network::GetLastErrorCode()
 {
 	return WSAGetLastError();
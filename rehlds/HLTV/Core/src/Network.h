@@ -109,8 +109,9 @@ public:
 	EXT_FUNC char *GetErrorText(int code);
 
 protected:
-	enum LocalCommandIDs { CMD_ID_FAKELOSS = 1 };
+	enum LocalCommandIDs { CMD_ID_FAKELOSS = 1, CMD_ID_NETBENCH };
 	void CMD_FakeLoss(char *cmdLine);
+	void CMD_NetBench(char *cmdLine);
 
 	void SetName(char *newName);
 	void UpdateStats();
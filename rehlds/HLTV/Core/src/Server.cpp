@@ -229,6 +229,7 @@ void Server::ShutDown()
 
 	Disconnect();
 	m_ServerChannel.Close();
+	NetChannel::FreeCompressCache();
 
 	m_ReliableData.Free();
 	m_UnreliableData.Free();
@@ -377,6 +377,7 @@ void Proxy::ShutDown()
 	m_InfoString.Free();
 
 	ClearResources();
+	NetChannel::FreeCompressCache();
 	BaseSystemModule::ShutDown();
 	m_System->Printf("Proxy module shutdown.\n");
 }
@@ -836,6 +837,11 @@ void Proxy::ParseStatusReport(NetAddress *from, BitBuffer *stream)
 
 void Proxy::Broadcast(byte *data, int length, int groupType, bool isReliable)
 {
+#ifdef HLTV_FIXES
+	// Kept once and referenced by the channels of the clients until their next packet
+	NetChannel::sharedbuf_t *shared = NetChannel::AllocSharedBuffer(data, length);
+#endif
+
 	IClient *client = (IClient *)m_Clients.GetFirst();
 	while (client)
 	{
@@ -845,12 +851,23 @@ void Proxy::Broadcast(byte *data, int length, int groupType, bool isReliable)
 			||  ((groupType & GROUP_VOICE)  && client->IsHearingVoices())
 			||  ((groupType & GROUP_CHAT)   && client->HasChatEnabled())))
 		{
+#ifdef HLTV_FIXES
+			if (shared)
+				static_cast<ProxyClient *>(client)->SendShared(shared, isReliable);
+			else
+#endif
 			client->Send(data, length, isReliable);
 		}
 
 		client = (IClient *)m_Clients.GetNext();
 	}
 
+#ifdef HLTV_FIXES
+	if (shared) {
+		NetChannel::ReleaseSharedBuffer(shared);
+	}
+#endif
+
 	if (m_DemoClient.IsActive())
 	{
 		if (groupType & GROUP_DEMO) {
@@ -568,6 +568,7 @@ void BaseClient::WriteDatagram(double time, frame_t *frame)
 
 	if (m_ClientChannel.m_unreliableStream.IsOverflowed()) {
 		m_System->DPrintf("Unreliable data stream overflow.\n");
+		m_ClientChannel.ClearSharedStream(NetChannel::SHARED_UNRELIABLE);
 		m_ClientChannel.m_unreliableStream.Clear();
 
 		// FIXME: V519 The 'm_LastFrameSeqNr' variable is assigned values twice successively.
@@ -751,6 +752,11 @@ void BaseClient::Send(unsigned char *data, int length, bool isReliable)
 		m_ClientChannel.m_unreliableStream.WriteBuf(data, length);
 }
 
+void BaseClient::SendShared(NetChannel::sharedbuf_t *buf, bool isReliable)
+{
+	m_ClientChannel.WriteSharedBuffer(buf, isReliable);
+}
+
 NetAddress *BaseClient::GetAddress()
 {
 	return m_ClientChannel.GetTargetAddress();
@@ -59,6 +59,7 @@ public:
 	virtual char *GetClientName();
 	virtual bool IsActive();
 	virtual void Send(unsigned char *data, int length, bool isReliable);
+	void SendShared(NetChannel::sharedbuf_t *buf, bool isReliable);
 	virtual void DownloadFailed(char *fileName);
 	virtual void DownloadFile(char *fileName);
 	virtual void UpdateVoiceMask(BitBuffer *stream);
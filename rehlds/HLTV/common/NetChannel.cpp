@@ -44,6 +44,12 @@ NetChannel::NetChannel()
 		m_reliable_fragment[i] = 0;
 	}
 
+	for (int i = 0; i < MAX_SHARED_STREAMS; i++)
+	{
+		m_sharedStreams[i].count = 0;
+		m_sharedStreams[i].size = 0;
+	}
+
 	m_Socket = nullptr;
 	m_tempBuffer = nullptr;
 }
@@ -213,6 +219,10 @@ void NetChannel::Clear()
 	Q_memset(m_reliableOutBuffer, 0, sizeof(m_reliableOutBuffer));
 	Q_memset(m_flow, 0, sizeof(m_flow));
 
+	for (int i = 0; i < MAX_SHARED_STREAMS; i++) {
+		ClearSharedStream(i);
+	}
+
 	m_reliableStream.Clear();
 	m_unreliableStream.Clear();
 
@@ -229,6 +239,10 @@ bool NetChannel::Create(IBaseSystem *system, INetSocket *netsocket, NetAddress *
 	m_incomingPackets.Init();
 	m_blocksize = FRAGMENT_S2C_MAX_SIZE;
 
+	for (int i = 0; i < MAX_SHARED_STREAMS; i++) {
+		ClearSharedStream(i);
+	}
+
 	if (!m_reliableStream.Resize(MAX_MSGLEN))
 	{
 		m_System->Errorf("NetChannel::Create: m_reliableStream out of memory.\n");
@@ -331,6 +345,8 @@ void NetChannel::TransmitOutgoing()
 		m_last_send = m_System->GetTime();
 		m_cleartime = m_last_send + m_send_interval;
 
+		ClearSharedStream(SHARED_RELIABLE);
+		ClearSharedStream(SHARED_UNRELIABLE);
 		m_reliableStream.FastClear();
 		m_unreliableStream.FastClear();
 
@@ -342,6 +358,7 @@ void NetChannel::TransmitOutgoing()
 	if (m_reliableStream.IsOverflowed())
 	{
 		m_System->DPrintf("NetChannel::Transmit:Outgoing m_reliableStream overflow (%s)\n", m_remote_address.ToString());
+		ClearSharedStream(SHARED_RELIABLE);
 		m_reliableStream.Clear();
 		return;
 	}
@@ -350,6 +367,7 @@ void NetChannel::TransmitOutgoing()
 	if (m_unreliableStream.IsOverflowed())
 	{
 		m_System->DPrintf("NetChannel::Transmit:Outgoing m_unreliableStream overflow (%s)\n", m_remote_address.ToString());
+		ClearSharedStream(SHARED_UNRELIABLE);
 		m_unreliableStream.Clear();
 	}
 
@@ -382,7 +400,7 @@ void NetChannel::TransmitOutgoing()
 		FragSend();
 
 		// Sending regular payload
-		send_from_regular = m_reliableStream.CurrentSize() ? 1 : 0;
+		send_from_regular = GetSharedStreamSize(SHARED_RELIABLE) ? 1 : 0;
 
 		// Check to see if we are sending a frag payload
 		for (i = 0; i < MAX_STREAMS; i++)
@@ -405,9 +423,14 @@ void NetChannel::TransmitOutgoing()
 			send_from_regular = false;
 
 			// If the reliable buffer has gotten too big, queue it at the end of everything and clear out buffer
-			if (m_reliableStream.CurrentSize() > MAX_RELIABLE_PAYLOAD)
+			if (GetSharedStreamSize(SHARED_RELIABLE) > MAX_RELIABLE_PAYLOAD)
 			{
-				CreateFragmentsFromBuffer(m_reliableStream.GetData(), m_reliableStream.CurrentSize(), FRAG_NORMAL_STREAM);
+				// m_reliableOutBuffer is empty here, put the broadcast payloads in place there
+				BitBuffer reliable(m_reliableOutBuffer, sizeof(m_reliableOutBuffer));
+				WriteSharedStream(SHARED_RELIABLE, &reliable);
+
+				CreateFragmentsFromBuffer(reliable.GetData(), reliable.CurrentSize(), FRAG_NORMAL_STREAM);
+				ClearSharedStream(SHARED_RELIABLE);
 				m_reliableStream.FastClear();
 			}
 		}
@@ -436,9 +459,11 @@ void NetChannel::TransmitOutgoing()
 
 		if (send_from_regular)
 		{
-			Q_memcpy(m_reliableOutBuffer, m_reliableStream.GetData(), m_reliableStream.CurrentSize());
+			BitBuffer reliable(m_reliableOutBuffer, sizeof(m_reliableOutBuffer));
+			WriteSharedStream(SHARED_RELIABLE, &reliable);
 
-			m_reliableOutSize = m_reliableStream.CurrentSize();
+			m_reliableOutSize = reliable.CurrentSize();
+			ClearSharedStream(SHARED_RELIABLE);
 			m_reliableStream.FastClear();
 
 			// If we send fragments, this is where they'll start
@@ -543,13 +568,14 @@ void NetChannel::TransmitOutgoing()
 
 	// Is there room for the unreliable payload?
 	int max_send_size = send_resending ? MAX_ROUTEABLE_PACKET : NET_MAX_MESSAGE;
-	if ((max_send_size - data.CurrentSize()) >= m_unreliableStream.CurrentSize()) {
-		data.ConcatBuffer(&m_unreliableStream);
+	if ((max_send_size - data.CurrentSize()) >= GetSharedStreamSize(SHARED_UNRELIABLE)) {
+		WriteSharedStream(SHARED_UNRELIABLE, &data);
 	}
 	else {
 		m_System->DPrintf("WARNING! TransmitOutgoing: Unreliable would overfow, ignoring.\n");
 	}
 
+	ClearSharedStream(SHARED_UNRELIABLE);
 	m_unreliableStream.FastClear();
 
 	// Deal with packets that are too small for some networks
@@ -970,6 +996,105 @@ void NetChannel::AddBufferToList(fragbuf_t **pplist, fragbuf_t *pbuf)
 	pprev->next = pbuf;
 }
 
+// Spectators that connect or get a full update together are sent the same data, which is compressed
+// for each of their channels. The latest results are kept, so identical buffers are compressed only once.
+// The module owning the channels frees them on shutdown through NetChannel::FreeCompressCache.
+const int MAX_COMPRESS_CACHE = 4;
+
+typedef struct compresscache_s
+{
+	unsigned char *source;
+	unsigned int sourceSize;
+	unsigned int maxSize;		// size limit the result was produced with
+	unsigned char *compressed;
+	unsigned int compressedSize;
+	int result;
+	unsigned int lastUsed;
+} compresscache_t;
+
+static compresscache_t g_CompressCache[MAX_COMPRESS_CACHE];
+static unsigned int g_CompressCacheTick;
+
+static int NET_CompressBuffer(char *dest, unsigned int *destLen, char *source, unsigned int sourceLen)
+{
+	compresscache_t *oldest = &g_CompressCache[0];
+	g_CompressCacheTick++;
+
+	for (int i = 0; i < MAX_COMPRESS_CACHE; i++)
+	{
+		compresscache_t *entry = &g_CompressCache[i];
+		if (entry->source && entry->sourceSize == sourceLen && entry->maxSize == *destLen
+			&& !Q_memcmp(entry->source, source, sourceLen))
+		{
+			entry->lastUsed = g_CompressCacheTick;
+			if (entry->result == BZ_OK)
+			{
+				Q_memcpy(dest, entry->compressed, entry->compressedSize);
+				*destLen = entry->compressedSize;
+			}
+
+			return entry->result;
+		}
+
+		if (entry->lastUsed < oldest->lastUsed)
+			oldest = entry;
+	}
+
+	unsigned int maxSize = *destLen;
+	int result = BZ2_bzBuffToBuffCompress(dest, destLen, source, sourceLen, 9, 0, 30);
+
+	if (oldest->source)
+		Mem_Free(oldest->source);
+
+	if (oldest->compressed)
+		Mem_Free(oldest->compressed);
+
+	oldest->source = (unsigned char *)Mem_Malloc(sourceLen);
+	oldest->compressed = (result == BZ_OK) ? (unsigned char *)Mem_Malloc(*destLen) : nullptr;
+
+	if (!oldest->source || (result == BZ_OK && !oldest->compressed))
+	{
+		if (oldest->source)
+			Mem_Free(oldest->source);
+
+		if (oldest->compressed)
+			Mem_Free(oldest->compressed);
+
+		Q_memset(oldest, 0, sizeof(*oldest));
+		return result;
+	}
+
+	Q_memcpy(oldest->source, source, sourceLen);
+	oldest->sourceSize = sourceLen;
+	oldest->maxSize = maxSize;
+	oldest->result = result;
+	oldest->lastUsed = g_CompressCacheTick;
+
+	if (result == BZ_OK)
+	{
+		Q_memcpy(oldest->compressed, dest, *destLen);
+		oldest->compressedSize = *destLen;
+	}
+
+	return result;
+}
+
+void NetChannel::FreeCompressCache()
+{
+	for (int i = 0; i < MAX_COMPRESS_CACHE; i++)
+	{
+		compresscache_t *entry = &g_CompressCache[i];
+		if (entry->source)
+			Mem_Free(entry->source);
+
+		if (entry->compressed)
+			Mem_Free(entry->compressed);
+	}
+
+	Q_memset(g_CompressCache, 0, sizeof(g_CompressCache));
+	g_CompressCacheTick = 0;
+}
+
 bool NetChannel::CreateFragmentsFromBuffer(void *buffer, int size, int streamtype, char *filename)
 {
 	fragbuf_t *buf;
@@ -1001,7 +1126,7 @@ bool NetChannel::CreateFragmentsFromBuffer(void *buffer, int size, int streamtyp
 		compressedSize -= 4;
 	}
 
-	if (!BZ2_bzBuffToBuffCompress((char *)compressed, &compressedSize, (char *)buffer, size, 9, 0, 30))
+	if (!NET_CompressBuffer((char *)compressed, &compressedSize, (char *)buffer, size))
 	{
 		m_System->DPrintf("Compressing split packet (%d -> %d bytes)\n", size, compressedSize);
 		Q_memcpy(buffer, hdr, sizeof(hdr));
@@ -1112,6 +1237,103 @@ void NetChannel::FreePacket(NetPacket *packet)
 	}
 }
 
+// Proxy::Broadcast sends the same data to all clients. It is kept once, each channel only stores a reference
+// with the position in its stream the data would have been copied to, and reserves the room for it there,
+// so further writes overflow the stream just like before. TransmitOutgoing copies the payloads into the
+// packet, where they are sequenced and munged per channel as usual.
+NetChannel::sharedbuf_t *NetChannel::AllocSharedBuffer(const void *data, int size)
+{
+	if (!data || size <= 0) {
+		return nullptr;
+	}
+
+	sharedbuf_t *buf = (sharedbuf_t *)Mem_Malloc(sizeof(sharedbuf_t) + size);
+	if (!buf) {
+		return nullptr;
+	}
+
+	buf->refcount = 1;
+	buf->size = size;
+	Q_memcpy(buf->data, data, size);
+
+	return buf;
+}
+
+void NetChannel::ReleaseSharedBuffer(sharedbuf_t *buf)
+{
+	if (--buf->refcount == 0) {
+		Mem_Free(buf);
+	}
+}
+
+void NetChannel::WriteSharedBuffer(sharedbuf_t *buf, bool isReliable)
+{
+	int index = isReliable ? SHARED_RELIABLE : SHARED_UNRELIABLE;
+	BitBuffer *stream = GetSharedStream(index);
+	sharedstream_t *shared = &m_sharedStreams[index];
+
+	// In bit mode, out of references or overflowing, copy it as usual
+	if (stream->m_CurBit || stream->IsOverflowed() || shared->count == MAX_SHARED_REFS
+		|| stream->CurrentSize() + buf->size > stream->GetMaxSize())
+	{
+		stream->WriteBuf(buf->data, buf->size);
+		return;
+	}
+
+	sharedref_t *ref = &shared->refs[shared->count++];
+	ref->offset = stream->CurrentSize();
+	ref->buf = buf;
+	buf->refcount++;
+
+	shared->size += buf->size;
+	stream->m_MaxSize -= buf->size;
+}
+
+BitBuffer *NetChannel::GetSharedStream(int index)
+{
+	return (index == SHARED_RELIABLE) ? &m_reliableStream : &m_unreliableStream;
+}
+
+// Size of the stream with the referenced payloads
+int NetChannel::GetSharedStreamSize(int index)
+{
+	return GetSharedStream(index)->CurrentSize() + m_sharedStreams[index].size;
+}
+
+// Writes the stream to dest with the referenced payloads in place
+void NetChannel::WriteSharedStream(int index, BitBuffer *dest)
+{
+	BitBuffer *stream = GetSharedStream(index);
+	sharedstream_t *shared = &m_sharedStreams[index];
+	int pos = 0;
+
+	for (int i = 0; i < shared->count; i++)
+	{
+		sharedref_t *ref = &shared->refs[i];
+
+		dest->WriteBuf(stream->GetData() + pos, ref->offset - pos);
+		dest->WriteBuf(ref->buf->data, ref->buf->size);
+		pos = ref->offset;
+	}
+
+	dest->WriteBuf(stream->GetData() + pos, stream->CurrentSize() - pos);
+}
+
+// Drops the references and gives the reserved room back, the stream itself is cleared by the caller
+void NetChannel::ClearSharedStream(int index)
+{
+	sharedstream_t *shared = &m_sharedStreams[index];
+
+	for (int i = 0; i < shared->count; i++) {
+		ReleaseSharedBuffer(shared->refs[i].buf);
+	}
+
+	GetSharedStream(index)->m_MaxSize += shared->size;
+
+	shared->count = 0;
+	shared->size = 0;
+}
+
 void NetChannel::SetUpdateRate(int newupdaterate)
 {
 	m_updaterate = newupdaterate;
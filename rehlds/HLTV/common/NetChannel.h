@@ -170,6 +170,35 @@ public:
 		fragbuf_t *fragbufs;			// The actual buffers
 	} fragbufwaiting_t;
 
+	// Payload broadcast to several channels, kept once and referenced by each of them
+	typedef struct sharedbuf_s
+	{
+		int refcount;
+		int size;
+		byte data[1];
+	} sharedbuf_t;
+
+	enum { SHARED_RELIABLE, SHARED_UNRELIABLE, MAX_SHARED_STREAMS };
+	enum { MAX_SHARED_REFS = 64 };
+
+	typedef struct sharedref_s
+	{
+		int offset;						// Position in the stream the payload belongs to
+		sharedbuf_t *buf;
+	} sharedref_t;
+
+	typedef struct sharedstream_s
+	{
+		int count;
+		int size;						// Total size of the payloads, reserved in the stream
+		sharedref_t refs[MAX_SHARED_REFS];
+	} sharedstream_t;
+
+	static sharedbuf_t *AllocSharedBuffer(const void *data, int size);
+	static void ReleaseSharedBuffer(sharedbuf_t *buf);
+	static void FreeCompressCache();
+	void WriteSharedBuffer(sharedbuf_t *buf, bool isReliable);
+
 	bool ValidateFragments(BitBuffer &buf, bool *frag_message, unsigned int *fragid, int *frag_offset, int *frag_length);
 	bool CreateFragmentsFromFile(char *fileName);
 	bool CopyFileFragments();
@@ -190,6 +219,10 @@ public:
 	void FragSend();
 	bool CheckForCompletion(int stream, int intotalbuffers);
 	fragbuf_t *FindBufferById(fragbuf_t **pplist, int id, bool allocate);
+	BitBuffer *GetSharedStream(int index);
+	int GetSharedStreamSize(int index);
+	void WriteSharedStream(int index, BitBuffer *dest);
+	void ClearSharedStream(int index);
 
 public:
 	IBaseSystem *m_System;
@@ -223,6 +256,7 @@ public:
 	int m_blocksize;
 	BitBuffer m_reliableStream;
 	BitBuffer m_unreliableStream;
+	sharedstream_t m_sharedStreams[MAX_SHARED_STREAMS];	// Broadcast payloads referenced by the reliable and unreliable stream
 	ObjectList m_incomingPackets;
 
 	// Reliable message buffer.
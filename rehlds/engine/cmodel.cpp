@@ -123,6 +123,356 @@ unsigned char *CM_LeafPAS(int leafnum)
 	return mod_novis;
 }
 
+#ifdef REHLDS_FIXES
+// PAS cache (sv_rehlds_pas_cache).
+// The decompressed PVS and the PAS of a map are written to rehlds_cache/<map>_<crc>.pas after they were built,
+// a later load of the same map maps that file read only and points gPVS and gPAS into it.
+const char PAS_CACHE_MAGIC[4] = { 'R', 'P', 'A', 'S' };
+const int PAS_CACHE_VERSION = 2;	// version 1 files may hold a PAS that was built from unfinished PVS rows
+
+typedef struct pascache_header_s
+{
+	char magic[4];
+	int version;
+	CRC32_t mapcrc;
+	int numleafs;
+	int rowbytes;
+	int vcount;
+	int acount;
+	int reserved;
+} pascache_header_t;
+
+// The rows are built in chunks, each worker counts the visible and audible leaves of its own rows
+const int PAS_BUILD_ROWS = 32;
+
+typedef struct pasbuild_s
+{
+	model_t *model;
+	int count;			// rows
+	int rowbytes;
+	byte *pvs;
+	byte *pas;
+	int vcount[MAX_WORKER_THREADS + 1];
+	int acount[MAX_WORKER_THREADS + 1];
+} pasbuild_t;
+
+static CWorkerPool g_PASWorkerPool;
+static void *g_pPASCacheView;		// gPVS and gPAS point into it when the matrices were loaded from the cache
+static size_t g_PASCacheSize;
+static int g_PASVisibleCount;
+static int g_PASAudibleCount;
+
+static inline int CM_LowestBit(uint32 bits)
+{
+#ifdef _WIN32
+	unsigned long index;
+	_BitScanForward(&index, bits);
+	return index;
+#else
+	return __builtin_ctz(bits);
+#endif
+}
+
+// Number of bits set among the first numbits of the row, never past its end
+static int CM_CountRowBits(const byte *row, int rowbytes, int numbits)
+{
+	numbits = Q_min(numbits, rowbytes * 8);
+	const uint32 *words = (const uint32 *)row;
+	int count = 0;
+
+	for (int w = 0; w < (numbits >> 5); w++)
+	{
+		for (uint32 bits = words[w]; bits; bits &= bits - 1)
+			count++;
+	}
+
+	if (numbits & 31)
+	{
+		for (uint32 bits = words[numbits >> 5] & ((1u << (numbits & 31)) - 1); bits; bits &= bits - 1)
+			count++;
+	}
+
+	return count;
+}
+
+static void CM_OrRow(uint32 *dest, const uint32 *src, int rowwords)
+{
+	int l = 0;
+
+#ifdef REHLDS_SSE
+	for (; l + 4 <= rowwords; l += 4)
+	{
+		__m128i d = _mm_loadu_si128((const __m128i *)&dest[l]);
+		__m128i s = _mm_loadu_si128((const __m128i *)&src[l]);
+		_mm_storeu_si128((__m128i *)&dest[l], _mm_or_si128(d, s));
+	}
+#endif // REHLDS_SSE
+
+	for (; l < rowwords; l++)
+		dest[l] |= src[l];
+}
+
+static void CM_DecompressPVSJob(int index, int worker, void *ctx)
+{
+	pasbuild_t *b = (pasbuild_t *)ctx;
+	int last = Q_min(b->count, (index + 1) * PAS_BUILD_ROWS);
+	int rows = (b->model->numleafs + 7) / 8;
+
+	for (int i = index * PAS_BUILD_ROWS; i < last; i++)
+	{
+		byte *scan = &b->pvs[i * b->rowbytes];
+		CM_DecompressPVS(b->model->leafs[i].compressed_vis, scan, rows);
+
+		if (i != 0)
+			b->vcount[worker] += CM_CountRowBits(scan, b->rowbytes, b->count);
+	}
+}
+
+// Same rows as the byte by byte loop, the leaves seen from a leaf are found a word at a time
+static void CM_BuildPASJob(int index, int worker, void *ctx)
+{
+	pasbuild_t *b = (pasbuild_t *)ctx;
+	int last = Q_min(b->count, (index + 1) * PAS_BUILD_ROWS);
+	int rowwords = b->rowbytes / 4;
+
+	for (int i = index * PAS_BUILD_ROWS; i < last; i++)
+	{
+		const uint32 *scan = (const uint32 *)&b->pvs[i * b->rowbytes];
+		uint32 *dest = (uint32 *)&b->pas[i * b->rowbytes];
+
+		Q_memcpy(dest, scan, b->rowbytes);
+
+		for (int w = 0; w < rowwords; w++)
+		{
+			for (uint32 bits = scan[w]; bits; bits &= bits - 1)
+			{
+				int leafnum = (w << 5) + CM_LowestBit(bits) + 1;
+				if (leafnum >= b->count)
+					break;
+
+				CM_OrRow(dest, (const uint32 *)&b->pvs[leafnum * b->rowbytes], rowwords);
+			}
+		}
+
+		if (i != 0)
+			b->acount[worker] += CM_CountRowBits((byte *)dest, b->rowbytes, b->count);
+	}
+}
+
+static void CM_PASCacheName(model_t *pModel, CRC32_t mapCRC, char *name, int size)
+{
+	char base[MAX_PATH];
+	COM_FileBase(pModel->name, base);
+	Q_snprintf(name, size, "rehlds_cache/%s_%08x.pas", base, mapCRC);
+}
+
+static void *CM_MapFile(const char *path, size_t *size)
+{
+#ifdef _WIN32
+	HANDLE file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+	if (file == INVALID_HANDLE_VALUE)
+		return nullptr;
+
+	LARGE_INTEGER filesize;
+	if (!GetFileSizeEx(file, &filesize) || filesize.HighPart || !filesize.LowPart)
+	{
+		CloseHandle(file);
+		return nullptr;
+	}
+
+	// the view keeps the mapping and the file open
+	HANDLE mapping = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+	CloseHandle(file);
+	if (!mapping)
+		return nullptr;
+
+	void *view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+	CloseHandle(mapping);
+
+	*size = filesize.LowPart;
+	return view;
+#else
+	int fd = open(path, O_RDONLY);
+	if (fd == -1)
+		return nullptr;
+
+	struct stat st;
+	if (fstat(fd, &st) == -1 || st.st_size <= 0)
+	{
+		close(fd);
+		return nullptr;
+	}
+
+	void *view = mmap(NULL, st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+	close(fd);
+	if (view == MAP_FAILED)
+		return nullptr;
+
+	*size = st.st_size;
+	return view;
+#endif // _WIN32
+}
+
+static void CM_UnmapFile(void *view, size_t size)
+{
+#ifdef _WIN32
+	UnmapViewOfFile(view);
+#else
+	munmap(view, size);
+#endif
+}
+
+qboolean CM_LoadPASCache(model_t *pModel, CRC32_t mapCRC)
+{
+	char name[MAX_PATH];
+	char path[MAX_PATH];
+
+	double start = Sys_FloatTime();
+	CM_FreePAS();
+
+	CM_PASCacheName(pModel, mapCRC, name, sizeof(name));
+	if (!FS_GetLocalPath(name, path, sizeof(path)))
+		return FALSE;
+
+	size_t size;
+	void *view = CM_MapFile(path, &size);
+	if (!view)
+		return FALSE;
+
+	const pascache_header_t *header = (const pascache_header_t *)view;
+	int count = pModel->numleafs + 1;
+	int rowbytes = (((pModel->numleafs + 7) / 8) + 3) & ~3;
+
+	if (size != sizeof(pascache_header_t) + 2 * (size_t)rowbytes * count
+		|| Q_memcmp(header->magic, PAS_CACHE_MAGIC, sizeof(header->magic))
+		|| header->version != PAS_CACHE_VERSION
+		|| header->mapcrc != mapCRC
+		|| header->numleafs != pModel->numleafs
+		|| header->rowbytes != rowbytes)
+	{
+		Con_Printf("Ignoring stale PAS cache %s\n", name);
+		CM_UnmapFile(view, size);
+		return FALSE;
+	}
+
+	g_pPASCacheView = view;
+	g_PASCacheSize = size;
+	gPVSRowBytes = rowbytes;
+	gPVS = (byte *)view + sizeof(pascache_header_t);
+	gPAS = gPVS + rowbytes * count;
+
+	Con_Printf("PAS loaded from %s in %.1f ms\n", name, (Sys_FloatTime() - start) * 1000.0);
+	Con_DPrintf("Average leaves visible / audible / total: %i / %i / %i\n", header->vcount / count, header->acount / count, count);
+	return TRUE;
+}
+
+void CM_SavePASCache(model_t *pModel, CRC32_t mapCRC)
+{
+	char name[MAX_PATH];
+	char tempname[MAX_PATH];
+
+	if (!gPVS || !gPAS || g_pPASCacheView)
+		return;
+
+	CM_PASCacheName(pModel, mapCRC, name, sizeof(name));
+	Q_snprintf(tempname, sizeof(tempname), "%s.tmp", name);
+
+	FS_CreateDirHierarchy("rehlds_cache", NULL);
+	FileHandle_t f = FS_Open(tempname, "wb");
+	if (!f)
+	{
+		Con_Printf("Couldn't write PAS cache %s\n", tempname);
+		return;
+	}
+
+	pascache_header_t header;
+	Q_memset(&header, 0, sizeof(header));
+	Q_memcpy(header.magic, PAS_CACHE_MAGIC, sizeof(header.magic));
+	header.version = PAS_CACHE_VERSION;
+	header.mapcrc = mapCRC;
+	header.numleafs = pModel->numleafs;
+	header.rowbytes = gPVSRowBytes;
+	header.vcount = g_PASVisibleCount;
+	header.acount = g_PASAudibleCount;
+
+	int count = pModel->numleafs + 1;
+	qboolean ok = FS_Write(&header, sizeof(header), 1, f) == 1
+		&& FS_Write(gPVS, gPVSRowBytes, count, f) == count
+		&& FS_Write(gPAS, gPVSRowBytes, count, f) == count;
+	FS_Close(f);
+
+	// renamed only once complete, another server may be mapping the old one
+	if (ok)
+		FS_Rename(tempname, name);
+	else
+		FS_RemoveFile(tempname, NULL);
+}
+
+void CM_FreePAS(void)
+{
+	if (g_pPASCacheView)
+	{
+		CM_UnmapFile(g_pPASCacheView, g_PASCacheSize);
+		g_pPASCacheView = nullptr;
+		g_PASCacheSize = 0;
+	}
+	else
+	{
+		if (gPAS)
+			Mem_Free(gPAS);
+		if (gPVS)
+			Mem_Free(gPVS);
+	}
+	gPAS = 0;
+	gPVS = 0;
+}
+
+void CM_ShutdownPASWorkers(void)
+{
+	g_PASWorkerPool.Stop();
+}
+
+void CM_CalcPAS(model_t *pModel)
+{
+	Con_DPrintf("Building PAS...\n");
+	CM_FreePAS();
+
+	double start = Sys_FloatTime();
+
+	pasbuild_t build;
+	Q_memset(&build, 0, sizeof(build));
+	build.model = pModel;
+	build.count = pModel->numleafs + 1;
+	build.rowbytes = (((pModel->numleafs + 7) / 8) + 3) & ~3;	// 4-byte align
+
+	gPVSRowBytes = build.rowbytes;
+	gPVS = build.pvs = (byte *)Mem_Calloc(build.rowbytes, build.count);
+	gPAS = build.pas = (byte *)Mem_Calloc(build.rowbytes, build.count);
+
+	g_PASWorkerPool.Start((int)sv_rehlds_pas_threads.value);
+	int numChunks = (build.count + PAS_BUILD_ROWS - 1) / PAS_BUILD_ROWS;
+
+	// every row of the PVS has to be there before the PAS rows are built from them
+	g_PASWorkerPool.Run(numChunks, CM_DecompressPVSJob, &build);
+	g_PASWorkerPool.Run(numChunks, CM_BuildPASJob, &build);
+
+	// the pool stays up until the server shuts down, the next map reuses its threads
+	int numThreads = g_PASWorkerPool.GetNumThreads() + 1;
+
+	g_PASVisibleCount = 0;
+	g_PASAudibleCount = 0;
+	for (int w = 0; w <= MAX_WORKER_THREADS; w++)
+	{
+		g_PASVisibleCount += build.vcount[w];
+		g_PASAudibleCount += build.acount[w];
+	}
+
+	Con_Printf("PAS built in %.1f ms on %i thread(s)\n", (Sys_FloatTime() - start) * 1000.0, numThreads);
+	Con_DPrintf("Average leaves visible / audible / total: %i / %i / %i\n", g_PASVisibleCount / build.count, g_PASAudibleCount / build.count, build.count);
+}
+
+#else // REHLDS_FIXES
+
 void CM_FreePAS(void)
 {
 	if (gPAS)
@@ -234,6 +584,7 @@ void CM_CalcPAS(model_t *pModel)
 
 	Con_DPrintf("Average leaves visible / audible / total: %i / %i / %i\n", vcount / count, acount / count, count);
 }
+#endif // REHLDS_FIXES
 
 qboolean CM_HeadnodeVisible(mnode_t *node, unsigned char *visbits, int *first_visible_leafnum)
 {
@@ -47,4 +47,9 @@ unsigned char *CM_LeafPVS(int leafnum);
 unsigned char *CM_LeafPAS(int leafnum);
 void CM_FreePAS(void);
 void CM_CalcPAS(model_t *pModel);
+#ifdef REHLDS_FIXES
+qboolean CM_LoadPASCache(model_t *pModel, CRC32_t mapCRC);
+void CM_SavePASCache(model_t *pModel, CRC32_t mapCRC);
+void CM_ShutdownPASWorkers(void);
+#endif
 qboolean CM_HeadnodeVisible(mnode_t *node, unsigned char *visbits, int *first_visible_leafnum);
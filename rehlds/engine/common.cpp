@@ -330,32 +330,6 @@ void MSG_WriteUsercmd(sizebuf_t *buf, usercmd_t *to, usercmd_t *from)
 	MSG_EndBitWriting(buf);
 }
 
-typedef struct bf_write_s
-{
-	// For enhanced and safe bits writing functions
-#if defined(REHLDS_FIXES)
-
-#pragma pack(push, 1)
-	union {
-		uint64 u64;
-		uint32 u32[2];
-		uint8 u8[8];
-	} pendingData;
-	uint64 sse_highbits;
-#pragma pack(pop)
-
-	int nCurOutputBit;
-	sizebuf_t *pbuf;
-
-#else // defined(REHLDS_FIXES)
-
-	int nCurOutputBit;
-	unsigned char *pOutByte;
-	sizebuf_t *pbuf;
-
-#endif // defined(REHLDS_FIXES)
-} bf_write_t;
-
 typedef struct bf_read_s
 {
 	int nMsgReadCount;	// was msg_readcount
@@ -377,112 +351,162 @@ void COM_BitOpsInit(void)
 	Q_memset(&bfread, 0, sizeof(bf_read_t));
 }
 
+// The MSG_*Bits functions write through the global writer, the encoders take a writer
+// from their caller and pass it down to the MSG_*BitsTo functions
+bf_write_t *MSG_GetBitWriter(void)
+{
+	return &bfwrite;
+}
+
 // Enhanced and safe bits writing functions
 #if defined(REHLDS_FIXES)
 
-void MSG_WBits_MaybeFlush() {
-	if (bfwrite.nCurOutputBit < 32)
+void MSG_WBits_MaybeFlush(bf_write_t *bw) {
+	if (bw->nCurOutputBit < 32)
 		return;
 
-	uint32* pDest = (uint32*)SZ_GetSpace(bfwrite.pbuf, 4);
-	if (!(bfwrite.pbuf->flags & SIZEBUF_OVERFLOWED))
-		*pDest = bfwrite.pendingData.u32[0];
+	uint32* pDest = (uint32*)SZ_GetSpace(bw->pbuf, 4);
+	if (!(bw->pbuf->flags & SIZEBUF_OVERFLOWED))
+		*pDest = bw->pendingData.u32[0];
 
-	bfwrite.pendingData.u32[0] = bfwrite.pendingData.u32[1];
-	bfwrite.pendingData.u32[1] = 0;
-	bfwrite.nCurOutputBit -= 32;
+	bw->pendingData.u32[0] = bw->pendingData.u32[1];
+	bw->pendingData.u32[1] = 0;
+	bw->nCurOutputBit -= 32;
 }
 
-void MSG_WriteBits(uint32 data, int numbits)
+void MSG_WriteBitsTo(bf_write_t *bw, uint32 data, int numbits)
 {
 	uint32 maxval = _mm_cvtsi128_si32(_mm_slli_epi64(_mm_cvtsi32_si128(1), numbits)) - 1; //maxval = (1 << numbits) - 1
 	if (data > maxval)
 		data = maxval;
 
-	MSG_WBits_MaybeFlush();
+	MSG_WBits_MaybeFlush(bw);
 
-	__m128i pending = _mm_load_si128((__m128i*) &bfwrite.pendingData.u64);
+	// writers of the callers are not necessarily 16-byte aligned, only the low qword is used anyway
+	__m128i pending = _mm_loadl_epi64((__m128i*) &bw->pendingData.u64);
 
-	__m128i mmdata = _mm_slli_epi64(_mm_cvtsi32_si128(data), bfwrite.nCurOutputBit); //mmdata = data << bfwrite.nCurOutputBit
+	__m128i mmdata = _mm_slli_epi64(_mm_cvtsi32_si128(data), bw->nCurOutputBit); //mmdata = data << bw->nCurOutputBit
 	pending = _mm_or_si128(pending, mmdata);
 
-	_mm_store_si128((__m128i*) &bfwrite.pendingData.u64, pending);
-	bfwrite.nCurOutputBit += numbits;
+	_mm_storel_epi64((__m128i*) &bw->pendingData.u64, pending);
+	bw->nCurOutputBit += numbits;
 }
 
-void MSG_WriteOneBit(int nValue) {
-	MSG_WriteBits(nValue, 1);
+void MSG_WriteOneBitTo(bf_write_t *bw, int nValue) {
+	MSG_WriteBitsTo(bw, nValue, 1);
 }
 
-void MSG_StartBitWriting(sizebuf_t *buf)
+void MSG_StartBitWritingTo(bf_write_t *bw, sizebuf_t *buf)
 {
-	bfwrite.nCurOutputBit = 0;
-	bfwrite.pbuf = buf;
-	bfwrite.pendingData.u64 = 0;
+	bw->nCurOutputBit = 0;
+	bw->pbuf = buf;
+	bw->pendingData.u64 = 0;
 }
 
-void MSG_EndBitWriting(sizebuf_t *buf)
+void MSG_EndBitWritingTo(bf_write_t *bw)
 {
-	int bytesNeed = bfwrite.nCurOutputBit / 8;
-	if ((bfwrite.nCurOutputBit % 8) || bytesNeed == 0) {
+	int bytesNeed = bw->nCurOutputBit / 8;
+	if ((bw->nCurOutputBit % 8) || bytesNeed == 0) {
 		bytesNeed++;
 	}
 
-	uint8* pData = (uint8*)SZ_GetSpace(bfwrite.pbuf, bytesNeed);
-	if (!(bfwrite.pbuf->flags & SIZEBUF_OVERFLOWED)) {
+	uint8* pData = (uint8*)SZ_GetSpace(bw->pbuf, bytesNeed);
+	if (!(bw->pbuf->flags & SIZEBUF_OVERFLOWED)) {
 		for (int i = 0; i < bytesNeed; i++) {
-			pData[i] = bfwrite.pendingData.u8[i];
+			pData[i] = bw->pendingData.u8[i];
 		}
 	}
 
 }
 
+// Captures a piece of the stream into a separate buffer, the state of the writer is parked in outer meanwhile
+void MSG_BeginBitCaptureTo(bf_write_t *bw, bf_write_t *outer, sizebuf_t *buf)
+{
+	*outer = *bw;
+	MSG_StartBitWritingTo(bw, buf);
+}
+
+// Returns the number of captured bits or -1 if the capture buffer overflowed
+int MSG_EndBitCaptureTo(bf_write_t *bw, const bf_write_t *outer)
+{
+	sizebuf_t *buf = bw->pbuf;
+	int numbits = buf->cursize * 8 + bw->nCurOutputBit;
+	int bytesNeed = (bw->nCurOutputBit + 7) / 8;
+
+	if (bytesNeed)
+	{
+		uint8* pData = (uint8*)SZ_GetSpace(buf, bytesNeed);
+		if (!(buf->flags & SIZEBUF_OVERFLOWED))
+			Q_memcpy(pData, bw->pendingData.u8, bytesNeed);
+	}
+
+	*bw = *outer;
+	return (buf->flags & SIZEBUF_OVERFLOWED) ? -1 : numbits;
+}
+
+// Appends previously captured bits, a word at a time. src must be readable up to a whole word.
+void MSG_WriteBitBufferTo(bf_write_t *bw, const void *src, int numbits)
+{
+	const uint32 *p = (const uint32 *)src;
+
+	for (; numbits >= 32; numbits -= 32)
+		MSG_WriteBitsTo(bw, *p++, 32);
+
+	if (numbits > 0)
+		MSG_WriteBitsTo(bw, *p & ((1u << numbits) - 1), numbits);
+}
+
+void MSG_WriteBitBuffer(const void *src, int numbits)
+{
+	MSG_WriteBitBufferTo(&bfwrite, src, numbits);
+}
+
 #else // defined(REHLDS_FIXES)
 
-void MSG_WriteOneBit(int nValue)
+void MSG_WriteOneBitTo(bf_write_t *bw, int nValue)
 {
-	if (bfwrite.nCurOutputBit >= 8)
+	if (bw->nCurOutputBit >= 8)
 	{
-		SZ_GetSpace(bfwrite.pbuf, 1);
-		bfwrite.nCurOutputBit = 0;
-		++bfwrite.pOutByte;
+		SZ_GetSpace(bw->pbuf, 1);
+		bw->nCurOutputBit = 0;
+		++bw->pOutByte;
 	}
 
-	if (!(bfwrite.pbuf->flags & SIZEBUF_OVERFLOWED))
+	if (!(bw->pbuf->flags & SIZEBUF_OVERFLOWED))
 	{
 		if (nValue)
 		{
-			*bfwrite.pOutByte |= BITTABLE[bfwrite.nCurOutputBit];
+			*bw->pOutByte |= BITTABLE[bw->nCurOutputBit];
 		}
 		else
 		{
-			*bfwrite.pOutByte &= INVBITTABLE[bfwrite.nCurOutputBit * 4];
+			*bw->pOutByte &= INVBITTABLE[bw->nCurOutputBit * 4];
 		}
 
-		bfwrite.nCurOutputBit++;
+		bw->nCurOutputBit++;
 	}
 }
 
-void MSG_StartBitWriting(sizebuf_t *buf)
+void MSG_StartBitWritingTo(bf_write_t *bw, sizebuf_t *buf)
 {
-	bfwrite.nCurOutputBit = 0;
-	bfwrite.pbuf = buf;
-	bfwrite.pOutByte = &buf->data[buf->cursize];
+	bw->nCurOutputBit = 0;
+	bw->pbuf = buf;
+	bw->pOutByte = &buf->data[buf->cursize];
 }
 
-void MSG_EndBitWriting(sizebuf_t *buf)
+void MSG_EndBitWritingTo(bf_write_t *bw)
 {
-	if (!(bfwrite.pbuf->flags & SIZEBUF_OVERFLOWED))
+	if (!(bw->pbuf->flags & SIZEBUF_OVERFLOWED))
 	{
-		*bfwrite.pOutByte &= 255 >> (8 - bfwrite.nCurOutputBit);
-		SZ_GetSpace(bfwrite.pbuf, 1);
-		bfwrite.nCurOutputBit = 0;
-		bfwrite.pOutByte = 0;
-		bfwrite.pbuf = 0;
+		*bw->pOutByte &= 255 >> (8 - bw->nCurOutputBit);
+		SZ_GetSpace(bw->pbuf, 1);
+		bw->nCurOutputBit = 0;
+		bw->pOutByte = 0;
+		bw->pbuf = 0;
 	}
 }
 
-void MSG_WriteBits(uint32 data, int numbits)
+void MSG_WriteBitsTo(bf_write_t *bw, uint32 data, int numbits)
 {
 	if (numbits < 32)
 	{
@@ -491,52 +515,72 @@ void MSG_WriteBits(uint32 data, int numbits)
 	}
 
 	int surplusBytes = 0;
-	if ((uint32)bfwrite.nCurOutputBit >= 8)
+	if ((uint32)bw->nCurOutputBit >= 8)
 	{
 		surplusBytes = 1;
-		bfwrite.nCurOutputBit = 0;
-		++bfwrite.pOutByte;
+		bw->nCurOutputBit = 0;
+		++bw->pOutByte;
 	}
 
-	int bits = numbits + bfwrite.nCurOutputBit;
+	int bits = numbits + bw->nCurOutputBit;
 	if (bits <= 32)
 	{
 		int bytesToWrite = bits >> 3;
 		int bitsLeft = bits & 7;
 		if (!bitsLeft)
 			--bytesToWrite;
-		SZ_GetSpace(bfwrite.pbuf, surplusBytes + bytesToWrite);
-		if (!(bfwrite.pbuf->flags & SIZEBUF_OVERFLOWED))
+		SZ_GetSpace(bw->pbuf, surplusBytes + bytesToWrite);
+		if (!(bw->pbuf->flags & SIZEBUF_OVERFLOWED))
 		{
-			*(uint32 *)bfwrite.pOutByte = (data << bfwrite.nCurOutputBit) | *(uint32 *)bfwrite.pOutByte & ROWBITTABLE[bfwrite.nCurOutputBit];
-			bfwrite.nCurOutputBit = 8;
+			*(uint32 *)bw->pOutByte = (data << bw->nCurOutputBit) | *(uint32 *)bw->pOutByte & ROWBITTABLE[bw->nCurOutputBit];
+			bw->nCurOutputBit = 8;
 			if (bitsLeft)
-				bfwrite.nCurOutputBit = bitsLeft;
-			bfwrite.pOutByte = &bfwrite.pOutByte[bytesToWrite];
+				bw->nCurOutputBit = bitsLeft;
+			bw->pOutByte = &bw->pOutByte[bytesToWrite];
 		}
 	}
 	else
 	{
-		SZ_GetSpace(bfwrite.pbuf, surplusBytes + 4);
-		if (!(bfwrite.pbuf->flags & SIZEBUF_OVERFLOWED))
+		SZ_GetSpace(bw->pbuf, surplusBytes + 4);
+		if (!(bw->pbuf->flags & SIZEBUF_OVERFLOWED))
 		{
-			*(uint32 *)bfwrite.pOutByte = (data << bfwrite.nCurOutputBit) | *(uint32 *)bfwrite.pOutByte & ROWBITTABLE[bfwrite.nCurOutputBit];
-			int leftBits = 32 - bfwrite.nCurOutputBit;
-			bfwrite.nCurOutputBit = bits & 7;
-			bfwrite.pOutByte += 4;
-			*(uint32 *)bfwrite.pOutByte = data >> leftBits;
+			*(uint32 *)bw->pOutByte = (data << bw->nCurOutputBit) | *(uint32 *)bw->pOutByte & ROWBITTABLE[bw->nCurOutputBit];
+			int leftBits = 32 - bw->nCurOutputBit;
+			bw->nCurOutputBit = bits & 7;
+			bw->pOutByte += 4;
+			*(uint32 *)bw->pOutByte = data >> leftBits;
 		}
 	}
 }
 
 #endif //defined(REHLDS_FIXES)
 
+void MSG_WriteOneBit(int nValue)
+{
+	MSG_WriteOneBitTo(&bfwrite, nValue);
+}
+
+void MSG_StartBitWriting(sizebuf_t *buf)
+{
+	MSG_StartBitWritingTo(&bfwrite, buf);
+}
+
+void MSG_EndBitWriting(sizebuf_t *buf)
+{
+	MSG_EndBitWritingTo(&bfwrite);
+}
+
+void MSG_WriteBits(uint32 data, int numbits)
+{
+	MSG_WriteBitsTo(&bfwrite, data, numbits);
+}
+
 qboolean MSG_IsBitWriting(void)
 {
 	return bfwrite.pbuf != 0;
 }
 
-void MSG_WriteSBits(int data, int numbits)
+void MSG_WriteSBitsTo(bf_write_t *bw, int data, int numbits)
 {
 	int idata = data;
 
@@ -552,11 +596,16 @@ void MSG_WriteSBits(int data, int numbits)
 
 	int sigbits = idata < 0;
 
-	MSG_WriteOneBit(sigbits);
-	MSG_WriteBits(abs(idata), numbits - 1);
+	MSG_WriteOneBitTo(bw, sigbits);
+	MSG_WriteBitsTo(bw, abs(idata), numbits - 1);
 }
 
-void MSG_WriteBitString(const char *p)
+void MSG_WriteSBits(int data, int numbits)
+{
+	MSG_WriteSBitsTo(&bfwrite, data, numbits);
+}
+
+void MSG_WriteBitStringTo(bf_write_t *bw, const char *p)
 {
 #ifdef REHLDS_FIXES
 	const uint8_t *pch = (uint8_t *)p;
@@ -566,11 +615,16 @@ void MSG_WriteBitString(const char *p)
 
 	while (*pch)
 	{
-		MSG_WriteBits(*pch, 8);
+		MSG_WriteBitsTo(bw, *pch, 8);
 		++pch;
 	}
 
-	MSG_WriteBits(0, 8);
+	MSG_WriteBitsTo(bw, 0, 8);
+}
+
+void MSG_WriteBitString(const char *p)
+{
+	MSG_WriteBitStringTo(&bfwrite, p);
 }
 
 void MSG_WriteBitData(void *src, int length)
@@ -584,7 +638,7 @@ void MSG_WriteBitData(void *src, int length)
 	}
 }
 
-void MSG_WriteBitAngle(float fAngle, int numbits)
+void MSG_WriteBitAngleTo(bf_write_t *bw, float fAngle, int numbits)
 {
 	if (numbits >= 32)
 	{
@@ -597,7 +651,12 @@ void MSG_WriteBitAngle(float fAngle, int numbits)
 	int d = (int)(shift * fmod((double)fAngle, 360.0)) / 360;
 	d &= mask;
 
-	MSG_WriteBits(d, numbits);
+	MSG_WriteBitsTo(bw, d, numbits);
+}
+
+void MSG_WriteBitAngle(float fAngle, int numbits)
+{
+	MSG_WriteBitAngleTo(&bfwrite, fAngle, numbits);
 }
 
 float MSG_ReadBitAngle(int numbits)
@@ -55,7 +55,32 @@ extern char gpszVersionString[32];
 extern char gpszProductString[32];
 
 typedef struct bf_read_s bf_read_t;
-typedef struct bf_write_s bf_write_t;
+
+typedef struct bf_write_s
+{
+	// For enhanced and safe bits writing functions
+#if defined(REHLDS_FIXES)
+
+#pragma pack(push, 1)
+	union {
+		uint64 u64;
+		uint32 u32[2];
+		uint8 u8[8];
+	} pendingData;
+	uint64 sse_highbits;
+#pragma pack(pop)
+
+	int nCurOutputBit;
+	sizebuf_t *pbuf;
+
+#else // defined(REHLDS_FIXES)
+
+	int nCurOutputBit;
+	unsigned char *pOutByte;
+	sizebuf_t *pbuf;
+
+#endif // defined(REHLDS_FIXES)
+} bf_write_t;
 
 extern bf_read_t bfread;
 extern bf_write_t bfwrite;
@@ -123,7 +148,23 @@ void MSG_WriteBits(uint32 data, int numbits);
 void MSG_WriteSBits(int data, int numbits);
 void MSG_WriteBitString(const char *p);
 void MSG_WriteBitData(void *src, int length);
+#ifdef REHLDS_FIXES
+void MSG_WriteBitBuffer(const void *src, int numbits);
+#endif
 void MSG_WriteBitAngle(float fAngle, int numbits);
+bf_write_t *MSG_GetBitWriter(void);
+void MSG_StartBitWritingTo(bf_write_t *bw, sizebuf_t *buf);
+void MSG_EndBitWritingTo(bf_write_t *bw);
+void MSG_WriteOneBitTo(bf_write_t *bw, int nValue);
+void MSG_WriteBitsTo(bf_write_t *bw, uint32 data, int numbits);
+void MSG_WriteSBitsTo(bf_write_t *bw, int data, int numbits);
+void MSG_WriteBitStringTo(bf_write_t *bw, const char *p);
+void MSG_WriteBitAngleTo(bf_write_t *bw, float fAngle, int numbits);
+#ifdef REHLDS_FIXES
+void MSG_BeginBitCaptureTo(bf_write_t *bw, bf_write_t *outer, sizebuf_t *buf);
+int MSG_EndBitCaptureTo(bf_write_t *bw, const bf_write_t *outer);
+void MSG_WriteBitBufferTo(bf_write_t *bw, const void *src, int numbits);
+#endif
 float MSG_ReadBitAngle(int numbits);
 int MSG_CurrentBit(void);
 qboolean MSG_IsBitReading(void);
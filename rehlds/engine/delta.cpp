@@ -416,7 +416,15 @@ int DELTA_TestDelta(unsigned char *from, unsigned char *to, delta_t *pFields)
 {
 #if (defined(REHLDS_OPT_PEDANTIC) || defined(REHLDS_FIXES)) && defined REHLDSJIT
 	return DELTAJit_TestDelta(from, to, pFields);
+#elif defined REHLDS_FIXES
+	return DELTABulk_TestDelta(from, to, pFields);
 #else
+	return DELTA_TestDeltaScalar(from, to, pFields);
+#endif
+}
+
+int DELTA_TestDeltaScalar(unsigned char *from, unsigned char *to, delta_t *pFields)
+{
 	int i;
 	char *st1, *st2;
 	delta_description_t *pTest;
@@ -491,7 +499,6 @@ int DELTA_TestDelta(unsigned char *from, unsigned char *to, delta_t *pFields)
 	}
 
 	return neededBits;
-#endif
 }
 
 int DELTA_CountSendFields(delta_t *pFields)
@@ -511,6 +518,29 @@ int DELTA_CountSendFields(delta_t *pFields)
 }
 
 void DELTA_MarkSendFields(unsigned char *from, unsigned char *to, delta_t *pFields)
+{
+#ifdef REHLDS_FIXES
+	DELTABulk_MarkSendFields(from, to, pFields);
+#else
+	DELTA_MarkSendFieldsScalar(from, to, pFields);
+#endif
+
+#if defined REHLDS_FIXES && !defined REHLDS_JIT
+	int i;
+	delta_description_t *pTest;
+	for (i = 0, pTest = pFields->pdd; i < pFields->fieldCount; i++, pTest++)
+	{
+		if (pTest->flags & FDT_MARK)
+			pFields->originalMarkedFieldsMask.u32[i >> 5] |= (1 << (i & 31));
+	}
+#endif
+
+	if (pFields->conditionalencode)
+		pFields->conditionalencode(pFields, from, to);
+}
+
+// Field by field compare, the bulk compare in delta_bulk.cpp marks the same fields
+void DELTA_MarkSendFieldsScalar(unsigned char *from, unsigned char *to, delta_t *pFields)
 {
 	int i;
 	char *st1, *st2;
@@ -565,14 +595,7 @@ void DELTA_MarkSendFields(unsigned char *from, unsigned char *to, delta_t *pFiel
 			Con_Printf("%s: Bad field type %i\n", __func__, fieldType);
 			break;
 		}
-
-#if defined REHLDS_FIXES && !defined REHLDS_JIT
-		if (pTest->flags & FDT_MARK)
-			pFields->originalMarkedFieldsMask.u32[i >> 5] |= (1 << (i & 31));
-#endif
 	}
-	if (pFields->conditionalencode)
-		pFields->conditionalencode(pFields, from, to);
 }
 
 void DELTA_SetSendFlagBits(delta_t *pFields, int *bits, int *bytecount)
@@ -614,7 +637,7 @@ qboolean DELTA_IsFieldMarked(delta_t* pFields, int fieldNumber)
 #endif
 }
 
-void DELTA_WriteMarkedFields(unsigned char *from, unsigned char *to, delta_t *pFields)
+void DELTA_WriteMarkedFieldsTo(bf_write_t *bw, unsigned char *from, unsigned char *to, delta_t *pFields)
 {
 	int i;
 	delta_description_t *pTest;
@@ -643,13 +666,13 @@ void DELTA_WriteMarkedFields(unsigned char *from, unsigned char *to, delta_t *pF
 			{
 				int8 si8 = *(int8 *)&to[pTest->fieldOffset];
 				si8 = (int8)((double)si8 * pTest->premultiply);
-				MSG_WriteSBits(si8, pTest->significant_bits);
+				MSG_WriteSBitsTo(bw, si8, pTest->significant_bits);
 			}
 			else
 			{
 				uint8 i8 = *(uint8 *)&to[pTest->fieldOffset];
 				i8 = (uint8)((double)i8 * pTest->premultiply);
-				MSG_WriteBits(i8, pTest->significant_bits);
+				MSG_WriteBitsTo(bw, i8, pTest->significant_bits);
 			}
 			break;
 		case DT_SHORT:
@@ -657,13 +680,13 @@ void DELTA_WriteMarkedFields(unsigned char *from, unsigned char *to, delta_t *pF
 			{
 				int16 si16 = *(int16 *)&to[pTest->fieldOffset];
 				si16 = (int16)((double)si16 * pTest->premultiply);
-				MSG_WriteSBits(si16, pTest->significant_bits);
+				MSG_WriteSBitsTo(bw, si16, pTest->significant_bits);
 			}
 			else
 			{
 				uint16 i16 = *(uint16 *)&to[pTest->fieldOffset];
 				i16 = (uint16)((double)i16 * pTest->premultiply);
-				MSG_WriteBits(i16, pTest->significant_bits);
+				MSG_WriteBitsTo(bw, i16, pTest->significant_bits);
 			}
 			break;
 		case DT_FLOAT:
@@ -671,11 +694,11 @@ void DELTA_WriteMarkedFields(unsigned char *from, unsigned char *to, delta_t *pF
 			double val = (double)(*(float *)&to[pTest->fieldOffset]) * pTest->premultiply;
 			if (fieldSign)
 			{
-				MSG_WriteSBits((int32)val, pTest->significant_bits);
+				MSG_WriteSBitsTo(bw, (int32)val, pTest->significant_bits);
 			}
 			else
 			{
-				MSG_WriteBits((uint32)val, pTest->significant_bits);
+				MSG_WriteBitsTo(bw, (uint32)val, pTest->significant_bits);
 			}
 			break;
 		}
@@ -688,7 +711,7 @@ void DELTA_WriteMarkedFields(unsigned char *from, unsigned char *to, delta_t *pF
 				{
 					signedInt = (int32)((double)signedInt * pTest->premultiply);
 				}
-				MSG_WriteSBits(signedInt, pTest->significant_bits);
+				MSG_WriteSBitsTo(bw, signedInt, pTest->significant_bits);
 			}
 			else
 			{
@@ -697,30 +720,30 @@ void DELTA_WriteMarkedFields(unsigned char *from, unsigned char *to, delta_t *pF
 				{
 					unsignedInt = (uint32)((double)unsignedInt * pTest->premultiply);
 				}
-				MSG_WriteBits(unsignedInt, pTest->significant_bits);
+				MSG_WriteBitsTo(bw, unsignedInt, pTest->significant_bits);
 			}
 			break;
 		}
 		case DT_ANGLE:
 			f2 = *(float *)&to[pTest->fieldOffset];
-			MSG_WriteBitAngle(f2, pTest->significant_bits);
+			MSG_WriteBitAngleTo(bw, f2, pTest->significant_bits);
 			break;
 		case DT_TIMEWINDOW_8:
 		{
 			f2 = *(float *)&to[pTest->fieldOffset];
 			int32 twVal = (int)(g_psv.time * 100.0) - (int)(f2 * 100.0);
-			MSG_WriteSBits(twVal, 8);
+			MSG_WriteSBitsTo(bw, twVal, 8);
 			break;
 		}
 		case DT_TIMEWINDOW_BIG:
 		{
 			f2 = *(float *)&to[pTest->fieldOffset];
 			int32 twVal = (int)(g_psv.time * pTest->premultiply) - (int)(f2 * pTest->premultiply);
-			MSG_WriteSBits((int32)twVal, pTest->significant_bits);
+			MSG_WriteSBitsTo(bw, (int32)twVal, pTest->significant_bits);
 			break;
 		}
 		case DT_STRING:
-			MSG_WriteBitString((const char *)&to[pTest->fieldOffset]);
+			MSG_WriteBitStringTo(bw, (const char *)&to[pTest->fieldOffset]);
 			break;
 		default:
 			Con_Printf("%s: unknown send field type\n", __func__);
@@ -729,6 +752,11 @@ void DELTA_WriteMarkedFields(unsigned char *from, unsigned char *to, delta_t *pF
 	}
 }
 
+void DELTA_WriteMarkedFields(unsigned char *from, unsigned char *to, delta_t *pFields)
+{
+	DELTA_WriteMarkedFieldsTo(MSG_GetBitWriter(), from, to, pFields);
+}
+
 qboolean DELTA_CheckDelta(unsigned char *from, unsigned char *to, delta_t *pFields)
 {
 	qboolean sendfields;
@@ -744,7 +772,13 @@ qboolean DELTA_CheckDelta(unsigned char *from, unsigned char *to, delta_t *pFiel
 	return sendfields;
 }
 
-NOINLINE qboolean DELTA_WriteDelta(unsigned char *from, unsigned char *to, qboolean force, delta_t *pFields, void(*callback)(void))
+// The variants without a writer take a callback without context
+static void DELTA_InvokePlainCallback(void *ctx)
+{
+	(*(void(**)(void))ctx)();
+}
+
+qboolean DELTA_WriteDeltaTo(bf_write_t *bw, unsigned char *from, unsigned char *to, qboolean force, delta_t *pFields, deltaheader_t callback, void *callbackctx)
 {
 	qboolean sendfields;
 
@@ -756,15 +790,20 @@ NOINLINE qboolean DELTA_WriteDelta(unsigned char *from, unsigned char *to, qbool
 	sendfields = DELTA_CountSendFields(pFields);
 #endif // REHLDS_OPT_PEDANTIC || REHLDS_FIXES
 
-	_DELTA_WriteDelta(from, to, force, pFields, callback, sendfields);
+	_DELTA_WriteDeltaTo(bw, from, to, force, pFields, callback, callbackctx, sendfields);
 	return sendfields;
 }
 
+NOINLINE qboolean DELTA_WriteDelta(unsigned char *from, unsigned char *to, qboolean force, delta_t *pFields, void(*callback)(void))
+{
+	return DELTA_WriteDeltaTo(MSG_GetBitWriter(), from, to, force, pFields, callback ? DELTA_InvokePlainCallback : NULL, &callback);
+}
+
 #ifdef REHLDS_FIXES //Fix for https://github.com/dreamstalker/rehlds/issues/24
-qboolean DELTA_WriteDeltaForceMask(unsigned char *from, unsigned char *to, qboolean force, delta_t *pFields, void(*callback)(void), void* pForceMask) {
+qboolean DELTA_WriteDeltaForceMaskTo(bf_write_t *bw, unsigned char *from, unsigned char *to, qboolean force, delta_t *pFields, deltaheader_t callback, void *callbackctx, void* pForceMask) {
 #ifdef REHLDS_JIT
 	qboolean sendfields = DELTAJit_Fields_Clear_Mark_Check(from, to, pFields, pForceMask);
-	_DELTA_WriteDelta(from, to, force, pFields, callback, sendfields);
+	_DELTA_WriteDeltaTo(bw, from, to, force, pFields, callback, callbackctx, sendfields);
 	return sendfields;
 #else
 	DELTA_ClearFlags(pFields);
@@ -783,11 +822,15 @@ qboolean DELTA_WriteDeltaForceMask(unsigned char *from, unsigned char *to, qbool
 
 	DELTA_MarkSendFields(from, to, pFields);
 	qboolean sendfields = DELTA_CountSendFields(pFields);
-	_DELTA_WriteDelta(from, to, force, pFields, callback, sendfields);
+	_DELTA_WriteDeltaTo(bw, from, to, force, pFields, callback, callbackctx, sendfields);
 	return sendfields;
 #endif
 }
 
+qboolean DELTA_WriteDeltaForceMask(unsigned char *from, unsigned char *to, qboolean force, delta_t *pFields, void(*callback)(void), void* pForceMask) {
+	return DELTA_WriteDeltaForceMaskTo(MSG_GetBitWriter(), from, to, force, pFields, callback ? DELTA_InvokePlainCallback : NULL, &callback, pForceMask);
+}
+
 uint64 DELTA_GetOriginalMask(delta_t* pFields)
 {
 #ifdef REHLDS_JIT
@@ -816,7 +859,7 @@ uint64 DELTA_GetMaskU64(delta_t* pFields)
 }
 #endif
 
-qboolean _DELTA_WriteDelta(unsigned char *from, unsigned char *to, qboolean force, delta_t *pFields, void(*callback)( void ), qboolean sendfields)
+qboolean _DELTA_WriteDeltaTo(bf_write_t *bw, unsigned char *from, unsigned char *to, qboolean force, delta_t *pFields, deltaheader_t callback, void *callbackctx, qboolean sendfields)
 {
 	int i;
 	int bytecount;
@@ -831,20 +874,25 @@ qboolean _DELTA_WriteDelta(unsigned char *from, unsigned char *to, qboolean forc
 #endif
 
 		if (callback)
-			callback();
+			callback(callbackctx);
 
-		MSG_WriteBits(bytecount, 3);
+		MSG_WriteBitsTo(bw, bytecount, 3);
 		for (i = 0; i < bytecount; i++)
 		{
-			MSG_WriteBits(( (byte*)bits )[i], 8);
+			MSG_WriteBitsTo(bw, ( (byte*)bits )[i], 8);
 		}
 
-		DELTA_WriteMarkedFields(from, to, pFields);
+		DELTA_WriteMarkedFieldsTo(bw, from, to, pFields);
 	}
 
 	return 1;
 }
 
+qboolean _DELTA_WriteDelta(unsigned char *from, unsigned char *to, qboolean force, delta_t *pFields, void(*callback)( void ), qboolean sendfields)
+{
+	return _DELTA_WriteDeltaTo(MSG_GetBitWriter(), from, to, force, pFields, callback ? DELTA_InvokePlainCallback : NULL, &callback, sendfields);
+}
+
 int DELTA_ParseDelta(unsigned char *from, unsigned char *to, delta_t *pFields)
 {
 	delta_description_t *pTest;
@@ -1293,12 +1341,90 @@ void DELTA_FreeDescription(delta_t **ppdesc)
 		{
 			if (p->dynamic)
 				Mem_Free(p->pdd);
+#ifdef REHLDS_FIXES
+			DELTABulk_Free(p);
+#endif
 			Mem_Free(p);
 			*ppdesc = 0;
 		}
 	}
 }
 
+#ifdef REHLDS_FIXES
+// Thread copies let another thread mark and write fields of the same description
+// without touching the send flags of the original one
+delta_t *DELTA_CreateThreadCopy(void)
+{
+	delta_t *copy = (delta_t *)Mem_ZeroMalloc(sizeof(delta_t));
+	copy->dynamic = TRUE;
+	return copy;
+}
+
+void DELTA_SyncThreadCopy(delta_t *copy, delta_t *original)
+{
+	if (copy->fieldCount != original->fieldCount)
+	{
+		if (copy->pdd)
+			Mem_Free(copy->pdd);
+
+		copy->pdd = (delta_description_t *)Mem_ZeroMalloc(sizeof(delta_description_t) * original->fieldCount);
+		copy->fieldCount = original->fieldCount;
+	}
+
+	Q_memcpy(copy->pdd, original->pdd, sizeof(delta_description_t) * original->fieldCount);
+	Q_memcpy(copy->conditionalencodename, original->conditionalencodename, sizeof(copy->conditionalencodename));
+	copy->conditionalencode = original->conditionalencode;
+
+	// the compare layout is read-only, so build it here once and share it
+	copy->bulk = DELTABulk_Get(original);
+
+	for (int i = 0; i < copy->fieldCount; i++)
+	{
+		copy->pdd[i].flags = 0;
+		copy->pdd[i].stats.sendcount = 0;
+		copy->pdd[i].stats.receivedcount = 0;
+	}
+
+	copy->cachehits = 0;
+	copy->cachemisses = 0;
+
+#ifdef REHLDS_JIT
+	DELTAJit_SetupThreadCopy(copy, original);
+#else
+	copy->originalMarkedFieldsMask.u64 = 0;
+#endif
+}
+
+void DELTA_MergeThreadCopyStats(delta_t *copy, delta_t *original)
+{
+	if (copy->fieldCount != original->fieldCount)
+		return;
+
+	for (int i = 0; i < copy->fieldCount; i++)
+	{
+		original->pdd[i].stats.sendcount += copy->pdd[i].stats.sendcount;
+		copy->pdd[i].stats.sendcount = 0;
+	}
+
+	original->cachehits += copy->cachehits;
+	original->cachemisses += copy->cachemisses;
+	copy->cachehits = 0;
+	copy->cachemisses = 0;
+}
+
+void DELTA_FreeThreadCopy(delta_t **ppcopy)
+{
+	if (!ppcopy || !*ppcopy)
+		return;
+
+#ifdef REHLDS_JIT
+	DELTAJit_FreeThreadCopy(*ppcopy);
+#endif
+	(*ppcopy)->bulk = nullptr;
+	DELTA_FreeDescription(ppcopy);
+}
+#endif // REHLDS_FIXES
+
 void DELTA_AddDefinition(char *name, delta_definition_t *pdef, int numelements)
 {
 	delta_definition_list_t *p = g_defs;
@@ -1569,6 +1695,11 @@ void DELTA_ClearStats(delta_t *p)
 			p->pdd[i].stats.sendcount = 0;
 			p->pdd[i].stats.receivedcount = 0;
 		}
+
+#ifdef REHLDS_FIXES
+		p->cachehits = 0;
+		p->cachemisses = 0;
+#endif
 	}
 }
 
@@ -1596,6 +1727,13 @@ void DELTA_PrintStats(const char *name, delta_t *p)
 				Con_Printf("  %02i % 10s:  s % 5i r % 5i\n", i + 1, dt->fieldName, dt->stats.sendcount, dt->stats.receivedcount);
 			}
 		}
+#ifdef REHLDS_FIXES
+		int lookups = p->cachehits + p->cachemisses;
+		if (lookups > 0)
+		{
+			Con_Printf("  encode cache: %i hits, %i misses (%.1f%% hit rate)\n", p->cachehits, p->cachemisses, 100.0 * p->cachehits / lookups);
+		}
+#endif
 		Con_Printf("\n");
 	}
 }
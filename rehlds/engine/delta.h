@@ -30,6 +30,8 @@
 
 #include "maintypes.h"
 
+typedef struct bf_write_s bf_write_t;
+
 const int DELTA_MAX_FIELDS = 56;	// 7*8
 
 enum
@@ -50,6 +52,7 @@ const int FDT_MARK = BIT(0);		// Delta mark for sending
 
 typedef struct delta_s delta_t;
 typedef void(*encoder_t)(delta_t *, const unsigned char *, const unsigned char *);
+typedef void(*deltaheader_t)(void *ctx);	// writes what goes before the fields of a delta, ctx is the caller's
 
 typedef struct delta_stats_s
 {
@@ -91,6 +94,12 @@ typedef struct delta_s
 #elif defined(REHLDS_FIXES)
 	delta_marked_mask_t originalMarkedFieldsMask;
 #endif
+
+#ifdef REHLDS_FIXES
+	struct delta_bulk_s *bulk;
+	int cachehits;		// sv_rehlds_delta_cache
+	int cachemisses;
+#endif
 } delta_t;
 
 typedef struct delta_encoder_s delta_encoder_t;
@@ -129,21 +138,27 @@ void DELTA_SetFieldByIndex(struct delta_s *pFields, int fieldNumber);
 void DELTA_UnsetFieldByIndex(struct delta_s *pFields, int fieldNumber);
 void DELTA_ClearFlags(delta_t *pFields);
 int DELTA_TestDelta(unsigned char *from, unsigned char *to, delta_t *pFields);
+int DELTA_TestDeltaScalar(unsigned char *from, unsigned char *to, delta_t *pFields);
 int DELTA_CountSendFields(delta_t *pFields);
 void DELTA_MarkSendFields(unsigned char *from, unsigned char *to, delta_t *pFields);
+void DELTA_MarkSendFieldsScalar(unsigned char *from, unsigned char *to, delta_t *pFields);
 void DELTA_SetSendFlagBits(delta_t *pFields, int *bits, int *bytecount);
 qboolean DELTA_IsFieldMarked(delta_t* pFields, int fieldNumber);
 void DELTA_WriteMarkedFields(unsigned char *from, unsigned char *to, delta_t *pFields);
+void DELTA_WriteMarkedFieldsTo(bf_write_t *bw, unsigned char *from, unsigned char *to, delta_t *pFields);
 qboolean DELTA_CheckDelta(unsigned char *from, unsigned char *to, delta_t *pFields);
 
 #ifdef REHLDS_FIXES //Fix for https://github.com/dreamstalker/rehlds/issues/24
 qboolean DELTA_WriteDeltaForceMask(unsigned char *from, unsigned char *to, qboolean force, delta_t *pFields, void(*callback)(void), void* pForceMask);
+qboolean DELTA_WriteDeltaForceMaskTo(bf_write_t *bw, unsigned char *from, unsigned char *to, qboolean force, delta_t *pFields, deltaheader_t callback, void *callbackctx, void* pForceMask);
 uint64 DELTA_GetOriginalMask(delta_t* pFields);
 uint64 DELTA_GetMaskU64(delta_t* pFields);
 #endif
 
 qboolean DELTA_WriteDelta(unsigned char *from, unsigned char *to, qboolean force, delta_t *pFields, void(*callback)(void));
 qboolean _DELTA_WriteDelta(unsigned char *from, unsigned char *to, qboolean force, delta_t *pFields, void(*callback)(void), qboolean sendfields);
+qboolean DELTA_WriteDeltaTo(bf_write_t *bw, unsigned char *from, unsigned char *to, qboolean force, delta_t *pFields, deltaheader_t callback, void *callbackctx);
+qboolean _DELTA_WriteDeltaTo(bf_write_t *bw, unsigned char *from, unsigned char *to, qboolean force, delta_t *pFields, deltaheader_t callback, void *callbackctx, qboolean sendfields);
 int DELTA_ParseDelta(unsigned char *from, unsigned char *to, delta_t *pFields);
 void DELTA_AddEncoder(const char *name, void(*conditionalencode)(struct delta_s *, const unsigned char *, const unsigned char *));
 void DELTA_ClearEncoders(void);
@@ -156,6 +171,12 @@ int DELTA_FindOffset(int count, delta_definition_t *pdef, char *fieldname);
 qboolean DELTA_ParseType(delta_description_t *pdelta, char **pstream);
 qboolean DELTA_ParseField(int count, delta_definition_t *pdefinition, delta_link_t *pField, char **pstream);
 void DELTA_FreeDescription(delta_t **ppdesc);
+#ifdef REHLDS_FIXES
+delta_t *DELTA_CreateThreadCopy(void);
+void DELTA_SyncThreadCopy(delta_t *copy, delta_t *original);
+void DELTA_MergeThreadCopyStats(delta_t *copy, delta_t *original);
+void DELTA_FreeThreadCopy(delta_t **ppcopy);
+#endif
 void DELTA_AddDefinition(char *name, delta_definition_t *pdef, int numelements);
 void DELTA_ClearDefinitions(void);
 delta_definition_t *DELTA_FindDefinition(char *name, int *count);
@@ -0,0 +1,352 @@
+/*
+*
+*    This program is free software; you can redistribute it and/or modify it
+*    under the terms of the GNU General Public License as published by the
+*    Free Software Foundation; either version 2 of the License, or (at
+*    your option) any later version.
+*
+*    This program is distributed in the hope that it will be useful, but
+*    WITHOUT ANY WARRANTY; without even the implied warranty of
+*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+*    General Public License for more details.
+*
+*    You should have received a copy of the GNU General Public License
+*    along with this program; if not, write to the Free Software Foundation,
+*    Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+*
+*    In addition, as a special exception, the author gives permission to
+*    link the code of this program with the Half-Life Game Engine ("HL
+*    Engine") and Modified Game Libraries ("MODs") developed by Valve,
+*    L.L.C ("Valve").  You must obey the GNU General Public License in all
+*    respects for all of the code used other than the HL Engine and MODs
+*    from Valve.  If you modify this file, you may extend this exception
+*    to your version of the file, but you are not obligated to do so.  If
+*    you do not wish to do so, delete this exception statement from your
+*    version.
+*
+*/
+
+#include "precompiled.h"
+
+#ifdef REHLDS_FIXES
+#include <immintrin.h>
+
+int g_DeltaBulkKernel = DELTABULK_KERNEL_AUTO;
+
+int DELTABulk_GetFieldSize(delta_description_t *pField)
+{
+	switch (pField->fieldType & ~DT_SIGNED)
+	{
+	case DT_BYTE:
+		return 1;
+	case DT_SHORT:
+		return 2;
+	case DT_FLOAT:
+	case DT_INTEGER:
+	case DT_ANGLE:
+	case DT_TIMEWINDOW_8:
+	case DT_TIMEWINDOW_BIG:
+		return 4;
+	default:
+		return 0;
+	}
+}
+
+// Splits the description into 32-byte chunks and records which bytes of each chunk belong to which field.
+// The last chunk is moved back to end on the last field, so a compare never reads past the structure.
+delta_bulk_t *DELTABulk_Build(delta_t *pFields)
+{
+	int i, c;
+	int size = 0;
+	int numStrings = 0;
+	delta_description_t *pField;
+
+	for (i = 0, pField = pFields->pdd; i < pFields->fieldCount; i++, pField++)
+	{
+		if ((pField->fieldType & ~DT_SIGNED) == DT_STRING)
+			numStrings++;
+		else
+			size = Q_max(size, pField->fieldOffset + DELTABulk_GetFieldSize(pField));
+	}
+
+	int numChunks = (size + DELTABULK_CHUNK_SIZE - 1) / DELTABULK_CHUNK_SIZE;
+	int numEntries = 0;
+
+	for (int pass = 0; pass < 2; pass++)
+	{
+		delta_bulk_t *bulk = nullptr;
+
+		if (pass == 1)
+		{
+			bulk = (delta_bulk_t *)Mem_ZeroMalloc(sizeof(delta_bulk_t)
+				+ sizeof(deltabulk_chunk_t) * numChunks
+				+ sizeof(deltabulk_field_t) * numEntries
+				+ sizeof(int) * numStrings);
+
+			bulk->size = size;
+			bulk->numChunks = numChunks;
+			bulk->chunks = (deltabulk_chunk_t *)(bulk + 1);
+			bulk->fields = (deltabulk_field_t *)(bulk->chunks + numChunks);
+			bulk->strings = (int *)(bulk->fields + numEntries);
+			numEntries = 0;
+		}
+
+		for (c = 0; c < numChunks; c++)
+		{
+			int start = Q_max(0, Q_min(c * DELTABULK_CHUNK_SIZE, size - DELTABULK_CHUNK_SIZE));
+			int end = start + DELTABULK_CHUNK_SIZE;
+
+			if (bulk)
+			{
+				bulk->chunks[c].offset = start;
+				bulk->chunks[c].firstField = numEntries;
+			}
+
+			for (i = 0, pField = pFields->pdd; i < pFields->fieldCount; i++, pField++)
+			{
+				int fieldStart = Q_max(start, pField->fieldOffset);
+				int fieldEnd = Q_min(end, pField->fieldOffset + DELTABulk_GetFieldSize(pField));
+				if (fieldStart >= fieldEnd)
+					continue;
+
+				if (bulk)
+				{
+					uint32 bytes = 0;
+					for (int b = fieldStart; b < fieldEnd; b++)
+						bytes |= 1u << (b - start);
+
+					bulk->fields[numEntries].bytes = bytes;
+					bulk->fields[numEntries].id = i;
+					bulk->chunks[c].numFields++;
+				}
+
+				numEntries++;
+			}
+		}
+
+		if (bulk)
+		{
+			for (i = 0, pField = pFields->pdd; i < pFields->fieldCount; i++, pField++)
+			{
+				if ((pField->fieldType & ~DT_SIGNED) == DT_STRING)
+					bulk->strings[bulk->numStrings++] = i;
+			}
+
+			return bulk;
+		}
+	}
+
+	return nullptr;
+}
+
+delta_bulk_t *DELTABulk_Get(delta_t *pFields)
+{
+	if (!pFields->bulk)
+		pFields->bulk = DELTABulk_Build(pFields);
+
+	return pFields->bulk;
+}
+
+void DELTABulk_Free(delta_t *pFields)
+{
+	if (pFields->bulk)
+	{
+		Mem_Free(pFields->bulk);
+		pFields->bulk = nullptr;
+	}
+}
+
+bool DELTABulk_IsKernelSupported(int kernel)
+{
+	switch (kernel)
+	{
+	case DELTABULK_KERNEL_AUTO:
+	case DELTABULK_KERNEL_GENERIC:
+		return true;
+#ifdef REHLDS_SSE
+	case DELTABULK_KERNEL_SSE2:
+		return true;
+	case DELTABULK_KERNEL_AVX2:
+		return cpuinfo.avx2 != 0;
+#endif
+	default:
+		return false;
+	}
+}
+
+// One bit for each byte that differs between a and b
+inline uint32 DELTABulk_DiffBytes64(uint64 a, uint64 b)
+{
+	uint64 x = a ^ b;
+	x = (((x & 0x7F7F7F7F7F7F7F7FULL) + 0x7F7F7F7F7F7F7F7FULL) | x) & 0x8080808080808080ULL;
+	return (uint32)(((x >> 7) * 0x0102040810204080ULL) >> 56);
+}
+
+inline void DELTABulk_MapChunk(delta_bulk_t *bulk, deltabulk_chunk_t *pChunk, uint32 diff, delta_marked_mask_t *mask)
+{
+	deltabulk_field_t *pField = &bulk->fields[pChunk->firstField];
+	for (int i = 0; i < pChunk->numFields; i++, pField++)
+	{
+		if (diff & pField->bytes)
+			mask->u32[pField->id >> 5] |= (1 << (pField->id & 31));
+	}
+}
+
+void DELTABulk_CompareChunks_Generic(delta_bulk_t *bulk, const unsigned char *from, const unsigned char *to, delta_marked_mask_t *mask)
+{
+	deltabulk_chunk_t *pChunk = bulk->chunks;
+	for (int c = 0; c < bulk->numChunks; c++, pChunk++)
+	{
+		const uint64 *a = (const uint64 *)&from[pChunk->offset];
+		const uint64 *b = (const uint64 *)&to[pChunk->offset];
+
+		uint32 diff = DELTABulk_DiffBytes64(a[0], b[0])
+			| (DELTABulk_DiffBytes64(a[1], b[1]) << 8)
+			| (DELTABulk_DiffBytes64(a[2], b[2]) << 16)
+			| (DELTABulk_DiffBytes64(a[3], b[3]) << 24);
+
+		if (diff)
+			DELTABulk_MapChunk(bulk, pChunk, diff, mask);
+	}
+}
+
+#ifdef REHLDS_SSE
+void DELTABulk_CompareChunks_SSE2(delta_bulk_t *bulk, const unsigned char *from, const unsigned char *to, delta_marked_mask_t *mask)
+{
+	deltabulk_chunk_t *pChunk = bulk->chunks;
+	for (int c = 0; c < bulk->numChunks; c++, pChunk++)
+	{
+		const __m128i *a = (const __m128i *)&from[pChunk->offset];
+		const __m128i *b = (const __m128i *)&to[pChunk->offset];
+
+		uint32 equal = _mm_movemask_epi8(_mm_cmpeq_epi8(_mm_loadu_si128(a), _mm_loadu_si128(b)))
+			| (_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_loadu_si128(a + 1), _mm_loadu_si128(b + 1))) << 16);
+
+		if (equal != 0xFFFFFFFF)
+			DELTABulk_MapChunk(bulk, pChunk, ~equal, mask);
+	}
+}
+
+FUNC_TARGET("avx2")
+void DELTABulk_CompareChunks_AVX2(delta_bulk_t *bulk, const unsigned char *from, const unsigned char *to, delta_marked_mask_t *mask)
+{
+	deltabulk_chunk_t *pChunk = bulk->chunks;
+	for (int c = 0; c < bulk->numChunks; c++, pChunk++)
+	{
+		__m256i a = _mm256_loadu_si256((const __m256i *)&from[pChunk->offset]);
+		__m256i b = _mm256_loadu_si256((const __m256i *)&to[pChunk->offset]);
+
+		uint32 equal = _mm256_movemask_epi8(_mm256_cmpeq_epi8(a, b));
+		if (equal != 0xFFFFFFFF)
+			DELTABulk_MapChunk(bulk, pChunk, ~equal, mask);
+	}
+
+	_mm256_zeroupper();
+}
+#endif // REHLDS_SSE
+
+uint64 DELTABulk_Compare(delta_t *pFields, const unsigned char *from, const unsigned char *to)
+{
+	delta_bulk_t *bulk = DELTABulk_Get(pFields);
+	delta_marked_mask_t mask;
+	mask.u64 = 0;
+
+	const unsigned char *pFrom = from;
+	const unsigned char *pTo = to;
+
+	// tiny descriptions get padded up to a whole chunk
+	ALIGN16 unsigned char paddedFrom[DELTABULK_CHUNK_SIZE];
+	ALIGN16 unsigned char paddedTo[DELTABULK_CHUNK_SIZE];
+	if (bulk->size < DELTABULK_CHUNK_SIZE && bulk->numChunks)
+	{
+		Q_memset(paddedFrom, 0, sizeof(paddedFrom));
+		Q_memset(paddedTo, 0, sizeof(paddedTo));
+		Q_memcpy(paddedFrom, from, bulk->size);
+		Q_memcpy(paddedTo, to, bulk->size);
+		pFrom = paddedFrom;
+		pTo = paddedTo;
+	}
+
+	int kernel = g_DeltaBulkKernel;
+	if (kernel == DELTABULK_KERNEL_AUTO)
+	{
+#ifdef REHLDS_SSE
+		kernel = cpuinfo.avx2 ? DELTABULK_KERNEL_AVX2 : DELTABULK_KERNEL_SSE2;
+#else
+		kernel = DELTABULK_KERNEL_GENERIC;
+#endif
+	}
+
+	switch (kernel)
+	{
+#ifdef REHLDS_SSE
+	case DELTABULK_KERNEL_AVX2:
+		DELTABulk_CompareChunks_AVX2(bulk, pFrom, pTo, &mask);
+		break;
+	case DELTABULK_KERNEL_SSE2:
+		DELTABulk_CompareChunks_SSE2(bulk, pFrom, pTo, &mask);
+		break;
+#endif
+	default:
+		DELTABulk_CompareChunks_Generic(bulk, pFrom, pTo, &mask);
+		break;
+	}
+
+	for (int i = 0; i < bulk->numStrings; i++)
+	{
+		int id = bulk->strings[i];
+		const char *st1 = (const char *)&from[pFields->pdd[id].fieldOffset];
+		const char *st2 = (const char *)&to[pFields->pdd[id].fieldOffset];
+
+		if (!((!*st1 && !*st2) || (*st1 && *st2 && !Q_stricmp(st1, st2))))
+			mask.u32[id >> 5] |= (1 << (id & 31));
+	}
+
+	return mask.u64;
+}
+
+void DELTABulk_MarkSendFields(unsigned char *from, unsigned char *to, delta_t *pFields)
+{
+	int i;
+	delta_description_t *pField;
+	delta_marked_mask_t mask;
+	mask.u64 = DELTABulk_Compare(pFields, from, to);
+
+	if (!mask.u64)
+		return;
+
+	for (i = 0, pField = pFields->pdd; i < pFields->fieldCount; i++, pField++)
+	{
+		if (mask.u32[i >> 5] & (1 << (i & 31)))
+			pField->flags |= FDT_MARK;
+	}
+}
+
+int DELTABulk_TestDelta(unsigned char *from, unsigned char *to, delta_t *pFields)
+{
+	int i;
+	delta_description_t *pField;
+	delta_marked_mask_t mask;
+	int neededBits = 0;
+	int highestBit = -1;
+
+	mask.u64 = DELTABulk_Compare(pFields, from, to);
+	if (!mask.u64)
+		return 0;
+
+	for (i = 0, pField = pFields->pdd; i < pFields->fieldCount; i++, pField++)
+	{
+		if (!(mask.u32[i >> 5] & (1 << (i & 31))))
+			continue;
+
+		highestBit = i;
+		if ((pField->fieldType & ~DT_SIGNED) == DT_STRING)
+			neededBits += Q_strlen((char *)&to[pField->fieldOffset]) * 8 + 8;
+		else
+			neededBits += pField->significant_bits;
+	}
+
+	neededBits += highestBit / 8 * 8 + 8;
+	return neededBits;
+}
+#endif // REHLDS_FIXES
@@ -0,0 +1,80 @@
+/*
+*
+*    This program is free software; you can redistribute it and/or modify it
+*    under the terms of the GNU General Public License as published by the
+*    Free Software Foundation; either version 2 of the License, or (at
+*    your option) any later version.
+*
+*    This program is distributed in the hope that it will be useful, but
+*    WITHOUT ANY WARRANTY; without even the implied warranty of
+*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+*    General Public License for more details.
+*
+*    You should have received a copy of the GNU General Public License
+*    along with this program; if not, write to the Free Software Foundation,
+*    Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+*
+*    In addition, as a special exception, the author gives permission to
+*    link the code of this program with the Half-Life Game Engine ("HL
+*    Engine") and Modified Game Libraries ("MODs") developed by Valve,
+*    L.L.C ("Valve").  You must obey the GNU General Public License in all
+*    respects for all of the code used other than the HL Engine and MODs
+*    from Valve.  If you modify this file, you may extend this exception
+*    to your version of the file, but you are not obligated to do so.  If
+*    you do not wish to do so, delete this exception statement from your
+*    version.
+*
+*/
+
+#pragma once
+
+#include "maintypes.h"
+
+#ifdef REHLDS_FIXES
+const int DELTABULK_CHUNK_SIZE = 32;
+
+enum deltabulk_kernel_e
+{
+	DELTABULK_KERNEL_AUTO = 0,	// best kernel supported by the cpu
+	DELTABULK_KERNEL_GENERIC,	// 64-bit words, no simd
+	DELTABULK_KERNEL_SSE2,		// two 16-byte compares per chunk
+	DELTABULK_KERNEL_AVX2,		// one 32-byte compare per chunk
+};
+
+// one field overlapping a chunk
+struct deltabulk_field_t
+{
+	uint32 bytes;	// one bit for each chunk byte owned by the field
+	int id;
+};
+
+struct deltabulk_chunk_t
+{
+	int offset;
+	int firstField;
+	int numFields;
+};
+
+// Precomputed compare layout of a delta description
+typedef struct delta_bulk_s
+{
+	int size;						// end of the last non-string field
+	int numChunks;
+	deltabulk_chunk_t *chunks;
+	deltabulk_field_t *fields;
+	int numStrings;
+	int *strings;					// string fields are compared one by one
+} delta_bulk_t;
+
+extern int g_DeltaBulkKernel;
+
+delta_bulk_t *DELTABulk_Get(delta_t *pFields);
+void DELTABulk_Free(delta_t *pFields);
+bool DELTABulk_IsKernelSupported(int kernel);
+
+// Returns the mask of fields that differ between from and to
+uint64 DELTABulk_Compare(delta_t *pFields, const unsigned char *from, const unsigned char *to);
+
+void DELTABulk_MarkSendFields(unsigned char *from, unsigned char *to, delta_t *pFields);
+int DELTABulk_TestDelta(unsigned char *from, unsigned char *to, delta_t *pFields);
+#endif // REHLDS_FIXES
@@ -755,6 +755,37 @@ uint64 DELTAJit_GetMaskU64(delta_t* pFields) {
 	return deltaJit->markedFieldsMask.u64;
 }
 
+#ifdef REHLDS_FIXES
+void DELTAJit_SetupThreadCopy(delta_t* copy, delta_t* original) {
+	CDeltaJit* originalJit = original->jit;
+	if (!originalJit) {
+		Sys_Error("%s: JITted delta encoder not found for delta %p", __func__, original);
+	}
+
+	// the copy shares the generated code, but has its own marked fields masks
+	if (!copy->jit) {
+		copy->jit = new CDeltaJit(copy, originalJit->cleanMarkCheckFunc, originalJit->testDeltaFunc);
+		return;
+	}
+
+	copy->jit->delta = copy;
+	copy->jit->cleanMarkCheckFunc = originalJit->cleanMarkCheckFunc;
+	copy->jit->testDeltaFunc = originalJit->testDeltaFunc;
+}
+
+void DELTAJit_FreeThreadCopy(delta_t* copy) {
+	CDeltaJit* deltaJit = copy->jit;
+	if (!deltaJit)
+		return;
+
+	// code is owned by the original delta
+	deltaJit->cleanMarkCheckFunc = NULL;
+	deltaJit->testDeltaFunc = NULL;
+	delete deltaJit;
+	copy->jit = NULL;
+}
+#endif
+
 void CDeltaJitRegistry::Cleanup() {
 #ifndef REHLDS_FIXES
 	for (auto itr = m_DeltaToJITMap.iterator(); itr.hasElement(); itr.next()) {
@@ -100,4 +100,9 @@ extern qboolean DELTAJit_IsFieldMarked(delta_t* pFields, int fieldNumber);
 /* Returns original mask, before it was changed by the conditional encoder */
 extern uint64 DELTAJit_GetOriginalMask(delta_t* pFields);
 extern uint64 DELTAJit_GetMaskU64(delta_t* pFields);
+
+#ifdef REHLDS_FIXES
+extern void DELTAJit_SetupThreadCopy(delta_t* copy, delta_t* original);
+extern void DELTAJit_FreeThreadCopy(delta_t* copy);
+#endif
 #endif
@@ -478,6 +478,9 @@ void SV_DropClient_internal(client_t *cl, qboolean crash, const char *string)
 #endif // REHLDS_FIXES
 
 	Netchan_Clear(&cl->netchan);
+#ifdef REHLDS_FIXES
+	SV_ClientHashRemove(cl);
+#endif // REHLDS_FIXES
 
 	Steam_NotifyClientDisconnect(cl);
 
@@ -452,6 +452,13 @@ void Host_Stats_f(void)
 	char stats[512];
 	GetStatsString(stats, sizeof(stats));
 	Con_Printf("CPU   In    Out   Uptime  Users   FPS    Players\n%s\n", stats);
+
+#ifndef _WIN32
+	NET_PrintFrameStats();
+#endif // _WIN32
+#ifdef REHLDS_FIXES
+	SV_PrintClientHashStats();
+#endif // REHLDS_FIXES
 }
 
 void Host_Quit_f(void)
@@ -815,6 +822,9 @@ void Host_Map(qboolean bIsDemo, char *mapstring, char *mapName, qboolean loadGam
 		}
 		if (sv_gpNewUserMsgs)
 		{
+#ifdef REHLDS_OPT_PEDANTIC
+			SV_IndexUserMsgs(sv_gpNewUserMsgs);
+#endif
 			pMsg = sv_gpUserMsgs;
 			if (pMsg)
 			{
@@ -0,0 +1,706 @@
+/*
+*
+*    This program is free software; you can redistribute it and/or modify it
+*    under the terms of the GNU General Public License as published by the
+*    Free Software Foundation; either version 2 of the License, or (at
+*    your option) any later version.
+*
+*    This program is distributed in the hope that it will be useful, but
+*    WITHOUT ANY WARRANTY; without even the implied warranty of
+*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+*    General Public License for more details.
+*
+*    You should have received a copy of the GNU General Public License
+*    along with this program; if not, write to the Free Software Foundation,
+*    Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+*
+*    In addition, as a special exception, the author gives permission to
+*    link the code of this program with the Half-Life Game Engine ("HL
+*    Engine") and Modified Game Libraries ("MODs") developed by Valve,
+*    L.L.C ("Valve").  You must obey the GNU General Public License in all
+*    respects for all of the code used other than the HL Engine and MODs
+*    from Valve.  If you modify this file, you may extend this exception
+*    to your version of the file, but you are not obligated to do so.  If
+*    you do not wish to do so, delete this exception statement from your
+*    version.
+*
+*/
+
+#include "precompiled.h"
+
+#ifdef REHLDS_FIXES
+// Consistency hash cache (sv_rehlds_md5_cache).
+// The MD5s sent to clients in the consistency list are kept by file name with the size and time of the file they were
+// computed from and saved to rehlds_cache/consistency.md5, so an unchanged file is hashed once instead of at every map
+// change. With sv_rehlds_md5_cache 2 the files forced by the game DLL are hashed on a background thread while the map
+// is still loading. Cached files are stat'ed and read by the local path of the copy MD5_Hash_File would open, files
+// inside a pak have none and are hashed through the filesystem every time.
+#define MD5_CACHE_FILE		"rehlds_cache/consistency.md5"
+#define MD5_CACHE_HEADER	"RMD5 1"
+#define MD5_CACHE_BUCKETS	1024
+
+typedef struct md5cache_s
+{
+	char name[MAX_PATH];	// lowercase, forward slashes
+	unsigned int size;
+	int32 filetime;
+	unsigned char digest[16];
+	struct md5cache_s *next;
+} md5cache_t;
+
+typedef struct md5job_s
+{
+	char name[MAX_PATH];
+	char path[MAX_PATH];	// local path the thread reads
+	unsigned int size;
+	int32 filetime;
+	struct md5job_s *next;
+} md5job_t;
+
+typedef struct md5cachestate_s
+{
+	md5cache_t *buckets[MD5_CACHE_BUCKETS];
+	int count;
+	bool loaded;
+	bool dirty;
+	bool stop;
+
+	md5job_t *jobs;
+	md5job_t **jobstail;
+	md5job_t *current;	// being hashed by the thread
+
+	uint32 hits;
+	uint32 misses;
+	double hashtime;
+} md5cachestate_t;
+
+static md5cachestate_t g_MD5Cache;
+static std::mutex g_MD5CacheMutex;
+static std::condition_variable g_MD5CacheCond;
+static std::thread g_MD5CacheThread;
+
+static void SV_MD5CacheKey(const char *filename, char *key)
+{
+	Q_strncpy(key, filename, MAX_PATH - 1);
+	key[MAX_PATH - 1] = 0;
+
+	for (char *p = key; *p; p++)
+	{
+		if (*p == '\\')
+			*p = '/';
+		else if (*p >= 'A' && *p <= 'Z')
+			*p += 'a' - 'A';
+	}
+}
+
+static unsigned int SV_MD5CacheBucket(const char *key)
+{
+	unsigned int hash = 2166136261u;
+	for (const char *p = key; *p; p++)
+		hash = (hash ^ (byte)*p) * 16777619u;
+
+	return hash & (MD5_CACHE_BUCKETS - 1);
+}
+
+// The callers hold g_MD5CacheMutex
+static md5cache_t *SV_MD5CacheFind(const char *key)
+{
+	for (md5cache_t *entry = g_MD5Cache.buckets[SV_MD5CacheBucket(key)]; entry; entry = entry->next)
+	{
+		if (!Q_strcmp(entry->name, key))
+			return entry;
+	}
+
+	return nullptr;
+}
+
+static void SV_MD5CacheSet(const char *key, unsigned int size, int32 filetime, const unsigned char digest[16])
+{
+	md5cache_t *entry = SV_MD5CacheFind(key);
+	if (!entry)
+	{
+		unsigned int bucket = SV_MD5CacheBucket(key);
+		entry = (md5cache_t *)Mem_ZeroMalloc(sizeof(md5cache_t));
+		Q_strcpy(entry->name, key);
+		entry->next = g_MD5Cache.buckets[bucket];
+		g_MD5Cache.buckets[bucket] = entry;
+		g_MD5Cache.count++;
+	}
+
+	entry->size = size;
+	entry->filetime = filetime;
+	Q_memcpy(entry->digest, digest, sizeof(entry->digest));
+	g_MD5Cache.dirty = true;
+}
+
+static md5job_t **SV_MD5CacheFindJob(const char *key)
+{
+	for (md5job_t **job = &g_MD5Cache.jobs; *job; job = &(*job)->next)
+	{
+		if (!Q_strcmp((*job)->name, key))
+			return job;
+	}
+
+	return nullptr;
+}
+
+static int SV_MD5CacheHexDigit(char c)
+{
+	if (c >= '0' && c <= '9')
+		return c - '0';
+	if (c >= 'a' && c <= 'f')
+		return c - 'a' + 10;
+	if (c >= 'A' && c <= 'F')
+		return c - 'A' + 10;
+
+	return -1;
+}
+
+static void SV_MD5CacheLoad()
+{
+	if (g_MD5Cache.loaded)
+		return;
+
+	g_MD5Cache.loaded = true;
+	g_MD5Cache.jobstail = &g_MD5Cache.jobs;
+
+	int length;
+	char *buffer = (char *)COM_LoadFileForMe(MD5_CACHE_FILE, &length);
+	if (!buffer)
+		return;
+
+	std::lock_guard<std::mutex> lock(g_MD5CacheMutex);
+
+	char *line = buffer;
+	char *next = Q_strchr(line, '\n');
+	if (next)
+		*next++ = 0;
+
+	if (Q_strncmp(line, MD5_CACHE_HEADER, sizeof(MD5_CACHE_HEADER) - 1))
+	{
+		Con_Printf("Ignoring stale consistency hash cache %s\n", MD5_CACHE_FILE);
+		COM_FreeFile(buffer);
+		return;
+	}
+
+	while ((line = next) != nullptr)
+	{
+		next = Q_strchr(line, '\n');
+		if (next)
+			*next++ = 0;
+
+		char hex[33];
+		char name[MAX_PATH];
+		unsigned int size;
+		int32 filetime;
+		if (sscanf(line, "%32s %u %d %259[^\r\n]", hex, &size, &filetime, name) != 4 || Q_strlen(hex) != 32)
+			continue;
+
+		unsigned char digest[16];
+		int i;
+		for (i = 0; i < 16; i++)
+		{
+			int hi = SV_MD5CacheHexDigit(hex[i * 2]);
+			int lo = SV_MD5CacheHexDigit(hex[i * 2 + 1]);
+			if (hi < 0 || lo < 0)
+				break;
+
+			digest[i] = (hi << 4) | lo;
+		}
+
+		if (i == 16)
+			SV_MD5CacheSet(name, size, filetime, digest);
+	}
+
+	g_MD5Cache.dirty = false;
+	COM_FreeFile(buffer);
+}
+
+static void SV_MD5CacheSave()
+{
+	char tempname[MAX_PATH];
+
+	std::lock_guard<std::mutex> lock(g_MD5CacheMutex);
+	if (!g_MD5Cache.dirty)
+		return;
+
+	Q_snprintf(tempname, sizeof(tempname), "%s.tmp", MD5_CACHE_FILE);
+
+	FS_CreateDirHierarchy("rehlds_cache", NULL);
+	FileHandle_t f = FS_Open(tempname, "wb");
+	if (!f)
+	{
+		Con_Printf("Couldn't write consistency hash cache %s\n", tempname);
+		return;
+	}
+
+	FS_FPrintf(f, "%s\n", MD5_CACHE_HEADER);
+	for (int i = 0; i < MD5_CACHE_BUCKETS; i++)
+	{
+		for (md5cache_t *entry = g_MD5Cache.buckets[i]; entry; entry = entry->next)
+			FS_FPrintf(f, "%s %u %d %s\n", MD5_Print(entry->digest), entry->size, entry->filetime, entry->name);
+	}
+
+	qboolean ok = FS_IsOk(f);
+	FS_Close(f);
+
+	if (ok)
+	{
+		FS_Rename(tempname, MD5_CACHE_FILE);
+		g_MD5Cache.dirty = false;
+	}
+	else
+	{
+		FS_RemoveFile(tempname, NULL);
+	}
+}
+
+// Runs on the hashing thread, no filesystem interface calls here
+static qboolean SV_MD5CacheHashPath(const char *path, unsigned int size, unsigned char digest[16])
+{
+	FILE *fp = fopen(path, "rb");
+	if (!fp)
+		return FALSE;
+
+	MD5Context_t ctx;
+	Q_memset(&ctx, 0, sizeof(ctx));
+	MD5Init(&ctx);
+
+	byte chunk[16384];
+	size_t total = 0;
+	size_t numread;
+	while ((numread = fread(chunk, 1, sizeof(chunk), fp)) > 0)
+	{
+		MD5Update(&ctx, chunk, numread);
+		total += numread;
+	}
+
+	qboolean ok = !ferror(fp) && total == size;
+	fclose(fp);
+
+	// a different size means the path resolved to another copy than the one MD5_Hash_File opens
+	if (!ok)
+		return FALSE;
+
+	MD5Final(digest, &ctx);
+	return TRUE;
+}
+
+static void SV_MD5CacheThreadMain()
+{
+	std::unique_lock<std::mutex> lock(g_MD5CacheMutex);
+	while (true)
+	{
+		g_MD5CacheCond.wait(lock, [] { return g_MD5Cache.stop || g_MD5Cache.jobs; });
+		if (g_MD5Cache.stop)
+			break;
+
+		md5job_t *job = g_MD5Cache.jobs;
+		g_MD5Cache.jobs = job->next;
+		if (!g_MD5Cache.jobs)
+			g_MD5Cache.jobstail = &g_MD5Cache.jobs;
+
+		g_MD5Cache.current = job;
+		lock.unlock();
+
+		unsigned char digest[16];
+		qboolean ok = SV_MD5CacheHashPath(job->path, job->size, digest);
+
+		lock.lock();
+		if (ok)
+			SV_MD5CacheSet(job->name, job->size, job->filetime, digest);
+
+		g_MD5Cache.current = nullptr;
+		Mem_Free(job);
+		g_MD5CacheCond.notify_all();
+	}
+}
+
+// Same file MD5_Hash_File opens: the game directory first, then the regular search order
+static qboolean SV_MD5CacheLocalPath(const char *filename, char *path, int size)
+{
+	FileHandle_t f = FS_OpenPathID(filename, "rb", "GAMECONFIG");
+	if (f)
+	{
+		FS_Close(f);
+		Q_snprintf(path, size, "%s/%s/%s", GetBaseDirectory(), com_gamedir, filename);
+		return TRUE;
+	}
+
+	return FS_GetLocalPath(filename, path, size) != NULL;
+}
+
+// Size and time of the copy at the local path, which is the one that gets hashed
+static qboolean SV_MD5CacheStat(const char *filename, char *path, int pathsize, unsigned int *size, int32 *filetime)
+{
+	if (!SV_MD5CacheLocalPath(filename, path, pathsize))
+		return FALSE;
+
+	struct stat st;
+	if (stat(path, &st) != 0 || st.st_size <= 0)
+		return FALSE;
+
+	*size = (unsigned int)st.st_size;
+	*filetime = (int32)st.st_mtime;
+	return TRUE;
+}
+
+// Returns 1 if the file was queued for the hashing thread
+static int SV_MD5CacheQueue(const char *filename)
+{
+	char key[MAX_PATH];
+	char path[MAX_PATH];
+	unsigned int size;
+	int32 filetime;
+
+	if (Q_strstr(filename, "..") || Q_strchr(filename, ':') || !SV_MD5CacheStat(filename, path, sizeof(path), &size, &filetime))
+		return 0;
+
+	SV_MD5CacheLoad();
+	SV_MD5CacheKey(filename, key);
+
+	{
+		std::lock_guard<std::mutex> lock(g_MD5CacheMutex);
+
+		md5cache_t *entry = SV_MD5CacheFind(key);
+		if (entry && entry->size == size && entry->filetime == filetime)
+			return 0;
+
+		if (SV_MD5CacheFindJob(key) || (g_MD5Cache.current && !Q_strcmp(g_MD5Cache.current->name, key)))
+			return 0;
+	}
+
+	md5job_t *job = (md5job_t *)Mem_ZeroMalloc(sizeof(md5job_t));
+	Q_strcpy(job->name, key);
+	Q_strncpy(job->path, path, sizeof(job->path) - 1);
+	job->size = size;
+	job->filetime = filetime;
+
+	std::lock_guard<std::mutex> lock(g_MD5CacheMutex);
+	if (!g_MD5CacheThread.joinable())
+		g_MD5CacheThread = std::thread(SV_MD5CacheThreadMain);
+
+	*g_MD5Cache.jobstail = job;
+	g_MD5Cache.jobstail = &job->next;
+	g_MD5CacheCond.notify_all();
+	return 1;
+}
+
+// Resource names as the game DLL passes them, sounds are relative to sound/
+int SV_MD5CacheQueueResource(const char *name)
+{
+	char filename[MAX_PATH];
+
+	if (sv_rehlds_md5_cache.value <= 0.0f || name[0] == '*' || name[0] == '!')
+		return 0;
+
+	const char *ext = Q_strrchr(name, '.');
+	if (ext && !Q_stricmp(ext, ".wav"))
+		Q_snprintf(filename, sizeof(filename), "sound/%s", name);
+	else
+		Q_snprintf(filename, sizeof(filename), "%s", name);
+
+	return SV_MD5CacheQueue(filename);
+}
+
+qboolean SV_MD5CacheHashFile(unsigned char digest[16], const char *filename)
+{
+	char key[MAX_PATH];
+	char path[MAX_PATH];
+	unsigned int size;
+	int32 filetime;
+
+	if (sv_rehlds_md5_cache.value <= 0.0f)
+		return MD5_Hash_File(digest, (char *)filename, FALSE, FALSE, NULL);
+
+	SV_MD5CacheLoad();
+	SV_MD5CacheKey(filename, key);
+	qboolean cacheable = SV_MD5CacheStat(filename, path, sizeof(path), &size, &filetime);
+
+	if (cacheable)
+	{
+		std::unique_lock<std::mutex> lock(g_MD5CacheMutex);
+
+		// still queued: cheaper to hash it right here than to wait for the thread to get to it
+		md5job_t **job = SV_MD5CacheFindJob(key);
+		if (job)
+		{
+			md5job_t *found = *job;
+			*job = found->next;
+			if (!*job)
+				g_MD5Cache.jobstail = job;
+
+			Mem_Free(found);
+		}
+
+		g_MD5CacheCond.wait(lock, [&key] { return !g_MD5Cache.current || Q_strcmp(g_MD5Cache.current->name, key); });
+
+		md5cache_t *entry = SV_MD5CacheFind(key);
+		if (entry && entry->size == size && entry->filetime == filetime)
+		{
+			Q_memcpy(digest, entry->digest, sizeof(entry->digest));
+			g_MD5Cache.hits++;
+			return TRUE;
+		}
+	}
+
+	double start = Sys_FloatTime();
+
+	// the digest is stored for the copy that was stat'ed, so that is the one to hash
+	if (cacheable && !SV_MD5CacheHashPath(path, size, digest))
+		cacheable = FALSE;
+
+	if (!cacheable && !MD5_Hash_File(digest, (char *)filename, FALSE, FALSE, NULL))
+		return FALSE;
+
+	g_MD5Cache.misses++;
+	g_MD5Cache.hashtime += Sys_FloatTime() - start;
+
+	if (cacheable)
+	{
+		std::lock_guard<std::mutex> lock(g_MD5CacheMutex);
+		SV_MD5CacheSet(key, size, filetime, digest);
+	}
+
+	return TRUE;
+}
+
+// Called once the consistency list of a new map is hashed
+void SV_MD5CacheFlush(void)
+{
+	if (sv_rehlds_md5_cache.value <= 0.0f)
+		return;
+
+	Con_DPrintf("Consistency MD5s: %u cached, %u hashed in %.1f ms\n", g_MD5Cache.hits, g_MD5Cache.misses, g_MD5Cache.hashtime * 1000.0);
+
+	g_MD5Cache.hits = 0;
+	g_MD5Cache.misses = 0;
+	g_MD5Cache.hashtime = 0.0;
+
+	SV_MD5CacheSave();
+}
+
+void SV_MD5CacheFree(void)
+{
+	if (g_MD5CacheThread.joinable())
+	{
+		{
+			std::lock_guard<std::mutex> lock(g_MD5CacheMutex);
+			g_MD5Cache.stop = true;
+			g_MD5CacheCond.notify_all();
+		}
+
+		g_MD5CacheThread.join();
+	}
+
+	if (!g_MD5Cache.loaded)
+		return;
+
+	SV_MD5CacheSave();
+
+	while (g_MD5Cache.jobs)
+	{
+		md5job_t *job = g_MD5Cache.jobs;
+		g_MD5Cache.jobs = job->next;
+		Mem_Free(job);
+	}
+
+	for (int i = 0; i < MD5_CACHE_BUCKETS; i++)
+	{
+		while (g_MD5Cache.buckets[i])
+		{
+			md5cache_t *entry = g_MD5Cache.buckets[i];
+			g_MD5Cache.buckets[i] = entry->next;
+			Mem_Free(entry);
+		}
+	}
+
+	Q_memset(&g_MD5Cache, 0, sizeof(g_MD5Cache));
+}
+
+// The map after the current one in the mapcycle, or its first map
+static qboolean SV_MD5CacheNextMap(char *mapname, int size)
+{
+	char first[64];
+	qboolean takeNext = FALSE;
+	int length;
+
+	char *buffer = (char *)COM_LoadFileForMe(mapcyclefile.string, &length);
+	if (!buffer)
+		return FALSE;
+
+	first[0] = 0;
+	mapname[0] = 0;
+
+	char *data = buffer;
+	while (true)
+	{
+		data = COM_Parse(data);
+		if (!com_token[0])
+			break;
+
+		// per map settings
+		if (!Q_strcmp(com_token, "{"))
+		{
+			do
+				data = COM_Parse(data);
+			while (com_token[0] && Q_strcmp(com_token, "}"));
+			continue;
+		}
+
+		if (takeNext)
+		{
+			Q_strncpy(mapname, com_token, size - 1);
+			mapname[size - 1] = 0;
+			break;
+		}
+
+		if (!first[0])
+		{
+			Q_strncpy(first, com_token, sizeof(first) - 1);
+			first[sizeof(first) - 1] = 0;
+		}
+
+		if (g_psv.active && !Q_stricmp(com_token, g_psv.name))
+			takeNext = TRUE;
+	}
+
+	COM_FreeFile(buffer);
+
+	if (!mapname[0])
+	{
+		Q_strncpy(mapname, first, size - 1);
+		mapname[size - 1] = 0;
+	}
+
+	return mapname[0] != 0;
+}
+
+// Models, sprites and sounds named by the entities of the map
+static int SV_MD5CachePrewarmEntities(const char *bspname)
+{
+	dheader_t header;
+
+	FileHandle_t f = FS_Open(bspname, "rb");
+	if (!f)
+		return 0;
+
+	if (FS_Read(&header, sizeof(header), 1, f) != 1
+		|| header.lumps[LUMP_ENTITIES].filelen <= 0
+		|| header.lumps[LUMP_ENTITIES].fileofs + header.lumps[LUMP_ENTITIES].filelen > (int)FS_Size(f))
+	{
+		FS_Close(f);
+		return 0;
+	}
+
+	int length = header.lumps[LUMP_ENTITIES].filelen;
+	char *entities = (char *)Mem_Malloc(length + 1);
+	FS_Seek(f, header.lumps[LUMP_ENTITIES].fileofs, FILESYSTEM_SEEK_HEAD);
+	int numread = FS_Read(entities, length, 1, f);
+	FS_Close(f);
+
+	int queued = 0;
+	if (numread == 1)
+	{
+		entities[length] = 0;
+
+		char *data = entities;
+		while (true)
+		{
+			data = COM_Parse(data);
+			if (!com_token[0])
+				break;
+
+			const char *ext = Q_strrchr(com_token, '.');
+			if (ext && (!Q_stricmp(ext, ".mdl") || !Q_stricmp(ext, ".spr") || !Q_stricmp(ext, ".wav")))
+				queued += SV_MD5CacheQueueResource(com_token);
+		}
+	}
+
+	Mem_Free(entities);
+	return queued;
+}
+
+// Generic resources of maps/<map>.res
+static int SV_MD5CachePrewarmResFile(const char *resname)
+{
+	char *buffer = (char *)COM_LoadFileForMe(resname, NULL);
+	if (!buffer)
+		return 0;
+
+	// skip bytes BOM signature
+	char *data = buffer;
+	if ((byte)data[0] == 0xEFu && (byte)data[1] == 0xBBu && (byte)data[2] == 0xBFu)
+		data += 3;
+
+	int queued = 0;
+	while (true)
+	{
+		data = COM_Parse(data);
+		if (!com_token[0])
+			break;
+
+		queued += SV_MD5CacheQueue(com_token);
+	}
+
+	COM_FreeFile(buffer);
+	return queued;
+}
+
+void SV_MD5Prewarm_f(void)
+{
+	char mapname[64];
+	char filename[MAX_PATH];
+
+	if (Cmd_Argc() > 2)
+	{
+		Con_Printf("Usage: md5_prewarm [map]\n");
+		return;
+	}
+
+	if (sv_rehlds_md5_cache.value <= 0.0f)
+	{
+		Con_Printf("sv_rehlds_md5_cache is disabled, nothing to prewarm\n");
+		return;
+	}
+
+	if (Cmd_Argc() == 2)
+	{
+		Q_strncpy(mapname, Cmd_Argv(1), sizeof(mapname) - 1);
+		mapname[sizeof(mapname) - 1] = 0;
+	}
+	else if (!SV_MD5CacheNextMap(mapname, sizeof(mapname)))
+	{
+		Con_Printf("md5_prewarm: no map in %s\n", mapcyclefile.string);
+		return;
+	}
+
+	Q_snprintf(filename, sizeof(filename), "maps/%s.bsp", mapname);
+	if (!FS_FileExists(filename))
+	{
+		Con_Printf("md5_prewarm: map %s not found\n", filename);
+		return;
+	}
+
+	int queued = SV_MD5CacheQueue(filename);
+	queued += SV_MD5CachePrewarmEntities(filename);
+
+	Q_snprintf(filename, sizeof(filename), "maps/%s.res", mapname);
+	queued += SV_MD5CachePrewarmResFile(filename);
+
+	// what the game DLL precaches on every map is in the precache lists of the current one
+	if (g_psv.active)
+	{
+		for (int i = 1; i < MAX_MODELS && g_psv.model_precache[i]; i++)
+			queued += SV_MD5CacheQueueResource(g_psv.model_precache[i]);
+
+		for (int i = 1; i < MAX_SOUNDS && g_psv.sound_precache[i]; i++)
+			queued += SV_MD5CacheQueueResource(g_psv.sound_precache[i]);
+
+		for (int i = 1; i < MAX_GENERIC && g_psv.generic_precache[i]; i++)
+			queued += SV_MD5CacheQueue(g_psv.generic_precache[i]);
+	}
+
+	Con_Printf("Hashing %i files for %s in the background\n", queued, mapname);
+}
+#endif // REHLDS_FIXES
@@ -250,6 +250,275 @@ qboolean IsCZPlayerModel(uint32 crc, const char  * filename)
 	return 0;
 }
 
+#ifdef REHLDS_FIXES
+// Model cache (sv_rehlds_model_cache).
+// Studio models and sprites are kept outside of the hunk once loaded, so a later map precaching the same file
+// copies them back instead of reading and parsing it again. An entry is reused while the size and time of the file
+// are unchanged and keeps the CRC of its contents for Mod_LoadModel's CRC tracking. Sprites live on the hunk and
+// hold pointers into it, so their block is copied whole and the pointers are moved to the new address.
+typedef struct modcache_s
+{
+	char name[64];
+	int length;			// of the file
+	int32 filetime;
+	CRC32_t crc;
+
+	modtype_t type;
+	int flags;
+	synctype_t synctype;
+	int numframes;
+	vec3_t mins;
+	vec3_t maxs;
+
+	int size;
+	byte *base;			// sprites: hunk address the block was loaded at
+	int dataofs;		// of the msprite_t in the block
+	byte *data;
+
+	struct modcache_s *prev;	// most recently used first
+	struct modcache_s *next;
+} modcache_t;
+
+typedef struct modcachestats_s
+{
+	modcache_t *head;
+	modcache_t *tail;
+	int count;
+	int bytes;
+	uint32 hits;
+	uint32 misses;
+	uint32 stale;
+	uint32 evictions;
+} modcachestats_t;
+
+static modcachestats_t g_ModCache;
+
+static int Mod_CacheBudget()
+{
+	return (int)Q_min(sv_rehlds_model_cache.value, 1024.0f) * 1024 * 1024;
+}
+
+static qboolean Mod_CacheEligible(const char *name)
+{
+	const char *ext = COM_FileExtension((char *)name);
+	return (!Q_stricmp(ext, "mdl") || !Q_stricmp(ext, "spr")) ? TRUE : FALSE;
+}
+
+static void Mod_CacheUnlink(modcache_t *entry)
+{
+	if (entry->prev)
+		entry->prev->next = entry->next;
+	else
+		g_ModCache.head = entry->next;
+
+	if (entry->next)
+		entry->next->prev = entry->prev;
+	else
+		g_ModCache.tail = entry->prev;
+
+	entry->prev = entry->next = nullptr;
+}
+
+static void Mod_CacheLinkFront(modcache_t *entry)
+{
+	entry->prev = nullptr;
+	entry->next = g_ModCache.head;
+
+	if (g_ModCache.head)
+		g_ModCache.head->prev = entry;
+	else
+		g_ModCache.tail = entry;
+
+	g_ModCache.head = entry;
+}
+
+static void Mod_CacheRemove(modcache_t *entry)
+{
+	Mod_CacheUnlink(entry);
+	g_ModCache.count--;
+	g_ModCache.bytes -= entry->size;
+	Mem_Free(entry);
+}
+
+static void Mod_CacheTrim(int budget)
+{
+	while (g_ModCache.tail && g_ModCache.bytes > budget)
+	{
+		Mod_CacheRemove(g_ModCache.tail);
+		g_ModCache.evictions++;
+	}
+}
+
+void Mod_CacheFree()
+{
+	while (g_ModCache.head)
+		Mod_CacheRemove(g_ModCache.head);
+}
+
+static modcache_t *Mod_CacheLookup(const char *name)
+{
+	if (Mod_CacheBudget() <= 0)
+	{
+		Mod_CacheFree();
+		return nullptr;
+	}
+
+	if (!Mod_CacheEligible(name) || g_modfuncs.m_pfnModelLoad)
+		return nullptr;
+
+	for (modcache_t *entry = g_ModCache.head; entry; entry = entry->next)
+	{
+		if (Q_stricmp(entry->name, name))
+			continue;
+
+		if ((int)FS_FileSize(name) != entry->length || FS_GetFileTime(name) != entry->filetime)
+		{
+			Mod_CacheRemove(entry);
+			g_ModCache.stale++;
+			break;
+		}
+
+		// hooks installed since it was cached have to see the load
+		if (entry->type == mod_studio && g_RehldsHookchains.m_Mod_LoadStudioModel.hasHooks())
+			break;
+
+		Mod_CacheUnlink(entry);
+		Mod_CacheLinkFront(entry);
+		g_ModCache.hits++;
+		return entry;
+	}
+
+	g_ModCache.misses++;
+	return nullptr;
+}
+
+static void Mod_CacheRelocateSprite(msprite_t *psprite, ptrdiff_t delta)
+{
+	for (int i = 0; i < psprite->numframes; i++)
+	{
+		mspriteframedesc_t *desc = &psprite->frames[i];
+		desc->frameptr = (mspriteframe_t *)((byte *)desc->frameptr + delta);
+
+		if (desc->type == SPR_SINGLE)
+			continue;
+
+		mspritegroup_t *group = (mspritegroup_t *)desc->frameptr;
+		group->intervals = (float *)((byte *)group->intervals + delta);
+
+		for (int j = 0; j < group->numframes; j++)
+			group->frames[j] = (mspriteframe_t *)((byte *)group->frames[j] + delta);
+	}
+}
+
+// Called right after the loader, hunkstart is the low mark from before it.
+// The CRC is the one of the file as read, the loaders may change the buffer
+static void Mod_CacheStore(model_t *mod, CRC32_t crc, int length, int hunkstart)
+{
+	int budget = Mod_CacheBudget();
+	if (budget <= 0 || g_modfuncs.m_pfnModelLoad || !Mod_CacheEligible(mod->name) || !mod->cache.data)
+		return;
+
+	byte *base;
+	int size;
+
+	if (mod->type == mod_studio)
+	{
+		// a hook may build the model differently, it has to see every load
+		if (g_RehldsHookchains.m_Mod_LoadStudioModel.hasHooks())
+			return;
+
+		studiohdr_t *phdr = (studiohdr_t *)mod->cache.data;
+		base = (byte *)phdr;
+		size = phdr->length + 1280 * phdr->numtextures;
+	}
+	else if (mod->type == mod_sprite)
+	{
+		base = hunk_base + hunkstart;
+		size = Hunk_LowMark() - hunkstart;
+	}
+	else
+	{
+		return;
+	}
+
+	if (size <= 0 || size > budget)
+		return;
+
+	modcache_t *entry = (modcache_t *)Mem_ZeroMalloc(sizeof(modcache_t) + size);
+	Q_strlcpy(entry->name, mod->name);
+	entry->length = length;
+	entry->filetime = FS_GetFileTime(mod->name);
+	entry->crc = crc;
+	entry->type = mod->type;
+	entry->flags = mod->flags;
+	entry->synctype = mod->synctype;
+	entry->numframes = mod->numframes;
+	VectorCopy(mod->mins, entry->mins);
+	VectorCopy(mod->maxs, entry->maxs);
+	entry->size = size;
+	entry->base = base;
+	entry->dataofs = (byte *)mod->cache.data - base;
+	entry->data = (byte *)(entry + 1);
+	Q_memcpy(entry->data, base, size);
+
+	Mod_CacheLinkFront(entry);
+	g_ModCache.count++;
+	g_ModCache.bytes += size;
+	Mod_CacheTrim(budget);
+}
+
+// Leaves the model as its loader would have
+static void Mod_CacheRestore(modcache_t *entry, model_t *mod)
+{
+	mod->type = entry->type;
+	mod->flags = entry->flags;
+
+	if (entry->type == mod_studio)
+	{
+		Cache_Alloc(&mod->cache, entry->size, mod->name);
+		if (mod->cache.data)
+			Q_memcpy(mod->cache.data, entry->data, entry->size);
+
+		return;
+	}
+
+	byte *block = (byte *)Hunk_AllocName(entry->size, loadname);
+	Q_memcpy(block, entry->data, entry->size);
+
+	msprite_t *psprite = (msprite_t *)(block + entry->dataofs);
+	Mod_CacheRelocateSprite(psprite, block - entry->base);
+
+	mod->cache.data = psprite;
+	mod->synctype = entry->synctype;
+	mod->numframes = entry->numframes;
+	VectorCopy(entry->mins, mod->mins);
+	VectorCopy(entry->maxs, mod->maxs);
+}
+
+void Mod_CacheStats_f(void)
+{
+	if (Cmd_Argc() == 2 && !Q_stricmp(Cmd_Argv(1), "flush"))
+	{
+		Mod_CacheFree();
+		return;
+	}
+
+	if (Cmd_Argc() != 1)
+	{
+		Con_Printf("Usage: model_cache_stats [flush]\n");
+		return;
+	}
+
+	if (Mod_CacheBudget() <= 0)
+		Con_Printf("sv_rehlds_model_cache is disabled, models are not cached\n");
+
+	uint32 lookups = g_ModCache.hits + g_ModCache.misses;
+	Con_Printf("Model cache: %i models, %.1f of %.1f MB\n", g_ModCache.count, g_ModCache.bytes / (1024.0 * 1024.0), Mod_CacheBudget() / (1024.0 * 1024.0));
+	Con_Printf("  %u hits, %u misses (%.1f%% hit rate), %u stale, %u evicted\n", g_ModCache.hits, g_ModCache.misses,
+		lookups ? g_ModCache.hits * 100.0 / lookups : 0.0, g_ModCache.stale, g_ModCache.evictions);
+}
+#endif // REHLDS_FIXES
+
 model_t *Mod_LoadModel(model_t *mod, qboolean crash, qboolean trackCRC)
 {
 	unsigned char *buf;
@@ -285,23 +554,45 @@ model_t *Mod_LoadModel(model_t *mod, qboolean crash, qboolean trackCRC)
 	}
 
 	// load the file
+#ifdef REHLDS_FIXES
+	modcache_t *cached = Mod_CacheLookup(mod->name);
+	buf = cached ? nullptr : COM_LoadFileForMe(mod->name, &length);
+	if (!buf && !cached)
+#else
 	buf = COM_LoadFileForMe(mod->name, &length);
 	if (!buf)
+#endif
 	{
 		if (crash)
 			Sys_Error("%s: %s not found", __func__, mod->name);
 		return 0;
 	}
 
+#ifdef REHLDS_FIXES
+	// taken once before the loader runs, it is both tracked and kept with the cache entry
+	qboolean wantCRC = trackCRC && mod_known_info[mod - mod_known].shouldCRC;
+	if (cached)
+	{
+		currentCRC = cached->crc;
+	}
+	else if (wantCRC || (Mod_CacheBudget() > 0 && Mod_CacheEligible(mod->name)))
+	{
+		CRC32_Init(&currentCRC);
+		CRC32_ProcessBuffer(&currentCRC, buf, length);
+		currentCRC = CRC32_Final(currentCRC);
+	}
+#endif
 
 	if (trackCRC)
 	{
 		mod_known_info_t *p = &mod_known_info[mod - mod_known];
 		if (p->shouldCRC)
 		{
+#ifndef REHLDS_FIXES
 			CRC32_Init(&currentCRC);
 			CRC32_ProcessBuffer(&currentCRC, buf, length);
 			currentCRC = CRC32_Final(currentCRC);
+#endif
 			if (p->firstCRCDone)
 			{
 				if (currentCRC != p->initialCRC)
@@ -335,6 +626,16 @@ model_t *Mod_LoadModel(model_t *mod, qboolean crash, qboolean trackCRC)
 
 	mod->needload = NL_PRESENT;
 
+#ifdef REHLDS_FIXES
+	if (cached)
+	{
+		Mod_CacheRestore(cached, mod);
+		return mod;
+	}
+
+	int hunkstart = Hunk_LowMark();
+#endif
+
 	// call the apropriate loader
 	switch (LittleLong(*(uint32 *)buf))
 	{
@@ -356,6 +657,10 @@ model_t *Mod_LoadModel(model_t *mod, qboolean crash, qboolean trackCRC)
 	if (g_modfuncs.m_pfnModelLoad)
 		g_modfuncs.m_pfnModelLoad(mod, buf);
 
+#ifdef REHLDS_FIXES
+	Mod_CacheStore(mod, currentCRC, length, hunkstart);
+#endif
+
 	Mem_Free(buf);
 	return mod;
 }
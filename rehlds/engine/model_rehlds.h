@@ -103,3 +103,8 @@ void Mod_Print(void);
 NOXREF void Mod_ChangeGame(void);
 model_t *Mod_Handle(int modelindex);
 modtype_t Mod_GetType(int modelindex);
+
+#ifdef REHLDS_FIXES
+void Mod_CacheFree();
+void Mod_CacheStats_f(void);
+#endif
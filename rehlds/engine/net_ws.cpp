@@ -28,6 +28,13 @@
 
 #include "precompiled.h"
 
+#ifndef _WIN32
+#include <atomic>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/timerfd.h>
+#endif // _WIN32
+
 qboolean net_thread_initialized;
 
 loopback_t loopbacks[2];
@@ -48,6 +55,8 @@ unsigned char net_message_buffer[NET_MAX_PAYLOAD];
 unsigned char in_message_buf[NET_MAX_PAYLOAD];
 sizebuf_t in_message;
 netadr_t in_from;
+double in_time;		// Receive time of in_message, in realtime units
+double net_time;	// Receive time of net_message, in realtime units
 
 #ifdef REHLDS_FIXES
 // Define default to INVALID_SOCKET
@@ -67,12 +76,41 @@ LONGPACKET gNetSplit;
 net_messages_t *messages[NS_MAX];
 net_messages_t *normalqueue;
 
+#ifndef _WIN32
+netrecvbatch_t *g_pNetRecvBatch[NS_MAX];
+netbatchstats_t g_NetRecvBatchStats;
+netsendbatch_t *g_pNetSendBatch;
+qboolean g_bNetSendBatching;
+netbatchstats_t g_NetSendBatchStats;
+#endif // _WIN32
+
 #ifdef _WIN32
 HANDLE hNetThread;
 DWORD dwNetThreadId;
 CRITICAL_SECTION net_cs;
+#else // _WIN32
+// Single producer (network thread), single consumer (main thread) packet queue
+typedef struct netring_s
+{
+	net_messages_t msgs[NET_THREAD_RING_SIZE];
+	std::atomic<unsigned int> head;	// Advanced by the network thread only
+	std::atomic<unsigned int> tail;	// Advanced by the main thread only
+} netring_t;
+
+netring_t *net_rings[NS_MAX];
+SOCKET net_thread_sockets[NS_MAX] = { INV_SOCK, INV_SOCK, INV_SOCK };
+pthread_t net_thread;
+int net_epollfd = -1;
+int net_wakefd = -1;
+int net_readyfd = -1;	// Signalled by the network thread after it has queued packets
+std::atomic<bool> net_thread_stop;
+
+netframestats_t g_NetFrameStats;
 #endif
 
+// Bumped whenever sockets are opened or closed
+int net_sockets_version;
+
 cvar_t net_address = { "net_address", "", 0, 0.0f, NULL };
 cvar_t ipname = { "ip", "localhost", 0, 0.0f, NULL };
 cvar_t defport = { "port", "27015", 0, 0.0f, NULL };
@@ -98,6 +136,12 @@ cvar_t net_graphwidth = { "net_graphwidth", "150", 0, 0.0f, NULL };
 cvar_t net_scale = { "net_scale", "5", FCVAR_ARCHIVE, 0.0f, NULL };
 cvar_t net_graphpos = { "net_graphpos", "1", FCVAR_ARCHIVE, 0.0f, NULL };
 
+#ifndef _WIN32
+cvar_t net_recvmmsg = { "net_recvmmsg", "0", 0, 0.0f, NULL };
+cvar_t net_sendmmsg = { "net_sendmmsg", "0", 0, 0.0f, NULL };
+cvar_t net_framescheduler = { "net_framescheduler", "0", 0, 0.0f, NULL };
+#endif // _WIN32
+
 void NET_ThreadLock()
 {
 #ifdef _WIN32
@@ -442,11 +486,7 @@ qboolean NET_IsLocalAddress(const netadr_t& adr)
 
 int NET_GetLastError()
 {
-#ifdef _WIN32
 	return CRehldsPlatformHolder::get()->WSAGetLastError();
-#else
-	return errno;
-#endif // _WIN32
 }
 
 char *NET_ErrorString(int code)
@@ -733,6 +773,7 @@ qboolean NET_LagPacket(qboolean newdata, netsrc_t sock, netadr_t *from, sizebuf_
 	NET_RemoveFromPacketList(pPacket);
 	NET_TransferRawData(&in_message, pPacket->pPacketData, pPacket->nSize);
 	Q_memcpy(&in_from, &pPacket->net_from_, sizeof(in_from));
+	in_time = realtime;
 	if (pPacket->pPacketData)
 		free(pPacket->pPacketData);
 
@@ -742,6 +783,10 @@ qboolean NET_LagPacket(qboolean newdata, netsrc_t sock, netadr_t *from, sizebuf_
 
 void NET_FlushSocket(netsrc_t sock)
 {
+#ifndef _WIN32
+	NET_ClearRecvBatch(sock);
+#endif
+
 	SOCKET net_socket = ip_sockets[sock];
 	if (net_socket != INV_SOCK)
 	{
@@ -858,6 +903,148 @@ qboolean NET_GetLong(unsigned char *pData, int size, int *outSize)
 	}
 }
 
+#ifndef _WIN32
+
+void NET_ClearRecvBatch(netsrc_t sock)
+{
+	netrecvbatch_t *batch = g_pNetRecvBatch[sock];
+	if (batch)
+	{
+		batch->count = 0;
+		batch->current = 0;
+	}
+}
+
+// Hands out the next datagram of the batch, refilling it with a single recvmmsg call once it runs dry.
+// Returns the datagram length like recvfrom does, *data points into the batch storage
+int NET_RecvBatched(netsrc_t sock, SOCKET s, unsigned char **data, struct sockaddr *from)
+{
+	netrecvbatch_t *batch = g_pNetRecvBatch[sock];
+	if (!batch)
+	{
+		batch = (netrecvbatch_t *)Mem_ZeroMalloc(sizeof(netrecvbatch_t));
+		g_pNetRecvBatch[sock] = batch;
+	}
+
+	if (batch->current >= batch->count)
+	{
+		batch->count = 0;
+		batch->current = 0;
+
+		for (int i = 0; i < NET_RECV_BATCH_SIZE; i++)
+		{
+			batch->iov[i].iov_base = batch->data[i];
+			batch->iov[i].iov_len = sizeof(batch->data[i]);
+
+			msghdr *hdr = &batch->msgs[i].msg_hdr;
+			Q_memset(hdr, 0, sizeof(*hdr));
+			hdr->msg_name = &batch->from[i];
+			hdr->msg_namelen = sizeof(batch->from[i]);
+			hdr->msg_iov = &batch->iov[i];
+			hdr->msg_iovlen = 1;
+		}
+
+		int ret = CRehldsPlatformHolder::get()->recvmmsg(s, batch->msgs, NET_RECV_BATCH_SIZE, 0, NULL);
+		if (ret <= 0)
+		{
+			if (ret == 0)
+				errno = WSAEWOULDBLOCK;
+
+			return -1;
+		}
+
+		batch->count = ret;
+
+		g_NetRecvBatchStats.syscalls++;
+		g_NetRecvBatchStats.packets += ret;
+		if (g_NetRecvBatchStats.maxpackets < ret)
+			g_NetRecvBatchStats.maxpackets = ret;
+	}
+
+	int i = batch->current++;
+	*data = batch->data[i];
+	Q_memcpy(from, &batch->from[i], sizeof(*from));
+	return batch->msgs[i].msg_len;
+}
+
+// Server datagrams sent between NET_BeginSendBatch and NET_EndSendBatch are queued
+// by NET_SendTo and go out with as few sendmmsg calls as possible
+void NET_BeginSendBatch()
+{
+	if (net_sendmmsg.value == 0.0f)
+		return;
+
+	if (!g_pNetSendBatch)
+		g_pNetSendBatch = (netsendbatch_t *)Mem_ZeroMalloc(sizeof(netsendbatch_t));
+
+	g_bNetSendBatching = TRUE;
+}
+
+void NET_FlushSendBatch()
+{
+	netsendbatch_t *batch = g_pNetSendBatch;
+	if (!batch || !batch->count)
+		return;
+
+	int sent = 0;
+	while (sent < batch->count)
+	{
+		int ret = CRehldsPlatformHolder::get()->sendmmsg(batch->socket, &batch->msgs[sent], batch->count - sent, 0);
+		if (ret <= 0)
+		{
+			int err = NET_GetLastError();
+			if (err != WSAEWOULDBLOCK && err != WSAECONNREFUSED && err != WSAECONNRESET)
+			{
+				netadr_t adr;
+				SockadrToNetadr(&batch->to[sent], &adr);
+				Con_Printf("%s: ERROR: %s : %s\n", __func__, NET_ErrorString(err), NET_AdrToString(adr));
+			}
+
+			// Skip the datagram that failed and keep sending the rest
+			sent++;
+			continue;
+		}
+
+		g_NetSendBatchStats.syscalls++;
+		g_NetSendBatchStats.packets += ret;
+		if (g_NetSendBatchStats.maxpackets < ret)
+			g_NetSendBatchStats.maxpackets = ret;
+
+		sent += ret;
+	}
+
+	batch->count = 0;
+}
+
+void NET_EndSendBatch()
+{
+	if (!g_bNetSendBatching)
+		return;
+
+	NET_FlushSendBatch();
+	g_bNetSendBatching = FALSE;
+}
+
+void NET_BatchStats_f()
+{
+	if (Cmd_Argc() == 2 && !Q_stricmp(Cmd_Argv(1), "reset"))
+	{
+		Q_memset(&g_NetRecvBatchStats, 0, sizeof(g_NetRecvBatchStats));
+		Q_memset(&g_NetSendBatchStats, 0, sizeof(g_NetSendBatchStats));
+		return;
+	}
+
+	const netbatchstats_t *stats = &g_NetRecvBatchStats;
+	Con_Printf("recvmmsg: %llu calls, %llu packets, %.2f packets per call, max %i\n",
+		stats->syscalls, stats->packets, stats->syscalls ? (double)stats->packets / stats->syscalls : 0.0, stats->maxpackets);
+
+	stats = &g_NetSendBatchStats;
+	Con_Printf("sendmmsg: %llu calls, %llu packets, %.2f packets per call, max %i\n",
+		stats->syscalls, stats->packets, stats->syscalls ? (double)stats->packets / stats->syscalls : 0.0, stats->maxpackets);
+}
+
+#endif // _WIN32
+
 qboolean NET_QueuePacket(netsrc_t sock)
 {
 #ifdef REHLDS_FIXES
@@ -866,6 +1053,9 @@ qboolean NET_QueuePacket(netsrc_t sock)
 	{
 		int ret = -1;
 		unsigned char buf[MAX_UDP_PACKET];
+		unsigned char *data = buf;
+
+		in_time = realtime;
 
 #ifdef _WIN32
 		for (int protocol = 0; protocol < 2; protocol++)
@@ -887,6 +1077,15 @@ qboolean NET_QueuePacket(netsrc_t sock)
 
 			struct sockaddr from;
 			socklen_t fromlen = sizeof(from);
+#ifndef _WIN32
+			netrecvbatch_t *batch = g_pNetRecvBatch[sock];
+			if (net_thread_initialized)
+				ret = NET_ThreadPopPacket(sock, buf, &from, &in_time);
+			// Keep draining a pending batch even if net_recvmmsg was just turned off
+			else if (net_recvmmsg.value != 0.0f || (batch && batch->current < batch->count))
+				ret = NET_RecvBatched(sock, net_socket, &data, &from);
+			else
+#endif // _WIN32
 			ret = CRehldsPlatformHolder::get()->recvfrom(net_socket, (char *)buf, sizeof buf, 0, &from, &fromlen);
 			if (ret == -1)
 			{
@@ -937,7 +1136,7 @@ qboolean NET_QueuePacket(netsrc_t sock)
 		}
 #endif // REHLDS_FIXES
 
-		NET_TransferRawData(&in_message, buf, ret);
+		NET_TransferRawData(&in_message, data, ret);
 
 		if (*(int32 *)in_message.data != NET_HEADER_FLAG_SPLITPACKET)
 		{
@@ -976,8 +1175,208 @@ qboolean NET_QueuePacket(netsrc_t sock)
 	}
 }
 
+#ifndef _WIN32
+
+int64 NET_MonotonicTime()
+{
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (int64)ts.tv_sec * 1000000000LL + ts.tv_nsec;
+}
+
+// Sleeps until a packet arrives or the next frame deadline passes.
+// Deadlines are absolute and spaced exactly 1/sys_ticrate apart, so oversleeping one frame doesn't delay the next ones
+int NET_Sleep_Scheduler()
+{
+	static int epollfd = -1;
+	static int timerfd = -1;
+	static int registered_version = -1;
+	static int64 deadline;
+	static int64 lastwake;
+
+	if (epollfd == -1)
+	{
+		epollfd = epoll_create1(EPOLL_CLOEXEC);
+		timerfd = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+		if (epollfd == -1 || timerfd == -1)
+			Sys_Error("%s: Couldn't create scheduler descriptors: %s\n", __func__, NET_ErrorString(NET_GetLastError()));
+
+		struct epoll_event ev;
+		Q_memset(&ev, 0, sizeof(ev));
+		ev.events = EPOLLIN;
+		ev.data.fd = timerfd;
+		epoll_ctl(epollfd, EPOLL_CTL_ADD, timerfd, &ev);
+	}
+
+	if (registered_version != net_sockets_version)
+	{
+		static SOCKET registered[NS_MAX + 1] = { INV_SOCK, INV_SOCK, INV_SOCK, INV_SOCK };
+
+		// The network thread drains the sockets itself, wait for it to queue the packets instead
+		qboolean threaded = use_thread && net_thread_initialized;
+
+		for (int sock = 0; sock < NS_MAX + 1; sock++)
+		{
+			// Closed descriptors are removed from the set by the kernel, so errors here are expected
+			if (registered[sock] != INV_SOCK)
+				epoll_ctl(epollfd, EPOLL_CTL_DEL, registered[sock], NULL);
+
+			if (sock == NS_MAX)
+				registered[sock] = threaded ? net_readyfd : INV_SOCK;
+			else
+				registered[sock] = threaded ? INV_SOCK : ip_sockets[sock];
+
+			if (registered[sock] == INV_SOCK)
+				continue;
+
+			struct epoll_event ev;
+			Q_memset(&ev, 0, sizeof(ev));
+			ev.events = EPOLLIN;
+			ev.data.fd = registered[sock];
+			epoll_ctl(epollfd, EPOLL_CTL_ADD, registered[sock], &ev);
+		}
+
+		registered_version = net_sockets_version;
+	}
+
+	float fps = sys_ticrate.value;
+	if (fps < 1.0f)
+		fps = 1.0f;
+
+	int64 interval = (int64)(1000000000.0 / fps);
+	int64 now = NET_MonotonicTime();
+
+	if (g_NetFrameStats.ticrate != fps)
+	{
+		Q_memset(&g_NetFrameStats, 0, sizeof(g_NetFrameStats));
+		g_NetFrameStats.ticrate = fps;
+		deadline = 0;
+	}
+
+	// Resync if we fell behind by more than a frame instead of running a burst of frames to catch up.
+	// A packet may have woken us before the deadline, keep waiting for the same one then
+	if (!deadline || now - deadline > interval)
+	{
+		deadline = now + interval;
+		lastwake = 0;
+	}
+	else if (now >= deadline)
+	{
+		deadline += interval;
+	}
+
+	struct itimerspec its;
+	Q_memset(&its, 0, sizeof(its));
+	its.it_value.tv_sec = deadline / 1000000000LL;
+	its.it_value.tv_nsec = deadline % 1000000000LL;
+	timerfd_settime(timerfd, TFD_TIMER_ABSTIME, &its, NULL);
+
+	struct epoll_event events[NS_MAX + 2];
+	int res = epoll_wait(epollfd, events, ARRAYSIZE(events), -1);
+
+	for (int i = 0; i < res; i++)
+	{
+		if (events[i].data.fd == net_readyfd)
+			NET_ThreadClearReady();
+
+		if (events[i].data.fd != timerfd)
+			continue;
+
+		uint64 expirations;
+		read(timerfd, &expirations, sizeof(expirations));
+
+		int64 wake = NET_MonotonicTime();
+		double late = (wake - deadline) * 1e-9;
+
+		netframestats_t *stats = &g_NetFrameStats;
+		if (lastwake)
+		{
+			double frametime = (wake - lastwake) * 1e-9;
+			stats->frames++;
+			stats->frametime_sum += frametime;
+			stats->frametime_sqsum += frametime * frametime;
+			stats->frametime_max = Q_max(stats->frametime_max, frametime);
+			stats->late_sum += late;
+			stats->late_max = Q_max(stats->late_max, late);
+		}
+
+		lastwake = wake;
+	}
+
+	return res;
+}
+
+void NET_PrintFrameStats()
+{
+	const netframestats_t *stats = &g_NetFrameStats;
+	if (net_framescheduler.value == 0.0f || !stats->frames)
+		return;
+
+	double avg = stats->frametime_sum / stats->frames;
+	double jitter = sqrt(Q_max(stats->frametime_sqsum / stats->frames - avg * avg, 0.0));
+
+	Con_Printf("Frame: target %.3f ms, avg %.3f ms, jitter %.3f ms, max %.3f ms, late avg %.3f ms, late max %.3f ms (%i frames)\n",
+		1000.0 / stats->ticrate, avg * 1000.0, jitter * 1000.0, stats->frametime_max * 1000.0,
+		stats->late_sum / stats->frames * 1000.0, stats->late_max * 1000.0, stats->frames);
+}
+
+#endif // _WIN32
+
+// Fills the set for the select() of the sleep functions, returns the highest descriptor
+SOCKET NET_SleepFdSet(fd_set *fdset)
+{
+	SOCKET number = 0;
+
+#ifndef _WIN32
+	// The network thread drains the sockets itself, wait for it to queue the packets instead
+	if (use_thread && net_thread_initialized)
+	{
+		FD_SET(net_readyfd, fdset);
+		return net_readyfd;
+	}
+#endif // _WIN32
+
+	for (int sock = 0; sock < NS_MAX; sock++)
+	{
+		SOCKET net_socket = ip_sockets[sock];
+		if (net_socket != INV_SOCK)
+		{
+			FD_SET(net_socket, fdset);
+
+			if (number < net_socket)
+				number = net_socket;
+		}
+
+#ifdef _WIN32
+		net_socket = ipx_sockets[sock];
+		if (net_socket != INV_SOCK)
+		{
+			FD_SET(net_socket, fdset);
+
+			if (number < net_socket)
+				number = net_socket;
+		}
+#endif // _WIN32
+	}
+
+	return number;
+}
+
 DLL_EXPORT int NET_Sleep_Timeout()
 {
+#ifndef _WIN32
+	// Test recordings see the time between the frames as a platform sleep, the playback skips it
+	if (g_RehldsRuntimeConfig.testPlayerMode != TPM_DISABLE)
+	{
+		int fps = (int)sys_ticrate.value;
+		CRehldsPlatformHolder::get()->Sleep(1000 / (fps > 0 ? fps : 1));
+		return 0;
+	}
+
+	if (net_framescheduler.value != 0.0f)
+		return NET_Sleep_Scheduler();
+#endif // _WIN32
+
 	static int32 lasttime;
 	static int numFrames;
 	static int staggerFrames;
@@ -1010,31 +1409,13 @@ DLL_EXPORT int NET_Sleep_Timeout()
 	int res;
 	if (numFrames > 0 && numFrames % staggerFrames)
 	{
-		SOCKET number = 0;
-
-		for (int sock = 0; sock < NS_MAX; sock++)
-		{
-			SOCKET net_socket = ip_sockets[sock];
-			if (net_socket != INV_SOCK)
-			{
-				FD_SET(net_socket, &fdset);
-
-				if (number < net_socket)
-					number = net_socket;
-			}
-
-#ifdef _WIN32
-			net_socket = ipx_sockets[sock];
-			if (net_socket != INV_SOCK)
-			{
-				FD_SET(net_socket, &fdset);
+		SOCKET number = NET_SleepFdSet(&fdset);
+		res = select((int)(number + 1), &fdset, NULL, NULL, &tv);
 
-				if (number < net_socket)
-					number = net_socket;
-			}
+#ifndef _WIN32
+		if (res > 0 && use_thread && net_thread_initialized)
+			NET_ThreadClearReady();
 #endif // _WIN32
-		}
-		res = select((int)(number + 1), &fdset, NULL, NULL, &tv);
 	}
 	else
 	{
@@ -1049,35 +1430,20 @@ int NET_Sleep()
 	fd_set fdset;
 	FD_ZERO(&fdset);
 
-	SOCKET number = 0;
-	for (int sock = 0; sock < NS_MAX; sock++)
-	{
-		SOCKET net_socket = ip_sockets[sock];
-		if (net_socket != INV_SOCK)
-		{
-			FD_SET(net_socket, &fdset);
-
-			if (number < net_socket)
-				number = net_socket;
-		}
-
-#ifdef _WIN32
-		net_socket = ipx_sockets[sock];
-		if (net_socket != INV_SOCK)
-		{
-			FD_SET(net_socket, &fdset);
-
-			if (number < net_socket)
-				number = net_socket;
-		}
-#endif // _WIN32
-	}
+	SOCKET number = NET_SleepFdSet(&fdset);
 
 	struct timeval tv;
 	tv.tv_sec = 0;
 	tv.tv_usec = 20 * 1000;
 
-	return select((int)(number + 1), &fdset, NULL, NULL, net_sleepforever == 0 ? &tv : NULL);
+	int res = select((int)(number + 1), &fdset, NULL, NULL, net_sleepforever == 0 ? &tv : NULL);
+
+#ifndef _WIN32
+	if (res > 0 && use_thread && net_thread_initialized)
+		NET_ThreadClearReady();
+#endif // _WIN32
+
+	return res;
 }
 
 #ifdef _WIN32
@@ -1130,6 +1496,144 @@ DWORD WINAPI NET_ThreadMain(LPVOID lpThreadParameter)
 	return 0;
 }
 
+#else // _WIN32
+
+// Reads every ready socket into its packet ring and timestamps each packet on arrival.
+// The main thread picks them up in NET_QueuePacket through NET_ThreadPopPacket without locking
+void *NET_ThreadMain(void *arg)
+{
+	struct epoll_event events[NS_MAX + 1];
+
+	while (!net_thread_stop.load(std::memory_order_acquire))
+	{
+		int count = epoll_wait(net_epollfd, events, ARRAYSIZE(events), -1);
+		qboolean overflow = FALSE;
+		qboolean queued = FALSE;
+
+		for (int i = 0; i < count; i++)
+		{
+			// Wakeup from NET_StopThread
+			if (events[i].data.u64 == (uint64)-1)
+				continue;
+
+			int sock = (int)(events[i].data.u64 >> 32);
+			SOCKET net_socket = (SOCKET)(events[i].data.u64 & 0xFFFFFFFF);
+			netring_t *ring = net_rings[sock];
+
+			while (true)
+			{
+				unsigned int head = ring->head.load(std::memory_order_relaxed);
+				if (head - ring->tail.load(std::memory_order_acquire) >= NET_THREAD_RING_SIZE)
+				{
+					// Leave the rest in the socket buffer until the main thread catches up
+					overflow = TRUE;
+					break;
+				}
+
+				net_messages_t *pmsg = &ring->msgs[head & (NET_THREAD_RING_SIZE - 1)];
+
+				struct sockaddr from;
+				socklen_t fromlen = sizeof(from);
+				int ret = CRehldsPlatformHolder::get()->recvfrom(net_socket, (char *)pmsg->buffer, MAX_UDP_PACKET, 0, &from, &fromlen);
+				if (ret == -1)
+					break;
+
+				pmsg->receivedtime = Sys_FloatTime();
+				pmsg->buffersize = ret;
+				SockadrToNetadr(&from, &pmsg->from);
+
+				ring->head.store(head + 1, std::memory_order_release);
+				queued = TRUE;
+			}
+		}
+
+		// Wake up the main thread sleeping in NET_Sleep_Timeout or NET_Sleep
+		if (queued)
+		{
+			uint64 one = 1;
+			write(net_readyfd, &one, sizeof(one));
+		}
+
+		if (overflow)
+			Sys_Sleep(1);
+	}
+
+	return NULL;
+}
+
+// Resets the wakeup of the main thread, the packets queued so far are picked up in this frame
+void NET_ThreadClearReady()
+{
+	uint64 count;
+	read(net_readyfd, &count, sizeof(count));
+}
+
+// Adds sockets opened since the last call to the thread's epoll set
+void NET_ThreadRegisterSockets()
+{
+	for (int sock = 0; sock < NS_MAX; sock++)
+	{
+		SOCKET net_socket = ip_sockets[sock];
+		if (net_socket == INV_SOCK || net_socket == net_thread_sockets[sock])
+			continue;
+
+		if (!net_rings[sock])
+		{
+			netring_t *ring = (netring_t *)Mem_ZeroMalloc(sizeof(netring_t));
+			for (int i = 0; i < NET_THREAD_RING_SIZE; i++)
+			{
+				ring->msgs[i].buffer = (unsigned char *)Mem_ZeroMalloc(MAX_UDP_PACKET);
+				ring->msgs[i].preallocated = TRUE;
+			}
+
+			net_rings[sock] = ring;
+		}
+
+		struct epoll_event ev;
+		Q_memset(&ev, 0, sizeof(ev));
+		ev.events = EPOLLIN;
+		ev.data.u64 = ((uint64)sock << 32) | (uint32)net_socket;
+
+		if (epoll_ctl(net_epollfd, EPOLL_CTL_ADD, net_socket, &ev) == -1)
+		{
+			Con_Printf("%s: epoll_ctl: %s\n", __func__, NET_ErrorString(NET_GetLastError()));
+			continue;
+		}
+
+		net_thread_sockets[sock] = net_socket;
+	}
+}
+
+int NET_ThreadPopPacket(netsrc_t sock, unsigned char *buf, struct sockaddr *from, double *time)
+{
+	netring_t *ring = net_rings[sock];
+	if (!ring)
+	{
+		errno = WSAEWOULDBLOCK;
+		return -1;
+	}
+
+	unsigned int tail = ring->tail.load(std::memory_order_relaxed);
+	if (tail == ring->head.load(std::memory_order_acquire))
+	{
+		errno = WSAEWOULDBLOCK;
+		return -1;
+	}
+
+	net_messages_t *pmsg = &ring->msgs[tail & (NET_THREAD_RING_SIZE - 1)];
+
+	int size = pmsg->buffersize;
+	Q_memcpy(buf, pmsg->buffer, size);
+	NetadrToSockadr(&pmsg->from, from);
+
+	// Don't count the time the packet spent in the queue
+	double queued = Sys_FloatTime() - pmsg->receivedtime;
+	*time = realtime - Q_max(queued, 0.0);
+
+	ring->tail.store(tail + 1, std::memory_order_release);
+	return size;
+}
+
 #endif // _WIN32
 
 void NET_StartThread()
@@ -1150,8 +1654,34 @@ void NET_StartThread()
 				use_thread = FALSE;
 				Sys_Error("%s: Couldn't initialize network thread, run without -netthread\n", __func__);
 			}
+#else // _WIN32
+			net_thread_stop.store(false);
+			net_epollfd = epoll_create1(EPOLL_CLOEXEC);
+			net_wakefd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+			net_readyfd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+
+			struct epoll_event ev;
+			Q_memset(&ev, 0, sizeof(ev));
+			ev.events = EPOLLIN;
+			ev.data.u64 = (uint64)-1;
+
+			if (net_epollfd == -1 || net_wakefd == -1 || net_readyfd == -1
+				|| epoll_ctl(net_epollfd, EPOLL_CTL_ADD, net_wakefd, &ev) == -1
+				|| pthread_create(&net_thread, NULL, NET_ThreadMain, NULL) != 0)
+			{
+				net_thread_initialized = FALSE;
+				use_thread = FALSE;
+				Sys_Error("%s: Couldn't initialize network thread, run without -netthread\n", __func__);
+			}
+
+			// The sleep functions switch over to net_readyfd
+			net_sockets_version++;
 #endif // _WIN32
 		}
+
+#ifndef _WIN32
+		NET_ThreadRegisterSockets();
+#endif // _WIN32
 	}
 }
 
@@ -1164,6 +1694,29 @@ void NET_StopThread()
 #ifdef _WIN32
 			TerminateThread(hNetThread, 0);
 			DeleteCriticalSection(&net_cs);
+#else // _WIN32
+			net_thread_stop.store(true, std::memory_order_release);
+
+			uint64 one = 1;
+			write(net_wakefd, &one, sizeof(one));
+			pthread_join(net_thread, NULL);
+
+			close(net_epollfd);
+			close(net_wakefd);
+			close(net_readyfd);
+			net_epollfd = -1;
+			net_wakefd = -1;
+			net_readyfd = -1;
+			net_sockets_version++;
+
+			for (int sock = 0; sock < NS_MAX; sock++)
+			{
+				net_thread_sockets[sock] = INV_SOCK;
+
+				// Drop whatever the thread has queued from the old sockets
+				if (net_rings[sock])
+					net_rings[sock]->tail.store(net_rings[sock]->head.load());
+			}
 #endif // _WIN32
 			net_thread_initialized = FALSE;
 		}
@@ -1218,19 +1771,23 @@ qboolean NET_GetPacket(netsrc_t sock)
 	NET_ThreadLock();
 	if (NET_GetLoopPacket(sock, &in_from, &in_message))
 	{
+		in_time = realtime;
 		bret = NET_LagPacket(TRUE, sock, &in_from, &in_message);
 	}
 	else
 	{
-		if (!use_thread)
+#ifdef _WIN32
+		if (use_thread)
 		{
-			bret = NET_QueuePacket(sock);
-			if (!bret)
-				bret = NET_LagPacket(FALSE, sock, NULL, NULL);
+			bret = NET_LagPacket(FALSE, sock, NULL, NULL);
 		}
 		else
+#endif // _WIN32
 		{
-			bret = NET_LagPacket(FALSE, sock, NULL, NULL);
+			// On Linux the network thread only fills the packet rings, NET_QueuePacket does the rest
+			bret = NET_QueuePacket(sock);
+			if (!bret)
+				bret = NET_LagPacket(FALSE, sock, NULL, NULL);
 		}
 	}
 
@@ -1239,6 +1796,7 @@ qboolean NET_GetPacket(netsrc_t sock)
 		Q_memcpy(net_message.data, in_message.data, in_message.cursize);
 		net_message.cursize = in_message.cursize;
 		Q_memcpy(&net_from, &in_from, sizeof(netadr_t));
+		net_time = in_time;
 		NET_ThreadUnlock();
 		return bret;
 	}
@@ -1250,6 +1808,7 @@ qboolean NET_GetPacket(netsrc_t sock)
 		messages[sock] = pmsg->next;
 		Q_memcpy(net_message.data, pmsg->buffer, net_message.cursize);
 		net_from = pmsg->from;
+		net_time = realtime;
 		msg_readcount = 0;
 		NET_FreeMsg(pmsg);
 		bret = TRUE;
@@ -1276,6 +1835,24 @@ void NET_FlushQueues()
 {
 	NET_StopThread();
 
+#ifndef _WIN32
+	for (int i = 0; i < NS_MAX; i++)
+	{
+		if (g_pNetRecvBatch[i])
+		{
+			Mem_Free(g_pNetRecvBatch[i]);
+			g_pNetRecvBatch[i] = NULL;
+		}
+	}
+
+	NET_EndSendBatch();
+	if (g_pNetSendBatch)
+	{
+		Mem_Free(g_pNetSendBatch);
+		g_pNetSendBatch = NULL;
+	}
+#endif // _WIN32
+
 	for (int i = 0; i < NS_MAX; i++)
 	{
 		net_messages_t *p = messages[i];
@@ -1288,6 +1865,18 @@ void NET_FlushQueues()
 		}
 
 		messages[i] = NULL;
+
+#ifndef _WIN32
+		netring_t *ring = net_rings[i];
+		if (ring)
+		{
+			for (int j = 0; j < NET_THREAD_RING_SIZE; j++)
+				Mem_Free(ring->msgs[j].buffer);
+
+			Mem_Free(ring);
+			net_rings[i] = NULL;
+		}
+#endif // _WIN32
 	}
 
 	net_messages_t *p = normalqueue;
@@ -1301,6 +1890,42 @@ void NET_FlushQueues()
 	normalqueue = NULL;
 }
 
+int NET_SendTo(netsrc_t sock, SOCKET s, const char *buf, int len, int flags, const struct sockaddr *to, int tolen)
+{
+#ifndef _WIN32
+	if (g_bNetSendBatching && sock == NS_SERVER && len <= MAX_ROUTEABLE_PACKET && !flags)
+	{
+		netsendbatch_t *batch = g_pNetSendBatch;
+		if (batch->count == NET_SEND_BATCH_SIZE || (batch->count && batch->socket != s))
+			NET_FlushSendBatch();
+
+		int i = batch->count++;
+		batch->socket = s;
+		Q_memcpy(batch->data[i], buf, len);
+		Q_memcpy(&batch->to[i], to, sizeof(batch->to[i]));
+
+		batch->iov[i].iov_base = batch->data[i];
+		batch->iov[i].iov_len = len;
+
+		msghdr *hdr = &batch->msgs[i].msg_hdr;
+		Q_memset(hdr, 0, sizeof(*hdr));
+		hdr->msg_name = &batch->to[i];
+		hdr->msg_namelen = sizeof(batch->to[i]);
+		hdr->msg_iov = &batch->iov[i];
+		hdr->msg_iovlen = 1;
+
+		// Errors are reported when the batch is flushed
+		return len;
+	}
+
+	// Anything sent directly must not overtake datagrams still waiting in the batch
+	if (g_bNetSendBatching)
+		NET_FlushSendBatch();
+#endif // _WIN32
+
+	return CRehldsPlatformHolder::get()->sendto(s, buf, len, flags, to, tolen);
+}
+
 int NET_SendLong(netsrc_t sock, SOCKET s, const char *buf, int len, int flags, const struct sockaddr *to, int tolen)
 {
 	static long gSequenceNumber = 1;
@@ -1346,7 +1971,7 @@ int NET_SendLong(netsrc_t sock, SOCKET s, const char *buf, int len, int flags, c
 					NET_AdrToString(adr));
 			}
 
-			int ret = CRehldsPlatformHolder::get()->sendto(s, packet, size + sizeof(SPLITPACKET), flags, to, tolen);
+			int ret = NET_SendTo(sock, s, packet, size + sizeof(SPLITPACKET), flags, to, tolen);
 			if (ret < 0)
 			{
 				return ret;
@@ -1364,7 +1989,7 @@ int NET_SendLong(netsrc_t sock, SOCKET s, const char *buf, int len, int flags, c
 		return totalSent;
 	}
 
-	int nSend = CRehldsPlatformHolder::get()->sendto(s, buf, len, flags, to, tolen);
+	int nSend = NET_SendTo(sock, s, buf, len, flags, to, tolen);
 	return nSend;
 }
 
@@ -1462,11 +2087,7 @@ SOCKET NET_IPSocket(char *net_interface, int port, qboolean multicast)
 	SOCKET newsocket;
 	qboolean _true = TRUE;
 
-#ifdef _WIN32
 	if ((newsocket = CRehldsPlatformHolder::get()->socket(PF_INET, SOCK_DGRAM, IPPROTO_UDP)) == INVALID_SOCKET)
-#else
-	if ((newsocket = socket(PF_INET, SOCK_DGRAM, IPPROTO_UDP)) == INVALID_SOCKET)
-#endif // _WIN32
 	{
 		int err = NET_GetLastError();
 		if (err != WSAEAFNOSUPPORT)
@@ -1476,22 +2097,14 @@ SOCKET NET_IPSocket(char *net_interface, int port, qboolean multicast)
 		return INV_SOCK;
 	}
 
-#ifdef _WIN32
 	if (CRehldsPlatformHolder::get()->ioctlsocket(newsocket, FIONBIO, (u_long *)&_true) == SOCKET_ERROR)
-#else
-	if (SOCKET_FIONBIO(newsocket, _true) == SOCKET_ERROR)
-#endif // _WIN32
 	{
 		Con_Printf("WARNING: UDP_OpenSocket: port: %d  ioctl FIONBIO: %s\n", port, NET_ErrorString(NET_GetLastError()));
 		return INV_SOCK;
 	}
 
 	qboolean i = TRUE;
-#ifdef _WIN32
 	if (CRehldsPlatformHolder::get()->setsockopt(newsocket, SOL_SOCKET, SO_BROADCAST, (char *)&i, sizeof(i)) == SOCKET_ERROR)
-#else
-	if (setsockopt(newsocket, SOL_SOCKET, SO_BROADCAST, (char *)&i, sizeof(i)) == SOCKET_ERROR)
-#endif
 	{
 		Con_Printf ("WARNING: UDP_OpenSocket: port: %d  setsockopt SO_BROADCAST: %s\n", port, NET_ErrorString(NET_GetLastError()));
 		return INV_SOCK;
@@ -1499,11 +2112,7 @@ SOCKET NET_IPSocket(char *net_interface, int port, qboolean multicast)
 
 	if (COM_CheckParm("-reuse") || multicast)
 	{
-#ifdef _WIN32
 		if (CRehldsPlatformHolder::get()->setsockopt(newsocket, SOL_SOCKET, SO_REUSEADDR, (char *)&_true, sizeof(qboolean)) == SOCKET_ERROR)
-#else
-		if (setsockopt(newsocket, SOL_SOCKET, SO_REUSEADDR, (char *)&_true, sizeof(qboolean)) == SOCKET_ERROR)
-#endif // _WIN32
 		{
 			Con_Printf ("WARNING: UDP_OpenSocket: port: %d  setsockopt SO_REUSEADDR: %s\n", port, NET_ErrorString(NET_GetLastError()));
 			return INV_SOCK;
@@ -1515,7 +2124,7 @@ SOCKET NET_IPSocket(char *net_interface, int port, qboolean multicast)
 	{
 		int i = IPTOS_LOWDELAY;
 		Con_Printf("Enabling LOWDELAY TOS option\n");
-		if (setsockopt(newsocket, IPPROTO_IP, IP_TOS, (char *)&i, sizeof(i)) == SOCKET_ERROR)
+		if (CRehldsPlatformHolder::get()->setsockopt(newsocket, IPPROTO_IP, IP_TOS, (char *)&i, sizeof(i)) == SOCKET_ERROR)
 		{
 			int err = NET_GetLastError();
 			if (err != WSAENOPROTOOPT)
@@ -1539,34 +2148,22 @@ SOCKET NET_IPSocket(char *net_interface, int port, qboolean multicast)
 
 	address.sin_family = AF_INET;
 
-#ifdef _WIN32
 	if (CRehldsPlatformHolder::get()->bind(newsocket, (struct sockaddr *)&address, sizeof(address)) == SOCKET_ERROR)
-#else
-	if (bind(newsocket, (struct sockaddr *)&address, sizeof(address)) == SOCKET_ERROR)
-#endif // _WIN32
 	{
 		Con_Printf("WARNING: UDP_OpenSocket: port: %d  bind: %s\n", port, NET_ErrorString(NET_GetLastError()));
-#ifdef _WIN32
 		CRehldsPlatformHolder::get()->closesocket(newsocket);
-#else
-		SOCKET_CLOSE(newsocket);
-#endif // _WIN32
 		return INV_SOCK;
 	}
 
 	qboolean bLoopBack = COM_CheckParm("-loopback") != 0;
-#ifdef _WIN32
 	if (CRehldsPlatformHolder::get()->setsockopt(newsocket, IPPROTO_IP, IP_MULTICAST_LOOP, (char *)&bLoopBack, sizeof(bLoopBack)) == SOCKET_ERROR)
-#else
-	if (setsockopt(newsocket, IPPROTO_IP, IP_MULTICAST_LOOP, (char *)&bLoopBack, sizeof(bLoopBack)) == SOCKET_ERROR)
-#endif // _WIN32
 	{
 		Con_DPrintf("WARNING: UDP_OpenSocket: port %d setsockopt IP_MULTICAST_LOOP: %s\n", port, NET_ErrorString(NET_GetLastError()));
 	}
 
 #if !defined _WIN32 && defined REHLDS_FIXES
 	int j = IP_PMTUDISC_DONT;
- 	if (setsockopt(newsocket, IPPROTO_IP, IP_MTU_DISCOVER, (char *)&j, sizeof(j)) == SOCKET_ERROR)
+	if (CRehldsPlatformHolder::get()->setsockopt(newsocket, IPPROTO_IP, IP_MTU_DISCOVER, (char *)&j, sizeof(j)) == SOCKET_ERROR)
 	{
 		Con_Printf("WARNING: UDP_OpenSocket: port %d  setsockopt IP_MTU_DISCOVER: %s\n", port, NET_ErrorString(NET_GetLastError()));
 	}
@@ -1776,11 +2373,7 @@ void NET_GetLocalAddress()
 			Q_strncpy(buff, ipname.string,  ARRAYSIZE(buff) - 1);
 		else
 		{
-#ifdef _WIN32
 			CRehldsPlatformHolder::get()->gethostname(buff,  ARRAYSIZE(buff));
-#else
-			gethostname(buff, ARRAYSIZE(buff));
-#endif // _WIN32
 		}
 
 		buff[ARRAYSIZE(buff) - 1] = 0;
@@ -1793,11 +2386,7 @@ void NET_GetLocalAddress()
 		NET_StringToAdr(buff, &net_local_adr);
 #endif
 		namelen = sizeof(address);
-#ifdef _WIN32
 		if (CRehldsPlatformHolder::get()->getsockname(ip_sockets[NS_SERVER], (struct sockaddr *)&address, (socklen_t *)&namelen) == SOCKET_ERROR)
-#else
-		if (getsockname(ip_sockets[NS_SERVER], (struct sockaddr *)&address, (socklen_t *)&namelen) == SOCKET_ERROR)
-#endif // _WIN32
 		{
 			noip = TRUE;
 			net_error = NET_GetLastError();
@@ -1878,8 +2467,12 @@ void NET_Config(qboolean multiplayer)
 #ifdef _WIN32
 		if (!noipx)
 			NET_OpenIPX();
+#else // _WIN32
+		NET_StartThread();
 #endif //_WIN32
 
+		net_sockets_version++;
+
 		static qboolean bFirst = TRUE;
 		if (bFirst)
 		{
@@ -1891,14 +2484,22 @@ void NET_Config(qboolean multiplayer)
 	{
 		NET_ThreadLock();
 
+		net_sockets_version++;
+
+#ifndef _WIN32
+		NET_FlushSendBatch();
+
+		// The network thread must not be reading the sockets while they are closed
+		NET_StopThread();
+#endif // _WIN32
+
 		for (int sock = 0; sock < NS_MAX; sock++)
 		{
 			if (ip_sockets[sock] != INV_SOCK)
 			{
-#ifdef _WIN32
 				CRehldsPlatformHolder::get()->closesocket(ip_sockets[sock]);
-#else //_WIN32
-				SOCKET_CLOSE(ip_sockets[sock]);
+#ifndef _WIN32
+				NET_ClearRecvBatch((netsrc_t)sock);
 #endif //_WIN32
 				ip_sockets[sock] = INV_SOCK;
 			}
@@ -1974,8 +2575,15 @@ void NET_Init()
 	Cvar_RegisterVariable(&net_graphwidth);
 	Cvar_RegisterVariable(&net_scale);
 	Cvar_RegisterVariable(&net_graphpos);
+#ifndef _WIN32
+	Cvar_RegisterVariable(&net_recvmmsg);
+	Cvar_RegisterVariable(&net_sendmmsg);
+	Cvar_RegisterVariable(&net_framescheduler);
+	Cmd_AddCommand("net_batchstats", NET_BatchStats_f);
+#endif // _WIN32
 
-	if (COM_CheckParm("-netthread"))
+	// The network thread would make test recordings nondeterministic
+	if (COM_CheckParm("-netthread") && g_RehldsRuntimeConfig.testPlayerMode == TPM_DISABLE)
 		use_thread = TRUE;
 
 	if (COM_CheckParm("-netsleep"))
@@ -88,6 +88,7 @@ typedef struct net_messages_s
 	unsigned char *buffer;
 	netadr_t from;
 	int buffersize;
+	double receivedtime;	// Sys_FloatTime() when the packet was read from the socket
 } net_messages_t;
 
 // Split long packets. Anything over 1460 is failing on some routers.
@@ -112,6 +113,58 @@ typedef struct SPLITPACKET_t
 
 const int NET_WS_MAX_FRAGMENTS = 5;
 
+#ifndef _WIN32
+
+// Packets buffered per socket by the network thread, must be a power of two
+const int NET_THREAD_RING_SIZE = 256;
+
+// Max datagrams pulled from the socket by a single recvmmsg call
+const int NET_RECV_BATCH_SIZE = 32;
+
+typedef struct netrecvbatch_s
+{
+	struct mmsghdr msgs[NET_RECV_BATCH_SIZE];
+	struct iovec iov[NET_RECV_BATCH_SIZE];
+	struct sockaddr from[NET_RECV_BATCH_SIZE];
+	unsigned char data[NET_RECV_BATCH_SIZE][MAX_UDP_PACKET];
+	int count;		// Datagrams received by the last syscall
+	int current;	// Next datagram to hand out
+} netrecvbatch_t;
+
+// Max datagrams queued for a single sendmmsg call
+const int NET_SEND_BATCH_SIZE = 64;
+
+typedef struct netsendbatch_s
+{
+	struct mmsghdr msgs[NET_SEND_BATCH_SIZE];
+	struct iovec iov[NET_SEND_BATCH_SIZE];
+	struct sockaddr to[NET_SEND_BATCH_SIZE];
+	unsigned char data[NET_SEND_BATCH_SIZE][MAX_ROUTEABLE_PACKET];
+	SOCKET socket;	// All queued datagrams go out through this socket
+	int count;
+} netsendbatch_t;
+
+typedef struct netbatchstats_s
+{
+	uint64 syscalls;
+	uint64 packets;
+	int maxpackets;	// Largest number of datagrams moved by a single syscall
+} netbatchstats_t;
+
+// Frame pacing of the epoll/timerfd scheduler, all times in seconds
+typedef struct netframestats_s
+{
+	float ticrate;			// sys_ticrate the samples were taken with
+	int frames;
+	double frametime_sum;	// Time between consecutive deadline wakeups
+	double frametime_sqsum;
+	double frametime_max;
+	double late_sum;		// How far past the deadline the wakeup happened
+	double late_max;
+} netframestats_t;
+
+#endif // _WIN32
+
 extern qboolean net_thread_initialized;
 extern cvar_t net_address;
 extern cvar_t ipname;
@@ -152,6 +205,8 @@ extern unsigned char net_message_buffer[NET_MAX_PAYLOAD];
 extern unsigned char in_message_buf[NET_MAX_PAYLOAD];
 extern sizebuf_t in_message;
 extern netadr_t in_from;
+extern double in_time;
+extern double net_time;
 extern SOCKET ip_sockets[3];
 #ifdef _WIN32
 extern SOCKET ipx_sockets[3];
@@ -159,6 +214,17 @@ extern SOCKET ipx_sockets[3];
 extern LONGPACKET gNetSplit;
 extern net_messages_t *messages[3];
 extern net_messages_t *normalqueue;
+#ifndef _WIN32
+extern cvar_t net_recvmmsg;
+extern netrecvbatch_t *g_pNetRecvBatch[3];
+extern netbatchstats_t g_NetRecvBatchStats;
+extern cvar_t net_sendmmsg;
+extern netsendbatch_t *g_pNetSendBatch;
+extern qboolean g_bNetSendBatching;
+extern netbatchstats_t g_NetSendBatchStats;
+extern cvar_t net_framescheduler;
+extern netframestats_t g_NetFrameStats;
+#endif // _WIN32
 
 
 void NET_ThreadLock();
@@ -188,8 +254,26 @@ void NET_AdjustLag();
 qboolean NET_LagPacket(qboolean newdata, netsrc_t sock, netadr_t *from, sizebuf_t *data);
 void NET_FlushSocket(netsrc_t sock);
 qboolean NET_GetLong(unsigned char *pData, int size, int *outSize);
+#ifndef _WIN32
+void NET_ClearRecvBatch(netsrc_t sock);
+int NET_RecvBatched(netsrc_t sock, SOCKET s, unsigned char **data, struct sockaddr *from);
+void NET_BeginSendBatch();
+void NET_FlushSendBatch();
+void NET_EndSendBatch();
+void NET_BatchStats_f();
+#endif // _WIN32
 qboolean NET_QueuePacket(netsrc_t sock);
+SOCKET NET_SleepFdSet(fd_set *fdset);
 int NET_Sleep();
+#ifndef _WIN32
+int64 NET_MonotonicTime();
+int NET_Sleep_Scheduler();
+void NET_PrintFrameStats();
+void *NET_ThreadMain(void *arg);
+void NET_ThreadClearReady();
+void NET_ThreadRegisterSockets();
+int NET_ThreadPopPacket(netsrc_t sock, unsigned char *buf, struct sockaddr *from, double *time);
+#endif // _WIN32
 void NET_StartThread();
 void NET_StopThread();
 void *net_malloc(size_t size);
@@ -198,6 +282,7 @@ void NET_FreeMsg(net_messages_t *pmsg);
 qboolean NET_GetPacket(netsrc_t sock);
 void NET_AllocateQueues();
 void NET_FlushQueues();
+int NET_SendTo(netsrc_t sock, SOCKET s, const char *buf, int len, int flags, const struct sockaddr *to, int tolen);
 int NET_SendLong(netsrc_t sock, SOCKET s, const char *buf, int len, int flags, const struct sockaddr *to, int tolen);
 void NET_SendPacket_api(unsigned int length, void *data, const netadr_t &to);
 void NET_SendPacket(netsrc_t sock, int length, void *data, const netadr_t& to);
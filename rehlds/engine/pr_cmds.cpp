@@ -134,6 +134,7 @@ void EXT_FUNC PF_setmodel_I(edict_t *e, const char *m)
 			model_t *mod = g_psv.models[i];
 #ifdef REHLDS_FIXES
 			e->v.model = *check - pr_strings;
+			ED_InvalidateFindIndex();
 #else // REHLDS_FIXES
 			e->v.model = m - pr_strings;
 #endif // REHLDS_FIXES
@@ -860,6 +861,12 @@ edict_t* EXT_FUNC FindEntityInSphere(edict_t *pEdictStartSearchAfter, const floa
 {
 	int e = pEdictStartSearchAfter ? NUM_FOR_EDICT(pEdictStartSearchAfter) : 0;
 
+#ifdef REHLDS_FIXES
+	edict_t *found;
+	if (SV_SphereGridFind(e, org, rad, &found))
+		return found;
+#endif // REHLDS_FIXES
+
 	for (int i = e + 1; i < g_psv.num_edicts; i++)
 	{
 		edict_t* ent = &g_psv.edicts[i];
@@ -927,8 +934,246 @@ void EXT_FUNC PF_Remove_I_internal(edict_t *ed)
 	ED_Free(ed);
 }
 
+#ifdef REHLDS_FIXES
+// Indexed FindEntityByString (sv_rehlds_find_index).
+// One index per searched entvars field, built on demand: the edicts are bucketed by a hash of the
+// field's string in ascending order, so a search jumps to the first bucket entry after the start edict.
+// Keys are the string contents, the game DLL also sets fields to its own literals (MAKE_STRING).
+// The engine can't see the game DLL writing a field, so all indexes are dropped whenever an edict is
+// cleared, a string is allocated, a model is set and at the start of every frame. A dirty index is
+// rebuilt on the second search after that, a single search after each change just does the scan.
+// Candidates are always checked against the edict, a stale entry is never returned. Neither a hit nor
+// a miss is trusted as is, the field may have been set behind the index since: the edicts between the
+// start and the hit (or the last edict) whose field differs from the one seen at build time are
+// compared as well, an earlier match among them is returned instead.
+typedef struct findindex_entry_s
+{
+	uint32 hash;
+	int num;
+} findindex_entry_t;
+
+typedef struct findindex_s
+{
+	uint32 generation;		// g_FindIndexGeneration at build time
+	uint32 scanned;			// generation of the last search which scanned instead
+	int numbuckets;			// power of two
+	int *buckets;			// numbuckets + 1 offsets into entries
+	findindex_entry_t *entries;
+	findindex_entry_t *scratch;
+	string_t *values;		// field of every edict at build time, 0 for free ones
+	int numvalues;
+	int maxentries;
+} findindex_t;
+
+uint32 g_FindIndexGeneration = 1;
+findindex_t *g_FindIndex[sizeof(entvars_t) / sizeof(string_t)];
+
+void ED_InvalidateFindIndex(void)
+{
+	g_FindIndexGeneration++;
+}
+
+void ED_FreeFindIndex(void)
+{
+	for (int i = 0; i < ARRAYSIZE(g_FindIndex); i++)
+	{
+		findindex_t *index = g_FindIndex[i];
+		if (!index)
+			continue;
+
+		Mem_Free(index->buckets);
+		Mem_Free(index->entries);
+		Mem_Free(index->scratch);
+		Mem_Free(index->values);
+		Mem_Free(index);
+		g_FindIndex[i] = NULL;
+	}
+}
+
+static inline const char *PF_FindFieldString(edict_t *ed, int iFieldToMatch)
+{
+	string_t s = *(string_t *)((size_t)&ed->v + iFieldToMatch);
+	return s ? &pr_strings[s] : NULL;
+}
+
+static inline uint32 PF_FindHash(const char *s)
+{
+	uint32 hash = 2166136261u;
+	while (*s)
+	{
+		hash ^= (uint8)*s++;
+		hash *= 16777619u;
+	}
+
+	return hash;
+}
+
+static void PF_BuildFindIndex(findindex_t *index, int iFieldToMatch)
+{
+	int numbuckets = 64;
+	while (numbuckets < g_psv.num_edicts)
+		numbuckets <<= 1;
+
+	if (index->numbuckets != numbuckets)
+	{
+		index->numbuckets = numbuckets;
+		index->buckets = (int *)Mem_Realloc(index->buckets, (numbuckets + 1) * sizeof(int));
+	}
+
+	if (index->maxentries < g_psv.num_edicts)
+	{
+		index->maxentries = g_psv.max_edicts;
+		index->entries = (findindex_entry_t *)Mem_Realloc(index->entries, index->maxentries * sizeof(findindex_entry_t));
+		index->scratch = (findindex_entry_t *)Mem_Realloc(index->scratch, index->maxentries * sizeof(findindex_entry_t));
+		index->values = (string_t *)Mem_Realloc(index->values, index->maxentries * sizeof(string_t));
+	}
+
+	// counting sort by bucket, edicts stay in ascending order inside each one
+	Q_memset(index->buckets, 0, (numbuckets + 1) * sizeof(int));
+
+	int numentries = 0;
+	for (int e = 0; e < g_psv.num_edicts; e++)
+	{
+		edict_t *ed = &g_psv.edicts[e];
+		const char *s = PF_FindFieldString(ed, iFieldToMatch);
+		index->values[e] = ed->free ? 0 : *(string_t *)((size_t)&ed->v + iFieldToMatch);
+		if (ed->free || !s)
+			continue;
+
+		uint32 hash = PF_FindHash(s);
+		index->scratch[numentries].hash = hash;
+		index->scratch[numentries].num = e;
+		index->buckets[(hash & (numbuckets - 1)) + 1]++;
+		numentries++;
+	}
+
+	for (int i = 0; i < numbuckets; i++)
+		index->buckets[i + 1] += index->buckets[i];
+
+	// scatter with the bucket starts as cursors, each one ends up at the start of the next bucket
+	for (int i = 0; i < numentries; i++)
+		index->entries[index->buckets[index->scratch[i].hash & (numbuckets - 1)]++] = index->scratch[i];
+
+	for (int i = numbuckets; i > 0; i--)
+		index->buckets[i] = index->buckets[i - 1];
+
+	index->buckets[0] = 0;
+	index->numvalues = g_psv.num_edicts;
+	index->generation = g_FindIndexGeneration;
+}
+
+// Returns the index of the field if it is current, NULL if the caller has to scan
+static findindex_t *PF_GetFindIndex(int iFieldToMatch)
+{
+	if (iFieldToMatch < 0 || iFieldToMatch >= (int)sizeof(entvars_t) || (iFieldToMatch % sizeof(string_t)) != 0)
+		return NULL;
+
+	findindex_t *&index = g_FindIndex[iFieldToMatch / sizeof(string_t)];
+	if (!index)
+		index = (findindex_t *)Mem_ZeroMalloc(sizeof(findindex_t));
+
+	if (index->generation == g_FindIndexGeneration)
+		return index;
+
+	if (index->scanned != g_FindIndexGeneration)
+	{
+		// first search since the last change
+		index->scanned = g_FindIndexGeneration;
+		return NULL;
+	}
+
+	PF_BuildFindIndex(index, iFieldToMatch);
+	return index;
+}
+
+// First edict in (eStartSearchAfter, eEnd) matching the value whose field was changed since the build
+static edict_t *PF_FindWrittenBefore(findindex_t *index, int eStartSearchAfter, int eEnd, int iFieldToMatch, const char *szValueToFind)
+{
+	for (int e = eStartSearchAfter + 1; e < eEnd; e++)
+	{
+		edict_t *ed = &g_psv.edicts[e];
+		if (ed->free)
+			continue;
+
+		string_t value = *(string_t *)((size_t)&ed->v + iFieldToMatch);
+		if (e < index->numvalues && value == index->values[e])
+			continue;
+
+		if (value && !Q_strcmp(&pr_strings[value], szValueToFind))
+			return ed;
+	}
+
+	return NULL;
+}
+
+static edict_t *PF_FindIndexed(findindex_t *index, int eStartSearchAfter, int iFieldToMatch, const char *szValueToFind)
+{
+	uint32 hash = PF_FindHash(szValueToFind);
+	int bucket = hash & (index->numbuckets - 1);
+	int lo = index->buckets[bucket];
+	int hi = index->buckets[bucket + 1];
+
+	// first entry after the start edict
+	while (lo < hi)
+	{
+		int mid = (lo + hi) / 2;
+		if (index->entries[mid].num <= eStartSearchAfter)
+			lo = mid + 1;
+		else
+			hi = mid;
+	}
+
+	for (int i = lo; i < index->buckets[bucket + 1]; i++)
+	{
+		findindex_entry_t *entry = &index->entries[i];
+		if (entry->hash != hash || entry->num >= g_psv.num_edicts)
+			continue;
+
+		edict_t *ed = &g_psv.edicts[entry->num];
+		const char *s = PF_FindFieldString(ed, iFieldToMatch);
+		if (ed->free || !s || Q_strcmp(s, szValueToFind))
+			continue;
+
+		// an edict before the hit may have been set to the value behind the index
+		edict_t *written = PF_FindWrittenBefore(index, eStartSearchAfter, entry->num, iFieldToMatch, szValueToFind);
+		if (written)
+		{
+			ED_InvalidateFindIndex();
+			return written;
+		}
+
+		return ed;
+	}
+
+	return NULL;
+}
+#endif // REHLDS_FIXES
+
 edict_t* EXT_FUNC PF_find_Shared(int eStartSearchAfter, int iFieldToMatch, const char *szValueToFind)
 {
+#ifdef REHLDS_FIXES
+	if (sv_rehlds_find_index.value != 0.0f)
+	{
+		findindex_t *index = PF_GetFindIndex(iFieldToMatch);
+		if (index)
+		{
+			edict_t *ed = PF_FindIndexed(index, eStartSearchAfter, iFieldToMatch, szValueToFind);
+			if (ed)
+				return ed;
+
+			// only the fields written since the build can hold the value now
+			ed = PF_FindWrittenBefore(index, eStartSearchAfter, g_psv.num_edicts, iFieldToMatch, szValueToFind);
+			if (ed)
+			{
+				ED_InvalidateFindIndex();
+				return ed;
+			}
+
+			return &g_psv.edicts[0];
+		}
+	}
+#endif // REHLDS_FIXES
+
 	for (int e = eStartSearchAfter + 1; e < g_psv.num_edicts; e++)
 	{
 		edict_t* ed = &g_psv.edicts[e];
@@ -2129,6 +2374,10 @@ void EXT_FUNC PF_MessageEnd_I(void)
 	if (gMsgBuffer.flags & SIZEBUF_OVERFLOWED)
 		Sys_Error("%s: called, but message buffer from .dll had overflowed\n", __func__);
 
+#ifdef REHLDS_FIXES
+	SV_CountMsg(gMsgType, gMsgDest);
+#endif
+
 // With `REHLDS_FIXES` enabled meaning of `svc_startofusermessages` changed a bit: now it is an id of the first user message
 #ifdef REHLDS_FIXES
 	if (gMsgType >= svc_startofusermessages)
@@ -2136,16 +2385,7 @@ void EXT_FUNC PF_MessageEnd_I(void)
 	if (gMsgType > svc_startofusermessages)
 #endif // REHLDS_FIXES
 	{
-		UserMsg* pUserMsg = sv_gpUserMsgs;
-		while (pUserMsg && pUserMsg->iMsg != gMsgType)
-			pUserMsg = pUserMsg->next;
-
-		if (!pUserMsg && gMsgDest == MSG_INIT)
-		{
-			pUserMsg = sv_gpNewUserMsgs;
-			while (pUserMsg && pUserMsg->iMsg != gMsgType)
-				pUserMsg = pUserMsg->next;
-		}
+		UserMsg* pUserMsg = SV_FindUserMsg(gMsgType, gMsgDest == MSG_INIT);
 
 		if (!pUserMsg)
 		{
@@ -2195,6 +2435,9 @@ void EXT_FUNC PF_MessageEnd_I(void)
 		if (MsgIsVarLength)
 			MSG_WriteByte(pBuffer, gMsgBuffer.cursize);
 		MSG_WriteBuf(pBuffer, gMsgBuffer.cursize, gMsgBuffer.data);
+#ifdef REHLDS_FIXES
+		SV_CountMsgBytes(gMsgType, (MsgIsVarLength ? 2 : 1) + gMsgBuffer.cursize);
+#endif
 	}
 #ifdef REHLDS_FIXES
 	;
@@ -2614,7 +2857,12 @@ void EXT_FUNC PF_SetPhysicsKeyValue(const edict_t *pClient, const char *key, con
 
 int EXT_FUNC PF_GetCurrentPlayer(void)
 {
+#ifdef REHLDS_FIXES
+	// conditional encoders run on the snapshot workers, host_client is the main thread's
+	int idx = SV_QueryCurrentPlayer() - g_psvs.clients;
+#else // REHLDS_FIXES
 	int idx = host_client - g_psvs.clients;
+#endif // REHLDS_FIXES
 	if (idx < 0 || idx >= g_psvs.maxclients)
 		return -1;
 
@@ -2685,6 +2933,11 @@ void EXT_FUNC PF_ForceUnmodified(FORCE_TYPE type, float *mins, float *maxs, cons
 
 		cnode->check_type = type;
 		cnode->filename = (char *)filename;
+#ifdef REHLDS_FIXES
+		// hashed in the background while the map loads, SV_TransferConsistencyInfo picks the result up
+		if (sv_rehlds_md5_cache.value >= 2.0f)
+			SV_MD5CacheQueueResource(filename);
+#endif // REHLDS_FIXES
 		if (mins)
 		{
 			cnode->mins[0] = mins[0];
@@ -114,6 +114,10 @@ edict_t *PF_Spawn_I(void);
 edict_t *CreateNamedEntity(int className);
 void PF_Remove_I(edict_t *ed);
 void PF_Remove_I_internal(edict_t *ed);
+#ifdef REHLDS_FIXES
+void ED_InvalidateFindIndex(void);
+void ED_FreeFindIndex(void);
+#endif
 edict_t *PF_find_Shared(int eStartSearchAfter, int iFieldToMatch, const char *szValueToFind);
 int iGetIndex(const char *pszField);
 edict_t *FindEntityByString(edict_t *pEdictStartSearchAfter, const char *pszField, const char *pszValue);
@@ -28,12 +28,230 @@
 
 #include "precompiled.h"
 
+#ifdef REHLDS_FIXES
+// Edict free list (sv_rehlds_edict_freelist).
+// Freed edicts wait in a queue ordered by freetime until they may be reused, then they get a bit in the
+// ready set. ED_Alloc takes the lowest ready edict, which is the one the scan would have found.
+// Queue entries of edicts which got reused and freed again meanwhile are recognized by their freetime.
+typedef struct edfreelist_entry_s
+{
+	int num;
+	float freetime;
+} edfreelist_entry_t;
+
+typedef struct edfreelist_s
+{
+	qboolean valid;
+	int maxedicts;
+	uint32 *ready;				// a bit per edict
+	edfreelist_entry_t *cooling;	// ordered by freetime, entries before head are done
+	int head;
+	int count;
+	int capacity;
+} edfreelist_t;
+
+edfreelist_t g_EdFreeList;
+
+static inline qboolean ED_CanReuse(edict_t *e)
+{
+	return (e->freetime <= 2.0 || g_psv.time - e->freetime >= 0.5) ? TRUE : FALSE;
+}
+
+static void ED_FreeListSetReady(int num, qboolean ready)
+{
+	if (ready)
+		g_EdFreeList.ready[num >> 5] |= 1u << (num & 31);
+	else
+		g_EdFreeList.ready[num >> 5] &= ~(1u << (num & 31));
+}
+
+static void ED_FreeListPush(edict_t *e)
+{
+	edfreelist_t *fl = &g_EdFreeList;
+	int num = e - g_psv.edicts;
+
+	if (num <= g_psvs.maxclients)
+		return;
+
+	if (ED_CanReuse(e))
+	{
+		ED_FreeListSetReady(num, TRUE);
+		return;
+	}
+
+	if (fl->count >= fl->capacity)
+	{
+		if (fl->head)
+		{
+			Q_memmove(fl->cooling, &fl->cooling[fl->head], (fl->count - fl->head) * sizeof(edfreelist_entry_t));
+			fl->count -= fl->head;
+			fl->head = 0;
+		}
+		else
+		{
+			fl->capacity = fl->capacity ? fl->capacity * 2 : 256;
+			fl->cooling = (edfreelist_entry_t *)Mem_Realloc(fl->cooling, fl->capacity * sizeof(edfreelist_entry_t));
+		}
+	}
+
+	// freetime is the current time nearly always, so this stops at the tail
+	int i = fl->count++;
+	while (i > fl->head && fl->cooling[i - 1].freetime > e->freetime)
+	{
+		fl->cooling[i] = fl->cooling[i - 1];
+		i--;
+	}
+
+	fl->cooling[i].num = num;
+	fl->cooling[i].freetime = e->freetime;
+}
+
+static void ED_FreeListBuild(void)
+{
+	edfreelist_t *fl = &g_EdFreeList;
+
+	if (fl->maxedicts != g_psv.max_edicts)
+	{
+		if (fl->ready)
+			Mem_Free(fl->ready);
+
+		fl->maxedicts = g_psv.max_edicts;
+		fl->ready = (uint32 *)Mem_Malloc(((fl->maxedicts + 31) >> 5) * sizeof(uint32));
+	}
+
+	Q_memset(fl->ready, 0, ((fl->maxedicts + 31) >> 5) * sizeof(uint32));
+	fl->head = 0;
+	fl->count = 0;
+
+	for (int i = g_psvs.maxclients + 1; i < g_psv.num_edicts; i++)
+	{
+		if (g_psv.edicts[i].free)
+			ED_FreeListPush(&g_psv.edicts[i]);
+	}
+
+	fl->valid = TRUE;
+}
+
+void ED_FreeListInvalidate(void)
+{
+	g_EdFreeList.valid = FALSE;
+}
+
+void ED_FreeListShutdown(void)
+{
+	if (g_EdFreeList.ready)
+		Mem_Free(g_EdFreeList.ready);
+
+	if (g_EdFreeList.cooling)
+		Mem_Free(g_EdFreeList.cooling);
+
+	Q_memset(&g_EdFreeList, 0, sizeof(g_EdFreeList));
+}
+
+static qboolean ED_FreeListUsable(void)
+{
+	if (sv_rehlds_edict_freelist.value == 0.0f || !g_psv.edicts)
+	{
+		g_EdFreeList.valid = FALSE;
+		return FALSE;
+	}
+
+	if (!g_EdFreeList.valid)
+		ED_FreeListBuild();
+
+	return TRUE;
+}
+
+// Returns the lowest edict that may be reused, NULL if a new one has to be taken
+static edict_t *ED_FreeListTake(void)
+{
+	edfreelist_t *fl = &g_EdFreeList;
+
+	while (fl->head < fl->count)
+	{
+		edfreelist_entry_t *entry = &fl->cooling[fl->head];
+		edict_t *e = &g_psv.edicts[entry->num];
+
+		if (e->free && e->freetime == entry->freetime)
+		{
+			if (!ED_CanReuse(e))
+				break;
+
+			ED_FreeListSetReady(entry->num, TRUE);
+		}
+
+		fl->head++;
+	}
+
+	if (fl->head == fl->count)
+		fl->head = fl->count = 0;
+
+	int first = g_psvs.maxclients + 1;
+	int numwords = (g_psv.num_edicts + 31) >> 5;
+	for (int w = first >> 5; w < numwords; w++)
+	{
+		uint32 bits = fl->ready[w];
+		if (w == (first >> 5))
+			bits &= ~0u << (first & 31);
+
+		while (bits)
+		{
+			int num = w << 5;
+			while (!(bits & (1u << (num & 31))))
+				num++;
+
+			bits &= bits - 1;
+
+			if (num >= g_psv.num_edicts)
+				return NULL;
+
+			// set free by hand in between, leave it to the scan's rules
+			edict_t *e = &g_psv.edicts[num];
+			if (!e->free)
+			{
+				ED_FreeListSetReady(num, FALSE);
+				continue;
+			}
+
+			return e;
+		}
+	}
+
+	return NULL;
+}
+
+void ED_PrintStats_f(void)
+{
+	int live = 0, reusable = 0, cooling = 0;
+
+	for (int i = 0; i < g_psv.num_edicts; i++)
+	{
+		edict_t *e = &g_psv.edicts[i];
+		if (!e->free)
+			live++;
+		else if (i > g_psvs.maxclients && !ED_CanReuse(e))
+			cooling++;
+		else
+			reusable++;
+	}
+
+	Con_Printf("Edicts: %i live, %i free, %i cooling down, %i of %i allocated\n", live, reusable, cooling, g_psv.num_edicts, g_psv.max_edicts);
+}
+#endif // REHLDS_FIXES
+
 void ED_ClearEdict(edict_t *e)
 {
 	Q_memset(&e->v, 0, sizeof(e->v));
 	e->free = FALSE;
 	ReleaseEntityDLLFields(e);
 	InitEntityDLLFields(e);
+#ifdef REHLDS_FIXES
+	ED_InvalidateFindIndex();
+	SV_SphereGridUpdate(e);
+
+	if (g_EdFreeList.valid)
+		ED_FreeListSetReady(e - g_psv.edicts, FALSE);
+#endif
 }
 
 edict_t *ED_Alloc(void)
@@ -41,6 +259,26 @@ edict_t *ED_Alloc(void)
 	int i;
 	edict_t *e;
 
+#ifdef REHLDS_FIXES
+	qboolean scan = TRUE;
+
+	if (ED_FreeListUsable())
+	{
+		e = ED_FreeListTake();
+		if (e)
+		{
+			ED_ClearEdict(e);
+			return e;
+		}
+
+		// nothing to reuse, skip the scan while a new one can be taken.
+		// Edicts set free without ED_Free aren't in the list, so the scan still looks for them when all are used
+		i = g_psv.num_edicts;
+		scan = (i >= g_psv.max_edicts);
+	}
+
+	if (scan)
+#endif
 	// Search for free entity
 	for (i = g_psvs.maxclients + 1; i < g_psv.num_edicts; i++)
 	{
@@ -79,6 +317,10 @@ void ED_Free(edict_t *ed)
 		ed->serialnumber++;
 		ed->freetime = (float)g_psv.time;
 		ed->free = TRUE;
+#ifdef REHLDS_FIXES
+		if (g_EdFreeList.valid)
+			ED_FreeListPush(ed);
+#endif
 		ed->v.flags = 0;
 		ed->v.model = 0;
 
@@ -137,6 +379,7 @@ char *ED_NewString(const char *string)
 
 	// escaping is done inside Ed_StrPool_Alloc()
 	new_s = Ed_StrPool_Alloc(string);
+	ED_InvalidateFindIndex();
 
 #else // REHLDS_FIXES
 
@@ -314,6 +557,10 @@ char *ED_ParseEdict(char *data, edict_t *ent)
 	{
 		ent->free = 1;
 		ent->serialnumber++;
+#ifdef REHLDS_FIXES
+		if (g_EdFreeList.valid)
+			ED_FreeListPush(ent);
+#endif
 	}
 	return data;
 }
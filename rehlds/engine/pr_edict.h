@@ -37,6 +37,11 @@ void ED_ClearEdict(edict_t *e);
 edict_t *ED_Alloc(void);
 void ED_Free(edict_t *ed);
 NOXREF void ED_Count(void);
+#ifdef REHLDS_FIXES
+void ED_FreeListInvalidate(void);
+void ED_FreeListShutdown(void);
+void ED_PrintStats_f(void);
+#endif
 char *ED_NewString(const char *string);
 char *ED_ParseEdict(char *data, edict_t *ent);
 void ED_LoadFromFile(char *data);
@@ -263,8 +263,22 @@ typedef struct deltacallback_s
 	int newblindex;
 	qboolean full;
 	int offset;
+	bf_write_t *writer;
 } deltacallback_t;
 
+#ifdef REHLDS_FIXES
+// Client datagram which packet entities are encoded by the worker pool
+typedef struct sv_snapshot_s
+{
+	client_t *client;
+	packet_entities_t *pack;
+	qboolean sendping;
+	int entitiesstart;
+	sizebuf_t msg;
+	unsigned char buf[MAX_DATAGRAM];
+} sv_snapshot_t;
+#endif
+
 extern char *pr_strings;
 extern char *gNullString;
 extern qboolean scr_skipupdate;
@@ -377,7 +391,26 @@ extern cvar_t sv_rehlds_userinfo_transmitted_fields;
 extern cvar_t sv_rehlds_attachedentities_playeranimationspeed_fix;
 extern cvar_t sv_rehlds_local_gametime;
 extern cvar_t sv_rehlds_send_mapcycle;
+extern cvar_t sv_rehlds_parallel_snapshots;
+extern cvar_t sv_rehlds_visibility_cache;
+extern cvar_t sv_rehlds_delta_cache;
+extern cvar_t sv_rehlds_trace_index;
+extern cvar_t sv_rehlds_unlag_batch;
+extern cvar_t sv_rehlds_ban_index;
+extern cvar_t sv_rehlds_client_hash;
+extern cvar_t sv_rehlds_find_index;
+extern cvar_t sv_rehlds_sphere_index;
+extern cvar_t sv_rehlds_edict_freelist;
+extern cvar_t sv_rehlds_msg_stats;
+extern cvar_t sv_rehlds_profile;
+extern cvar_t sv_rehlds_batch_projectiles;
+extern cvar_t sv_rehlds_pas_cache;
+extern cvar_t sv_rehlds_pas_threads;
+extern cvar_t sv_rehlds_model_cache;
+extern cvar_t sv_rehlds_md5_cache;
 extern cvar_t sv_usercmd_custom_random_seed;
+
+extern qboolean g_bSnapshotEncodersThreadSafe;
 #endif
 extern int sv_playermodel;
 
@@ -437,6 +470,9 @@ extern challenge_t g_rg_sv_challenges[MAX_CHALLENGES];
 extern rcon_failure_t g_rgRconFailures[32];
 extern deltacallback_t g_svdeltacallback;
 
+// per thread state of the snapshot encoding, only defined with REHLDS_FIXES
+typedef struct sv_snapshot_worker_s sv_snapshot_worker_t;
+
 delta_t *SV_LookupDelta(char *name);
 NOXREF void SV_DownloadingModules(void);
 void SV_GatherStatistics(void);
@@ -484,6 +520,12 @@ void SV_RejectConnection(netadr_t *adr, char *fmt, ...);
 void SV_RejectConnectionForPassword(netadr_t *adr);
 int SV_GetFragmentSize(void *state);
 qboolean SV_FilterUser(USERID_t *userid);
+#ifdef REHLDS_FIXES
+void SV_InvalidateBanIndex(void);
+void SV_FreeBanIndex(void);
+qboolean SV_BanIndexMatchIP(const uint8 *ip);
+qboolean SV_BanIndexMatchUser(USERID_t *userid);
+#endif
 int SV_CheckProtocol(netadr_t *adr, int nProtocol);
 int SV_CheckProtocol_internal(netadr_t *adr, int nProtocol);
 bool SV_CheckChallenge_api(const netadr_t &adr, int nChallengeValue);
@@ -531,6 +573,13 @@ void SV_ConnectionlessPacket(void);
 void SV_CheckRate(client_t *cl);
 void SV_ProcessFile(client_t *cl, char *filename);
 qboolean SV_FilterPacket(void);
+#ifdef REHLDS_FIXES
+void SV_ClientHashInsert(client_t *cl);
+void SV_ClientHashRemove(client_t *cl);
+client_t *SV_ClientHashLookup(void);
+void SV_PrintClientHashStats(void);
+#endif
+void SV_ProcessClientPacket(client_t *cl);
 void SV_SendBan(void);
 void SV_ReadPackets(void);
 void SV_CheckTimeouts(void);
@@ -546,21 +595,51 @@ unsigned char *SV_FatPAS(float *org);
 int SV_PointLeafnum(vec_t *p);
 void TRACE_DELTA(char *fmt, ...);
 void SV_SetCallback(int num, qboolean remove, qboolean custom, int *numbase, qboolean full, int offset);
+void SV_SetCallbackTo(deltacallback_t *cb, int num, qboolean remove, qboolean custom, int *numbase, qboolean full, int offset);
 void SV_SetNewInfo(int newblindex);
-void SV_WriteDeltaHeader(int num, qboolean remove, qboolean custom, int *numbase, qboolean newbl, int newblindex, qboolean full, int offset);
+void SV_SetNewInfoTo(deltacallback_t *cb, int newblindex);
+void SV_WriteDeltaHeader(bf_write_t *bw, int num, qboolean remove, qboolean custom, int *numbase, qboolean newbl, int newblindex, qboolean full, int offset);
 void SV_InvokeCallback(void);
-int SV_FindBestBaseline(int index, entity_state_t ** baseline, entity_state_t *to, int num, qboolean custom);
+void SV_InvokeCallbackTo(void *ctx);
+int SV_FindBestBaseline(sv_snapshot_worker_t *worker, int index, entity_state_t ** baseline, entity_state_t *to, int num, qboolean custom);
+#ifdef REHLDS_FIXES
+void SV_ClearDeltaCache(void);
+void SV_FreeDeltaCache(void);
+void SV_InvokeCallbackCapture(void *ctx);
+void SV_WriteEntityDelta(sv_snapshot_worker_t *worker, bf_write_t *bw, int num, qboolean custom, entity_state_t *from, entity_state_t *to, qboolean force, delta_t *delta, uint64 *pForceMask, uint64 *pForceMaskOut);
+#endif
 int SV_CreatePacketEntities(sv_delta_t type, client_t *client, packet_entities_t *to, sizebuf_t *msg);
 int SV_CreatePacketEntities_internal(sv_delta_t type, client_t *client, packet_entities_t *to, sizebuf_t *msg);
+int SV_CreatePacketEntitiesTo(sv_snapshot_worker_t *worker, bf_write_t *bw, sv_delta_t type, client_t *client, packet_entities_t *to, sizebuf_t *msg);
 void SV_EmitPacketEntities(client_t *client, packet_entities_t *to, sizebuf_t *msg);
 qboolean SV_ShouldUpdatePing(client_t *client);
 NOXREF qboolean SV_HasEventsInQueue(client_t *client);
 void SV_GetNetInfo(client_t *client, int *ping, int *packet_loss);
 int SV_CheckVisibility(edict_t *entity, unsigned char *pset);
 void SV_EmitPings(client_t *client, sizebuf_t *msg);
+#ifdef REHLDS_FIXES
+void SV_ClearVisibilityCache(void);
+void SV_FreeVisibilityCache(void);
+void SV_BuildTransmitList(void);
+struct sv_visset_s *SV_GetVisibilitySet(unsigned char *pset);
+#endif
+packet_entities_t *SV_SetupPacketEntities(client_t *client);
 void SV_WriteEntitiesToClient(client_t *client, sizebuf_t *msg);
 void SV_CleanupEnts(void);
+void SV_WriteClientDatagramHeader(client_t *client, sizebuf_t *msg);
+void SV_TransmitClientDatagram(client_t *client, sizebuf_t *msg);
 qboolean SV_SendClientDatagram(client_t *client);
+delta_t *SV_SnapshotDelta(sv_snapshot_worker_t *worker, delta_t *delta);
+#ifdef REHLDS_FIXES
+void SV_SnapshotLockedEncoder(delta_t *pFields, const unsigned char *from, const unsigned char *to);
+client_t *SV_QueryCurrentPlayer(void);
+void SV_SyncSnapshotWorkers(int numWorkers);
+void SV_EmitPacketEntitiesJob(int index, int worker, void *ctx);
+void SV_EmitPacketEntitiesParallel(sv_snapshot_t *snapshots, int count);
+void SV_ShutdownSnapshotWorkers(void);
+void SV_SendClientDatagramsParallel(client_t **clients, int count);
+qboolean SV_ShouldSendClientDatagramsParallel(int count);
+#endif
 void SV_UpdateUserInfo(client_t *client);
 void SV_UpdateToReliableMessages(void);
 void SV_SkipUpdates(void);
@@ -587,6 +666,21 @@ int SV_SpawnServer(qboolean bIsDemo, char *server, char *startspot);
 void SV_LoadEntities(void);
 void SV_ClearEntities(void);
 int RegUserMsg(const char *pszName, int iSize);
+#ifdef REHLDS_OPT_PEDANTIC
+void SV_IndexUserMsgs(UserMsg *pMsgs);
+#endif
+UserMsg *SV_FindUserMsg(int iMsg, qboolean bSearchNew);
+#ifdef REHLDS_FIXES
+struct msgstats_t;
+msgstats_t *SV_GetMsgStats(int iMsg);
+void SV_ResetMsgStats(void);
+void SV_CountMsg(int iMsg, int iDest);
+void SV_CountMsgBytes(int iMsg, int bytes);
+void SV_CountDatagramBytes(int svc, int bytes);
+void SV_CountDatagramSection(sizebuf_t *msg, int start);
+void SV_MsgStats_f(void);
+void SV_Profile_f(void);
+#endif
 qboolean StringToFilter(const char *s, ipfilter_t *f);
 USERID_t *SV_StringToUserID(const char *str);
 void SV_BanId_f(void);
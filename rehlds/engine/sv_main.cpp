@@ -208,6 +208,23 @@ cvar_t sv_rehlds_attachedentities_playeranimationspeed_fix = {"sv_rehlds_attache
 cvar_t sv_rehlds_local_gametime = {"sv_rehlds_local_gametime", "0", 0, 0.0f, nullptr};
 cvar_t sv_rehlds_send_mapcycle = { "sv_rehlds_send_mapcycle", "0", 0, 0.0f, nullptr };
 cvar_t sv_rehlds_maxclients_from_single_ip = { "sv_rehlds_maxclients_from_single_ip", "5", 0, 5.0f, nullptr };
+cvar_t sv_rehlds_parallel_snapshots = { "sv_rehlds_parallel_snapshots", "0", 0, 0.0f, nullptr };
+cvar_t sv_rehlds_visibility_cache = { "sv_rehlds_visibility_cache", "0", 0, 0.0f, nullptr };
+cvar_t sv_rehlds_delta_cache = { "sv_rehlds_delta_cache", "0", 0, 0.0f, nullptr };
+cvar_t sv_rehlds_trace_index = { "sv_rehlds_trace_index", "0", 0, 0.0f, nullptr };
+cvar_t sv_rehlds_unlag_batch = { "sv_rehlds_unlag_batch", "0", 0, 0.0f, nullptr };
+cvar_t sv_rehlds_ban_index = { "sv_rehlds_ban_index", "0", 0, 0.0f, nullptr };
+cvar_t sv_rehlds_client_hash = { "sv_rehlds_client_hash", "0", 0, 0.0f, nullptr };
+cvar_t sv_rehlds_find_index = { "sv_rehlds_find_index", "0", 0, 0.0f, nullptr };
+cvar_t sv_rehlds_sphere_index = { "sv_rehlds_sphere_index", "0", 0, 0.0f, nullptr };
+cvar_t sv_rehlds_edict_freelist = { "sv_rehlds_edict_freelist", "0", 0, 0.0f, nullptr };
+cvar_t sv_rehlds_msg_stats = { "sv_rehlds_msg_stats", "0", 0, 0.0f, nullptr };
+cvar_t sv_rehlds_profile = { "sv_rehlds_profile", "0", 0, 0.0f, nullptr };
+cvar_t sv_rehlds_batch_projectiles = { "sv_rehlds_batch_projectiles", "0", 0, 0.0f, nullptr };
+cvar_t sv_rehlds_pas_cache = { "sv_rehlds_pas_cache", "0", 0, 0.0f, nullptr };
+cvar_t sv_rehlds_pas_threads = { "sv_rehlds_pas_threads", "0", 0, 0.0f, nullptr };
+cvar_t sv_rehlds_model_cache = { "sv_rehlds_model_cache", "0", 0, 0.0f, nullptr };
+cvar_t sv_rehlds_md5_cache = { "sv_rehlds_md5_cache", "0", 0, 0.0f, nullptr };
 cvar_t sv_use_entity_file = { "sv_use_entity_file", "0", 0, 0.0f, nullptr };
 cvar_t sv_usercmd_custom_random_seed = { "sv_usercmd_custom_random_seed", "0", 0, 0.0f, nullptr };
 #endif
@@ -1738,8 +1755,332 @@ int SV_GetFragmentSize(void *state)
 	return size;
 }
 
+#ifdef REHLDS_FIXES
+// Ban list index (sv_rehlds_ban_index).
+// ipfilters[] and userfilters[] stay the lists the console commands work on, so addip, removeip, writeip
+// and the slot numbers of listid/removeid behave as before. Lookups go through an index rebuilt from
+// them after every change: a path compressed binary trie over the ip prefixes and an open addressed
+// hash of the user ids. Masks which are not a prefix (addip 0.0.0.5 gives 0.0.0.255) are kept in a short
+// list and scanned. Timed bans are dropped when the earliest end time has passed, not on every lookup.
+const int BANINDEX_MIN_USERSLOTS = 64;	// power of two
+
+typedef struct banindex_node_s
+{
+	uint32 key;			// prefix in host order, most significant bit first
+	int bits;			// prefix length
+	qboolean term;		// some filter ends on this node
+	int child[2];		// -1 if none
+} banindex_node_t;
+
+typedef struct banindex_s
+{
+	qboolean dirty;
+	double ipexpire;	// earliest end time in ipfilters[], 0 if all are permanent
+	double userexpire;
+
+	banindex_node_t *nodes;
+	int numnodes;
+	int maxnodes;
+	int *oddfilters;
+	int numoddfilters;
+	int maxoddfilters;
+
+	uint32 *userhashes;
+	int *userslots;		// -1 if empty
+	int numuserslots;
+} banindex_t;
+
+banindex_t g_BanIndex = { TRUE };
+
+void SV_InvalidateBanIndex(void)
+{
+	g_BanIndex.dirty = TRUE;
+}
+
+void SV_FreeBanIndex(void)
+{
+	if (g_BanIndex.nodes)
+		Mem_Free(g_BanIndex.nodes);
+	if (g_BanIndex.oddfilters)
+		Mem_Free(g_BanIndex.oddfilters);
+	if (g_BanIndex.userhashes)
+		Mem_Free(g_BanIndex.userhashes);
+	if (g_BanIndex.userslots)
+		Mem_Free(g_BanIndex.userslots);
+
+	Q_memset(&g_BanIndex, 0, sizeof(g_BanIndex));
+	g_BanIndex.dirty = TRUE;
+}
+
+static inline uint32 SV_BanIndexKey(const void *addr)
+{
+	const uint8 *b = (const uint8 *)addr;
+	return (b[0] << 24) | (b[1] << 16) | (b[2] << 8) | b[3];
+}
+
+static inline uint32 SV_BanIndexMask(int bits)
+{
+	return bits ? 0xFFFFFFFF << (32 - bits) : 0;
+}
+
+static inline int SV_BanIndexBit(uint32 key, int bit)
+{
+	return (key >> (31 - bit)) & 1;
+}
+
+static int SV_BanIndexNewNode(uint32 key, int bits, qboolean term)
+{
+	banindex_node_t *node = &g_BanIndex.nodes[g_BanIndex.numnodes];
+	node->key = key;
+	node->bits = bits;
+	node->term = term;
+	node->child[0] = node->child[1] = -1;
+	return g_BanIndex.numnodes++;
+}
+
+// Every insert adds at most two nodes, the arrays are sized up front
+static void SV_BanIndexInsert(uint32 key, int bits)
+{
+	banindex_node_t *nodes = g_BanIndex.nodes;
+	int n = 0;
+
+	while (nodes[n].bits != bits)
+	{
+		int b = SV_BanIndexBit(key, nodes[n].bits);
+		int c = nodes[n].child[b];
+		if (c == -1)
+		{
+			nodes[n].child[b] = SV_BanIndexNewNode(key, bits, TRUE);
+			return;
+		}
+
+		int maxsame = Q_min(bits, nodes[c].bits);
+		uint32 diff = key ^ nodes[c].key;
+		int same = nodes[n].bits + 1;
+		while (same < maxsame && !SV_BanIndexBit(diff, same))
+			same++;
+
+		if (same == nodes[c].bits)
+		{
+			n = c;
+			continue;
+		}
+
+		// the child goes deeper than the common part, split it
+		int mid = SV_BanIndexNewNode(key & SV_BanIndexMask(same), same, same == bits);
+		nodes[mid].child[SV_BanIndexBit(nodes[c].key, same)] = c;
+		if (same != bits)
+			nodes[mid].child[SV_BanIndexBit(key, same)] = SV_BanIndexNewNode(key, bits, TRUE);
+
+		nodes[n].child[b] = mid;
+		return;
+	}
+
+	nodes[n].term = TRUE;
+}
+
+static uint32 SV_BanIndexUserHash(USERID_t *id)
+{
+	// same string SV_CompareUserID_internal compares, case insensitive
+	const char *s = SV_GetIDString(id);
+	uint32 hash = 2166136261u ^ id->idtype;
+	for (int i = 0; i < 63 && s[i]; i++)
+	{
+		hash ^= (uint8)tolower(s[i]);
+		hash *= 16777619u;
+	}
+
+	return hash;
+}
+
+static void SV_ExpireBans(void)
+{
+	int j = 0;
+	for (int i = 0; i < numipfilters; i++)
+	{
+		ipfilter_t *filter = &ipfilters[i];
+		if (filter->compare.u32 != 0xFFFFFFFF && filter->banEndTime != 0.0f && filter->banEndTime <= realtime)
+			continue;
+
+		if (i != j)
+			ipfilters[j] = *filter;
+		j++;
+	}
+	numipfilters = j;
+
+	j = 0;
+	for (int i = 0; i < numuserfilters; i++)
+	{
+		userfilter_t *filter = &userfilters[i];
+		if (filter->banEndTime != 0.0f && filter->banEndTime <= realtime)
+			continue;
+
+		if (i != j)
+			userfilters[j] = *filter;
+		j++;
+	}
+	numuserfilters = j;
+
+	g_BanIndex.dirty = TRUE;
+}
+
+static void SV_BuildBanIndex(void)
+{
+	banindex_t *idx = &g_BanIndex;
+
+	if (idx->maxnodes < numipfilters * 2 + 1)
+	{
+		idx->maxnodes = numipfilters * 2 + 1;
+		idx->nodes = (banindex_node_t *)Mem_Realloc(idx->nodes, idx->maxnodes * sizeof(banindex_node_t));
+	}
+	if (idx->maxoddfilters < numipfilters)
+	{
+		idx->maxoddfilters = numipfilters;
+		idx->oddfilters = (int *)Mem_Realloc(idx->oddfilters, idx->maxoddfilters * sizeof(int));
+	}
+
+	idx->numnodes = 0;
+	idx->numoddfilters = 0;
+	idx->ipexpire = 0.0;
+	SV_BanIndexNewNode(0, 0, FALSE);
+
+	for (int i = 0; i < numipfilters; i++)
+	{
+		ipfilter_t *filter = &ipfilters[i];
+		if (filter->compare.u32 != 0xFFFFFFFF && filter->banEndTime != 0.0f && (idx->ipexpire == 0.0 || filter->banEndTime < idx->ipexpire))
+			idx->ipexpire = filter->banEndTime;
+
+		// a compare value with bits outside of the mask can't match anything
+		if ((filter->compare.u32 & filter->mask) != filter->compare.u32)
+			continue;
+
+		uint32 mask = SV_BanIndexKey(&filter->mask);
+		if (~mask & (~mask + 1))
+		{
+			idx->oddfilters[idx->numoddfilters++] = i;
+			continue;
+		}
+
+		int bits = 0;
+		while (bits < 32 && SV_BanIndexBit(mask, bits))
+			bits++;
+
+		SV_BanIndexInsert(SV_BanIndexKey(filter->compare.octets), bits);
+	}
+
+	int numslots = BANINDEX_MIN_USERSLOTS;
+	while (numslots < numuserfilters * 2)
+		numslots <<= 1;
+
+	if (idx->numuserslots != numslots)
+	{
+		idx->numuserslots = numslots;
+		idx->userhashes = (uint32 *)Mem_Realloc(idx->userhashes, numslots * sizeof(uint32));
+		idx->userslots = (int *)Mem_Realloc(idx->userslots, numslots * sizeof(int));
+	}
+
+	Q_memset(idx->userslots, -1, numslots * sizeof(int));
+	idx->userexpire = 0.0;
+
+	for (int i = 0; i < numuserfilters; i++)
+	{
+		userfilter_t *filter = &userfilters[i];
+		if (filter->banEndTime != 0.0f && (idx->userexpire == 0.0 || filter->banEndTime < idx->userexpire))
+			idx->userexpire = filter->banEndTime;
+
+		if (filter->userid.idtype != AUTH_IDTYPE_STEAM && filter->userid.idtype != AUTH_IDTYPE_VALVE)
+			continue;
+
+		uint32 hash = SV_BanIndexUserHash(&filter->userid);
+		int slot = hash & (numslots - 1);
+		while (idx->userslots[slot] != -1)
+			slot = (slot + 1) & (numslots - 1);
+
+		idx->userhashes[slot] = hash;
+		idx->userslots[slot] = i;
+	}
+
+	idx->dirty = FALSE;
+}
+
+static void SV_UpdateBanIndex(void)
+{
+	if (g_BanIndex.dirty)
+		SV_BuildBanIndex();
+
+	if ((g_BanIndex.ipexpire != 0.0 && g_BanIndex.ipexpire <= realtime)
+	 || (g_BanIndex.userexpire != 0.0 && g_BanIndex.userexpire <= realtime))
+	{
+		SV_ExpireBans();
+		SV_BuildBanIndex();
+	}
+}
+
+qboolean SV_BanIndexMatchIP(const uint8 *ip)
+{
+	SV_UpdateBanIndex();
+
+	uint32 key = SV_BanIndexKey(ip);
+	banindex_node_t *nodes = g_BanIndex.nodes;
+	int n = 0;
+
+	while (n != -1)
+	{
+		banindex_node_t *node = &nodes[n];
+		if ((key & SV_BanIndexMask(node->bits)) != node->key)
+			break;
+
+		if (node->term)
+			return TRUE;
+
+		if (node->bits == 32)
+			break;
+
+		n = node->child[SV_BanIndexBit(key, node->bits)];
+	}
+
+	for (int i = 0; i < g_BanIndex.numoddfilters; i++)
+	{
+		ipfilter_t *filter = &ipfilters[g_BanIndex.oddfilters[i]];
+		if ((*(uint32 *)ip & filter->mask) == filter->compare.u32)
+			return TRUE;
+	}
+
+	return FALSE;
+}
+
+qboolean SV_BanIndexMatchUser(USERID_t *userid)
+{
+	SV_UpdateBanIndex();
+
+	if (userid->idtype != AUTH_IDTYPE_STEAM && userid->idtype != AUTH_IDTYPE_VALVE)
+		return FALSE;
+
+	int mask = g_BanIndex.numuserslots - 1;
+	uint32 hash = SV_BanIndexUserHash(userid);
+
+	for (int slot = hash & mask; g_BanIndex.userslots[slot] != -1; slot = (slot + 1) & mask)
+	{
+		if (g_BanIndex.userhashes[slot] == hash && SV_CompareUserID_internal(userid, &userfilters[g_BanIndex.userslots[slot]].userid))
+			return TRUE;
+	}
+
+	return FALSE;
+}
+#endif // REHLDS_FIXES
+
 qboolean EXT_FUNC SV_FilterUser(USERID_t *userid)
 {
+#ifdef REHLDS_FIXES
+	if (sv_rehlds_ban_index.value != 0.0f && !g_RehldsHookchains.m_SV_CompareUserID.hasHooks())
+	{
+		if (SV_BanIndexMatchUser(userid))
+			return (qboolean)sv_filterban.value;
+
+		return sv_filterban.value == 0.0f ? TRUE : FALSE;
+	}
+#endif // REHLDS_FIXES
+
 	int j = numuserfilters;
 	for (int i = numuserfilters - 1; i >= 0; i--)
 	{
@@ -2461,6 +2802,9 @@ void EXT_FUNC SV_ConnectClient_internal(void)
 		g_modfuncs.m_pfnConnectClient(nClientSlot);
 
 	Netchan_Setup(NS_SERVER, &host_client->netchan, adr, client - g_psvs.clients, client, SV_GetFragmentSize);
+#ifdef REHLDS_FIXES
+	SV_ClientHashInsert(host_client);
+#endif // REHLDS_FIXES
 	host_client->next_messageinterval = 5.0;
 	host_client->next_messagetime = realtime + 0.05;
 	host_client->delta_sequence = -1;
@@ -3622,6 +3966,16 @@ void SV_ProcessFile(client_t *cl, char *filename)
 
 qboolean SV_FilterPacket(void)
 {
+#ifdef REHLDS_FIXES
+	if (sv_rehlds_ban_index.value != 0.0f)
+	{
+		if (SV_BanIndexMatchIP(net_from.ip))
+			return (int)sv_filterban.value;
+
+		return sv_filterban.value == 0.0f;
+	}
+#endif // REHLDS_FIXES
+
 	for (int i = numipfilters - 1; i >= 0; i--)
 	{
 		ipfilter_t* curFilter = &ipfilters[i];
@@ -3661,6 +4015,189 @@ bool EXT_FUNC NET_GetPacketPreprocessor(uint8* data, unsigned int len, const net
 	return true;
 }
 
+#ifdef REHLDS_FIXES
+// Client lookup by address (sv_rehlds_client_hash).
+// Open addressed map from ip:port to client slot, updated when a client connects or is dropped.
+// Connecting rebuilds the few entries there are, so a slot never has more than one of them.
+// A hit is still checked against the slot, so an entry left behind by a slot reset elsewhere is
+// only a miss. Non-ip addresses (loopback) take the old scan.
+const int CLIENTHASH_SIZE = 256;	// power of two, several times MAX_CLIENTS
+
+typedef struct clienthash_entry_s
+{
+	uint32 ip;
+	uint16 port;
+	int16 slot;		// -1 if empty
+} clienthash_entry_t;
+
+typedef struct clienthash_s
+{
+	clienthash_entry_t entries[CLIENTHASH_SIZE];
+	uint32 unknownpackets;
+	qboolean initialized;
+} clienthash_t;
+
+clienthash_t g_ClientHash;
+
+static inline int SV_ClientHashIndex(uint32 ip, uint16 port)
+{
+	uint32 hash = (ip ^ (port * 0x9E3779B1)) * 0x85EBCA6B;
+	return (hash >> 16) & (CLIENTHASH_SIZE - 1);
+}
+
+static clienthash_entry_t *SV_ClientHashFind(uint32 ip, uint16 port)
+{
+	int i = SV_ClientHashIndex(ip, port);
+	while (g_ClientHash.entries[i].slot != -1)
+	{
+		clienthash_entry_t *entry = &g_ClientHash.entries[i];
+		if (entry->ip == ip && entry->port == port)
+			return entry;
+
+		i = (i + 1) & (CLIENTHASH_SIZE - 1);
+	}
+
+	return NULL;
+}
+
+static void SV_ClientHashInit(void)
+{
+	for (int i = 0; i < CLIENTHASH_SIZE; i++)
+		g_ClientHash.entries[i].slot = -1;
+
+	g_ClientHash.initialized = TRUE;
+}
+
+void SV_ClientHashRemove(client_t *cl)
+{
+	netadr_t *adr = &cl->netchan.remote_address;
+	if (!g_ClientHash.initialized || adr->type != NA_IP)
+		return;
+
+	int i = SV_ClientHashIndex(*(uint32 *)adr->ip, adr->port);
+	while (g_ClientHash.entries[i].slot != -1)
+	{
+		clienthash_entry_t *entry = &g_ClientHash.entries[i];
+		if (entry->ip == *(uint32 *)adr->ip && entry->port == adr->port)
+			break;
+
+		i = (i + 1) & (CLIENTHASH_SIZE - 1);
+	}
+
+	if (g_ClientHash.entries[i].slot != cl - g_psvs.clients)
+		return;
+
+	// backward shift deletion, keeps the probe sequences intact without tombstones
+	int hole = i;
+	for (int j = (i + 1) & (CLIENTHASH_SIZE - 1); g_ClientHash.entries[j].slot != -1; j = (j + 1) & (CLIENTHASH_SIZE - 1))
+	{
+		int home = SV_ClientHashIndex(g_ClientHash.entries[j].ip, g_ClientHash.entries[j].port);
+		if (((j - home) & (CLIENTHASH_SIZE - 1)) >= ((j - hole) & (CLIENTHASH_SIZE - 1)))
+		{
+			g_ClientHash.entries[hole] = g_ClientHash.entries[j];
+			hole = j;
+		}
+	}
+
+	g_ClientHash.entries[hole].slot = -1;
+}
+
+void SV_ClientHashInsert(client_t *cl)
+{
+	netadr_t *adr = &cl->netchan.remote_address;
+	int slot = cl - g_psvs.clients;
+
+	if (!g_ClientHash.initialized)
+		SV_ClientHashInit();
+
+	// drop whatever this slot or this address had before, so there is never more than an entry per slot
+	clienthash_entry_t old[CLIENTHASH_SIZE];
+	Q_memcpy(old, g_ClientHash.entries, sizeof(old));
+	SV_ClientHashInit();
+
+	for (int i = 0; i < CLIENTHASH_SIZE; i++)
+	{
+		if (old[i].slot == -1 || old[i].slot == slot)
+			continue;
+
+		if (adr->type == NA_IP && old[i].ip == *(uint32 *)adr->ip && old[i].port == adr->port)
+			continue;
+
+		int j = SV_ClientHashIndex(old[i].ip, old[i].port);
+		while (g_ClientHash.entries[j].slot != -1)
+			j = (j + 1) & (CLIENTHASH_SIZE - 1);
+
+		g_ClientHash.entries[j] = old[i];
+	}
+
+	if (adr->type != NA_IP)
+		return;
+
+	int i = SV_ClientHashIndex(*(uint32 *)adr->ip, adr->port);
+	while (g_ClientHash.entries[i].slot != -1)
+		i = (i + 1) & (CLIENTHASH_SIZE - 1);
+
+	clienthash_entry_t *entry = &g_ClientHash.entries[i];
+	entry->ip = *(uint32 *)adr->ip;
+	entry->port = adr->port;
+	entry->slot = slot;
+}
+
+// Returns the client the packet in net_from belongs to, NULL for unknown peers
+client_t *SV_ClientHashLookup(void)
+{
+	if (!g_ClientHash.initialized)
+		SV_ClientHashInit();
+
+	clienthash_entry_t *entry = SV_ClientHashFind(*(uint32 *)net_from.ip, net_from.port);
+	if (entry && entry->slot < g_psvs.maxclients)
+	{
+		client_t *cl = &g_psvs.clients[entry->slot];
+		if ((cl->connected || cl->active || cl->spawned) && NET_CompareAdr(net_from, cl->netchan.remote_address))
+			return cl;
+	}
+
+	g_ClientHash.unknownpackets++;
+	return NULL;
+}
+
+void SV_PrintClientHashStats(void)
+{
+	if (sv_rehlds_client_hash.value == 0.0f)
+		return;
+
+	Con_Printf("Packets from unknown peers: %u\n", g_ClientHash.unknownpackets);
+}
+#endif // REHLDS_FIXES
+
+void SV_ProcessClientPacket(client_t *cl)
+{
+	if (Netchan_Process(&cl->netchan))
+	{
+		if (g_psvs.maxclients == 1 || !cl->active || !cl->spawned || !cl->fully_connected)
+		{
+			cl->send_message = TRUE;
+		}
+
+		SV_ExecuteClientMessage(cl);
+		gGlobalVariables.frametime = host_frametime;
+	}
+
+	if (Netchan_IncomingReady(&cl->netchan))
+	{
+		if (Netchan_CopyNormalFragments(&cl->netchan))
+		{
+			MSG_BeginReading();
+			SV_ExecuteClientMessage(cl);
+		}
+		if (Netchan_CopyFileFragments(&cl->netchan))
+		{
+			host_client = cl;
+			SV_ProcessFile(cl, cl->netchan.incomingfilename);
+		}
+	}
+}
+
 void SV_ReadPackets(void)
 {
 	while (NET_GetPacket(NS_SERVER))
@@ -3697,6 +4234,17 @@ void SV_ReadPackets(void)
 			continue;
 		}
 
+#ifdef REHLDS_FIXES
+		if (sv_rehlds_client_hash.value != 0.0f && net_from.type == NA_IP)
+		{
+			client_t *cl = SV_ClientHashLookup();
+			if (cl)
+				SV_ProcessClientPacket(cl);
+
+			continue;
+		}
+#endif // REHLDS_FIXES
+
 		for (int i = 0 ; i < g_psvs.maxclients; i++)
 		{
 			client_t *cl = &g_psvs.clients[i];
@@ -3710,30 +4258,7 @@ void SV_ReadPackets(void)
 				continue;
 			}
 
-			if (Netchan_Process(&cl->netchan))
-			{
-				if (g_psvs.maxclients == 1 || !cl->active || !cl->spawned || !cl->fully_connected)
-				{
-					cl->send_message = TRUE;
-				}
-
-				SV_ExecuteClientMessage(cl);
-				gGlobalVariables.frametime = host_frametime;
-			}
-
-			if (Netchan_IncomingReady(&cl->netchan))
-			{
-				if (Netchan_CopyNormalFragments(&cl->netchan))
-				{
-					MSG_BeginReading();
-					SV_ExecuteClientMessage(cl);
-				}
-				if (Netchan_CopyFileFragments(&cl->netchan))
-				{
-					host_client = cl;
-					SV_ProcessFile(cl, cl->netchan.incomingfilename);
-				}
-			}
+			SV_ProcessClientPacket(cl);
 		}
 	}
 }
@@ -4143,25 +4668,74 @@ void TRACE_DELTA(char *fmt, ...)
 
 deltacallback_t g_svdeltacallback;
 
+#ifdef REHLDS_FIXES
+const int SV_DELTACACHE_MAX_WORDS = (3 + 64 + DELTA_MAX_FIELDS * 32 + 31) / 32;
+
+// The fields of a delta written to the side while the delta cache is filled
+typedef struct sv_deltacapture_s
+{
+	qboolean active;
+	deltacallback_t *callback;	// writes the header before the capture starts
+	sizebuf_t buf;
+	bf_write_t outer;	// the writer of the packet while capturing
+	uint32 data[SV_DELTACACHE_MAX_WORDS + 1];
+} sv_deltacapture_t;
+
+// Everything a snapshot worker changes while encoding, the main thread encoding on its own uses
+// g_svdeltacallback, g_DeltaCapture and g_bCurrentPlayerQueried instead
+struct sv_snapshot_worker_s
+{
+	delta_t *original[3];
+	delta_t *copy[3];
+	encoder_t encoder[3];
+	bf_write_t writer;	// bits of the snapshot being encoded by this worker
+	deltacallback_t callback;
+	sv_deltacapture_t capture;
+	client_t *client;	// host_client of the snapshot being encoded
+	qboolean currentplayerqueried;
+	std::thread::id thread;	// set before every run of the pool
+};
+
+qboolean g_bSnapshotEncodersThreadSafe = FALSE;
+
+CWorkerPool g_SnapshotWorkerPool;
+sv_snapshot_worker_t g_SnapshotWorkers[MAX_WORKER_THREADS + 1];
+int g_NumRunningSnapshotWorkers;	// 0 unless the pool is encoding snapshots
+std::mutex g_SnapshotEncoderMutex;
+sv_snapshot_t g_Snapshots[MAX_CLIENTS];
+sv_deltacapture_t g_DeltaCapture;
+qboolean g_bCurrentPlayerQueried;
+#endif
+
+void SV_SetCallbackTo(deltacallback_t *cb, int num, qboolean remove, qboolean custom, int *numbase, qboolean full, int offset)
+{
+	cb->num = num;
+	cb->remove = remove;
+	cb->custom = custom;
+	cb->numbase = numbase;
+	cb->full = full;
+	cb->newbl = FALSE;
+	cb->newblindex = 0;
+	cb->offset = offset;
+}
+
 void SV_SetCallback(int num, qboolean remove, qboolean custom, int *numbase, qboolean full, int offset)
 {
-	g_svdeltacallback.num = num;
-	g_svdeltacallback.remove = remove;
-	g_svdeltacallback.custom = custom;
-	g_svdeltacallback.numbase = numbase;
-	g_svdeltacallback.full = full;
-	g_svdeltacallback.newbl = FALSE;
-	g_svdeltacallback.newblindex = 0;
-	g_svdeltacallback.offset = offset;
+	SV_SetCallbackTo(&g_svdeltacallback, num, remove, custom, numbase, full, offset);
+}
+
+void SV_SetNewInfoTo(deltacallback_t *cb, int newblindex)
+{
+	cb->newbl = TRUE;
+	cb->newblindex = newblindex;
 }
 
 void SV_SetNewInfo(int newblindex)
 {
-	g_svdeltacallback.newbl = TRUE;
-	g_svdeltacallback.newblindex = newblindex;
+	SV_SetNewInfoTo(&g_svdeltacallback, newblindex);
 }
 
-void SV_WriteDeltaHeader(int num, qboolean remove, qboolean custom, int *numbase, qboolean newbl, int newblindex, qboolean full, int offset)
+void SV_WriteDeltaHeader(bf_write_t *bw, int num, qboolean remove, qboolean custom, int *numbase, qboolean newbl, int newblindex, qboolean full, int offset)
 {
 	int delta;
 
@@ -4170,78 +4744,87 @@ void SV_WriteDeltaHeader(int num, qboolean remove, qboolean custom, int *numbase
 	{
 		if (delta == 1)
 		{
-			MSG_WriteBits(1, 1);
+			MSG_WriteBitsTo(bw, 1, 1);
 		}
 		else
 		{
-			MSG_WriteBits(0, 1);
+			MSG_WriteBitsTo(bw, 0, 1);
 		}
 	}
 	else
 	{
-		MSG_WriteBits((remove != 0) ? 1 : 0, 1);
+		MSG_WriteBitsTo(bw, (remove != 0) ? 1 : 0, 1);
 	}
 
 	if (!full || delta != 1)
 	{
 		if (delta <= 0 || delta > 63)
 		{
-			MSG_WriteBits(1u, 1);
-			MSG_WriteBits(num, 11);
+			MSG_WriteBitsTo(bw, 1u, 1);
+			MSG_WriteBitsTo(bw, num, 11);
 		}
 		else
 		{
-			MSG_WriteBits(0, 1);
-			MSG_WriteBits(delta, 6);
+			MSG_WriteBitsTo(bw, 0, 1);
+			MSG_WriteBitsTo(bw, delta, 6);
 		}
 	}
 
 	*numbase = num;
 	if (!remove)
 	{
-		MSG_WriteBits(custom != 0, 1);
+		MSG_WriteBitsTo(bw, custom != 0, 1);
 		if (g_psv.instance_baselines->number)
 		{
 			if (newbl)
 			{
-				MSG_WriteBits(1u, 1);
-				MSG_WriteBits(newblindex, 6);
+				MSG_WriteBitsTo(bw, 1u, 1);
+				MSG_WriteBitsTo(bw, newblindex, 6);
 			}
 			else
 			{
-				MSG_WriteBits(0, 1);
+				MSG_WriteBitsTo(bw, 0, 1);
 			}
 		}
 		if (full && !newbl)
 		{
 			if (offset)
 			{
-				MSG_WriteBits(1u, 1);
-				MSG_WriteBits(offset, 6);
+				MSG_WriteBitsTo(bw, 1u, 1);
+				MSG_WriteBitsTo(bw, offset, 6);
 			}
 			else
 			{
-				MSG_WriteBits(0, 1);
+				MSG_WriteBitsTo(bw, 0, 1);
 			}
 		}
 	}
 }
 
-void SV_InvokeCallback(void)
+// ctx is the deltacallback_t of the writing thread
+void SV_InvokeCallbackTo(void *ctx)
 {
+	deltacallback_t *cb = (deltacallback_t *)ctx;
+
 	SV_WriteDeltaHeader(
-		g_svdeltacallback.num,
-		g_svdeltacallback.remove,
-		g_svdeltacallback.custom,
-		g_svdeltacallback.numbase,
-		g_svdeltacallback.newbl,
-		g_svdeltacallback.newblindex,
-		g_svdeltacallback.full,
-		g_svdeltacallback.offset
+		cb->writer,
+		cb->num,
+		cb->remove,
+		cb->custom,
+		cb->numbase,
+		cb->newbl,
+		cb->newblindex,
+		cb->full,
+		cb->offset
 	);
 }
 
-int SV_FindBestBaseline(int index, entity_state_t ** baseline, entity_state_t *to, int num, qboolean custom)
+void SV_InvokeCallback(void)
+{
+	SV_InvokeCallbackTo(&g_svdeltacallback);
+}
+
+int SV_FindBestBaseline(sv_snapshot_worker_t *worker, int index, entity_state_t ** baseline, entity_state_t *to, int num, qboolean custom)
 {
 	int bestbitnumber;
 	delta_t* delta;
@@ -4258,6 +4841,8 @@ int SV_FindBestBaseline(int index, entity_state_t ** baseline, entity_state_t *t
 			delta = g_pentitydelta;
 	}
 
+	delta = SV_SnapshotDelta(worker, delta);
+
 	bestbitnumber = DELTA_TestDelta((byte *)*baseline, (byte *)&to[index], delta);
 	bestbitnumber -= 6;
 
@@ -4285,6 +4870,231 @@ int SV_FindBestBaseline(int index, entity_state_t ** baseline, entity_state_t *t
 	return index - bestfound;
 }
 
+#ifdef REHLDS_FIXES
+// Per-frame delta cache (sv_rehlds_delta_cache).
+// Clients which get the same entity between the same pair of states receive the same bits after the
+// delta header, so that part is encoded once per frame and then copied into the other snapshots.
+// The whole states are kept in the entry, a lookup only hits when both of them match byte for byte.
+// A description whose conditional encoder asks for the current player depends on the receiving client
+// and is no longer cached from the first time that happens.
+const int SV_DELTACACHE_SIZE = 4096;	// power of two
+const int SV_DELTACACHE_PROBES = 8;
+
+typedef struct sv_deltacache_entry_s
+{
+	std::atomic<uint32> tag;	// frame << 1, low bit is set once the entry is complete
+	int num;
+	delta_t *delta;
+	qboolean force;
+	uint64 forcemask;
+	uint32 fromhash;
+	uint32 tohash;
+	entity_state_t from;
+	entity_state_t to;
+	qboolean sent;
+	uint64 markedmask;
+	uint64 forcemaskout;
+	int numbits;
+	uint32 bits[SV_DELTACACHE_MAX_WORDS];
+} sv_deltacache_entry_t;
+
+typedef struct sv_deltacache_s
+{
+	uint32 frame;
+	sv_deltacache_entry_t *entries;
+	std::atomic<bool> clientdependent[3];	// entity, player and custom entity descriptions
+} sv_deltacache_t;
+
+sv_deltacache_t g_DeltaCache;
+
+void SV_ClearDeltaCache(void)
+{
+	if (sv_rehlds_delta_cache.value == 0.0f)
+	{
+		SV_FreeDeltaCache();
+		return;
+	}
+
+	if (!g_DeltaCache.entries)
+	{
+		g_DeltaCache.entries = (sv_deltacache_entry_t *)Mem_ZeroMalloc(sizeof(sv_deltacache_entry_t) * SV_DELTACACHE_SIZE);
+		g_DeltaCache.frame = 0;
+	}
+
+	// entries of older frames are stale, tags only need a reset when the frame counter wraps
+	if (++g_DeltaCache.frame >= 0x7FFFFFFF)
+	{
+		for (int i = 0; i < SV_DELTACACHE_SIZE; i++)
+			g_DeltaCache.entries[i].tag = 0;
+
+		g_DeltaCache.frame = 1;
+	}
+}
+
+void SV_FreeDeltaCache(void)
+{
+	if (g_DeltaCache.entries)
+	{
+		Mem_Free(g_DeltaCache.entries);
+		g_DeltaCache.entries = NULL;
+	}
+
+	for (int i = 0; i < ARRAYSIZE(g_DeltaCache.clientdependent); i++)
+		g_DeltaCache.clientdependent[i] = false;
+}
+
+// Writes the delta header and redirects the rest of the delta into the capture buffer, ctx is the sv_deltacapture_t
+void SV_InvokeCallbackCapture(void *ctx)
+{
+	sv_deltacapture_t *capture = (sv_deltacapture_t *)ctx;
+	SV_InvokeCallbackTo(capture->callback);
+
+	capture->buf.buffername = "Delta Cache";
+	capture->buf.data = (byte *)capture->data;
+	capture->buf.maxsize = SV_DELTACACHE_MAX_WORDS * 4;
+	capture->buf.cursize = 0;
+	capture->buf.flags = SIZEBUF_ALLOW_OVERFLOW;
+
+	MSG_BeginBitCaptureTo(capture->callback->writer, &capture->outer, &capture->buf);
+	capture->active = TRUE;
+}
+
+void SV_WriteEntityDelta(sv_snapshot_worker_t *worker, bf_write_t *bw, int num, qboolean custom, entity_state_t *from, entity_state_t *to, qboolean force, delta_t *delta, uint64 *pForceMask, uint64 *pForceMaskOut)
+{
+	delta_bulk_t *bulk = DELTABulk_Get(delta);
+	int kind = custom ? 2 : (SV_IsPlayerIndex(num) ? 1 : 0);
+	deltacallback_t *cb = worker ? &worker->callback : &g_svdeltacallback;
+
+	// strings have no upper bound for the size of the encoded delta
+	if (!g_DeltaCache.entries || bulk->numStrings || g_DeltaCache.clientdependent[kind].load(std::memory_order_relaxed))
+	{
+		DELTA_WriteDeltaForceMaskTo(bw, (uint8 *)from, (uint8 *)to, force, delta, &SV_InvokeCallbackTo, cb, pForceMask);
+
+		if (pForceMaskOut)
+		{
+			uint64 origMask = DELTA_GetOriginalMask(delta);
+			uint64 usedMask = DELTA_GetMaskU64(delta);
+
+			//Remember changed fields that was marked in original mask, but unmarked by the conditional encoder
+			*pForceMaskOut = (origMask ^ usedMask) & origMask;
+		}
+		return;
+	}
+
+	// thread copies of the snapshot workers share the entries of their description
+	delta_t *original = (kind == 2) ? g_pcustomentitydelta : (kind == 1 ? g_pplayerdelta : g_pentitydelta);
+	uint64 forcemask = pForceMask ? *pForceMask : 0;
+	uint32 fromhash = crc32c((uint8 *)from, sizeof(entity_state_t));
+	uint32 tohash = crc32c((uint8 *)to, sizeof(entity_state_t));
+	uint32 hash = fromhash ^ (tohash * 0x9E3779B1) ^ (num * 0x85EBCA6B) ^ (uint32)forcemask ^ (uint32)(forcemask >> 32);
+	uint32 writing = g_DeltaCache.frame << 1;
+	uint32 ready = writing | 1;
+
+	sv_deltacache_entry_t *slot = NULL;
+	for (int i = 0; i < SV_DELTACACHE_PROBES; i++)
+	{
+		sv_deltacache_entry_t *e = &g_DeltaCache.entries[(hash + i) & (SV_DELTACACHE_SIZE - 1)];
+		uint32 tag = e->tag.load(std::memory_order_acquire);
+
+		if (tag == ready)
+		{
+			if (e->num != num || e->delta != original || e->force != force || e->forcemask != forcemask
+				|| e->fromhash != fromhash || e->tohash != tohash
+				|| Q_memcmp(&e->from, from, sizeof(entity_state_t)) || Q_memcmp(&e->to, to, sizeof(entity_state_t)))
+				continue;
+
+			delta->cachehits++;
+
+			if (e->sent)
+			{
+				SV_InvokeCallbackTo(cb);
+				MSG_WriteBitBufferTo(bw, e->bits, e->numbits);
+
+#ifndef REHLDS_JIT
+				for (int f = 0; f < delta->fieldCount; f++)
+				{
+					if (e->markedmask & (1ull << f))
+						delta->pdd[f].stats.sendcount++;
+				}
+#endif
+			}
+
+			if (pForceMaskOut)
+				*pForceMaskOut = e->forcemaskout;
+			return;
+		}
+
+		// another worker is filling this one
+		if (tag == writing)
+			continue;
+
+		if (e->tag.compare_exchange_strong(tag, writing, std::memory_order_acquire))
+		{
+			slot = e;
+			break;
+		}
+	}
+
+	delta->cachemisses++;
+
+	sv_deltacapture_t *capture = worker ? &worker->capture : &g_DeltaCapture;
+	qboolean *currentPlayerQueried = worker ? &worker->currentplayerqueried : &g_bCurrentPlayerQueried;
+
+	capture->active = FALSE;
+	capture->callback = cb;
+	*currentPlayerQueried = FALSE;
+	DELTA_WriteDeltaForceMaskTo(bw, (uint8 *)from, (uint8 *)to, force, delta, &SV_InvokeCallbackCapture, capture, pForceMask);
+
+	qboolean sent = capture->active;
+	int numbits = 0;
+	if (sent)
+	{
+		capture->active = FALSE;
+
+		numbits = MSG_EndBitCaptureTo(bw, &capture->outer);
+		if (numbits < 0)
+			Sys_Error("%s: delta of entity %i is too big\n", __func__, num);
+
+		MSG_WriteBitBufferTo(bw, capture->data, numbits);
+	}
+
+	uint64 origMask = DELTA_GetOriginalMask(delta);
+	uint64 usedMask = DELTA_GetMaskU64(delta);
+	uint64 forcemaskout = (origMask ^ usedMask) & origMask;
+
+	if (pForceMaskOut)
+		*pForceMaskOut = forcemaskout;
+
+	// encoded for this client only
+	if (*currentPlayerQueried)
+	{
+		g_DeltaCache.clientdependent[kind].store(true, std::memory_order_relaxed);
+		if (slot)
+			slot->tag.store(0, std::memory_order_release);
+		return;
+	}
+
+	if (!slot)
+		return;
+
+	slot->num = num;
+	slot->delta = original;
+	slot->force = force;
+	slot->forcemask = forcemask;
+	slot->fromhash = fromhash;
+	slot->tohash = tohash;
+	slot->from = *from;
+	slot->to = *to;
+	slot->sent = sent;
+	slot->markedmask = usedMask;
+	slot->forcemaskout = forcemaskout;
+	slot->numbits = numbits;
+	Q_memcpy(slot->bits, capture->data, (numbits + 31) / 32 * 4);
+
+	slot->tag.store(ready, std::memory_order_release);
+}
+#endif // REHLDS_FIXES
+
 int EXT_FUNC SV_CreatePacketEntities_api(sv_delta_t type, IGameClient *client, packet_entities_t *to, sizebuf_t *msg)
 {
 	return SV_CreatePacketEntities_internal(type, client->GetClient(), to, msg);
@@ -4296,6 +5106,12 @@ int SV_CreatePacketEntities(sv_delta_t type, client_t *client, packet_entities_t
 }
 
 int SV_CreatePacketEntities_internal(sv_delta_t type, client_t *client, packet_entities_t *to, sizebuf_t *msg)
+{
+	return SV_CreatePacketEntitiesTo(NULL, MSG_GetBitWriter(), type, client, to, msg);
+}
+
+// worker is NULL when the main thread encodes the snapshot on its own
+int SV_CreatePacketEntitiesTo(sv_snapshot_worker_t *worker, bf_write_t *bw, sv_delta_t type, client_t *client, packet_entities_t *to, sizebuf_t *msg)
 {
 	packet_entities_t *from;
 	int oldindex;
@@ -4311,6 +5127,20 @@ int SV_CreatePacketEntities_internal(sv_delta_t type, client_t *client, packet_e
 	uint64 toBaselinesForceMask[MAX_PACKET_ENTITIES];
 #endif
 
+	// thread copies when encoded by the snapshot workers
+	delta_t *entitydelta = SV_SnapshotDelta(worker, g_pentitydelta);
+	delta_t *playerdelta = SV_SnapshotDelta(worker, g_pplayerdelta);
+	delta_t *customentitydelta = SV_SnapshotDelta(worker, g_pcustomentitydelta);
+
+#ifdef REHLDS_FIXES
+	deltacallback_t *cb = worker ? &worker->callback : &g_svdeltacallback;
+#else
+	deltacallback_t *cb = &g_svdeltacallback;
+#endif
+
+	// the delta header callback writes through the same writer
+	cb->writer = bw;
+
 	numbase = 0;
 	if (type == sv_packet_delta)
 	{
@@ -4333,7 +5163,7 @@ int SV_CreatePacketEntities_internal(sv_delta_t type, client_t *client, packet_e
 
 	newnum = 0; //index in to->entities
 	oldnum = 0; //index in from->entities
-	MSG_StartBitWriting(msg);
+	MSG_StartBitWritingTo(bw, msg);
 	while (1)
 	{
 		if (newnum < to->num_entities)
@@ -4364,8 +5194,12 @@ int SV_CreatePacketEntities_internal(sv_delta_t type, client_t *client, packet_e
 		{
 			entity_state_t *baseline_ = &to->entities[newnum];
 			qboolean custom = baseline_->entityType & 0x2 ? TRUE : FALSE;
-			SV_SetCallback(newindex, FALSE, custom, &numbase, FALSE, 0);
-			DELTA_WriteDelta((uint8 *)&from->entities[oldnum], (uint8 *)baseline_, FALSE, custom ? g_pcustomentitydelta : (SV_IsPlayerIndex(newindex) ? g_pplayerdelta : g_pentitydelta), &SV_InvokeCallback);
+			SV_SetCallbackTo(cb, newindex, FALSE, custom, &numbase, FALSE, 0);
+#ifdef REHLDS_FIXES
+			SV_WriteEntityDelta(worker, bw, newindex, custom, &from->entities[oldnum], baseline_, FALSE, custom ? customentitydelta : (SV_IsPlayerIndex(newindex) ? playerdelta : entitydelta), NULL, NULL);
+#else
+			DELTA_WriteDeltaTo(bw, (uint8 *)&from->entities[oldnum], (uint8 *)baseline_, FALSE, custom ? customentitydelta : (SV_IsPlayerIndex(newindex) ? playerdelta : entitydelta), &SV_InvokeCallbackTo, cb);
+#endif
 			++oldnum;
 			_mm_prefetch((const char*)&from->entities[oldnum], _MM_HINT_T0);
 			_mm_prefetch(((const char*)&from->entities[oldnum]) + 64, _MM_HINT_T0);
@@ -4377,7 +5211,7 @@ int SV_CreatePacketEntities_internal(sv_delta_t type, client_t *client, packet_e
 		{
 			if (newindex > oldindex)
 			{
-				SV_WriteDeltaHeader(oldindex, TRUE, FALSE, &numbase, FALSE, 0, FALSE, 0);
+				SV_WriteDeltaHeader(bw, oldindex, TRUE, FALSE, &numbase, FALSE, 0, FALSE, 0);
 				++oldnum;
 				_mm_prefetch((const char*)&from->entities[oldnum], _MM_HINT_T0);
 				_mm_prefetch(((const char*)&from->entities[oldnum]) + 64, _MM_HINT_T0);
@@ -4387,7 +5221,8 @@ int SV_CreatePacketEntities_internal(sv_delta_t type, client_t *client, packet_e
 
 		edict_t *ent = EDICT_NUM(newindex);
 		qboolean custom = to->entities[newnum].entityType & 0x2 ? TRUE : FALSE;
-		SV_SetCallback(
+		SV_SetCallbackTo(
+			cb,
 			newindex,
 			FALSE,
 			custom,
@@ -4402,7 +5237,7 @@ int SV_CreatePacketEntities_internal(sv_delta_t type, client_t *client, packet_e
 			{
 				if (g_psv.instance_baselines->classname[i] == ent->v.classname)
 				{
-					SV_SetNewInfo(i);
+					SV_SetNewInfoTo(cb, i);
 					baseline_ = &g_psv.instance_baselines->baseline[i];
 					break;
 				}
@@ -4412,11 +5247,11 @@ int SV_CreatePacketEntities_internal(sv_delta_t type, client_t *client, packet_e
 		{
 			if (!from)
 			{
-				int offset = SV_FindBestBaseline(newnum, &baseline_, to->entities, newindex, custom);
+				int offset = SV_FindBestBaseline(worker, newnum, &baseline_, to->entities, newindex, custom);
 				_mm_prefetch((const char*)baseline_, _MM_HINT_T0);
 				_mm_prefetch(((const char*)baseline_) + 64, _MM_HINT_T0);
 				if (offset)
-					SV_SetCallback(newindex, FALSE, custom, &numbase, TRUE, offset);
+					SV_SetCallbackTo(cb, newindex, FALSE, custom, &numbase, TRUE, offset);
 
 				// fix for https://github.com/dreamstalker/rehlds/issues/24
 #ifdef REHLDS_FIXES
@@ -4427,35 +5262,34 @@ int SV_CreatePacketEntities_internal(sv_delta_t type, client_t *client, packet_e
 		}
 
 
-		delta_t* delta = custom ? g_pcustomentitydelta : (SV_IsPlayerIndex(newindex) ? g_pplayerdelta : g_pentitydelta);
+		delta_t* delta = custom ? customentitydelta : (SV_IsPlayerIndex(newindex) ? playerdelta : entitydelta);
 
 		// fix for https://github.com/dreamstalker/rehlds/issues/24
 #ifdef REHLDS_FIXES
-		DELTA_WriteDeltaForceMask(
-			(uint8 *)baseline_,
-			(uint8 *)&to->entities[newnum],
+		SV_WriteEntityDelta(
+			worker,
+			bw,
+			newindex,
+			custom,
+			baseline_,
+			&to->entities[newnum],
 			TRUE,
 			delta,
-			&SV_InvokeCallback,
-			baselineToIdx != -1 ? &toBaselinesForceMask[baselineToIdx] : NULL
+			baselineToIdx != -1 ? &toBaselinesForceMask[baselineToIdx] : NULL,
+			&toBaselinesForceMask[newnum]
 		);
 		baselineToIdx = -1;
 
-		uint64 origMask = DELTA_GetOriginalMask(delta);
-		uint64 usedMask = DELTA_GetMaskU64(delta);
-		uint64 diffMask = origMask ^ usedMask;
-
-		//Remember changed fields that was marked in original mask, but unmarked by the conditional encoder
-		toBaselinesForceMask[newnum] = diffMask & origMask;
-
 
 #else //REHLDS_FIXES
-		DELTA_WriteDelta(
+		DELTA_WriteDeltaTo(
+			bw,
 			(uint8 *)baseline_,
 			(uint8 *)&to->entities[newnum],
 			TRUE,
 			delta,
-			&SV_InvokeCallback
+			&SV_InvokeCallbackTo,
+			cb
 			);
 #endif //REHLDS_FIXES
 
@@ -4463,8 +5297,8 @@ int SV_CreatePacketEntities_internal(sv_delta_t type, client_t *client, packet_e
 
 	}
 
-	MSG_WriteBits(0, 16);
-	MSG_EndBitWriting(msg);
+	MSG_WriteBitsTo(bw, 0, 16);
+	MSG_EndBitWritingTo(bw);
 	return msg->cursize;
 }
 
@@ -4590,7 +5424,120 @@ void SV_EmitPings(client_t *client, sizebuf_t *msg)
 	MSG_EndBitWriting(msg);
 }
 
-void SV_WriteEntitiesToClient(client_t *client, sizebuf_t *msg)
+#ifdef REHLDS_FIXES
+// Per-frame visibility cache (sv_rehlds_visibility_cache).
+// Entities that can't be transmitted at all are dropped once per frame, and the remaining ones are tested
+// against each distinct PVS only once, so clients looking from the same spot share a single candidate list.
+// The game dll only gets AddToFullPack calls for the entities which passed both checks.
+typedef struct sv_visset_s
+{
+	uint32 hash;
+	qboolean nopvs;
+	unsigned char pvs[sizeof(fatpvs)];
+	int numentities;
+	int *entities;
+} sv_visset_t;
+
+typedef struct sv_viscache_s
+{
+	qboolean valid;
+	int capacity;
+	int numtransmit;
+	int *transmit;
+	int numsets;
+	sv_visset_t sets[MAX_CLIENTS];
+} sv_viscache_t;
+
+sv_viscache_t g_VisCache;
+
+void SV_ClearVisibilityCache(void)
+{
+	g_VisCache.valid = FALSE;
+	g_VisCache.numsets = 0;
+}
+
+void SV_FreeVisibilityCache(void)
+{
+	Mem_Free(g_VisCache.transmit);
+	for (int i = 0; i < ARRAYSIZE(g_VisCache.sets); i++)
+		Mem_Free(g_VisCache.sets[i].entities);
+
+	Q_memset(&g_VisCache, 0, sizeof(g_VisCache));
+}
+
+void SV_BuildTransmitList(void)
+{
+	if (g_VisCache.capacity < g_psv.max_edicts)
+	{
+		SV_FreeVisibilityCache();
+
+		g_VisCache.capacity = g_psv.max_edicts;
+		g_VisCache.transmit = (int *)Mem_Malloc(sizeof(int) * g_VisCache.capacity);
+		for (int i = 0; i < ARRAYSIZE(g_VisCache.sets); i++)
+			g_VisCache.sets[i].entities = (int *)Mem_Malloc(sizeof(int) * g_VisCache.capacity);
+	}
+
+	g_VisCache.numtransmit = 0;
+	for (int e = g_psvs.maxclients + 1; e < g_psv.num_edicts; e++)
+	{
+		edict_t *ent = &g_psv.edicts[e];
+		if (ent->free || !ent->v.modelindex || (ent->v.effects & EF_NODRAW))
+			continue;
+
+		g_VisCache.transmit[g_VisCache.numtransmit++] = e;
+	}
+
+	g_VisCache.numsets = 0;
+	g_VisCache.valid = TRUE;
+}
+
+sv_visset_t *SV_GetVisibilitySet(unsigned char *pset)
+{
+	if (!g_VisCache.valid)
+		SV_BuildTransmitList();
+
+	int pvsbytes = Q_min((g_psv.worldmodel->numleafs + 7) >> 3, (int)sizeof(fatpvs));
+	uint32 hash = pset ? crc32c(pset, pvsbytes) : 0;
+
+	for (int i = 0; i < g_VisCache.numsets; i++)
+	{
+		sv_visset_t *set = &g_VisCache.sets[i];
+		if (set->nopvs)
+		{
+			if (!pset)
+				return set;
+		}
+		else if (pset && set->hash == hash && !Q_memcmp(set->pvs, pset, pvsbytes))
+		{
+			return set;
+		}
+	}
+
+	// there is at most one set per client
+	if (g_VisCache.numsets == ARRAYSIZE(g_VisCache.sets))
+		g_VisCache.numsets--;
+
+	sv_visset_t *set = &g_VisCache.sets[g_VisCache.numsets++];
+	set->hash = hash;
+	set->nopvs = pset ? FALSE : TRUE;
+	set->numentities = 0;
+
+	if (pset)
+		Q_memcpy(set->pvs, pset, pvsbytes);
+
+	for (int i = 0; i < g_VisCache.numtransmit; i++)
+	{
+		int e = g_VisCache.transmit[i];
+		if (SV_CheckVisibility(&g_psv.edicts[e], pset))
+			set->entities[set->numentities++] = e;
+	}
+
+	return set;
+}
+#endif // REHLDS_FIXES
+
+// Builds the frame's packet entities list, it's where the game dll decides what the client can see
+packet_entities_t *SV_SetupPacketEntities(client_t *client)
 {
 	client_frame_t *frame = &client->frames[SV_UPDATE_MASK & client->netchan.outgoing_sequence];
 
@@ -4614,7 +5561,6 @@ void SV_WriteEntitiesToClient(client_t *client, sizebuf_t *msg)
 	full_packet_entities_t* curPack = &fullpack;
 #endif // REHLDS_OPT_PEDANTIC
 
-	qboolean sendping = SV_ShouldUpdatePing(client);
 	int flags = client->lw != 0;
 
 	int e;
@@ -4629,6 +5575,29 @@ void SV_WriteEntitiesToClient(client_t *client, sizebuf_t *msg)
 			++curPack->num_entities;
 	}
 
+#ifdef REHLDS_FIXES
+	if (sv_rehlds_visibility_cache.value != 0.0f)
+	{
+		sv_visset_t *visset = SV_GetVisibilitySet(pSet);
+		for (int i = 0; i < visset->numentities; i++)
+		{
+			if (curPack->num_entities >= MAX_PACKET_ENTITIES)
+			{
+				Con_DPrintf("Too many entities in visible packet list.\n");
+				break;
+			}
+
+			e = visset->entities[i];
+			qboolean add = gEntityInterface.pfnAddToFullPack(&curPack->entities[curPack->num_entities], e, &g_psv.edicts[e], host_client->edict, flags, FALSE, pSet);
+			if (add)
+				++curPack->num_entities;
+		}
+
+		// skip the full scan below
+		e = g_psv.num_edicts;
+	}
+#endif // REHLDS_FIXES
+
 	for (; e < g_psv.num_edicts; e++)
 	{
 		if (curPack->num_entities >= MAX_PACKET_ENTITIES)
@@ -4695,10 +5664,44 @@ void SV_WriteEntitiesToClient(client_t *client, sizebuf_t *msg)
 		Q_memcpy(pack->entities, fullpack.entities, sizeof(entity_state_t) * pack->num_entities);
 #endif
 
+	return pack;
+}
+
+#ifdef REHLDS_FIXES
+// Counts what was written to a client datagram since start as one svc_* message
+void SV_CountDatagramSection(sizebuf_t *msg, int start)
+{
+	if (msg->cursize > start)
+		SV_CountDatagramBytes(msg->data[start], msg->cursize - start);
+}
+#endif // REHLDS_FIXES
+
+void SV_WriteEntitiesToClient(client_t *client, sizebuf_t *msg)
+{
+	packet_entities_t *pack = SV_SetupPacketEntities(client);
+	qboolean sendping = SV_ShouldUpdatePing(client);
+
+#ifdef REHLDS_FIXES
+	int start = msg->cursize;
 	SV_EmitPacketEntities(client, pack, msg);
+	SV_CountDatagramSection(msg, start);
+
+	start = msg->cursize;
 	SV_EmitEvents(client, pack, msg);
+	SV_CountDatagramSection(msg, start);
+
 	if (sendping)
+	{
+		start = msg->cursize;
 		SV_EmitPings(client, msg);
+		SV_CountDatagramSection(msg, start);
+	}
+#else // REHLDS_FIXES
+	SV_EmitPacketEntities(client, pack, msg);
+	SV_EmitEvents(client, pack, msg);
+	if (sendping)
+		SV_EmitPings(client, msg);
+#endif // REHLDS_FIXES
 }
 
 void SV_CleanupEnts(void)
@@ -4710,32 +5713,38 @@ void SV_CleanupEnts(void)
 	}
 }
 
-qboolean SV_SendClientDatagram(client_t *client)
+void SV_WriteClientDatagramHeader(client_t *client, sizebuf_t *msg)
 {
-	unsigned char buf[MAX_DATAGRAM];
-	sizebuf_t msg;
-
-	msg.buffername = "Client Datagram";
-	msg.data = buf;
-	msg.maxsize = sizeof(buf);
-	msg.cursize = 0;
-	msg.flags = SIZEBUF_ALLOW_OVERFLOW;
+#ifdef REHLDS_FIXES
+	int start = msg->cursize;
+#endif
 
-	MSG_WriteByte(&msg, svc_time);
+	MSG_WriteByte(msg, svc_time);
 #ifdef REHLDS_FIXES
 	if (sv_rehlds_local_gametime.value != 0.0f)
 	{
-		MSG_WriteFloat(&msg, (float)g_GameClients[client - g_psvs.clients]->GetLocalGameTime());
+		MSG_WriteFloat(msg, (float)g_GameClients[client - g_psvs.clients]->GetLocalGameTime());
 	}
 	else
 #endif
 	{
-		MSG_WriteFloat(&msg, g_psv.time);
+		MSG_WriteFloat(msg, g_psv.time);
 	}
 
-	SV_WriteClientdataToMessage(client, &msg);
-	SV_WriteEntitiesToClient(client, &msg);
+#ifdef REHLDS_FIXES
+	SV_CountDatagramSection(msg, start);
+	start = msg->cursize;
+#endif
+
+	SV_WriteClientdataToMessage(client, msg);
 
+#ifdef REHLDS_FIXES
+	SV_CountDatagramSection(msg, start);
+#endif
+}
+
+void SV_TransmitClientDatagram(client_t *client, sizebuf_t *msg)
+{
 	if (client->datagram.flags & SIZEBUF_OVERFLOWED)
 	{
 		Con_Printf("WARNING: datagram overflowed for %s\n", client->name);
@@ -4743,24 +5752,40 @@ qboolean SV_SendClientDatagram(client_t *client)
 	else
 	{
 #ifdef REHLDS_FIXES
-		if (msg.cursize + client->datagram.cursize > msg.maxsize)
+		if (msg->cursize + client->datagram.cursize > msg->maxsize)
 			Con_DPrintf("Warning: Ignoring unreliable datagram for %s, would overflow on msg\n", client->name);
 		else
-			SZ_Write(&msg, client->datagram.data, client->datagram.cursize);
+			SZ_Write(msg, client->datagram.data, client->datagram.cursize);
 #else
-		SZ_Write(&msg, client->datagram.data, client->datagram.cursize);
+		SZ_Write(msg, client->datagram.data, client->datagram.cursize);
 #endif
 	}
 
 	SZ_Clear(&client->datagram);
 
-	if (msg.flags & SIZEBUF_OVERFLOWED)
+	if (msg->flags & SIZEBUF_OVERFLOWED)
 	{
 		Con_Printf("WARNING: msg overflowed for %s\n", client->name);
-		SZ_Clear(&msg);
+		SZ_Clear(msg);
 	}
 
-	Netchan_Transmit(&client->netchan, msg.cursize, buf);
+	Netchan_Transmit(&client->netchan, msg->cursize, msg->data);
+}
+
+qboolean SV_SendClientDatagram(client_t *client)
+{
+	unsigned char buf[MAX_DATAGRAM];
+	sizebuf_t msg;
+
+	msg.buffername = "Client Datagram";
+	msg.data = buf;
+	msg.maxsize = sizeof(buf);
+	msg.cursize = 0;
+	msg.flags = SIZEBUF_ALLOW_OVERFLOW;
+
+	SV_WriteClientDatagramHeader(client, &msg);
+	SV_WriteEntitiesToClient(client, &msg);
+	SV_TransmitClientDatagram(client, &msg);
 
 	return TRUE;
 }
@@ -4816,6 +5841,9 @@ void SV_UpdateToReliableMessages(void)
 	// Link new user messages to sent chain
 	if (sv_gpNewUserMsgs != NULL)
 	{
+#ifdef REHLDS_OPT_PEDANTIC
+		SV_IndexUserMsgs(sv_gpNewUserMsgs);
+#endif
 		UserMsg *pMsg = sv_gpUserMsgs;
 		if (pMsg != NULL)
 		{
@@ -4837,98 +5865,299 @@ void SV_UpdateToReliableMessages(void)
 		Con_DPrintf("sv.datagram overflowed!\n");
 		SZ_Clear(&g_psv.datagram);
 	}
-	if (g_psv.spectator.flags & SIZEBUF_OVERFLOWED)
+	if (g_psv.spectator.flags & SIZEBUF_OVERFLOWED)
+	{
+		Con_DPrintf("sv.spectator overflowed!\n");
+		SZ_Clear(&g_psv.spectator);
+	}
+
+	// Fix for the "server failed to transmit file 'AY&SY..." bug
+	// https://github.com/dreamstalker/rehlds/issues/38
+#ifdef REHLDS_FIXES
+	bool svReliableCompressed = false;
+#endif
+
+	// Send broadcast data
+	for (i = 0; i < g_psvs.maxclients; i++)
+	{
+		client = &g_psvs.clients[i];
+
+		// Fix for the "server failed to transmit file 'AY&SY..." bug
+		// https://github.com/dreamstalker/rehlds/issues/38
+#ifdef REHLDS_FIXES
+		if (!(!client->fakeclient && (client->active || g_GameClients[i]->GetSpawnedOnce())))
+			continue;
+
+		if (!svReliableCompressed && g_psv.reliable_datagram.cursize + client->netchan.message.cursize < client->netchan.message.maxsize)
+		{
+			SZ_Write(&client->netchan.message, g_psv.reliable_datagram.data, g_psv.reliable_datagram.cursize);
+		}
+		else
+		{
+			Netchan_CreateFragments(TRUE, &client->netchan, &g_psv.reliable_datagram);
+			svReliableCompressed = true;
+		}
+#else
+		if (!(!client->fakeclient && client->active))
+			continue;
+
+		if (g_psv.reliable_datagram.cursize + client->netchan.message.cursize < client->netchan.message.maxsize)
+		{
+			SZ_Write(&client->netchan.message, g_psv.reliable_datagram.data, g_psv.reliable_datagram.cursize);
+		}
+		else
+		{
+			Netchan_CreateFragments(TRUE, &client->netchan, &g_psv.reliable_datagram);
+		}
+#endif
+
+		if (g_psv.datagram.cursize + client->datagram.cursize < client->datagram.maxsize)
+		{
+			SZ_Write(&client->datagram, g_psv.datagram.data, g_psv.datagram.cursize);
+		}
+		else
+		{
+			Con_DPrintf("Warning:  Ignoring unreliable datagram for %s, would overflow\n", client->name);
+		}
+
+		if (client->proxy)
+		{
+			if (g_psv.spectator.cursize + client->datagram.cursize < client->datagram.maxsize)
+			{
+				SZ_Write(&client->datagram, g_psv.spectator.data, g_psv.spectator.cursize);
+			}
+#ifdef REHLDS_FIXES
+			else
+			{
+				Con_DPrintf("Warning:  Ignoring spectator datagram for %s, would overflow\n", client->name);
+			}
+#endif
+		}
+	}
+
+	SZ_Clear(&g_psv.reliable_datagram);
+	SZ_Clear(&g_psv.datagram);
+	SZ_Clear(&g_psv.spectator);
+}
+
+void SV_SkipUpdates(void)
+{
+	for (int i = 0; i < g_psvs.maxclients; i++)
+	{
+		client_t *client = &g_psvs.clients[i];
+		if (!client->active && !client->connected && !client->spawned)
+			continue;
+
+		if (!host_client->fakeclient) //TODO: should be client, not host_client; investigation needed
+			client->skip_message = TRUE;
+	}
+}
+
+delta_t *SV_SnapshotDelta(sv_snapshot_worker_t *worker, delta_t *delta)
+{
+#ifdef REHLDS_FIXES
+	if (worker)
+	{
+		for (int i = 0; i < ARRAYSIZE(worker->original); i++)
+		{
+			if (worker->original[i] == delta)
+				return worker->copy[i];
+		}
+	}
+#endif
+
+	return delta;
+}
+
+#ifdef REHLDS_FIXES
+// Conditional encoders of the game dll are serialized unless it declared them thread-safe through the API
+void SV_SnapshotLockedEncoder(delta_t *pFields, const unsigned char *from, const unsigned char *to)
+{
+	// the copy tells which worker is encoding
+	for (int w = 0; w < g_NumRunningSnapshotWorkers; w++)
+	{
+		sv_snapshot_worker_t *worker = &g_SnapshotWorkers[w];
+		for (int i = 0; i < ARRAYSIZE(worker->copy); i++)
+		{
+			if (worker->copy[i] == pFields)
+			{
+				std::lock_guard<std::mutex> lock(g_SnapshotEncoderMutex);
+				worker->encoder[i](pFields, from, to);
+				return;
+			}
+		}
+	}
+}
+
+// PF_GetCurrentPlayer of the conditional encoders, on a snapshot worker it is the client of its snapshot
+client_t *SV_QueryCurrentPlayer(void)
+{
+	if (g_NumRunningSnapshotWorkers)
+	{
+		std::thread::id self = std::this_thread::get_id();
+		for (int w = 0; w < g_NumRunningSnapshotWorkers; w++)
+		{
+			sv_snapshot_worker_t *worker = &g_SnapshotWorkers[w];
+			if (worker->thread == self)
+			{
+				worker->currentplayerqueried = TRUE;
+				return worker->client;
+			}
+		}
+	}
+
+	g_bCurrentPlayerQueried = TRUE;
+	return host_client;
+}
+
+void SV_SyncSnapshotWorkers(int numWorkers)
+{
+	delta_t *deltas[] = { g_pentitydelta, g_pplayerdelta, g_pcustomentitydelta };
+
+	for (int w = 0; w < numWorkers; w++)
+	{
+		sv_snapshot_worker_t *worker = &g_SnapshotWorkers[w];
+		for (int i = 0; i < ARRAYSIZE(deltas); i++)
+		{
+			if (!worker->copy[i])
+				worker->copy[i] = DELTA_CreateThreadCopy();
+
+			DELTA_SyncThreadCopy(worker->copy[i], deltas[i]);
+			worker->original[i] = deltas[i];
+			worker->encoder[i] = deltas[i]->conditionalencode;
+
+			if (worker->encoder[i] && !g_bSnapshotEncodersThreadSafe)
+				worker->copy[i]->conditionalencode = SV_SnapshotLockedEncoder;
+		}
+	}
+}
+
+void SV_EmitPacketEntitiesJob(int index, int worker, void *ctx)
+{
+	sv_snapshot_t *snapshot = &((sv_snapshot_t *)ctx)[index];
+	sv_snapshot_worker_t *w = &g_SnapshotWorkers[worker];
+	client_t *client = snapshot->client;
+
+	w->client = client;
+	SV_CreatePacketEntitiesTo(w, &w->writer, client->delta_sequence == -1 ? sv_packet_nodelta : sv_packet_delta, client, snapshot->pack, &snapshot->msg);
+	w->client = NULL;
+}
+
+void SV_EmitPacketEntitiesParallel(sv_snapshot_t *snapshots, int count)
+{
+	g_SnapshotWorkerPool.Start((int)sv_rehlds_parallel_snapshots.value);
+
+	int numWorkers = g_SnapshotWorkerPool.GetNumThreads() + 1;
+	SV_SyncSnapshotWorkers(numWorkers);
+
+	// written before the workers are woken up, they only read it during the run
+	for (int w = 0; w < numWorkers; w++)
+		g_SnapshotWorkers[w].thread = g_SnapshotWorkerPool.GetThreadId(w);
+
+	g_NumRunningSnapshotWorkers = numWorkers;
+	g_SnapshotWorkerPool.Run(count, SV_EmitPacketEntitiesJob, snapshots);
+	g_NumRunningSnapshotWorkers = 0;
+
+	for (int w = 0; w < numWorkers; w++)
+	{
+		sv_snapshot_worker_t *worker = &g_SnapshotWorkers[w];
+		for (int i = 0; i < ARRAYSIZE(worker->copy); i++)
+			DELTA_MergeThreadCopyStats(worker->copy[i], worker->original[i]);
+	}
+}
+
+void SV_ShutdownSnapshotWorkers(void)
+{
+	g_SnapshotWorkerPool.Stop();
+
+	for (int w = 0; w < ARRAYSIZE(g_SnapshotWorkers); w++)
+	{
+		sv_snapshot_worker_t *worker = &g_SnapshotWorkers[w];
+		for (int i = 0; i < ARRAYSIZE(worker->copy); i++)
+		{
+			DELTA_FreeThreadCopy(&worker->copy[i]);
+			worker->original[i] = NULL;
+			worker->encoder[i] = NULL;
+		}
+	}
+}
+
+// Game dll callbacks, events, pings and the transmit itself stay on the main thread and in the usual order,
+// only the packet entities of all clients are delta encoded at once on the worker pool
+void SV_SendClientDatagramsParallel(client_t **clients, int count)
+{
+	for (int i = 0; i < count; i++)
 	{
-		Con_DPrintf("sv.spectator overflowed!\n");
-		SZ_Clear(&g_psv.spectator);
+		sv_snapshot_t *snapshot = &g_Snapshots[i];
+		client_t *cl = clients[i];
+		host_client = cl;
+
+		snapshot->client = cl;
+		snapshot->msg.buffername = "Client Datagram";
+		snapshot->msg.data = snapshot->buf;
+		snapshot->msg.maxsize = sizeof(snapshot->buf);
+		snapshot->msg.cursize = 0;
+		snapshot->msg.flags = SIZEBUF_ALLOW_OVERFLOW;
+
+		SV_WriteClientDatagramHeader(cl, &snapshot->msg);
+		snapshot->entitiesstart = snapshot->msg.cursize;
+		snapshot->pack = SV_SetupPacketEntities(cl);
+		snapshot->sendping = SV_ShouldUpdatePing(cl);
 	}
 
-	// Fix for the "server failed to transmit file 'AY&SY..." bug
-	// https://github.com/dreamstalker/rehlds/issues/38
-#ifdef REHLDS_FIXES
-	bool svReliableCompressed = false;
-#endif
+	SV_EmitPacketEntitiesParallel(g_Snapshots, count);
 
-	// Send broadcast data
-	for (i = 0; i < g_psvs.maxclients; i++)
+	for (int i = 0; i < count; i++)
 	{
-		client = &g_psvs.clients[i];
-
-		// Fix for the "server failed to transmit file 'AY&SY..." bug
-		// https://github.com/dreamstalker/rehlds/issues/38
-#ifdef REHLDS_FIXES
-		if (!(!client->fakeclient && (client->active || g_GameClients[i]->GetSpawnedOnce())))
-			continue;
+		sv_snapshot_t *snapshot = &g_Snapshots[i];
+		client_t *cl = snapshot->client;
+		host_client = cl;
 
-		if (!svReliableCompressed && g_psv.reliable_datagram.cursize + client->netchan.message.cursize < client->netchan.message.maxsize)
-		{
-			SZ_Write(&client->netchan.message, g_psv.reliable_datagram.data, g_psv.reliable_datagram.cursize);
-		}
-		else
-		{
-			Netchan_CreateFragments(TRUE, &client->netchan, &g_psv.reliable_datagram);
-			svReliableCompressed = true;
-		}
-#else
-		if (!(!client->fakeclient && client->active))
-			continue;
+		SV_CountDatagramSection(&snapshot->msg, snapshot->entitiesstart);
 
-		if (g_psv.reliable_datagram.cursize + client->netchan.message.cursize < client->netchan.message.maxsize)
-		{
-			SZ_Write(&client->netchan.message, g_psv.reliable_datagram.data, g_psv.reliable_datagram.cursize);
-		}
-		else
-		{
-			Netchan_CreateFragments(TRUE, &client->netchan, &g_psv.reliable_datagram);
-		}
-#endif
+		int start = snapshot->msg.cursize;
+		SV_EmitEvents(cl, snapshot->pack, &snapshot->msg);
+		SV_CountDatagramSection(&snapshot->msg, start);
 
-		if (g_psv.datagram.cursize + client->datagram.cursize < client->datagram.maxsize)
+		if (snapshot->sendping)
 		{
-			SZ_Write(&client->datagram, g_psv.datagram.data, g_psv.datagram.cursize);
-		}
-		else
-		{
-			Con_DPrintf("Warning:  Ignoring unreliable datagram for %s, would overflow\n", client->name);
+			start = snapshot->msg.cursize;
+			SV_EmitPings(cl, &snapshot->msg);
+			SV_CountDatagramSection(&snapshot->msg, start);
 		}
 
-		if (client->proxy)
-		{
-			if (g_psv.spectator.cursize + client->datagram.cursize < client->datagram.maxsize)
-			{
-				SZ_Write(&client->datagram, g_psv.spectator.data, g_psv.spectator.cursize);
-			}
-#ifdef REHLDS_FIXES
-			else
-			{
-				Con_DPrintf("Warning:  Ignoring spectator datagram for %s, would overflow\n", client->name);
-			}
-#endif
-		}
+		SV_TransmitClientDatagram(cl, &snapshot->msg);
 	}
-
-	SZ_Clear(&g_psv.reliable_datagram);
-	SZ_Clear(&g_psv.datagram);
-	SZ_Clear(&g_psv.spectator);
 }
 
-void SV_SkipUpdates(void)
+qboolean SV_ShouldSendClientDatagramsParallel(int count)
 {
-	for (int i = 0; i < g_psvs.maxclients; i++)
-	{
-		client_t *client = &g_psvs.clients[i];
-		if (!client->active && !client->connected && !client->spawned)
-			continue;
+	if (sv_rehlds_parallel_snapshots.value < 1.0f || count < 2)
+		return FALSE;
 
-		if (!host_client->fakeclient) //TODO: should be client, not host_client; investigation needed
-			client->skip_message = TRUE;
-	}
+	// hooks expect to be called on the main thread
+	return g_RehldsHookchains.m_SV_CreatePacketEntities.hasHooks() ? FALSE : TRUE;
 }
+#endif // REHLDS_FIXES
 
 void SV_SendClientMessages(void)
 {
+#ifdef REHLDS_FIXES
+	client_t *datagramClients[MAX_CLIENTS];
+	int numDatagramClients = 0;
+#endif
+
 	SV_UpdateToReliableMessages();
 
+#ifdef REHLDS_FIXES
+	SV_ClearVisibilityCache();
+	SV_ClearDeltaCache();
+#endif
+
+#ifndef _WIN32
+	NET_BeginSendBatch();
+#endif // _WIN32
+
 	for (int i = 0; i < g_psvs.maxclients; i++)
 	{
 		client_t *cl = &g_psvs.clients[i];
@@ -4976,11 +6205,38 @@ void SV_SendClientMessages(void)
 			host_client->send_message = FALSE;
 			cl->next_messagetime = host_frametime + cl->next_messageinterval + realtime;
 			if (cl->active && cl->spawned && cl->fully_connected)
-				SV_SendClientDatagram(cl);
+			{
+#ifdef REHLDS_FIXES
+				if (sv_rehlds_parallel_snapshots.value >= 1.0f)
+					datagramClients[numDatagramClients++] = cl;
+				else
+#endif
+					SV_SendClientDatagram(cl);
+			}
 			else
 				Netchan_Transmit(&cl->netchan, 0, NULL);
 		}
 	}
+
+#ifdef REHLDS_FIXES
+	if (SV_ShouldSendClientDatagramsParallel(numDatagramClients))
+	{
+		SV_SendClientDatagramsParallel(datagramClients, numDatagramClients);
+	}
+	else
+	{
+		for (int i = 0; i < numDatagramClients; i++)
+		{
+			host_client = datagramClients[i];
+			SV_SendClientDatagram(datagramClients[i]);
+		}
+	}
+#endif
+
+#ifndef _WIN32
+	NET_EndSendBatch();
+#endif // _WIN32
+
 	SV_CleanupEnts();
 }
 
@@ -5881,6 +7137,7 @@ void EXT_FUNC SV_ActivateServer_internal(int runPhysics)
 	SV_CreateResourceList();
 	g_psv.num_consistency = SV_TransferConsistencyInfo();
 #ifdef REHLDS_FIXES
+	SV_MD5CacheFlush();
 	MoveCheckedResourcesToFirstPositions();
 #endif // REHLDS_FIXES
 	for (i = 0, cl = g_psvs.clients; i < g_psvs.maxclients; cl++, i++)
@@ -6102,6 +7359,9 @@ int SV_SpawnServer(qboolean bIsDemo, char *server, char *startspot)
 	g_psv.signon.cursize = 0;
 
 	g_psv.num_edicts = g_psvs.maxclients + 1;
+#ifdef REHLDS_FIXES
+	ED_FreeListInvalidate();
+#endif
 
 	cl = g_psvs.clients;
 	for (i = 1; i < g_psvs.maxclients; i++, cl++)
@@ -6145,7 +7405,11 @@ int SV_SpawnServer(qboolean bIsDemo, char *server, char *startspot)
 		char szDllName[64];
 		Q_snprintf(szDllName, sizeof(szDllName), "cl_dlls//client.dll");
 		COM_FixSlashes(szDllName);
+#ifdef REHLDS_FIXES
+		if (!SV_MD5CacheHashFile(g_psv.clientdllmd5, szDllName))
+#else // REHLDS_FIXES
 		if (!MD5_Hash_File(g_psv.clientdllmd5, szDllName, FALSE, FALSE, NULL))
+#endif // REHLDS_FIXES
 		{
 			Con_Printf("Couldn't CRC client side dll:  %s\n", szDllName);
 			g_psv.active = FALSE;
@@ -6165,7 +7429,17 @@ int SV_SpawnServer(qboolean bIsDemo, char *server, char *startspot)
 			g_psv.active = FALSE;
 			return 0;
 		}
+#ifdef REHLDS_FIXES
+		if (!sv_rehlds_pas_cache.value || !CM_LoadPASCache(g_psv.worldmodel, g_psv.worldmapCRC))
+		{
+			CM_CalcPAS(g_psv.worldmodel);
+
+			if (sv_rehlds_pas_cache.value)
+				CM_SavePASCache(g_psv.worldmodel, g_psv.worldmapCRC);
+		}
+#else
 		CM_CalcPAS(g_psv.worldmodel);
+#endif
 	}
 
 	g_psv.models[1] = g_psv.worldmodel;
@@ -6310,6 +7584,223 @@ int EXT_FUNC RegUserMsg(const char *pszName, int iSize)
 	return pNewMsg->iMsg;
 }
 
+#ifdef REHLDS_OPT_PEDANTIC
+// User messages that were sent to the clients by id, the ones still in sv_gpNewUserMsgs are not here
+UserMsg *sv_UserMsgIndex[256];
+
+void SV_IndexUserMsgs(UserMsg *pMsgs)
+{
+	for (UserMsg *pMsg = pMsgs; pMsg; pMsg = pMsg->next)
+	{
+		if (pMsg->iMsg >= 0 && pMsg->iMsg < ARRAYSIZE(sv_UserMsgIndex))
+			sv_UserMsgIndex[pMsg->iMsg] = pMsg;
+	}
+}
+#endif // REHLDS_OPT_PEDANTIC
+
+UserMsg *SV_FindUserMsg(int iMsg, qboolean bSearchNew)
+{
+	UserMsg *pUserMsg;
+
+#ifdef REHLDS_OPT_PEDANTIC
+	pUserMsg = (iMsg >= 0 && iMsg < ARRAYSIZE(sv_UserMsgIndex)) ? sv_UserMsgIndex[iMsg] : NULL;
+#else // REHLDS_OPT_PEDANTIC
+	pUserMsg = sv_gpUserMsgs;
+	while (pUserMsg && pUserMsg->iMsg != iMsg)
+		pUserMsg = pUserMsg->next;
+#endif // REHLDS_OPT_PEDANTIC
+
+	if (!pUserMsg && bSearchNew)
+	{
+		pUserMsg = sv_gpNewUserMsgs;
+		while (pUserMsg && pUserMsg->iMsg != iMsg)
+			pUserMsg = pUserMsg->next;
+	}
+
+	return pUserMsg;
+}
+
+#ifdef REHLDS_FIXES
+// Message stats (sv_rehlds_msg_stats).
+// Messages of the game dll are counted by type and destination in PF_MessageEnd_I along with the bytes they add
+// to the destination buffers. For the client datagrams built by the engine the bytes of each svc_* are counted.
+msgstats_t g_MsgStats[256];
+
+msgstats_t *SV_GetMsgStats(int iMsg)
+{
+	if (iMsg < 0 || iMsg >= ARRAYSIZE(g_MsgStats))
+		return NULL;
+
+	return &g_MsgStats[iMsg];
+}
+
+void SV_ResetMsgStats(void)
+{
+	Q_memset(g_MsgStats, 0, sizeof(g_MsgStats));
+}
+
+void SV_CountMsg(int iMsg, int iDest)
+{
+	if (sv_rehlds_msg_stats.value == 0.0f || iMsg < 0 || iMsg >= ARRAYSIZE(g_MsgStats))
+		return;
+
+	msgstats_t *stats = &g_MsgStats[iMsg];
+	stats->count++;
+
+	if (iDest >= 0 && iDest < ARRAYSIZE(stats->dest))
+		stats->dest[iDest]++;
+}
+
+void SV_CountMsgBytes(int iMsg, int bytes)
+{
+	if (sv_rehlds_msg_stats.value == 0.0f || iMsg < 0 || iMsg >= ARRAYSIZE(g_MsgStats))
+		return;
+
+	g_MsgStats[iMsg].bytes += bytes;
+}
+
+void SV_CountDatagramBytes(int svc, int bytes)
+{
+	if (sv_rehlds_msg_stats.value == 0.0f || bytes <= 0)
+		return;
+
+	g_MsgStats[svc].datagramBytes += bytes;
+}
+
+static const char *SV_MsgStatsName(int iMsg)
+{
+	static char szName[32];
+
+	switch (iMsg)
+	{
+	case svc_time: return "svc_time";
+	case svc_clientdata: return "svc_clientdata";
+	case svc_packetentities: return "svc_packetentities";
+	case svc_deltapacketentities: return "svc_deltapacketentities";
+	case svc_event: return "svc_event";
+	case svc_pings: return "svc_pings";
+	case svc_temp_entity: return "svc_temp_entity";
+	default:
+		break;
+	}
+
+	UserMsg *pUserMsg = SV_FindUserMsg(iMsg, TRUE);
+	if (pUserMsg)
+		return pUserMsg->szName;
+
+	Q_snprintf(szName, sizeof(szName), "svc %i", iMsg);
+	return szName;
+}
+
+void SV_MsgStats_f(void)
+{
+	static const char *destNames[] = { "broadcast", "one", "all", "init", "pvs", "pas", "pvs_r", "pas_r", "one_unrel", "spec" };
+
+	if (Cmd_Argc() == 2 && !Q_stricmp(Cmd_Argv(1), "reset"))
+	{
+		SV_ResetMsgStats();
+		return;
+	}
+
+	if (sv_rehlds_msg_stats.value == 0.0f)
+		Con_Printf("sv_rehlds_msg_stats is disabled, the counters are not updated\n");
+
+	// highest traffic first
+	int order[ARRAYSIZE(g_MsgStats)];
+	int num = 0;
+	for (int i = 0; i < ARRAYSIZE(g_MsgStats); i++)
+	{
+		msgstats_t *stats = &g_MsgStats[i];
+		if (!stats->count && !stats->datagramBytes)
+			continue;
+
+		uint32 bytes = stats->bytes + stats->datagramBytes;
+
+		int j = num++;
+		while (j > 0 && g_MsgStats[order[j - 1]].bytes + g_MsgStats[order[j - 1]].datagramBytes < bytes)
+		{
+			order[j] = order[j - 1];
+			j--;
+		}
+		order[j] = i;
+	}
+
+	Con_Printf("%-24s %3s %10s %12s %12s  %s\n", "message", "id", "count", "bytes", "datagram", "destinations");
+
+	for (int i = 0; i < num; i++)
+	{
+		msgstats_t *stats = &g_MsgStats[order[i]];
+		char szDest[256];
+
+		szDest[0] = '\0';
+		for (int d = 0; d < ARRAYSIZE(stats->dest); d++)
+		{
+			if (!stats->dest[d])
+				continue;
+
+			char szCount[32];
+			Q_snprintf(szCount, sizeof(szCount), "%s%s:%u", szDest[0] ? " " : "", destNames[d], stats->dest[d]);
+			Q_strlcat(szDest, szCount);
+		}
+
+		Con_Printf("%-24s %3i %10u %12u %12u  %s\n", SV_MsgStatsName(order[i]), order[i], stats->count, stats->bytes, stats->datagramBytes, szDest);
+	}
+}
+
+// Frame profiler (sv_rehlds_profile).
+// SV_Frame is split into its phases and every hook called during the frame is timed under the module it lives in,
+// so the cost of each plugin shows up where it is spent. See rehlds/profiler.cpp.
+static void SV_ProfilePrintConsole(void *ctx, const char *line)
+{
+	Con_Printf("%s", line);
+}
+
+static void SV_ProfilePrintFile(void *ctx, const char *line)
+{
+	FS_FPrintf((FileHandle_t)ctx, "%s", line);
+}
+
+void SV_Profile_f(void)
+{
+	if (Cmd_Argc() == 2 && !Q_stricmp(Cmd_Argv(1), "reset"))
+	{
+		g_FrameProfiler.Reset();
+		return;
+	}
+
+	if (Cmd_Argc() == 3 && !Q_stricmp(Cmd_Argv(1), "dump"))
+	{
+		const char *name = Cmd_Argv(2);
+		if (Q_stricmp(COM_FileExtension((char *)name), "txt") != 0)
+		{
+			Con_Printf("Couldn't open %s (wrong file extension, must be .txt).\n", name);
+			return;
+		}
+
+		FileHandle_t f = FS_Open(name, "wt");
+		if (!f)
+		{
+			Con_Printf("Couldn't open %s\n", name);
+			return;
+		}
+
+		g_FrameProfiler.Print(SV_ProfilePrintFile, f);
+		FS_Close(f);
+
+		Con_Printf("Writing %s.\n", name);
+		return;
+	}
+
+	if (Cmd_Argc() != 1)
+	{
+		Con_Printf("Usage: rehlds_profile [reset | dump <file.txt>]\n");
+		return;
+	}
+
+	g_FrameProfiler.Print(SV_ProfilePrintConsole, NULL);
+}
+#endif // REHLDS_FIXES
+
 #ifdef REHLDS_FIXES
 uint32_t CIDRToMask(int cidr)
 {
@@ -6651,6 +8142,9 @@ void SV_BanId_f(void)
 
 	// give 3-rd party plugins a chance to serialize ID
 	g_RehldsHookchains.m_SerializeSteamId.callChain(SV_SerializeSteamid, id, &userfilters[i].userid);
+#ifdef REHLDS_FIXES
+	SV_InvalidateBanIndex();
+#endif // REHLDS_FIXES
 
 	if (banTime == 0.0f)
 		Q_sprintf(szreason, "permanently");
@@ -6959,6 +8453,9 @@ void SV_RemoveId_f(void)
 #endif // REHLDS_FIXES
 
 		numuserfilters--;
+#ifdef REHLDS_FIXES
+		SV_InvalidateBanIndex();
+#endif // REHLDS_FIXES
 		Con_Printf("UserID filter removed for %s, id %s\n", idstring, SV_GetIDString(&id));
 	}
 	else
@@ -6988,6 +8485,9 @@ void SV_RemoveId_f(void)
 #endif // REHLDS_FIXES
 
 				numuserfilters--;
+#ifdef REHLDS_FIXES
+				SV_InvalidateBanIndex();
+#endif // REHLDS_FIXES
 				Con_Printf("UserID filter removed for %s\n", idstring);
 				return;
 			}
@@ -7110,6 +8610,7 @@ void SV_AddIP_f(void)
 			ipfilters[i].banEndTime = (banTime == 0.0f) ? 0.0f : banTime * 60.0f + realtime;
 #ifdef REHLDS_FIXES
 			ipfilters[i].cidr = tempFilter.cidr;
+			SV_InvalidateBanIndex();
 #endif // REHLDS_FIXES
 			return;
 		}
@@ -7131,6 +8632,7 @@ void SV_AddIP_f(void)
 	ipfilters[i].mask = tempFilter.mask;
 #ifdef REHLDS_FIXES
 	ipfilters[i].cidr = tempFilter.cidr;
+	SV_InvalidateBanIndex();
 #endif // REHLDS_FIXES
 
 #ifdef REHLDS_FIXES
@@ -7210,6 +8712,7 @@ void SV_RemoveIP_f(void)
 			ipfilters[numipfilters].compare.u32 = 0;
 			ipfilters[numipfilters].mask = 0;
 #ifdef REHLDS_FIXES
+			SV_InvalidateBanIndex();
 			found = true;
 			--i;
 
@@ -7776,30 +9279,55 @@ void SV_CheckMapDifferences(void)
 
 void SV_Frame()
 {
+#ifdef REHLDS_FIXES
+	g_FrameProfiler.BeginFrame(sv_rehlds_profile.value != 0.0f);
+#endif
+
 	g_RehldsHookchains.m_SV_Frame.callChain(SV_Frame_Internal);
+
+#ifdef REHLDS_FIXES
+	g_FrameProfiler.EndFrame();
+#endif
 }
 
+#ifdef REHLDS_FIXES
+#define SV_PROFILE_PHASE(phase) g_FrameProfiler.Phase(phase)
+#else
+#define SV_PROFILE_PHASE(phase)
+#endif
+
 void EXT_FUNC SV_Frame_Internal()
 {
 	if (!g_psv.active)
 		return;
 
+#ifdef REHLDS_FIXES
+	ED_InvalidateFindIndex();
+#endif
+
 	gGlobalVariables.frametime = host_frametime;
 	g_psv.oldtime = g_psv.time;
 	SV_CheckCmdTimes();
+	SV_PROFILE_PHASE(PROF_READPACKETS);
 	SV_ReadPackets();
 	if (SV_IsSimulating())
 	{
+		SV_PROFILE_PHASE(PROF_PHYSICS);
 		SV_Physics();
 		g_psv.time += host_frametime;
 	}
+	SV_PROFILE_PHASE(PROF_NONE);
 	SV_QueryMovevarsChanged();
 	SV_RequestMissingResourcesFromClients();
 	SV_CheckTimeouts();
+	SV_PROFILE_PHASE(PROF_SENDMESSAGES);
 	SV_SendClientMessages();
+	SV_PROFILE_PHASE(PROF_NONE);
 	SV_CheckMapDifferences();
 	SV_GatherStatistics();
+	SV_PROFILE_PHASE(PROF_STEAM);
 	Steam_RunFrame();
+	SV_PROFILE_PHASE(PROF_NONE);
 }
 
 void SV_Drop_f(void)
@@ -7919,6 +9447,13 @@ void SV_Init(void)
 	Cmd_AddCommand("sendres", SV_SendRes_f);
 	Cmd_AddCommand("sendents", SV_SendEnts_f);
 	Cmd_AddCommand("fullupdate", SV_FullUpdate_f);
+#ifdef REHLDS_FIXES
+	Cmd_AddCommand("edict_stats", ED_PrintStats_f);
+	Cmd_AddCommand("msg_stats", SV_MsgStats_f);
+	Cmd_AddCommand("rehlds_profile", SV_Profile_f);
+	Cmd_AddCommand("model_cache_stats", Mod_CacheStats_f);
+	Cmd_AddCommand("md5_prewarm", SV_MD5Prewarm_f);
+#endif
 
 	Cvar_RegisterVariable(&sv_failuretime);
 	Cvar_RegisterVariable(&sv_voiceenable);
@@ -8020,6 +9555,23 @@ void SV_Init(void)
 	Cvar_RegisterVariable(&sv_rehlds_local_gametime);
 	Cvar_RegisterVariable(&sv_rehlds_send_mapcycle);
 	Cvar_RegisterVariable(&sv_rehlds_maxclients_from_single_ip);
+	Cvar_RegisterVariable(&sv_rehlds_parallel_snapshots);
+	Cvar_RegisterVariable(&sv_rehlds_visibility_cache);
+	Cvar_RegisterVariable(&sv_rehlds_delta_cache);
+	Cvar_RegisterVariable(&sv_rehlds_trace_index);
+	Cvar_RegisterVariable(&sv_rehlds_unlag_batch);
+	Cvar_RegisterVariable(&sv_rehlds_ban_index);
+	Cvar_RegisterVariable(&sv_rehlds_client_hash);
+	Cvar_RegisterVariable(&sv_rehlds_find_index);
+	Cvar_RegisterVariable(&sv_rehlds_sphere_index);
+	Cvar_RegisterVariable(&sv_rehlds_edict_freelist);
+	Cvar_RegisterVariable(&sv_rehlds_msg_stats);
+	Cvar_RegisterVariable(&sv_rehlds_profile);
+	Cvar_RegisterVariable(&sv_rehlds_batch_projectiles);
+	Cvar_RegisterVariable(&sv_rehlds_pas_cache);
+	Cvar_RegisterVariable(&sv_rehlds_pas_threads);
+	Cvar_RegisterVariable(&sv_rehlds_model_cache);
+	Cvar_RegisterVariable(&sv_rehlds_md5_cache);
 
 	Cvar_RegisterVariable(&sv_rollspeed);
 	Cvar_RegisterVariable(&sv_rollangle);
@@ -8053,6 +9605,22 @@ void SV_Init(void)
 
 void SV_Shutdown(void)
 {
+#ifdef REHLDS_FIXES
+	SV_ShutdownSnapshotWorkers();
+	CM_ShutdownPASWorkers();
+	SV_FreeVisibilityCache();
+	SV_FreeDeltaCache();
+	SV_AreaIndexFree();
+	SV_SphereGridFree();
+	SV_FreeBanIndex();
+	ED_FreeFindIndex();
+	ED_FreeListShutdown();
+	g_FrameProfiler.Free();
+	SV_WorldBoxFree();
+	SV_ProjectileBatchFree();
+	Mod_CacheFree();
+	SV_MD5CacheFree();
+#endif
 #if (defined(REHLDS_OPT_PEDANTIC) || defined(REHLDS_FIXES)) && defined REHLDS_JIT
 	g_DeltaJitRegistry.Cleanup();
 #endif
@@ -1469,12 +1469,222 @@ void SV_Physics_Step(edict_t *ent)
 	SV_CheckWaterTransition(ent);
 }
 
+#ifdef REHLDS_FIXES
+// Projectile batch (sv_rehlds_batch_projectiles).
+// The free flying toss, bounce and fly entities are gathered into packed arrays at the start of the frame,
+// then the move each of them is about to make is predicted four at a time and its swept bounds are proven empty
+// against the world hull it traces (see the world boxes in world.cpp). Every entity still runs its own physics
+// in edict order afterwards, thinks, touches and entity clipping included, only the world hull part of its traces
+// is skipped while the move stays inside its box. A bad prediction costs a normal trace, never a different result.
+const int PROJBATCH_GROUP = 4;
+
+typedef struct projbatch_s
+{
+	int count;
+	int capacity;		// multiple of PROJBATCH_GROUP
+	int *nums;
+	float *origin[3];
+	float *velocity[3];	// with the base velocity
+	float *gravity;		// 0 for the movetypes without gravity
+	float *mins[3];		// swept bounds of the predicted move
+	float *maxs[3];
+	float *pad;			// room given to the world box for the next frames
+} projbatch_t;
+
+static projbatch_t g_ProjBatch;
+
+void SV_ProjectileBatchFree()
+{
+	if (g_ProjBatch.nums)
+	{
+		Mem_Free(g_ProjBatch.nums);
+		Mem_Free(g_ProjBatch.origin[0]);
+	}
+
+	Q_memset(&g_ProjBatch, 0, sizeof(g_ProjBatch));
+}
+
+static void SV_ProjectileBatchAlloc(int capacity)
+{
+	SV_ProjectileBatchFree();
+
+	// the float arrays share one block, each of them starts on a group boundary
+	float *data = (float *)Mem_ZeroMalloc(14 * capacity * sizeof(float));
+	g_ProjBatch.nums = (int *)Mem_ZeroMalloc(capacity * sizeof(int));
+	g_ProjBatch.capacity = capacity;
+
+	for (int i = 0; i < 3; i++)
+	{
+		g_ProjBatch.origin[i] = &data[i * capacity];
+		g_ProjBatch.velocity[i] = &data[(i + 3) * capacity];
+		g_ProjBatch.mins[i] = &data[(i + 6) * capacity];
+		g_ProjBatch.maxs[i] = &data[(i + 9) * capacity];
+	}
+
+	g_ProjBatch.gravity = &data[12 * capacity];
+	g_ProjBatch.pad = &data[13 * capacity];
+}
+
+static void SV_ProjectileBatchGather()
+{
+	projbatch_t *b = &g_ProjBatch;
+	int capacity = (g_psv.max_edicts + PROJBATCH_GROUP - 1) & ~(PROJBATCH_GROUP - 1);
+
+	if (b->capacity != capacity)
+		SV_ProjectileBatchAlloc(capacity);
+
+	b->count = 0;
+
+	for (int i = g_psvs.maxclients + 1; i < g_psv.num_edicts; i++)
+	{
+		edict_t *ent = &g_psv.edicts[i];
+		if (ent->free)
+			continue;
+
+		float gravity;
+		switch (ent->v.movetype)
+		{
+		case MOVETYPE_TOSS:
+		case MOVETYPE_BOUNCE:
+			gravity = ent->v.gravity ? ent->v.gravity : 1.0f;
+			break;
+		case MOVETYPE_BOUNCEMISSILE:
+		case MOVETYPE_FLY:
+		case MOVETYPE_FLYMISSILE:
+			gravity = 0.0f;
+			break;
+		default:
+			continue;
+		}
+
+		// at rest
+		if ((ent->v.flags & FL_ONGROUND) && VectorIsZero(ent->v.velocity) && VectorIsZero(ent->v.basevelocity))
+			continue;
+
+		int n = b->count++;
+		b->nums[n] = i;
+		b->gravity[n] = gravity;
+
+		for (int j = 0; j < 3; j++)
+		{
+			b->origin[j][n] = ent->v.origin[j];
+			b->velocity[j][n] = ent->v.velocity[j] + ent->v.basevelocity[j];
+		}
+	}
+
+	// clear the tail of the last group
+	for (int n = b->count; n & (PROJBATCH_GROUP - 1); n++)
+	{
+		b->gravity[n] = 0.0f;
+
+		for (int j = 0; j < 3; j++)
+		{
+			b->origin[j][n] = 0.0f;
+			b->velocity[j][n] = 0.0f;
+		}
+	}
+}
+
+// Predicts the moves of the frame and their swept bounds
+static void SV_ProjectileBatchIntegrate()
+{
+	projbatch_t *b = &g_ProjBatch;
+	float frametime = (float)host_frametime;
+	float gravitytime = sv_gravity.value * frametime;
+	int numgroups = (b->count + PROJBATCH_GROUP - 1) / PROJBATCH_GROUP;
+
+#ifdef REHLDS_SSE
+	__m128 dt = _mm_set1_ps(frametime);
+	__m128 gdt = _mm_set1_ps(gravitytime);
+	__m128 absmask = _mm_castsi128_ps(_mm_set1_epi32(0x7FFFFFFF));
+
+	for (int g = 0; g < numgroups; g++)
+	{
+		int n = g * PROJBATCH_GROUP;
+		__m128 reach = _mm_setzero_ps();
+
+		for (int j = 0; j < 3; j++)
+		{
+			__m128 vel = _mm_loadu_ps(&b->velocity[j][n]);
+			if (j == 2)
+				vel = _mm_sub_ps(vel, _mm_mul_ps(_mm_loadu_ps(&b->gravity[n]), gdt));
+
+			__m128 move = _mm_mul_ps(vel, dt);
+			__m128 start = _mm_loadu_ps(&b->origin[j][n]);
+			__m128 end = _mm_add_ps(start, move);
+
+			_mm_storeu_ps(&b->mins[j][n], _mm_min_ps(start, end));
+			_mm_storeu_ps(&b->maxs[j][n], _mm_max_ps(start, end));
+			reach = _mm_max_ps(reach, _mm_and_ps(move, absmask));
+		}
+
+		_mm_storeu_ps(&b->pad[n], _mm_add_ps(_mm_add_ps(reach, reach), _mm_set1_ps(4.0f)));
+	}
+#else
+	for (int n = 0; n < numgroups * PROJBATCH_GROUP; n++)
+	{
+		float reach = 0.0f;
+
+		for (int j = 0; j < 3; j++)
+		{
+			float vel = b->velocity[j][n];
+			if (j == 2)
+				vel -= b->gravity[n] * gravitytime;
+
+			float move = vel * frametime;
+			float start = b->origin[j][n];
+			float end = start + move;
+
+			b->mins[j][n] = Q_min(start, end);
+			b->maxs[j][n] = Q_max(start, end);
+			reach = Q_max(reach, (float)fabs(move));
+		}
+
+		b->pad[n] = reach + reach + 4.0f;
+	}
+#endif // REHLDS_SSE
+}
+
+static void SV_BatchProjectiles()
+{
+	edict_t *world = g_psv.edicts;
+	if (world->v.solid != SOLID_BSP || Mod_GetType(world->v.modelindex) != mod_brush || !VectorIsZero(world->v.angles))
+		return;
+
+	SV_ProjectileBatchGather();
+	SV_ProjectileBatchIntegrate();
+
+	projbatch_t *b = &g_ProjBatch;
+	for (int n = 0; n < b->count; n++)
+	{
+		edict_t *ent = &g_psv.edicts[b->nums[n]];
+		vec3_t offset, mins, maxs;
+
+		// the hull the world traces of this entity will use
+		hull_t *hull = SV_HullForEntity(world, ent->v.mins, ent->v.maxs, offset);
+
+		for (int j = 0; j < 3; j++)
+		{
+			mins[j] = b->mins[j][n] - offset[j];
+			maxs[j] = b->maxs[j][n] - offset[j];
+		}
+
+		SV_WorldBoxUpdate(b->nums[n], hull, mins, maxs, b->pad[n]);
+	}
+}
+#endif // REHLDS_FIXES
+
 void SV_Physics()
 {
 	// let the progs know that a new frame has started
 	gGlobalVariables.time = g_psv.time;
 	gEntityInterface.pfnStartFrame();
 
+#ifdef REHLDS_FIXES
+	if (SV_WorldBoxUsable())
+		SV_BatchProjectiles();
+#endif
+
 	// treat each object in turn
 	for (int i = 0; i < g_psv.num_edicts; i++)
 	{
@@ -67,3 +67,7 @@ void PF_WaterMove(edict_t *pSelf);
 void SV_Physics_Step(edict_t *ent);
 void SV_Physics(void);
 trace_t SV_Trace_Toss(edict_t *ent, edict_t *ignore);
+
+#ifdef REHLDS_FIXES
+void SV_ProjectileBatchFree();
+#endif
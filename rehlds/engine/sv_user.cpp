@@ -41,6 +41,17 @@ edict_t *sv_player;
 //int giSkip;
 qboolean nofind;
 
+#ifdef REHLDS_FIXES
+// Lag compensation batching (sv_rehlds_unlag_batch).
+// All usercmds of one clc_move share the same interpolation target, so the positions rewound for the first
+// command are kept for the following ones instead of being restored and rewound again after every command.
+// The players are put back once the packet is processed, or earlier if the game dll touched a rewound player.
+static qboolean g_bUnlagBatch;				// set while SV_ParseMove runs the commands
+static client_t *g_pUnlagBatchClient;		// client whose rewound positions are still applied
+static vec3_t g_UnlagBatchAbsMin[MAX_CLIENTS];
+static vec3_t g_UnlagBatchAbsMax[MAX_CLIENTS];
+#endif
+
 #if defined(SWDS) && defined(REHLDS_FIXES)
 const char *clcommands[] = { "status", "name", "kill", "pause", "spawn", "new", "sendres", "dropclient", "kick", "ping", "dlfile", "setinfo", "sendents", "fullupdate", "setpause", "unpause", NULL };
 #else
@@ -282,7 +293,11 @@ int EXT_FUNC SV_TransferConsistencyInfo_internal(void)
 		{
 			Q_snprintf(filename, MAX_PATH, "sound/%s", r->szFileName);
 		}
+#ifdef REHLDS_FIXES
+		SV_MD5CacheHashFile(r->rgucMD5_hash, filename);
+#else // REHLDS_FIXES
 		MD5_Hash_File(r->rgucMD5_hash, filename, FALSE, FALSE, NULL);
+#endif // REHLDS_FIXES
 
 		if (r->type == t_model)
 		{
@@ -1183,6 +1198,64 @@ entity_state_t *SV_FindEntInPack(int index, packet_entities_t *pack)
 	return NULL;
 }
 
+#ifdef REHLDS_FIXES
+// Leaves the rewound positions applied for the next command of the same client
+void SV_HoldUnlagBatch(client_t *_host_client)
+{
+	for (int i = 0; i < g_psvs.maxclients; i++)
+	{
+		if (!truepositions[i].needrelink)
+			continue;
+
+		edict_t *ent = g_psvs.clients[i].edict;
+		VectorCopy(ent->v.absmin, g_UnlagBatchAbsMin[i]);
+		VectorCopy(ent->v.absmax, g_UnlagBatchAbsMax[i]);
+	}
+
+	g_pUnlagBatchClient = _host_client;
+}
+
+// Checks that the held positions are still what SV_SetupMove would produce for this client
+qboolean SV_ResumeUnlagBatch(client_t *_host_client)
+{
+	if (g_pUnlagBatchClient != _host_client || !gEntityInterface.pfnAllowLagCompensation())
+		return FALSE;
+
+	for (int i = 0; i < g_psvs.maxclients; i++)
+	{
+		sv_adjusted_positions_t *pos = &truepositions[i];
+		if (!pos->needrelink)
+			continue;
+
+		client_t *cl = &g_psvs.clients[i];
+		if (!cl->active)
+			return FALSE;
+
+		edict_t *ent = cl->edict;
+		if (!VectorCompare(pos->initial_correction_org, ent->v.origin)
+			|| !VectorCompare(g_UnlagBatchAbsMin[i], ent->v.absmin)
+			|| !VectorCompare(g_UnlagBatchAbsMax[i], ent->v.absmax))
+			return FALSE;
+	}
+
+	return TRUE;
+}
+
+void SV_FlushUnlagBatch()
+{
+	client_t *cl = g_pUnlagBatchClient;
+	if (!cl)
+		return;
+
+	qboolean batch = g_bUnlagBatch;
+
+	g_pUnlagBatchClient = nullptr;
+	g_bUnlagBatch = FALSE;
+	SV_RestoreMove(cl);
+	g_bUnlagBatch = batch;
+}
+#endif // REHLDS_FIXES
+
 void SV_SetupMove(client_t *_host_client)
 {
 	struct client_s *cl;
@@ -1204,6 +1277,16 @@ void SV_SetupMove(client_t *_host_client)
 	float targettime;
 #endif // REHLDS_FIXES
 
+#ifdef REHLDS_FIXES
+	if (g_pUnlagBatchClient)
+	{
+		if (SV_ResumeUnlagBatch(_host_client))
+			return;
+
+		SV_FlushUnlagBatch();
+	}
+#endif
+
 	Q_memset(truepositions, 0, sizeof(truepositions));
 	nofind = 1;
 	if (!gEntityInterface.pfnAllowLagCompensation())
@@ -1409,6 +1492,14 @@ void SV_RestoreMove(client_t *_host_client)
 	sv_adjusted_positions_t *pos;
 	client_t *cli;
 
+#ifdef REHLDS_FIXES
+	if (g_bUnlagBatch && !nofind)
+	{
+		SV_HoldUnlagBatch(_host_client);
+		return;
+	}
+#endif
+
 	if (nofind)
 	{
 		nofind = 0;
@@ -1670,6 +1761,11 @@ void SV_ParseMove(client_t *pSenderClient)
 	sv_player->v.light_level = cmds[0].lightlevel;
 #endif
 	SV_EstablishTimeBase(host_client, cmds, net_drop, numbackup, numcmds);
+
+#ifdef REHLDS_FIXES
+	g_bUnlagBatch = (sv_rehlds_unlag_batch.value != 0.0f) ? TRUE : FALSE;
+#endif
+
 	if (net_drop < 24)
 	{
 		while (net_drop > numbackup)
@@ -1692,6 +1788,9 @@ void SV_ParseMove(client_t *pSenderClient)
 	}
 
 #ifdef REHLDS_FIXES
+	g_bUnlagBatch = FALSE;
+	SV_FlushUnlagBatch();
+
 	if (numcmds)
 		host_client->lastcmd = cmds[numcmds - 1];
 	else if (numbackup)
@@ -1815,7 +1914,7 @@ void SV_ExecuteClientMessage(client_t *cl)
 {
 	g_balreadymoved = 0;
 	client_frame_t * frame = &cl->frames[SV_UPDATE_MASK & cl->netchan.incoming_acknowledged];
-	frame->ping_time = realtime - frame->senttime - cl->next_messageinterval;
+	frame->ping_time = net_time - frame->senttime - cl->next_messageinterval;
 	if (frame->senttime == 0.0)
 		frame->ping_time = 0;
 
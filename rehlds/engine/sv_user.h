@@ -98,6 +98,11 @@ int SV_UnlagCheckTeleport(vec_t *v1, vec_t *v2);
 void SV_GetTrueOrigin(int player, vec_t *origin);
 void SV_GetTrueMinMax(int player, float **fmin, float **fmax);
 entity_state_t *SV_FindEntInPack(int index, packet_entities_t *pack);
+#ifdef REHLDS_FIXES
+void SV_HoldUnlagBatch(client_t *_host_client);
+qboolean SV_ResumeUnlagBatch(client_t *_host_client);
+void SV_FlushUnlagBatch();
+#endif
 void SV_SetupMove(client_t *_host_client);
 void SV_RestoreMove(client_t *_host_client);
 void SV_ParseStringCommand(client_t *pSenderClient);
@@ -415,7 +415,7 @@ void Sys_Sleep(int msec)
 #ifdef _WIN32
 	Sleep(msec);
 #else
-	usleep(1000 * msec);
+	CRehldsPlatformHolder::get()->Sleep(msec);
 #endif // _WIN32
 }
 
@@ -606,9 +606,9 @@ double Sys_FloatTime(void)
 	if ( !bInitialized )
 	{
 		bInitialized = true;
-		clock_gettime(CLOCK_MONOTONIC, &start_time);
+		CRehldsPlatformHolder::get()->clock_gettime(CLOCK_MONOTONIC, &start_time);
 	}
-	clock_gettime(CLOCK_MONOTONIC, &now);
+	CRehldsPlatformHolder::get()->clock_gettime(CLOCK_MONOTONIC, &now);
 	return (now.tv_sec - start_time.tv_sec) + now.tv_nsec * 0.000000001;
 }
 
@@ -642,6 +642,12 @@ NOXREF int BuildMapCycleListHints(char **hints)
 
 bool CDedicatedServerAPI::Init(const char *basedir, const char *cmdline, CreateInterfaceFn launcherFactory, CreateInterfaceFn filesystemFactory)
 {
+#ifndef _WIN32
+	// Done by DllMain on Windows
+	g_RehldsRuntimeConfig.parseFromCommandLine(TestSuite_GetCommandLine());
+	TestSuite_Init(NULL, NULL, NULL);
+#endif // _WIN32
+
 	dedicated_ = (IDedicatedExports *)launcherFactory(VENGINE_DEDICATEDEXPORTS_API_VERSION, NULL);
 	if (!dedicated_)
 		return false;
@@ -301,6 +301,12 @@ void SV_ClearWorld()
 	Q_memset(sv_areanodes, 0, sizeof(sv_areanodes));
 	sv_numareanodes = 0;
 	SV_CreateAreaNode(0, g_psv.worldmodel->mins, g_psv.worldmodel->maxs);
+
+#ifdef REHLDS_FIXES
+	SV_AreaIndexInvalidate();
+	SV_SphereGridInvalidate();
+	SV_WorldBoxInvalidate();
+#endif
 }
 
 // call before removing an entity, and before trying to move one,
@@ -314,6 +320,10 @@ void SV_UnlinkEdict(edict_t *ent)
 		return;
 	}
 
+#ifdef REHLDS_FIXES
+	SV_AreaIndexUnlink(ent);
+#endif
+
 	RemoveLink(&ent->area);
 	ent->area.prev = ent->area.next = nullptr;
 }
@@ -518,6 +528,10 @@ void SV_LinkEdict(edict_t *ent, qboolean touch_triggers)
 	// set the abs box
 	gEntityInterface.pfnSetAbsBox(ent);
 
+#ifdef REHLDS_FIXES
+	SV_SphereGridUpdate(ent);
+#endif
+
 	if (ent->v.movetype == MOVETYPE_FOLLOW && ent->v.aiment)
 	{
 		ent->headnode = ent->v.aiment->headnode;
@@ -572,8 +586,14 @@ void SV_LinkEdict(edict_t *ent, qboolean touch_triggers)
 	if (ent->v.solid == SOLID_TRIGGER)
 		InsertLinkBefore(&ent->area, &node->trigger_edicts);
 	else
+	{
 		InsertLinkBefore(&ent->area, &node->solid_edicts);
 
+#ifdef REHLDS_FIXES
+		SV_AreaIndexLink(ent, node);
+#endif
+	}
+
 	if (touch_triggers && !iTouchLinkSemaphore)
 	{
 		iTouchLinkSemaphore = 1;
@@ -1157,117 +1177,135 @@ trace_t SV_ClipMoveToEntity(edict_t *ent, const vec_t *start, const vec_t *mins,
 	return trace;
 }
 
-// Mins and maxs enclose the entire area swept by the move
-void SV_ClipToLinks(areanode_t *node, moveclip_t *clip)
+// Clips the move against one linked edict.
+// Returns false when the rest of the node has to be skipped.
+qboolean SV_ClipToLink(edict_t *touch, moveclip_t *clip)
 {
-	link_t *next, *l;
-	edict_t *touch;
-
-	// touch linked edicts
-	for (l = node->solid_edicts.next; l != &node->solid_edicts; l = next)
+	if (touch->v.groupinfo && clip->passedict && clip->passedict->v.groupinfo)
 	{
-		next = l->next;
-		touch = EDICT_FROM_AREA(l);
-
-		if (touch->v.groupinfo && clip->passedict && clip->passedict->v.groupinfo)
+		if (g_groupop)
 		{
-			if (g_groupop)
-			{
-				if (g_groupop == GROUP_OP_NAND && (clip->passedict->v.groupinfo & touch->v.groupinfo))
-					continue;
-			}
-			else
-			{
-				if (!(clip->passedict->v.groupinfo & touch->v.groupinfo))
-					continue;
-			}
+			if (g_groupop == GROUP_OP_NAND && (clip->passedict->v.groupinfo & touch->v.groupinfo))
+				return TRUE;
 		}
+		else
+		{
+			if (!(clip->passedict->v.groupinfo & touch->v.groupinfo))
+				return TRUE;
+		}
+	}
 
-		if (touch->v.solid == SOLID_NOT || touch == clip->passedict)
-			continue;
+	if (touch->v.solid == SOLID_NOT || touch == clip->passedict)
+		return TRUE;
 
-		if (touch->v.solid == SOLID_TRIGGER)
-			Sys_Error("%s: Trigger in clipping list", __func__);
+	if (touch->v.solid == SOLID_TRIGGER)
+		Sys_Error("%s: Trigger in clipping list", __func__);
 
-		if (gNewDLLFunctions.pfnShouldCollide && !gNewDLLFunctions.pfnShouldCollide(touch, clip->passedict))
+	if (gNewDLLFunctions.pfnShouldCollide && !gNewDLLFunctions.pfnShouldCollide(touch, clip->passedict))
 #ifdef REHLDS_FIXES
-			// https://github.com/dreamstalker/rehlds/issues/46
-			continue;
+		// https://github.com/dreamstalker/rehlds/issues/46
+		return TRUE;
 #else
-			return;
+		return FALSE;
 #endif
 
-		// monsterclip filter
-		if (touch->v.solid == SOLID_BSP)
-		{
-			if ((touch->v.flags & FL_MONSTERCLIP) && !clip->monsterClipBrush)
-				continue;
-		}
-		else
-		{
-			// ignore all monsters but pushables
-			if (clip->type == MOVE_NOMONSTERS && touch->v.movetype != MOVETYPE_PUSHSTEP)
-				continue;
-		}
+	// monsterclip filter
+	if (touch->v.solid == SOLID_BSP)
+	{
+		if ((touch->v.flags & FL_MONSTERCLIP) && !clip->monsterClipBrush)
+			return TRUE;
+	}
+	else
+	{
+		// ignore all monsters but pushables
+		if (clip->type == MOVE_NOMONSTERS && touch->v.movetype != MOVETYPE_PUSHSTEP)
+			return TRUE;
+	}
 
-		if (clip->ignoretrans && touch->v.rendermode != kRenderNormal && !(touch->v.flags & FL_WORLDBRUSH))
-			continue;
+	if (clip->ignoretrans && touch->v.rendermode != kRenderNormal && !(touch->v.flags & FL_WORLDBRUSH))
+		return TRUE;
 
-		if (clip->boxmins[0] > touch->v.absmax[0]
-		|| clip->boxmins[1] > touch->v.absmax[1]
-		|| clip->boxmins[2] > touch->v.absmax[2]
-		|| clip->boxmaxs[0] < touch->v.absmin[0]
-		|| clip->boxmaxs[1] < touch->v.absmin[1]
-		|| clip->boxmaxs[2] < touch->v.absmin[2])
-			continue;
+	if (clip->boxmins[0] > touch->v.absmax[0]
+	|| clip->boxmins[1] > touch->v.absmax[1]
+	|| clip->boxmins[2] > touch->v.absmax[2]
+	|| clip->boxmaxs[0] < touch->v.absmin[0]
+	|| clip->boxmaxs[1] < touch->v.absmin[1]
+	|| clip->boxmaxs[2] < touch->v.absmin[2])
+		return TRUE;
 
-		if (touch->v.solid != SOLID_SLIDEBOX
+	if (touch->v.solid != SOLID_SLIDEBOX
 #ifdef REHLDS_FIXES
-			|| sv_force_ent_intersection.value
+		|| sv_force_ent_intersection.value
 #endif
 )
-		{
-			if (!SV_CheckSphereIntersection(touch, clip->start, clip->end))
-				continue;
-		}
+	{
+		if (!SV_CheckSphereIntersection(touch, clip->start, clip->end))
+			return TRUE;
+	}
 
-		if (clip->passedict && clip->passedict->v.size[0] && !touch->v.size[0])
-			continue; // points never interact
+	if (clip->passedict && clip->passedict->v.size[0] && !touch->v.size[0])
+		return TRUE; // points never interact
 
-		// might intersect, so do an exact clip
-		if (clip->trace.allsolid)
-			return;
+	// might intersect, so do an exact clip
+	if (clip->trace.allsolid)
+		return FALSE;
 
-		if (clip->passedict)
-		{
-			if (touch->v.owner == clip->passedict)
-				continue; // don't clip against own missiles
+	if (clip->passedict)
+	{
+		if (touch->v.owner == clip->passedict)
+			return TRUE; // don't clip against own missiles
 
-			if (clip->passedict->v.owner == touch)
-				continue; // don't clip against owner
-		}
+		if (clip->passedict->v.owner == touch)
+			return TRUE; // don't clip against owner
+	}
 
-		trace_t trace;
-		if (touch->v.flags & FL_MONSTER)
-			trace = SV_ClipMoveToEntity(touch, clip->start, clip->mins2, clip->maxs2, clip->end);
-		else
-			trace = SV_ClipMoveToEntity(touch, clip->start, clip->mins, clip->maxs, clip->end);
+	trace_t trace;
+	if (touch->v.flags & FL_MONSTER)
+		trace = SV_ClipMoveToEntity(touch, clip->start, clip->mins2, clip->maxs2, clip->end);
+	else
+		trace = SV_ClipMoveToEntity(touch, clip->start, clip->mins, clip->maxs, clip->end);
 
-		if (trace.allsolid || trace.startsolid || trace.fraction < clip->trace.fraction)
+	if (trace.allsolid || trace.startsolid || trace.fraction < clip->trace.fraction)
+	{
+		trace.ent = touch;
+		if (clip->trace.startsolid)
 		{
-			trace.ent = touch;
-			if (clip->trace.startsolid)
-			{
-				clip->trace = trace;
-				clip->trace.startsolid = TRUE;
-			}
-			else
-			{
-				clip->trace = trace;
-			}
+			clip->trace = trace;
+			clip->trace.startsolid = TRUE;
+		}
+		else
+		{
+			clip->trace = trace;
 		}
 	}
 
+	return TRUE;
+}
+
+// Mins and maxs enclose the entire area swept by the move
+void SV_ClipToLinks(areanode_t *node, moveclip_t *clip)
+{
+	link_t *next, *l;
+	edict_t *touch;
+
+#ifdef REHLDS_FIXES
+	if (SV_AreaIndexUsable())
+	{
+		SV_ClipToAreaIndex(node, clip);
+		return;
+	}
+#endif
+
+	// touch linked edicts
+	for (l = node->solid_edicts.next; l != &node->solid_edicts; l = next)
+	{
+		next = l->next;
+		touch = EDICT_FROM_AREA(l);
+
+		if (!SV_ClipToLink(touch, clip))
+			return;
+	}
+
 	// recurse down both sides
 	if (node->axis == -1)
 		return;
@@ -1279,120 +1317,1046 @@ void SV_ClipToLinks(areanode_t *node, moveclip_t *clip)
 		SV_ClipToLinks(node->children[1], clip);
 }
 
-// Mins and maxs enclose the entire area swept by the move
-void SV_ClipToWorldbrush(areanode_t *node, moveclip_t *clip)
+#ifdef REHLDS_FIXES
+// The trace and sphere indexes take the bounds of an edict when it is linked. The engine only changes
+// absmin/absmax in SV_LinkEdict, but a game dll may write them directly without relinking, so both indexes
+// compare what they filed with the live bounds once per frame and are not used for the rest of the map
+// if anything differs.
+typedef struct boundscheck_s
 {
-	link_t *l;
-	link_t *next;
-	edict_t *touch;
+	qboolean disabled;	// bounds changed without a relink on this map
+	double verifytime;
+} boundscheck_t;
 
-	for (l = node->solid_edicts.next; l != &node->solid_edicts; l = next)
+typedef edict_t *(*boundsverify_t)();
+
+// Returns false if the index must not be used, verify returns the first edict whose bounds don't match
+static qboolean SV_BoundsCheck(boundscheck_t *check, boundsverify_t verify, const char *cvarname)
+{
+	if (check->disabled)
+		return FALSE;
+
+	if (check->verifytime == g_psv.time)
+		return TRUE;
+
+	check->verifytime = g_psv.time;
+
+	edict_t *ent = verify();
+	if (!ent)
+		return TRUE;
+
+	Con_DPrintf("%s: bounds of entity %d changed without relinking, %s is off until the next map\n", __func__, NUM_FOR_EDICT(ent), cvarname);
+	check->disabled = TRUE;
+	return FALSE;
+}
+
+// Area index (sv_rehlds_trace_index).
+// Every area node keeps the bounds of its solid edicts packed in groups of four (x/y/z mins, then x/y/z maxs),
+// so the move box is tested against four edicts at once and only the overlapping ones go to SV_ClipToLink.
+// Entries are appended in link order and removed ones are left as empty boxes until the node is compacted,
+// this way the candidates are visited in the same order as the solid_edicts list.
+// The bounds are taken at link time, which is where the area node of an edict is chosen as well.
+const int AREAINDEX_GROUP = 4;
+const float AREAINDEX_EMPTY = 1e30f;
+
+typedef struct areaindex_node_s
+{
+	int count;			// used entries including removed ones
+	int removed;
+	int capacity;		// multiple of AREAINDEX_GROUP
+	float *bounds;		// 6 * AREAINDEX_GROUP floats per group
+	edict_t **edicts;	// nullptr for removed entries
+	vec3_t absmin;		// union of the bounds added since the last compaction
+	vec3_t absmax;
+} areaindex_node_t;
+
+typedef struct areaindex_slot_s
+{
+	short node;			// -1 if the edict is not in the index
+	short pad;
+	int slot;
+} areaindex_slot_t;
+
+typedef struct areaindex_s
+{
+	qboolean valid;
+	boundscheck_t check;
+	int maxedicts;
+	areaindex_slot_t *slots;
+	areaindex_node_t nodes[AREA_NODES];
+} areaindex_t;
+
+static areaindex_t g_AreaIndex;
+
+static void SV_AreaIndexClearNode(areaindex_node_t *inode)
+{
+	inode->count = 0;
+	inode->removed = 0;
+
+	for (int i = 0; i < 3; i++)
 	{
-		next = l->next;
-		touch = EDICT_FROM_AREA(l);
+		inode->absmin[i] = AREAINDEX_EMPTY;
+		inode->absmax[i] = -AREAINDEX_EMPTY;
+	}
+}
 
-		if (touch->v.solid != SOLID_BSP)
-			continue;
+static void SV_AreaIndexSetBounds(areaindex_node_t *inode, int slot, const vec_t *absmin, const vec_t *absmax)
+{
+	float *group = &inode->bounds[(slot / AREAINDEX_GROUP) * 6 * AREAINDEX_GROUP];
+	int lane = slot % AREAINDEX_GROUP;
 
-		if (!(touch->v.flags & FL_WORLDBRUSH))
-			continue;
+	for (int i = 0; i < 3; i++)
+	{
+		group[i * AREAINDEX_GROUP + lane] = absmin[i];
+		group[(i + 3) * AREAINDEX_GROUP + lane] = absmax[i];
+	}
+}
 
-		if (clip->boxmins[0] > touch->v.absmax[0]
-		|| clip->boxmins[1] > touch->v.absmax[1]
-		|| clip->boxmins[2] > touch->v.absmax[2]
-		|| clip->boxmaxs[0] < touch->v.absmin[0]
-		|| clip->boxmaxs[1] < touch->v.absmin[1]
-		|| clip->boxmaxs[2] < touch->v.absmin[2])
-			continue;
+static void SV_AreaIndexClearBounds(areaindex_node_t *inode, int slot)
+{
+	static const vec3_t emptymin = { AREAINDEX_EMPTY, AREAINDEX_EMPTY, AREAINDEX_EMPTY };
+	static const vec3_t emptymax = { -AREAINDEX_EMPTY, -AREAINDEX_EMPTY, -AREAINDEX_EMPTY };
 
-		if (clip->trace.allsolid)
-			return;
+	SV_AreaIndexSetBounds(inode, slot, emptymin, emptymax);
+}
 
-		trace_t trace = SV_ClipMoveToEntity(touch, clip->start, clip->mins, clip->maxs, clip->end);
-		if (trace.allsolid || trace.startsolid || trace.fraction < clip->trace.fraction)
+static void SV_AreaIndexAppend(areaindex_node_t *inode, int nodenum, edict_t *ent)
+{
+	if (inode->count >= inode->capacity)
+	{
+		int capacity = inode->capacity ? inode->capacity * 2 : 16;
+
+		inode->bounds = (float *)Mem_Realloc(inode->bounds, (capacity / AREAINDEX_GROUP) * 6 * AREAINDEX_GROUP * sizeof(float));
+		inode->edicts = (edict_t **)Mem_Realloc(inode->edicts, capacity * sizeof(edict_t *));
+
+		for (int i = inode->capacity; i < capacity; i++)
 		{
-			trace.ent = touch;
-			if (clip->trace.startsolid)
-			{
-				clip->trace = trace;
-				clip->trace.startsolid = TRUE;
-			}
-			else
-			{
-				clip->trace = trace;
-			}
+			inode->edicts[i] = nullptr;
+			SV_AreaIndexClearBounds(inode, i);
 		}
+
+		inode->capacity = capacity;
 	}
 
-	// recurse down both sides
-	if (node->axis == -1)
-		return;
+	int slot = inode->count++;
+	inode->edicts[slot] = ent;
+	SV_AreaIndexSetBounds(inode, slot, ent->v.absmin, ent->v.absmax);
 
-	if (clip->boxmaxs[node->axis] > node->dist)
-		SV_ClipToWorldbrush(node->children[0], clip);
+	for (int i = 0; i < 3; i++)
+	{
+		inode->absmin[i] = Q_min(inode->absmin[i], ent->v.absmin[i]);
+		inode->absmax[i] = Q_max(inode->absmax[i], ent->v.absmax[i]);
+	}
 
-	if (node->dist > clip->boxmins[node->axis])
-		SV_ClipToWorldbrush(node->children[1], clip);
+	areaindex_slot_t *s = &g_AreaIndex.slots[ent - g_psv.edicts];
+	s->node = nodenum;
+	s->slot = slot;
 }
 
-void SV_MoveBounds(const vec_t *start, const vec_t *mins, const vec_t *maxs, const vec_t *end, vec_t *boxmins, vec_t *boxmaxs)
+// Drops the removed entries keeping the order of the remaining ones
+static void SV_AreaIndexCompact(areaindex_node_t *inode, int nodenum)
 {
-	for (int i = 0; i < 3; i++)
+	int count = inode->count;
+
+	SV_AreaIndexClearNode(inode);
+
+	for (int i = 0; i < count; i++)
 	{
-		if (end[i] > start[i])
-		{
-			boxmins[i] = start[i] + mins[i] - 1.0f;
-			boxmaxs[i] = end[i] + maxs[i] + 1.0f;
-		}
-		else
-		{
-			boxmins[i] = end[i] + mins[i] - 1.0f;
-			boxmaxs[i] = start[i] + maxs[i] + 1.0f;
-		}
+		edict_t *ent = inode->edicts[i];
+		if (!ent)
+			continue;
+
+		inode->edicts[i] = nullptr;
+		SV_AreaIndexClearBounds(inode, i);
+		SV_AreaIndexAppend(inode, nodenum, ent);
 	}
 }
 
-trace_t SV_MoveNoEnts(const vec_t *start, vec_t *mins, vec_t *maxs, const vec_t *end, int type, edict_t *passedict)
+void SV_AreaIndexInvalidate()
 {
-	moveclip_t clip;
-	vec3_t trace_endpos;
-	float trace_fraction;
+	g_AreaIndex.valid = FALSE;
+	g_AreaIndex.check.disabled = FALSE;
+}
 
-	Q_memset(&clip, 0, sizeof(clip));
-	clip.trace = SV_ClipMoveToEntity(g_psv.edicts, start, mins, maxs, end);
+void SV_AreaIndexFree()
+{
+	for (int i = 0; i < AREA_NODES; i++)
+	{
+		areaindex_node_t *inode = &g_AreaIndex.nodes[i];
 
-	if (clip.trace.fraction != 0.0f)
+		if (inode->bounds)
+			Mem_Free(inode->bounds);
+
+		if (inode->edicts)
+			Mem_Free(inode->edicts);
+	}
+
+	if (g_AreaIndex.slots)
+		Mem_Free(g_AreaIndex.slots);
+
+	Q_memset(&g_AreaIndex, 0, sizeof(g_AreaIndex));
+}
+
+// Fills the index from the solid_edicts lists of the area nodes
+static void SV_AreaIndexBuild()
+{
+	if (g_AreaIndex.maxedicts != g_psv.max_edicts)
 	{
-		VectorCopy(clip.trace.endpos, trace_endpos);
+		if (g_AreaIndex.slots)
+			Mem_Free(g_AreaIndex.slots);
 
-		trace_fraction = clip.trace.fraction;
+		g_AreaIndex.maxedicts = g_psv.max_edicts;
+		g_AreaIndex.slots = (areaindex_slot_t *)Mem_Malloc(g_AreaIndex.maxedicts * sizeof(areaindex_slot_t));
+	}
 
-		clip.trace.fraction = 1.0f;
-		clip.start = start;
-		clip.end = trace_endpos;
+	for (int i = 0; i < g_AreaIndex.maxedicts; i++)
+		g_AreaIndex.slots[i].node = -1;
 
-		clip.type = (type & 0xff);
-		clip.ignoretrans = (type >> 8);
-		clip.passedict = passedict;
-		clip.monsterClipBrush = FALSE;
+	for (int i = 0; i < AREA_NODES; i++)
+	{
+		areaindex_node_t *inode = &g_AreaIndex.nodes[i];
 
-		clip.mins = mins;
-		clip.maxs = maxs;
+		for (int j = 0; j < inode->count; j++)
+		{
+			inode->edicts[j] = nullptr;
+			SV_AreaIndexClearBounds(inode, j);
+		}
 
-		VectorCopy(mins, clip.mins2);
-		VectorCopy(maxs, clip.maxs2);
+		SV_AreaIndexClearNode(inode);
+	}
 
-		SV_MoveBounds(start, clip.mins2, clip.maxs2, trace_endpos, clip.boxmins, clip.boxmaxs);
-		SV_ClipToWorldbrush(sv_areanodes, &clip);
+	for (int i = 0; i < sv_numareanodes; i++)
+	{
+		areanode_t *node = &sv_areanodes[i];
 
-		clip.trace.fraction *= trace_fraction;
-		gGlobalVariables.trace_ent = clip.trace.ent;
+		for (link_t *l = node->solid_edicts.next; l != &node->solid_edicts; l = l->next)
+			SV_AreaIndexAppend(&g_AreaIndex.nodes[i], i, EDICT_FROM_AREA(l));
 	}
 
-	return clip.trace;
+	g_AreaIndex.valid = TRUE;
+	g_AreaIndex.check.verifytime = g_psv.time;
 }
 
-// mins and maxs are reletive
+// Compares the packed bounds with the ones of the edicts, returns the first one changed without a relink
+static edict_t *SV_AreaIndexVerify()
+{
+	for (int i = 0; i < sv_numareanodes; i++)
+	{
+		areaindex_node_t *inode = &g_AreaIndex.nodes[i];
+
+		for (int j = 0; j < inode->count; j++)
+		{
+			edict_t *ent = inode->edicts[j];
+			if (!ent)
+				continue;
+
+			const float *group = &inode->bounds[(j / AREAINDEX_GROUP) * 6 * AREAINDEX_GROUP];
+			int lane = j % AREAINDEX_GROUP;
+
+			for (int k = 0; k < 3; k++)
+			{
+				if (group[k * AREAINDEX_GROUP + lane] != ent->v.absmin[k] || group[(k + 3) * AREAINDEX_GROUP + lane] != ent->v.absmax[k])
+					return ent;
+			}
+		}
+	}
+
+	return NULL;
+}
+
+// The index skips the edicts in bulk, so it can't be used when the game dll wants to see every candidate
+qboolean SV_AreaIndexUsable()
+{
+	if (sv_rehlds_trace_index.value == 0.0f || gNewDLLFunctions.pfnShouldCollide || !g_psv.edicts || g_AreaIndex.check.disabled)
+	{
+		g_AreaIndex.valid = FALSE;
+		return FALSE;
+	}
+
+	if (!g_AreaIndex.valid)
+		SV_AreaIndexBuild();
+
+	if (!SV_BoundsCheck(&g_AreaIndex.check, SV_AreaIndexVerify, "sv_rehlds_trace_index"))
+	{
+		g_AreaIndex.valid = FALSE;
+		return FALSE;
+	}
+
+	return TRUE;
+}
+
+void SV_AreaIndexLink(edict_t *ent, areanode_t *node)
+{
+	if (!g_AreaIndex.valid)
+		return;
+
+	int nodenum = node - sv_areanodes;
+	SV_AreaIndexAppend(&g_AreaIndex.nodes[nodenum], nodenum, ent);
+}
+
+void SV_AreaIndexUnlink(edict_t *ent)
+{
+	if (!g_AreaIndex.valid)
+		return;
+
+	areaindex_slot_t *s = &g_AreaIndex.slots[ent - g_psv.edicts];
+	if (s->node == -1)
+		return;
+
+	areaindex_node_t *inode = &g_AreaIndex.nodes[s->node];
+	inode->edicts[s->slot] = nullptr;
+	SV_AreaIndexClearBounds(inode, s->slot);
+	inode->removed++;
+
+	int nodenum = s->node;
+	s->node = -1;
+
+	if (inode->removed * 2 > inode->count)
+		SV_AreaIndexCompact(inode, nodenum);
+}
+
+// Same walk as SV_ClipToLinks, using the packed bounds to pick the candidates
+void SV_ClipToAreaIndex(areanode_t *node, moveclip_t *clip)
+{
+	areaindex_node_t *inode = &g_AreaIndex.nodes[node - sv_areanodes];
+
+	if (inode->count - inode->removed > 0
+		&& !(clip->boxmins[0] > inode->absmax[0]
+		|| clip->boxmins[1] > inode->absmax[1]
+		|| clip->boxmins[2] > inode->absmax[2]
+		|| clip->boxmaxs[0] < inode->absmin[0]
+		|| clip->boxmaxs[1] < inode->absmin[1]
+		|| clip->boxmaxs[2] < inode->absmin[2]))
+	{
+		int numgroups = (inode->count + AREAINDEX_GROUP - 1) / AREAINDEX_GROUP;
+
+#ifdef REHLDS_SSE
+		__m128 bmin[3], bmax[3];
+		for (int i = 0; i < 3; i++)
+		{
+			bmin[i] = _mm_set1_ps(clip->boxmins[i]);
+			bmax[i] = _mm_set1_ps(clip->boxmaxs[i]);
+		}
+#endif
+
+		for (int g = 0; g < numgroups; g++)
+		{
+			const float *group = &inode->bounds[g * 6 * AREAINDEX_GROUP];
+			int hits;
+
+#ifdef REHLDS_SSE
+			__m128 reject = _mm_setzero_ps();
+			for (int i = 0; i < 3; i++)
+			{
+				reject = _mm_or_ps(reject, _mm_cmpgt_ps(bmin[i], _mm_loadu_ps(&group[(i + 3) * AREAINDEX_GROUP])));
+				reject = _mm_or_ps(reject, _mm_cmplt_ps(bmax[i], _mm_loadu_ps(&group[i * AREAINDEX_GROUP])));
+			}
+
+			hits = ~_mm_movemask_ps(reject) & ((1 << AREAINDEX_GROUP) - 1);
+#else
+			hits = 0;
+			for (int lane = 0; lane < AREAINDEX_GROUP; lane++)
+			{
+				if (clip->boxmins[0] > group[3 * AREAINDEX_GROUP + lane]
+					|| clip->boxmins[1] > group[4 * AREAINDEX_GROUP + lane]
+					|| clip->boxmins[2] > group[5 * AREAINDEX_GROUP + lane]
+					|| clip->boxmaxs[0] < group[0 * AREAINDEX_GROUP + lane]
+					|| clip->boxmaxs[1] < group[1 * AREAINDEX_GROUP + lane]
+					|| clip->boxmaxs[2] < group[2 * AREAINDEX_GROUP + lane])
+					continue;
+
+				hits |= 1 << lane;
+			}
+#endif
+
+			for (int lane = 0; hits; lane++, hits >>= 1)
+			{
+				if (!(hits & 1))
+					continue;
+
+				edict_t *touch = inode->edicts[g * AREAINDEX_GROUP + lane];
+				if (touch && !SV_ClipToLink(touch, clip))
+					return;
+			}
+		}
+	}
+
+	// recurse down both sides
+	if (node->axis == -1)
+		return;
+
+	if (clip->boxmaxs[node->axis] > node->dist)
+		SV_ClipToAreaIndex(node->children[0], clip);
+
+	if (node->dist > clip->boxmins[node->axis])
+		SV_ClipToAreaIndex(node->children[1], clip);
+}
+
+// Sphere grid (sv_rehlds_sphere_index).
+// Uniform grid over x/y with the cells hashed into a fixed number of buckets, every edict is filed in the
+// cells its bounds overlap. FindEntityInSphere then marks the edicts of the cells around the sphere in a
+// bitmap and walks it upwards from the start edict, which gives the order of the full scan.
+// Edicts spanning too many cells are kept in a separate list which every query tests.
+// Like the area index the bounds are taken when the edict is linked (or cleared on allocation). The check
+// against the live bounds recomputes the cells, bounds that moved within their cells still give the same
+// candidates.
+const float SPHEREGRID_CELL_SIZE = 256.0f;
+const int SPHEREGRID_BUCKETS = 4096;		// power of two
+const int SPHEREGRID_MAX_CELLS = 16;		// per edict, more goes to the large list
+const int SPHEREGRID_MAX_QUERY_CELLS = 144;	// more than that scans all edicts
+const float SPHEREGRID_MAX_COORD = 1048576.0f;
+
+typedef struct spheregrid_list_s
+{
+	int count;
+	int capacity;
+	int *nums;
+} spheregrid_list_t;
+
+typedef struct spheregrid_slot_s
+{
+	qboolean filed;
+	qboolean large;
+	int x0, y0, x1, y1;
+} spheregrid_slot_t;
+
+typedef struct spheregrid_s
+{
+	qboolean valid;
+	boundscheck_t check;
+	edict_t *edicts;	// g_psv.edicts the grid was built for
+	int maxedicts;
+	uint32 generation;	// bumped on every change of the grid
+	spheregrid_slot_t *slots;
+	uint32 *marks;		// candidates of the last query, a bit per edict
+	vec3_t queryorg;
+	float queryrad;
+	uint32 querygeneration;
+	spheregrid_list_t large;
+	spheregrid_list_t buckets[SPHEREGRID_BUCKETS];
+} spheregrid_t;
+
+static spheregrid_t g_SphereGrid;
+
+static inline int SV_SphereGridBucket(int x, int y)
+{
+	return ((uint32)x * 73856093u ^ (uint32)y * 19349663u) & (SPHEREGRID_BUCKETS - 1);
+}
+
+static inline int SV_SphereGridCoord(float f)
+{
+	return (int)floor(f / SPHEREGRID_CELL_SIZE);
+}
+
+static void SV_SphereGridAdd(spheregrid_list_t *list, int num)
+{
+	if (list->count >= list->capacity)
+	{
+		list->capacity = list->capacity ? list->capacity * 2 : 8;
+		list->nums = (int *)Mem_Realloc(list->nums, list->capacity * sizeof(int));
+	}
+
+	list->nums[list->count++] = num;
+}
+
+static void SV_SphereGridRemove(spheregrid_list_t *list, int num)
+{
+	for (int i = 0; i < list->count; i++)
+	{
+		if (list->nums[i] == num)
+		{
+			list->nums[i] = list->nums[--list->count];
+			return;
+		}
+	}
+}
+
+static void SV_SphereGridUnfile(int num)
+{
+	spheregrid_slot_t *s = &g_SphereGrid.slots[num];
+	if (!s->filed)
+		return;
+
+	if (s->large)
+	{
+		SV_SphereGridRemove(&g_SphereGrid.large, num);
+	}
+	else
+	{
+		for (int x = s->x0; x <= s->x1; x++)
+		{
+			for (int y = s->y0; y <= s->y1; y++)
+				SV_SphereGridRemove(&g_SphereGrid.buckets[SV_SphereGridBucket(x, y)], num);
+		}
+	}
+
+	s->filed = FALSE;
+}
+
+// Cells covered by the current bounds of the edict
+static void SV_SphereGridCells(const edict_t *ent, spheregrid_slot_t *s)
+{
+	s->large = TRUE;
+	s->x0 = s->y0 = s->x1 = s->y1 = 0;
+
+	// NaNs fail these as well
+	if (ent->v.absmin[0] >= -SPHEREGRID_MAX_COORD && ent->v.absmin[1] >= -SPHEREGRID_MAX_COORD
+		&& ent->v.absmax[0] <= SPHEREGRID_MAX_COORD && ent->v.absmax[1] <= SPHEREGRID_MAX_COORD
+		&& ent->v.absmin[0] <= ent->v.absmax[0] && ent->v.absmin[1] <= ent->v.absmax[1])
+	{
+		s->x0 = SV_SphereGridCoord(ent->v.absmin[0]);
+		s->y0 = SV_SphereGridCoord(ent->v.absmin[1]);
+		s->x1 = SV_SphereGridCoord(ent->v.absmax[0]);
+		s->y1 = SV_SphereGridCoord(ent->v.absmax[1]);
+		s->large = (s->x1 - s->x0 + 1) * (s->y1 - s->y0 + 1) > SPHEREGRID_MAX_CELLS;
+	}
+}
+
+static void SV_SphereGridFile(edict_t *ent)
+{
+	int num = ent - g_psv.edicts;
+	spheregrid_slot_t *s = &g_SphereGrid.slots[num];
+
+	SV_SphereGridCells(ent, s);
+	s->filed = TRUE;
+
+	if (s->large)
+	{
+		SV_SphereGridAdd(&g_SphereGrid.large, num);
+		return;
+	}
+
+	for (int x = s->x0; x <= s->x1; x++)
+	{
+		for (int y = s->y0; y <= s->y1; y++)
+			SV_SphereGridAdd(&g_SphereGrid.buckets[SV_SphereGridBucket(x, y)], num);
+	}
+}
+
+void SV_SphereGridInvalidate()
+{
+	g_SphereGrid.valid = FALSE;
+	g_SphereGrid.check.disabled = FALSE;
+}
+
+void SV_SphereGridFree()
+{
+	for (int i = 0; i < SPHEREGRID_BUCKETS; i++)
+	{
+		if (g_SphereGrid.buckets[i].nums)
+			Mem_Free(g_SphereGrid.buckets[i].nums);
+	}
+
+	if (g_SphereGrid.large.nums)
+		Mem_Free(g_SphereGrid.large.nums);
+
+	if (g_SphereGrid.slots)
+		Mem_Free(g_SphereGrid.slots);
+
+	if (g_SphereGrid.marks)
+		Mem_Free(g_SphereGrid.marks);
+
+	Q_memset(&g_SphereGrid, 0, sizeof(g_SphereGrid));
+}
+
+// Compares the filed cells with the ones of the current bounds, returns the first edict that moved without a relink
+static edict_t *SV_SphereGridVerify()
+{
+	for (int i = 1; i < g_psv.num_edicts; i++)
+	{
+		const spheregrid_slot_t *filed = &g_SphereGrid.slots[i];
+		spheregrid_slot_t live;
+		SV_SphereGridCells(&g_psv.edicts[i], &live);
+
+		if (!filed->filed || filed->large != live.large)
+			return &g_psv.edicts[i];
+
+		if (!live.large && (filed->x0 != live.x0 || filed->y0 != live.y0 || filed->x1 != live.x1 || filed->y1 != live.y1))
+			return &g_psv.edicts[i];
+	}
+
+	return NULL;
+}
+
+// Files every edict by its current bounds
+static void SV_SphereGridBuild()
+{
+	if (g_SphereGrid.maxedicts != g_psv.max_edicts)
+	{
+		if (g_SphereGrid.slots)
+			Mem_Free(g_SphereGrid.slots);
+
+		if (g_SphereGrid.marks)
+			Mem_Free(g_SphereGrid.marks);
+
+		g_SphereGrid.maxedicts = g_psv.max_edicts;
+		g_SphereGrid.slots = (spheregrid_slot_t *)Mem_Malloc(g_SphereGrid.maxedicts * sizeof(spheregrid_slot_t));
+		g_SphereGrid.marks = (uint32 *)Mem_Malloc(((g_SphereGrid.maxedicts + 31) >> 5) * sizeof(uint32));
+	}
+
+	Q_memset(g_SphereGrid.slots, 0, g_SphereGrid.maxedicts * sizeof(spheregrid_slot_t));
+
+	for (int i = 0; i < SPHEREGRID_BUCKETS; i++)
+		g_SphereGrid.buckets[i].count = 0;
+
+	g_SphereGrid.large.count = 0;
+	g_SphereGrid.edicts = g_psv.edicts;
+	g_SphereGrid.generation++;
+
+	for (int i = 1; i < g_psv.num_edicts; i++)
+		SV_SphereGridFile(&g_psv.edicts[i]);
+
+	g_SphereGrid.valid = TRUE;
+	g_SphereGrid.check.verifytime = g_psv.time;
+}
+
+// Called whenever the bounds of an edict are set or cleared
+void SV_SphereGridUpdate(edict_t *ent)
+{
+	if (!g_SphereGrid.valid || g_SphereGrid.edicts != g_psv.edicts || ent == g_psv.edicts)
+		return;
+
+	SV_SphereGridUnfile(ent - g_psv.edicts);
+	SV_SphereGridFile(ent);
+	g_SphereGrid.generation++;
+}
+
+static inline qboolean SV_SphereGridTouches(edict_t *ent, const float *org, float radSquared)
+{
+	// same computation as FindEntityInSphere, so the results match to the bit
+	float distSquared = 0.0;
+	for (int j = 0; j < 3 && distSquared <= radSquared; j++)
+	{
+		float eorg;
+		if (org[j] >= ent->v.absmin[j])
+			eorg = (org[j] <= ent->v.absmax[j]) ? 0.0f : org[j] - ent->v.absmax[j];
+		else
+			eorg = org[j] - ent->v.absmin[j];
+		distSquared = eorg * eorg + distSquared;
+	}
+
+	return distSquared <= radSquared;
+}
+
+static inline int SV_SphereGridLowestBit(uint32 bits)
+{
+#ifdef _WIN32
+	unsigned long index;
+	_BitScanForward(&index, bits);
+	return index;
+#else
+	return __builtin_ctz(bits);
+#endif
+}
+
+static void SV_SphereGridMark(spheregrid_list_t *list)
+{
+	for (int i = 0; i < list->count; i++)
+	{
+		int num = list->nums[i];
+		g_SphereGrid.marks[num >> 5] |= 1u << (num & 31);
+	}
+}
+
+// Returns false if the grid can't answer the query and the caller has to scan
+qboolean SV_SphereGridFind(int start, const float *org, float rad, edict_t **result)
+{
+	if (sv_rehlds_sphere_index.value == 0.0f || !g_psv.edicts || g_SphereGrid.check.disabled)
+	{
+		g_SphereGrid.valid = FALSE;
+		return FALSE;
+	}
+
+	if (!(rad >= 0.0f) || !(org[0] - rad >= -SPHEREGRID_MAX_COORD && org[0] + rad <= SPHEREGRID_MAX_COORD
+		&& org[1] - rad >= -SPHEREGRID_MAX_COORD && org[1] + rad <= SPHEREGRID_MAX_COORD))
+		return FALSE;
+
+	if (!g_SphereGrid.valid || g_SphereGrid.edicts != g_psv.edicts || g_SphereGrid.maxedicts != g_psv.max_edicts)
+		SV_SphereGridBuild();
+
+	if (!SV_BoundsCheck(&g_SphereGrid.check, SV_SphereGridVerify, "sv_rehlds_sphere_index"))
+	{
+		g_SphereGrid.valid = FALSE;
+		return FALSE;
+	}
+
+	// the continuation calls of a search ask for the same sphere again, the candidates stay marked
+	// until the sphere or the grid changes
+	if (g_SphereGrid.querygeneration != g_SphereGrid.generation
+		|| Q_memcmp(g_SphereGrid.queryorg, org, sizeof(vec3_t)) || g_SphereGrid.queryrad != rad)
+	{
+		// a unit of slack keeps rounding at the edge of the sphere from dropping a cell
+		float reach = rad + 1.0f;
+		int x0 = SV_SphereGridCoord(org[0] - reach);
+		int y0 = SV_SphereGridCoord(org[1] - reach);
+		int x1 = SV_SphereGridCoord(org[0] + reach);
+		int y1 = SV_SphereGridCoord(org[1] + reach);
+
+		if ((x1 - x0 + 1) * (y1 - y0 + 1) > SPHEREGRID_MAX_QUERY_CELLS)
+			return FALSE;
+
+		Q_memset(g_SphereGrid.marks, 0, ((g_SphereGrid.maxedicts + 31) >> 5) * sizeof(uint32));
+		SV_SphereGridMark(&g_SphereGrid.large);
+
+		for (int x = x0; x <= x1; x++)
+		{
+			for (int y = y0; y <= y1; y++)
+				SV_SphereGridMark(&g_SphereGrid.buckets[SV_SphereGridBucket(x, y)]);
+		}
+
+		VectorCopy(org, g_SphereGrid.queryorg);
+		g_SphereGrid.queryrad = rad;
+		g_SphereGrid.querygeneration = g_SphereGrid.generation;
+	}
+
+	*result = &g_psv.edicts[0];
+
+	// marked edicts in ascending order, tested with the same checks as FindEntityInSphere
+	int num = start + 1;
+	int numwords = (g_psv.num_edicts + 31) >> 5;
+	for (int w = num >> 5; w < numwords; w++)
+	{
+		uint32 bits = g_SphereGrid.marks[w];
+		if (w == (num >> 5))
+			bits &= ~0u << (num & 31);
+
+		while (bits)
+		{
+			int i = (w << 5) + SV_SphereGridLowestBit(bits);
+			bits &= bits - 1;
+
+			if (i >= g_psv.num_edicts)
+				return TRUE;
+
+			edict_t *ent = &g_psv.edicts[i];
+			if (ent->free || !ent->v.classname)
+				continue;
+
+			if (i <= g_psvs.maxclients && !g_psvs.clients[i - 1].active)
+				continue;
+
+			if (SV_SphereGridTouches(ent, org, rad * rad))
+			{
+				*result = ent;
+				return TRUE;
+			}
+		}
+	}
+
+	return TRUE;
+}
+#endif // REHLDS_FIXES
+
+#ifdef REHLDS_FIXES
+// World boxes (sv_rehlds_batch_projectiles).
+// Every edict may own a box in the space of one world clip hull that only reaches empty leaves. A trace of the world
+// whose start and end points are both inside the box of its passedict can't hit anything, so its result is filled
+// in directly, exactly as SV_RecursiveHullCheck would leave it. The boxes are found by the projectile batch
+// at the start of the physics frame and only depend on the world hulls, so they stay valid until the next map.
+const float WORLDBOX_EPSILON = 1.0f;	// covers the rounding of plane distances and of the trace midpoints
+
+typedef struct worldbox_s
+{
+	hull_t *hull;		// nullptr if the edict has no box
+	vec3_t mins;
+	vec3_t maxs;
+} worldbox_t;
+
+typedef struct worldboxes_s
+{
+	qboolean valid;
+	int maxedicts;
+	worldbox_t *boxes;
+} worldboxes_t;
+
+static worldboxes_t g_WorldBoxes;
+
+// True if all of the leaves the box reaches from the node are CONTENTS_EMPTY
+qboolean SV_HullBoxIsEmpty(hull_t *hull, int num, const vec_t *mins, const vec_t *maxs)
+{
+	while (num >= 0)
+	{
+		// leave the error to the real trace
+		if (num < hull->firstclipnode || num > hull->lastclipnode || !hull->planes)
+			return FALSE;
+
+		dclipnode_t *node = &hull->clipnodes[num];
+		mplane_t *plane = &hull->planes[node->planenum];
+		float dmin, dmax;
+
+		if (plane->type < 3)
+		{
+			dmin = mins[plane->type] - plane->dist;
+			dmax = maxs[plane->type] - plane->dist;
+		}
+		else
+		{
+			dmin = dmax = -plane->dist;
+			for (int i = 0; i < 3; i++)
+			{
+				if (plane->normal[i] >= 0.0f)
+				{
+					dmin += plane->normal[i] * mins[i];
+					dmax += plane->normal[i] * maxs[i];
+				}
+				else
+				{
+					dmin += plane->normal[i] * maxs[i];
+					dmax += plane->normal[i] * mins[i];
+				}
+			}
+		}
+
+		if (dmin >= 0.0f)
+		{
+			num = node->children[0];
+		}
+		else if (dmax < 0.0f)
+		{
+			num = node->children[1];
+		}
+		else
+		{
+			// NaNs end up here as well
+			if (!SV_HullBoxIsEmpty(hull, node->children[0], mins, maxs))
+				return FALSE;
+
+			num = node->children[1];
+		}
+	}
+
+	return (num == CONTENTS_EMPTY) ? TRUE : FALSE;
+}
+
+void SV_WorldBoxInvalidate()
+{
+	g_WorldBoxes.valid = FALSE;
+}
+
+void SV_WorldBoxFree()
+{
+	if (g_WorldBoxes.boxes)
+		Mem_Free(g_WorldBoxes.boxes);
+
+	Q_memset(&g_WorldBoxes, 0, sizeof(g_WorldBoxes));
+}
+
+qboolean SV_WorldBoxUsable()
+{
+	if (sv_rehlds_batch_projectiles.value == 0.0f || !g_psv.edicts)
+		return FALSE;
+
+	if (!g_WorldBoxes.valid)
+	{
+		if (g_WorldBoxes.maxedicts != g_psv.max_edicts)
+		{
+			if (g_WorldBoxes.boxes)
+				Mem_Free(g_WorldBoxes.boxes);
+
+			g_WorldBoxes.maxedicts = g_psv.max_edicts;
+			g_WorldBoxes.boxes = (worldbox_t *)Mem_Malloc(g_WorldBoxes.maxedicts * sizeof(worldbox_t));
+		}
+
+		for (int i = 0; i < g_WorldBoxes.maxedicts; i++)
+			g_WorldBoxes.boxes[i].hull = nullptr;
+
+		g_WorldBoxes.valid = TRUE;
+	}
+
+	return TRUE;
+}
+
+// Makes sure the box of the edict covers mins/maxs (in the space of the hull).
+// A box grown by pad is tried first, so it lasts for a few frames, then the tight one.
+qboolean SV_WorldBoxUpdate(int num, hull_t *hull, const vec_t *mins, const vec_t *maxs, float pad)
+{
+	worldbox_t *box = &g_WorldBoxes.boxes[num];
+
+	if (box->hull == hull
+		&& mins[0] >= box->mins[0] && mins[1] >= box->mins[1] && mins[2] >= box->mins[2]
+		&& maxs[0] <= box->maxs[0] && maxs[1] <= box->maxs[1] && maxs[2] <= box->maxs[2])
+		return TRUE;
+
+	for (int pass = 0; pass < 2; pass++, pad = 0.0f)
+	{
+		vec3_t testmins, testmaxs;
+		for (int i = 0; i < 3; i++)
+		{
+			testmins[i] = mins[i] - pad - WORLDBOX_EPSILON;
+			testmaxs[i] = maxs[i] + pad + WORLDBOX_EPSILON;
+		}
+
+		if (SV_HullBoxIsEmpty(hull, hull->firstclipnode, testmins, testmaxs))
+		{
+			box->hull = hull;
+			for (int i = 0; i < 3; i++)
+			{
+				box->mins[i] = mins[i] - pad;
+				box->maxs[i] = maxs[i] + pad;
+			}
+
+			return TRUE;
+		}
+	}
+
+	box->hull = nullptr;
+	return FALSE;
+}
+
+// Same result as SV_ClipMoveToEntity(g_psv.edicts, ...) when the move stays inside the box of passedict
+qboolean SV_WorldBoxTrace(edict_t *passedict, const vec_t *start, const vec_t *mins, const vec_t *maxs, const vec_t *end, trace_t *trace)
+{
+	if (!passedict || !g_WorldBoxes.valid || sv_rehlds_batch_projectiles.value == 0.0f)
+		return FALSE;
+
+	int num = passedict - g_psv.edicts;
+	if (num < 0 || num >= g_WorldBoxes.maxedicts)
+		return FALSE;
+
+	worldbox_t *box = &g_WorldBoxes.boxes[num];
+	if (!box->hull)
+		return FALSE;
+
+	edict_t *world = g_psv.edicts;
+	if (world->v.solid != SOLID_BSP || Mod_GetType(world->v.modelindex) != mod_brush || !VectorIsZero(world->v.angles))
+		return FALSE;
+
+	vec3_t offset;
+	if (SV_HullForEntity(world, mins, maxs, offset) != box->hull)
+		return FALSE;
+
+	for (int i = 0; i < 3; i++)
+	{
+		float s = start[i] - offset[i];
+		float e = end[i] - offset[i];
+
+		// written this way round so NaNs fail
+		if (!(s >= box->mins[i] && s <= box->maxs[i] && e >= box->mins[i] && e <= box->maxs[i]))
+			return FALSE;
+	}
+
+	Q_memset(trace, 0, sizeof(trace_t));
+	VectorCopy(end, trace->endpos);
+	trace->fraction = 1.0f;
+	trace->inopen = TRUE;
+	return TRUE;
+}
+#endif // REHLDS_FIXES
+
+// Mins and maxs enclose the entire area swept by the move
+void SV_ClipToWorldbrush(areanode_t *node, moveclip_t *clip)
+{
+	link_t *l;
+	link_t *next;
+	edict_t *touch;
+
+	for (l = node->solid_edicts.next; l != &node->solid_edicts; l = next)
+	{
+		next = l->next;
+		touch = EDICT_FROM_AREA(l);
+
+		if (touch->v.solid != SOLID_BSP)
+			continue;
+
+		if (!(touch->v.flags & FL_WORLDBRUSH))
+			continue;
+
+		if (clip->boxmins[0] > touch->v.absmax[0]
+		|| clip->boxmins[1] > touch->v.absmax[1]
+		|| clip->boxmins[2] > touch->v.absmax[2]
+		|| clip->boxmaxs[0] < touch->v.absmin[0]
+		|| clip->boxmaxs[1] < touch->v.absmin[1]
+		|| clip->boxmaxs[2] < touch->v.absmin[2])
+			continue;
+
+		if (clip->trace.allsolid)
+			return;
+
+		trace_t trace = SV_ClipMoveToEntity(touch, clip->start, clip->mins, clip->maxs, clip->end);
+		if (trace.allsolid || trace.startsolid || trace.fraction < clip->trace.fraction)
+		{
+			trace.ent = touch;
+			if (clip->trace.startsolid)
+			{
+				clip->trace = trace;
+				clip->trace.startsolid = TRUE;
+			}
+			else
+			{
+				clip->trace = trace;
+			}
+		}
+	}
+
+	// recurse down both sides
+	if (node->axis == -1)
+		return;
+
+	if (clip->boxmaxs[node->axis] > node->dist)
+		SV_ClipToWorldbrush(node->children[0], clip);
+
+	if (node->dist > clip->boxmins[node->axis])
+		SV_ClipToWorldbrush(node->children[1], clip);
+}
+
+void SV_MoveBounds(const vec_t *start, const vec_t *mins, const vec_t *maxs, const vec_t *end, vec_t *boxmins, vec_t *boxmaxs)
+{
+	for (int i = 0; i < 3; i++)
+	{
+		if (end[i] > start[i])
+		{
+			boxmins[i] = start[i] + mins[i] - 1.0f;
+			boxmaxs[i] = end[i] + maxs[i] + 1.0f;
+		}
+		else
+		{
+			boxmins[i] = end[i] + mins[i] - 1.0f;
+			boxmaxs[i] = start[i] + maxs[i] + 1.0f;
+		}
+	}
+}
+
+trace_t SV_MoveNoEnts(const vec_t *start, vec_t *mins, vec_t *maxs, const vec_t *end, int type, edict_t *passedict)
+{
+	moveclip_t clip;
+	vec3_t trace_endpos;
+	float trace_fraction;
+
+	Q_memset(&clip, 0, sizeof(clip));
+	clip.trace = SV_ClipMoveToEntity(g_psv.edicts, start, mins, maxs, end);
+
+	if (clip.trace.fraction != 0.0f)
+	{
+		VectorCopy(clip.trace.endpos, trace_endpos);
+
+		trace_fraction = clip.trace.fraction;
+
+		clip.trace.fraction = 1.0f;
+		clip.start = start;
+		clip.end = trace_endpos;
+
+		clip.type = (type & 0xff);
+		clip.ignoretrans = (type >> 8);
+		clip.passedict = passedict;
+		clip.monsterClipBrush = FALSE;
+
+		clip.mins = mins;
+		clip.maxs = maxs;
+
+		VectorCopy(mins, clip.mins2);
+		VectorCopy(maxs, clip.maxs2);
+
+		SV_MoveBounds(start, clip.mins2, clip.maxs2, trace_endpos, clip.boxmins, clip.boxmaxs);
+		SV_ClipToWorldbrush(sv_areanodes, &clip);
+
+		clip.trace.fraction *= trace_fraction;
+		gGlobalVariables.trace_ent = clip.trace.ent;
+	}
+
+	return clip.trace;
+}
+
+// mins and maxs are reletive
 // if the entire move stays in a solid volume, trace.allsolid will be set
 // if the starting point is in a solid, it will be allowed to move out to an open area
 // nomonsters is used for line of sight or edge testing,
@@ -1405,6 +2369,9 @@ trace_t SV_Move(const vec_t *start, const vec_t *mins, const vec_t *maxs, const
 	float trace_fraction;
 
 	Q_memset(&clip, 0, sizeof(clip));
+#ifdef REHLDS_FIXES
+	if (!SV_WorldBoxTrace(passedict, start, mins, maxs, end, &clip.trace))
+#endif
 	clip.trace = SV_ClipMoveToEntity(g_psv.edicts, start, mins, maxs, end);
 
 	if (clip.trace.fraction != 0.0f)
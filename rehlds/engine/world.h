@@ -105,12 +105,32 @@ edict_t *SV_TestEntityPosition(edict_t *ent);
 qboolean SV_RecursiveHullCheck(hull_t *hull, int num, float p1f, float p2f, const vec_t *p1, const vec_t *p2, trace_t *trace);
 void SV_SingleClipMoveToEntity(edict_t *ent, const vec_t *start, const vec_t *mins, const vec_t *maxs, const vec_t *end, trace_t *trace);
 trace_t SV_ClipMoveToEntity(edict_t *ent, const vec_t *start, const vec_t *mins, const vec_t *maxs, const vec_t *end);
+qboolean SV_ClipToLink(edict_t *touch, moveclip_t *clip);
 void SV_ClipToLinks(areanode_t *node, moveclip_t *clip);
 void SV_ClipToWorldbrush(areanode_t *node, moveclip_t *clip);
 void SV_MoveBounds(const vec_t *start, const vec_t *mins, const vec_t *maxs, const vec_t *end, vec_t *boxmins, vec_t *boxmaxs);
 trace_t SV_MoveNoEnts(const vec_t *start, vec_t *mins, vec_t *maxs, const vec_t *end, int type, edict_t *passedict);
 trace_t SV_Move(const vec_t *start, const vec_t *mins, const vec_t *maxs, const vec_t *end, int type, edict_t *passedict, qboolean monsterClipBrush);
 
+#ifdef REHLDS_FIXES
+void SV_AreaIndexInvalidate();
+void SV_AreaIndexFree();
+qboolean SV_AreaIndexUsable();
+void SV_AreaIndexLink(edict_t *ent, areanode_t *node);
+void SV_AreaIndexUnlink(edict_t *ent);
+void SV_ClipToAreaIndex(areanode_t *node, moveclip_t *clip);
+void SV_SphereGridInvalidate();
+void SV_SphereGridFree();
+void SV_SphereGridUpdate(edict_t *ent);
+qboolean SV_SphereGridFind(int start, const float *org, float rad, edict_t **result);
+qboolean SV_HullBoxIsEmpty(hull_t *hull, int num, const vec_t *mins, const vec_t *maxs);
+void SV_WorldBoxInvalidate();
+void SV_WorldBoxFree();
+qboolean SV_WorldBoxUsable();
+qboolean SV_WorldBoxUpdate(int num, hull_t *hull, const vec_t *mins, const vec_t *maxs, float pad);
+qboolean SV_WorldBoxTrace(edict_t *passedict, const vec_t *start, const vec_t *mins, const vec_t *maxs, const vec_t *end, trace_t *trace);
+#endif // REHLDS_FIXES
+
 #ifdef REHLDS_OPT_PEDANTIC
 trace_t SV_Move_Point(const vec_t *start, const vec_t *end, int type, edict_t *passedict);
 #endif // REHLDS_OPT_PEDANTIC
@@ -37,7 +37,7 @@
 #include "pr_dlls.h"
 
 #define REHLDS_API_VERSION_MAJOR 3
-#define REHLDS_API_VERSION_MINOR 10
+#define REHLDS_API_VERSION_MINOR 13
 
 //Steam_NotifyClientConnect hook
 typedef IHookChain<qboolean, IGameClient*, const void*, unsigned int> IRehldsHook_Steam_NotifyClientConnect;
@@ -261,6 +261,27 @@ public:
 	virtual IRehldsHookRegistry_GetEntityInit* GetEntityInit() = 0;
 };
 
+// Counters of a message type, updated while sv_rehlds_msg_stats is enabled
+struct msgstats_t {
+	uint32 count;			// messages of this type sent by the game dll
+	uint32 bytes;			// bytes they added to the destination buffers
+	uint32 dest[10];		// messages by destination, MSG_BROADCAST to MSG_SPEC
+	uint32 datagramBytes;	// bytes of this svc_* written into client datagrams by the engine
+};
+
+// Node of the frame profile, updated while sv_rehlds_profile is enabled.
+// Nodes come in tree order: the frame, its phases, and the modules of the hooks called from each of them.
+struct profilestats_t {
+	const char *name;		// phase, module file name or "engine" for the original function of a hook chain
+	int depth;
+	uint32 calls;
+	double selfMsec;		// per frame on average, without the children
+	double totalMsec;		// per frame on average, with the children
+	double p50Msec;			// percentiles of the total over the recent frames
+	double p99Msec;
+	double maxMsec;
+};
+
 struct RehldsFuncs_t {
 	void(*DropClient)(IGameClient* cl, bool crash, const char* fmt, ...);
 	void(*RejectConnection)(netadr_t *adr, char *fmt, ...);
@@ -369,6 +390,16 @@ struct RehldsFuncs_t {
 	void(*MSG_BeginReading)();
 	double(*GetHostFrameTime)();
 	struct cmd_function_s *(*GetFirstCmdFunctionHandle)();
+
+	// Declares that the conditional delta encoders (DELTA_AddEncoder) may be called from several threads at once,
+	// otherwise they are serialized while snapshots are encoded in parallel (sv_rehlds_parallel_snapshots)
+	void(*SetDeltaEncodersThreadSafe)(bool threadSafe);
+
+	// Message counters by type (0-255), nullptr if the type is out of range or the build has no stats
+	const msgstats_t *(*GetMessageStats)(int msgType);
+	void(*ResetMessageStats)();
+	int(*GetProfileStats)(profilestats_t *stats, int maxStats);
+	void(*ResetProfileStats)();
 };
 
 class IRehldsApi {
@@ -7,6 +7,7 @@ CRehldsRuntimeConfig::CRehldsRuntimeConfig()
 	disableAllHooks = false;
 	testRecordingFileName[0] = 0;
 	testPlayerMode = TPM_DISABLE;
+	testPlayFast = false;
 }
 
 void CRehldsRuntimeConfig::parseFromCommandLine(const char* cmdLine) {
@@ -36,6 +37,15 @@ void CRehldsRuntimeConfig::parseFromCommandLine(const char* cmdLine) {
 			testRecordingFileName[sizeof(testRecordingFileName) - 1] = 0;
 			testPlayerMode = TPM_PLAY;
 		}
+		else if (!strcmp(token, "--rehlds-test-play-fast"))
+		{
+			const char* fname = getNextToken(&cpos);
+			if (fname == NULL) rehlds_syserror("%s: usage: --rehlds-test-play-fast <filename>", __func__);
+			strncpy(testRecordingFileName, fname, sizeof(testRecordingFileName));
+			testRecordingFileName[sizeof(testRecordingFileName) - 1] = 0;
+			testPlayerMode = TPM_PLAY;
+			testPlayFast = true;
+		}
 		else if (!strcmp(token, "--rehlds-test-anon"))
 		{
 			const char* fname = getNextToken(&cpos);
@@ -17,6 +17,7 @@ public:
 	bool disableAllHooks;
 	char testRecordingFileName[260];
 	TestPlayerMode testPlayerMode;
+	bool testPlayFast;
 
 	void parseFromCommandLine(const char* cmdLine);
 };
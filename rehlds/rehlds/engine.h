@@ -31,6 +31,7 @@
 #include "decal.h"
 #include "delta.h"
 #include "delta_jit.h"
+#include "delta_bulk.h"
 #include "server.h"
 #include "sys_dll.h"
 #include "sys_dll2.h"
@@ -75,6 +76,7 @@
 #include "md5.h"
 #include "sv_remoteaccess.h"
 #include "sv_upld.h"
+#include "md5cache.h"
 #include "com_custom.h"
 #include "hashpak.h"
 #include "ipratelimit.h"
@@ -27,6 +27,7 @@
 */
 #pragma once
 #include "hookchains.h"
+#include "profiler.h"
 
 const int MAX_HOOKS_IN_CHAIN = 19;
 
@@ -51,13 +52,30 @@ public:
 		if (nexthook)
 		{
 			IHookChainImpl nextChain(m_Hooks + 1, m_OriginalFunc);
+#ifdef REHLDS_FIXES
+			if (g_FrameProfiler.IsActive())
+			{
+				g_FrameProfiler.EnterHook((void *)nexthook);
+				t_ret ret = nexthook(&nextChain, args...);
+				g_FrameProfiler.Leave();
+				return ret;
+			}
+#endif
 			return nexthook(&nextChain, args...);
 		}
 
-		return m_OriginalFunc(args...);
+		return callOriginal(args...);
 	}
 
 	EXT_FUNC virtual t_ret callOriginal(t_args... args) {
+#ifdef REHLDS_FIXES
+		if (g_FrameProfiler.IsActive() && g_FrameProfiler.EnterOriginal())
+		{
+			t_ret ret = m_OriginalFunc(args...);
+			g_FrameProfiler.Leave();
+			return ret;
+		}
+#endif
 		return m_OriginalFunc(args...);
 	}
 
@@ -82,18 +100,36 @@ public:
 		if (nexthook)
 		{
 			IVoidHookChainImpl nextChain(m_Hooks + 1, m_OriginalFunc);
+#ifdef REHLDS_FIXES
+			if (g_FrameProfiler.IsActive())
+			{
+				g_FrameProfiler.EnterHook((void *)nexthook);
+				nexthook(&nextChain, args...);
+				g_FrameProfiler.Leave();
+				return;
+			}
+#endif
 			nexthook(&nextChain, args...);
 		}
 		else
 		{
-			if (m_OriginalFunc)
-				m_OriginalFunc(args...);
+			callOriginal(args...);
 		}
 	}
 
 	EXT_FUNC virtual void callOriginal(t_args... args) {
-		if (m_OriginalFunc)
+		if (!m_OriginalFunc)
+			return;
+
+#ifdef REHLDS_FIXES
+		if (g_FrameProfiler.IsActive() && g_FrameProfiler.EnterOriginal())
+		{
 			m_OriginalFunc(args...);
+			g_FrameProfiler.Leave();
+			return;
+		}
+#endif
+		m_OriginalFunc(args...);
 	}
 
 private:
@@ -114,6 +150,8 @@ protected:
 
 public:
 	AbstractHookChainRegistry();
+
+	bool hasHooks() const { return m_NumHooks != 0; }
 };
 
 template<typename t_ret, typename ...t_args>
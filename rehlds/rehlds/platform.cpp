@@ -54,11 +54,15 @@ int CSimplePlatform::rand()
 	return ::rand();
 }
 
-#ifdef _WIN32
 void CSimplePlatform::Sleep(DWORD msec) {
+#ifdef _WIN32
 	::Sleep(msec);
+#else
+	usleep(msec * 1000);
+#endif
 }
 
+#ifdef _WIN32
 BOOL CSimplePlatform::QueryPerfCounter(LARGE_INTEGER* counter) {
 	return ::QueryPerformanceCounter(counter);
 }
@@ -92,6 +96,11 @@ void CSimplePlatform::GetSystemTimeAsFileTime(LPFILETIME lpSystemTimeAsFileTime)
 {
 	::GetSystemTimeAsFileTime(lpSystemTimeAsFileTime);
 }
+#else //WIN32
+int CSimplePlatform::clock_gettime(clockid_t clk, struct timespec* ts)
+{
+	return ::clock_gettime(clk, ts);
+}
 #endif //WIN32
 
 SOCKET CSimplePlatform::socket(int af, int type, int protocol) {
@@ -118,10 +127,22 @@ int CSimplePlatform::recvfrom(SOCKET s, char* buf, int len, int flags, struct so
 	return ::recvfrom(s, buf, len, flags, from, fromlen);
 }
 
+#ifndef _WIN32
+int CSimplePlatform::recvmmsg(SOCKET s, struct mmsghdr* msgvec, unsigned int vlen, int flags, struct timespec* timeout) {
+	return ::recvmmsg(s, msgvec, vlen, flags, timeout);
+}
+#endif
+
 int CSimplePlatform::sendto(SOCKET s, const char* buf, int len, int flags, const struct sockaddr* to, int tolen) {
 	return ::sendto(s, buf, len, flags, to, tolen);
 }
 
+#ifndef _WIN32
+int CSimplePlatform::sendmmsg(SOCKET s, struct mmsghdr* msgvec, unsigned int vlen, int flags) {
+	return ::sendmmsg(s, msgvec, vlen, flags);
+}
+#endif
+
 int CSimplePlatform::bind(SOCKET s, const struct sockaddr* addr, int namelen) {
 	return ::bind(s, addr, namelen);
 }
@@ -138,17 +159,22 @@ int CSimplePlatform::gethostname(char *name, int namelen) {
 	return ::gethostname(name, namelen);
 }
 
-#ifdef _WIN32
-
 int CSimplePlatform::ioctlsocket(SOCKET s, long cmd, u_long *argp) {
+#ifdef _WIN32
 	return ::ioctlsocket(s, cmd, argp);
+#else
+	return ::ioctl(s, cmd, argp);
+#endif
 }
 
 int CSimplePlatform::WSAGetLastError() {
+#ifdef _WIN32
 	return ::WSAGetLastError();
+#else
+	return errno;
+#endif
 }
 
-#endif //WIN32
 void CSimplePlatform::SteamAPI_SetBreakpadAppID(uint32 unAppID) {
 	return ::SteamAPI_SetBreakpadAppID(unAppID);
 }
@@ -15,8 +15,8 @@ public:
 	virtual void srand(uint32 seed) = 0;
 	virtual int rand() = 0;
 
-#ifdef _WIN32
 	virtual void Sleep(DWORD msec) = 0;
+#ifdef _WIN32
 	virtual BOOL QueryPerfCounter(LARGE_INTEGER* counter) = 0;
 	virtual BOOL QueryPerfFreq(LARGE_INTEGER* freq) = 0;
 	virtual DWORD GetTickCount() = 0;
@@ -25,22 +25,28 @@ public:
 	virtual void GetTimeZoneInfo(LPTIME_ZONE_INFORMATION zinfo) = 0;
 	virtual BOOL GetProcessTimes(HANDLE hProcess, LPFILETIME lpCreationTime, LPFILETIME lpExitTime, LPFILETIME lpKernelTime, LPFILETIME lpUserTime) = 0;
 	virtual void GetSystemTimeAsFileTime(LPFILETIME lpSystemTimeAsFileTime) = 0;
+#else
+	virtual int clock_gettime(clockid_t clk, struct timespec* ts) = 0;
 #endif
 
 	virtual SOCKET socket(int af, int type, int protocol) = 0;
 	virtual int setsockopt(SOCKET s, int level, int optname, const char* optval, int optlen) = 0;
 	virtual int closesocket(SOCKET s) = 0;
 	virtual int recvfrom(SOCKET s, char* buf, int len, int flags, struct sockaddr* from, socklen_t *fromlen) = 0;
+#ifndef _WIN32
+	virtual int recvmmsg(SOCKET s, struct mmsghdr* msgvec, unsigned int vlen, int flags, struct timespec* timeout) = 0;
+#endif
 	virtual int sendto(SOCKET s, const char* buf, int len, int flags, const struct sockaddr* to, int tolen) = 0;
+#ifndef _WIN32
+	virtual int sendmmsg(SOCKET s, struct mmsghdr* msgvec, unsigned int vlen, int flags) = 0;
+#endif
 	virtual int bind(SOCKET s, const struct sockaddr* addr, int namelen) = 0;
 	virtual int getsockname(SOCKET s, struct sockaddr* name, socklen_t* namelen) = 0;
 	virtual struct hostent* gethostbyname(const char *name) = 0;
 	virtual int gethostname(char *name, int namelen) = 0;
 
-#ifdef _WIN32
 	virtual int ioctlsocket(SOCKET s, long cmd, u_long *argp) = 0;
 	virtual int WSAGetLastError() = 0;
-#endif
 
 	virtual void SteamAPI_SetBreakpadAppID(uint32 unAppID) = 0;
 	virtual void SteamAPI_UseBreakpadCrashHandler(char const *pchVersion, char const *pchDate, char const *pchTime, bool bFullMemoryDumps, void *pvContext, PFNPreMinidumpCallback m_pfnPreMinidumpCallback) = 0;
@@ -72,8 +78,8 @@ public:
 	virtual void srand(uint32 seed);
 	virtual int rand();
 
-#ifdef _WIN32
 	virtual void Sleep(DWORD msec);
+#ifdef _WIN32
 	virtual BOOL QueryPerfCounter(LARGE_INTEGER* counter);
 	virtual BOOL QueryPerfFreq(LARGE_INTEGER* freq);
 	virtual DWORD GetTickCount();
@@ -82,22 +88,28 @@ public:
 	virtual void GetTimeZoneInfo(LPTIME_ZONE_INFORMATION zinfo);
 	virtual BOOL GetProcessTimes(HANDLE hProcess, LPFILETIME lpCreationTime, LPFILETIME lpExitTime, LPFILETIME lpKernelTime, LPFILETIME lpUserTime);
 	virtual void GetSystemTimeAsFileTime(LPFILETIME lpSystemTimeAsFileTime);
+#else
+	virtual int clock_gettime(clockid_t clk, struct timespec* ts);
 #endif
 
 	virtual SOCKET socket(int af, int type, int protocol);
 	virtual int setsockopt(SOCKET s, int level, int optname, const char* optval, int optlen);
 	virtual int closesocket(SOCKET s);
 	virtual int recvfrom(SOCKET s, char* buf, int len, int flags, struct sockaddr* from, socklen_t *fromlen);
+#ifndef _WIN32
+	virtual int recvmmsg(SOCKET s, struct mmsghdr* msgvec, unsigned int vlen, int flags, struct timespec* timeout);
+#endif
 	virtual int sendto(SOCKET s, const char* buf, int len, int flags, const struct sockaddr* to, int tolen);
+#ifndef _WIN32
+	virtual int sendmmsg(SOCKET s, struct mmsghdr* msgvec, unsigned int vlen, int flags);
+#endif
 	virtual int bind(SOCKET s, const struct sockaddr* addr, int namelen);
 	virtual int getsockname(SOCKET s, struct sockaddr* name, socklen_t* namelen);
 	virtual struct hostent* gethostbyname(const char *name);
 	virtual int gethostname(char *name, int namelen);
 
-#ifdef _WIN32
 	virtual int ioctlsocket(SOCKET s, long cmd, u_long *argp);
 	virtual int WSAGetLastError();
-#endif
 
 	virtual void SteamAPI_SetBreakpadAppID(uint32 unAppID);
 	virtual void SteamAPI_UseBreakpadCrashHandler(char const *pchVersion, char const *pchDate, char const *pchTime, bool bFullMemoryDumps, void *pvContext, PFNPreMinidumpCallback m_pfnPreMinidumpCallback);
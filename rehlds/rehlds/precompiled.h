@@ -50,6 +50,8 @@
 #include "FlightRecorderImpl.h"
 #include "flight_recorder.h"
 #include "rehlds_security.h"
+#include "workerpool.h"
+#include "profiler.h"
 
 #include "dlls/cdll_dll.h"
 #include "hltv.h"
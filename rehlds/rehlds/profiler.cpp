@@ -0,0 +1,396 @@
+#include "precompiled.h"
+
+#ifdef _WIN32
+#include <intrin.h>
+#else
+#include <x86intrin.h>
+#endif
+
+CFrameProfiler g_FrameProfiler;
+
+static const char *g_ProfPhaseNames[PROF_NUM_PHASES] = {
+	"", "frame", "SV_ReadPackets", "SV_Physics", "SV_SendClientMessages", "Steam_RunFrame", "engine",
+};
+
+CFrameProfiler::CFrameProfiler() {
+	m_Active = false;
+	m_Enabled = false;
+	m_ResetPending = false;
+	m_Nodes = NULL;
+	m_NumNodes = 0;
+	m_Depth = 0;
+	m_Overflow = 0;
+	m_Phase = PROF_NONE;
+	m_PhaseDepth = 0;
+	m_NumFrames = 0;
+	m_StartTicks = 0;
+	m_StartTime = 0.0;
+	m_NumModules = 0;
+	Q_memset(m_FuncCache, 0, sizeof(m_FuncCache));
+}
+
+CFrameProfiler::~CFrameProfiler() {
+	Free();
+}
+
+uint64 CFrameProfiler::Ticks() {
+	return __rdtsc();
+}
+
+void CFrameProfiler::BeginFrame(bool enabled) {
+	// the last frame was left by a longjmp (Host_Error), its scopes are dropped
+	if (m_Active) {
+		for (int i = 0; i < m_NumNodes; i++) {
+			m_Nodes[i].active = 0;
+			m_Nodes[i].frameTicks = 0;
+		}
+
+		m_Active = false;
+		m_ActiveThread = std::thread::id();
+		if (m_ResetPending)
+			Reset();
+	}
+
+	if (enabled != m_Enabled) {
+		m_Enabled = enabled;
+		if (enabled)
+			Reset();
+		else
+			Free();
+	}
+
+	if (!m_Enabled)
+		return;
+
+	m_Depth = 0;
+	m_Overflow = 0;
+	m_Phase = PROF_NONE;
+	m_Active = true;
+	m_ActiveThread = std::this_thread::get_id();
+	Enter(PROF_FRAME, g_ProfPhaseNames[PROF_FRAME]);
+}
+
+void CFrameProfiler::EndFrame() {
+	if (!m_Active)
+		return;
+
+	Phase(PROF_NONE);
+	Leave();
+	m_Active = false;
+	m_ActiveThread = std::thread::id();
+
+	uint32 slot = m_NumFrames++ & (PROF_HISTORY - 1);
+	for (int i = 0; i < m_NumNodes; i++) {
+		node_t *node = &m_Nodes[i];
+		node->history[slot] = (uint32)min(node->frameTicks, (uint64)0xFFFFFFFF);
+		node->frameTicks = 0;
+	}
+
+	if (m_ResetPending)
+		Reset();
+}
+
+void CFrameProfiler::Phase(int phase) {
+	if (!m_Active || phase == m_Phase)
+		return;
+
+	// phases follow each other at the depth of SV_Frame_Internal, under the hooks of SV_Frame if there are any
+	if (m_Phase != PROF_NONE) {
+		if (m_Depth == m_PhaseDepth + 1 || m_Overflow)
+			Leave();
+
+		m_Phase = PROF_NONE;
+	}
+
+	if (phase != PROF_NONE) {
+		m_PhaseDepth = m_Depth;
+		Enter(phase, g_ProfPhaseNames[phase]);
+		m_Phase = phase;
+	}
+}
+
+void CFrameProfiler::EnterHook(void *hookFunc) {
+	const module_t *module = FindModule(hookFunc);
+	Enter((uintptr_t)module->base, module->name);
+
+	if (!m_Overflow)
+		m_Nodes[m_Stack[m_Depth - 1].node].hook = true;
+}
+
+bool CFrameProfiler::EnterOriginal() {
+	// the engine is only split out of a hook, a chain without hooks stays in the time of its caller
+	if (!m_Overflow && (m_Depth == 0 || !m_Nodes[m_Stack[m_Depth - 1].node].hook))
+		return false;
+
+	Enter(PROF_ORIGINAL, g_ProfPhaseNames[PROF_ORIGINAL]);
+	return true;
+}
+
+void CFrameProfiler::Enter(uintptr_t key, const char *name) {
+	// everything nested in a scope that did not fit is dropped as well
+	if (m_Overflow || m_Depth >= PROF_MAX_DEPTH) {
+		m_Overflow++;
+		return;
+	}
+
+	int parent = m_Depth ? m_Stack[m_Depth - 1].node : -1;
+	int node = FindChild(parent, key, name);
+	if (node < 0) {
+		m_Overflow++;
+		return;
+	}
+
+	scope_t *scope = &m_Stack[m_Depth++];
+	scope->node = node;
+	scope->childTicks = 0;
+	m_Nodes[node].active++;
+	scope->start = Ticks();
+}
+
+void CFrameProfiler::Leave() {
+	uint64 now = Ticks();
+
+	if (m_Overflow) {
+		m_Overflow--;
+		return;
+	}
+
+	if (m_Depth <= 0)
+		return;
+
+	scope_t *scope = &m_Stack[--m_Depth];
+	node_t *node = &m_Nodes[scope->node];
+	uint64 elapsed = now - scope->start;
+
+	node->calls++;
+	node->selfTicks += elapsed - min(scope->childTicks, elapsed);
+	if (--node->active == 0) {
+		node->totalTicks += elapsed;
+		node->frameTicks += elapsed;
+	}
+
+	if (m_Depth > 0)
+		m_Stack[m_Depth - 1].childTicks += elapsed;
+}
+
+int CFrameProfiler::FindChild(int parent, uintptr_t key, const char *name) {
+	int first = parent >= 0 ? m_Nodes[parent].firstChild : (m_NumNodes ? 0 : -1);
+	for (int i = first; i >= 0; i = m_Nodes[i].nextSibling) {
+		if (m_Nodes[i].key == key)
+			return i;
+	}
+
+	if (m_NumNodes >= PROF_MAX_NODES)
+		return -1;
+
+	int index = m_NumNodes++;
+	node_t *node = &m_Nodes[index];
+	node->key = key;
+	node->parent = parent;
+	node->firstChild = -1;
+	node->nextSibling = -1;
+	node->depth = parent >= 0 ? m_Nodes[parent].depth + 1 : 0;
+	node->active = 0;
+	node->hook = false;
+	Q_strlcpy(node->name, name);
+	node->calls = 0;
+	node->selfTicks = 0;
+	node->totalTicks = 0;
+	node->frameTicks = 0;
+	Q_memset(node->history, 0, sizeof(uint32) * PROF_HISTORY);
+
+	// keep the order of creation among the siblings
+	if (parent >= 0) {
+		int *link = &m_Nodes[parent].firstChild;
+		while (*link >= 0)
+			link = &m_Nodes[*link].nextSibling;
+		*link = index;
+	}
+
+	return index;
+}
+
+const CFrameProfiler::module_t *CFrameProfiler::FindModule(void *func) {
+	uint32 slot = (uint32)((uintptr_t)func >> 4) * 0x9E3779B1u >> 24;
+	int probe;
+	for (probe = 0; probe < 256; probe++, slot = (slot + 1) & 255) {
+		if (m_FuncCache[slot] == func)
+			return &m_Modules[m_FuncModule[slot]];
+
+		if (!m_FuncCache[slot])
+			break;
+	}
+
+	void *base = NULL;
+	char path[MAX_PATH] = "unknown";
+
+#ifdef _WIN32
+	HMODULE hModule;
+	if (GetModuleHandleExA(GET_MODULE_HANDLE_EX_FLAG_FROM_ADDRESS | GET_MODULE_HANDLE_EX_FLAG_UNCHANGED_REFCOUNT, (LPCSTR)func, &hModule)) {
+		base = hModule;
+		GetModuleFileNameA(hModule, path, sizeof(path));
+	}
+#else // _WIN32
+	Dl_info addrInfo;
+	if (dladdr(func, &addrInfo) && addrInfo.dli_fname) {
+		base = addrInfo.dli_fbase;
+		Q_strlcpy(path, addrInfo.dli_fname);
+	}
+#endif // _WIN32
+
+	int module;
+	for (module = 0; module < m_NumModules; module++) {
+		if (m_Modules[module].base == base)
+			break;
+	}
+
+	if (module == m_NumModules) {
+		// everything past the limit is accounted to the last one
+		if (m_NumModules < PROF_MAX_MODULES)
+			m_NumModules++;
+		else
+			module = PROF_MAX_MODULES - 1;
+
+		const char *fileName = max(Q_strrchr(path, '/'), Q_strrchr(path, '\\'));
+		m_Modules[module].base = base;
+		Q_strlcpy(m_Modules[module].name, fileName ? fileName + 1 : path);
+	}
+
+	// once the cache is full every miss resolves the module again
+	if (probe < 256) {
+		m_FuncCache[slot] = func;
+		m_FuncModule[slot] = module;
+	}
+
+	return &m_Modules[module];
+}
+
+void CFrameProfiler::Reset() {
+	if (!m_Enabled)
+		return;
+
+	if (!m_Nodes) {
+		m_Nodes = (node_t *)Mem_ZeroMalloc(sizeof(node_t) * PROF_MAX_NODES);
+		for (int i = 0; i < PROF_MAX_NODES; i++)
+			m_Nodes[i].history = (uint32 *)Mem_ZeroMalloc(sizeof(uint32) * PROF_HISTORY);
+	}
+
+	// nodes of the frame being recorded are in use, called from a hook
+	if (m_Active) {
+		m_ResetPending = true;
+		return;
+	}
+
+	m_ResetPending = false;
+	m_NumNodes = 0;
+	m_NumFrames = 0;
+
+	// modules may have been unloaded since, their addresses reused
+	m_NumModules = 0;
+	Q_memset(m_FuncCache, 0, sizeof(m_FuncCache));
+
+	m_StartTicks = Ticks();
+	m_StartTime = Sys_FloatTime();
+}
+
+void CFrameProfiler::Free() {
+	if (m_Nodes) {
+		for (int i = 0; i < PROF_MAX_NODES; i++)
+			Mem_Free(m_Nodes[i].history);
+
+		Mem_Free(m_Nodes);
+		m_Nodes = NULL;
+	}
+
+	m_NumNodes = 0;
+	m_NumFrames = 0;
+	m_NumModules = 0;
+	Q_memset(m_FuncCache, 0, sizeof(m_FuncCache));
+	m_Active = false;
+	m_ActiveThread = std::thread::id();
+	m_Enabled = false;
+}
+
+double CFrameProfiler::TicksPerMsec() const {
+	double elapsed = Sys_FloatTime() - m_StartTime;
+	if (elapsed <= 0.0)
+		return 1.0;
+
+	return (double)(Ticks() - m_StartTicks) / (elapsed * 1000.0);
+}
+
+static int ProfileHistoryCompare(const void *a, const void *b) {
+	uint32 x = *(const uint32 *)a, y = *(const uint32 *)b;
+	return (x > y) - (x < y);
+}
+
+int CFrameProfiler::GetStats(profilestats_t *stats, int maxStats) {
+	if (!m_Nodes || !m_NumFrames)
+		return 0;
+
+	double tpm = TicksPerMsec();
+	int numFrames = min(m_NumFrames, (uint32)PROF_HISTORY);
+	uint32 sorted[PROF_HISTORY];
+	int count = 0;
+
+	// depth-first, the same order as the tree is printed
+	int stack[PROF_MAX_NODES];
+	int sp = 0;
+	stack[sp++] = 0;
+
+	while (sp > 0 && count < maxStats) {
+		int index = stack[--sp];
+		node_t *node = &m_Nodes[index];
+		profilestats_t *s = &stats[count++];
+
+		Q_memcpy(sorted, node->history, sizeof(uint32) * numFrames);
+		qsort(sorted, numFrames, sizeof(uint32), ProfileHistoryCompare);
+
+		s->name = node->name;
+		s->depth = node->depth;
+		s->calls = node->calls;
+		s->selfMsec = node->selfTicks / tpm / m_NumFrames;
+		s->totalMsec = node->totalTicks / tpm / m_NumFrames;
+		s->p50Msec = sorted[numFrames / 2] / tpm;
+		s->p99Msec = sorted[numFrames * 99 / 100] / tpm;
+		s->maxMsec = sorted[numFrames - 1] / tpm;
+
+		// children go on the stack in reverse to come out in order
+		int first = sp;
+		for (int c = node->firstChild; c >= 0; c = m_Nodes[c].nextSibling)
+			stack[sp++] = c;
+
+		for (int i = first, j = sp - 1; i < j; i++, j--) {
+			int t = stack[i];
+			stack[i] = stack[j];
+			stack[j] = t;
+		}
+	}
+
+	return count;
+}
+
+void CFrameProfiler::Print(void(*print)(void *ctx, const char *line), void *ctx) {
+	static profilestats_t stats[PROF_MAX_NODES];
+	char line[256];
+
+	int count = GetStats(stats, PROF_MAX_NODES);
+	if (!count) {
+		print(ctx, "No frames recorded, set sv_rehlds_profile 1\n");
+		return;
+	}
+
+	Q_snprintf(line, sizeof(line), "%u frames, times in ms per frame, percentiles over the last %i frames\n", m_NumFrames, min(m_NumFrames, (uint32)PROF_HISTORY));
+	print(ctx, line);
+	Q_snprintf(line, sizeof(line), "%-40s %10s %8s %8s %8s %8s %8s\n", "node", "calls", "self", "total", "p50", "p99", "max");
+	print(ctx, line);
+
+	for (int i = 0; i < count; i++) {
+		profilestats_t *s = &stats[i];
+		char name[64];
+
+		Q_snprintf(name, sizeof(name), "%*s%s", s->depth * 2, "", s->name);
+		Q_snprintf(line, sizeof(line), "%-40s %10u %8.3f %8.3f %8.3f %8.3f %8.3f\n", name, s->calls, s->selfMsec, s->totalMsec, s->p50Msec, s->p99Msec, s->maxMsec);
+		print(ctx, line);
+	}
+}
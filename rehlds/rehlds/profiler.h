@@ -0,0 +1,112 @@
+#pragma once
+
+#include "archtypes.h"
+
+#include <thread>
+
+const int PROF_MAX_NODES = 128;
+const int PROF_MAX_DEPTH = 32;
+const int PROF_MAX_MODULES = 32;
+const int PROF_HISTORY = 1024;	// frames, power of two
+
+// Fixed nodes of the frame tree, hooks get a node per module under the node they were called from
+enum prof_phase_e
+{
+	PROF_NONE,
+	PROF_FRAME,
+	PROF_READPACKETS,
+	PROF_PHYSICS,
+	PROF_SENDMESSAGES,
+	PROF_STEAM,
+	PROF_ORIGINAL,	// engine function at the end of a hook chain
+
+	PROF_NUM_PHASES
+};
+
+struct profilestats_t;
+
+// Scoped rdtsc timers of the server frame (sv_rehlds_profile).
+// Runs on the main thread only, everything else is ignored while a frame is recorded.
+class CFrameProfiler {
+public:
+	CFrameProfiler();
+	~CFrameProfiler();
+
+	// False on any thread but the one recording the frame
+	bool IsActive() const { return m_Active && m_ActiveThread == std::this_thread::get_id(); }
+
+	void BeginFrame(bool enabled);
+	void EndFrame();
+
+	// Switches between the consecutive phases of the frame
+	void Phase(int phase);
+
+	void EnterHook(void *hookFunc);
+	bool EnterOriginal();	// false if there is no scope to leave
+	void Leave();
+
+	void Reset();
+	void Free();
+
+	// Fills the nodes in tree order and returns their count
+	int GetStats(profilestats_t *stats, int maxStats);
+	void Print(void(*print)(void *ctx, const char *line), void *ctx);
+
+private:
+	struct node_t {
+		uintptr_t key;
+		int parent;
+		int firstChild;
+		int nextSibling;
+		int depth;
+		int active;			// recursion of the same node is counted once in the total
+		bool hook;
+		char name[64];
+		uint32 calls;
+		uint64 selfTicks;
+		uint64 totalTicks;
+		uint64 frameTicks;
+		uint32 *history;	// ticks with the children per frame
+	};
+
+	struct scope_t {
+		int node;
+		uint64 start;
+		uint64 childTicks;
+	};
+
+	struct module_t {
+		void *base;
+		char name[64];
+	};
+
+	void Enter(uintptr_t key, const char *name);
+	int FindChild(int parent, uintptr_t key, const char *name);
+	const module_t *FindModule(void *func);
+	double TicksPerMsec() const;
+	static uint64 Ticks();
+
+private:
+	bool m_Active;
+	std::thread::id m_ActiveThread;	// set by BeginFrame, hooks called from other threads are not recorded
+	bool m_Enabled;
+	bool m_ResetPending;
+	node_t *m_Nodes;
+	int m_NumNodes;
+	scope_t m_Stack[PROF_MAX_DEPTH];
+	int m_Depth;
+	int m_Overflow;
+	int m_Phase;
+	int m_PhaseDepth;
+
+	uint32 m_NumFrames;		// since the last reset
+	uint64 m_StartTicks;
+	double m_StartTime;
+
+	module_t m_Modules[PROF_MAX_MODULES];
+	int m_NumModules;
+	void *m_FuncCache[256];
+	int m_FuncModule[256];
+};
+
+extern CFrameProfiler g_FrameProfiler;
@@ -75,6 +75,40 @@ cmd_function_t* EXT_FUNC GetFirstCmdFunctionHandle_api() {
 	return Cmd_GetFirstCmd();
 }
 
+void EXT_FUNC SetDeltaEncodersThreadSafe_api(bool threadSafe) {
+#ifdef REHLDS_FIXES
+	g_bSnapshotEncodersThreadSafe = threadSafe ? TRUE : FALSE;
+#endif
+}
+
+const msgstats_t* EXT_FUNC GetMessageStats_api(int msgType) {
+#ifdef REHLDS_FIXES
+	return SV_GetMsgStats(msgType);
+#else
+	return nullptr;
+#endif
+}
+
+void EXT_FUNC ResetMessageStats_api() {
+#ifdef REHLDS_FIXES
+	SV_ResetMsgStats();
+#endif
+}
+
+int EXT_FUNC GetProfileStats_api(profilestats_t *stats, int maxStats) {
+#ifdef REHLDS_FIXES
+	return g_FrameProfiler.GetStats(stats, maxStats);
+#else
+	return 0;
+#endif
+}
+
+void EXT_FUNC ResetProfileStats_api() {
+#ifdef REHLDS_FIXES
+	g_FrameProfiler.Reset();
+#endif
+}
+
 int* EXT_FUNC GetMsgBadRead_api() {
 	return &msg_badread;
 }
@@ -559,7 +593,12 @@ RehldsFuncs_t g_RehldsApiFuncs =
 	&SZ_Clear_api,
 	&MSG_BeginReading_api,
 	&GetHostFrameTime_api,
-	&GetFirstCmdFunctionHandle_api
+	&GetFirstCmdFunctionHandle_api,
+	&SetDeltaEncodersThreadSafe_api,
+	&GetMessageStats_api,
+	&ResetMessageStats_api,
+	&GetProfileStats_api,
+	&ResetProfileStats_api
 };
 
 bool EXT_FUNC SV_EmitSound2_internal(edict_t *entity, IGameClient *pReceiver, int channel, const char *sample, float volume, float attenuation, int flags, int pitch, int emitFlags, const float *pOrigin)
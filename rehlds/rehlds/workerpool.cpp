@@ -0,0 +1,114 @@
+#include "precompiled.h"
+
+CWorkerPool::CWorkerPool() {
+	m_NumThreads = 0;
+	m_Generation = 0;
+	m_Busy = 0;
+	m_Stop = false;
+	m_Job = NULL;
+	m_Ctx = NULL;
+	m_Count = 0;
+	m_NextIndex = 0;
+}
+
+CWorkerPool::~CWorkerPool() {
+	Stop();
+}
+
+void CWorkerPool::Start(int numThreads) {
+	numThreads = clamp(numThreads, 0, MAX_WORKER_THREADS);
+	if (numThreads == m_NumThreads)
+		return;
+
+	Stop();
+
+	// a new thread must only pick up the runs issued after it was started
+	unsigned int generation;
+	{
+		std::lock_guard<std::mutex> lock(m_Mutex);
+		m_Stop = false;
+		generation = m_Generation;
+	}
+
+	for (int i = 0; i < numThreads; i++) {
+		m_Threads[i] = std::thread(&CWorkerPool::ThreadMain, this, i + 1, generation);
+	}
+
+	m_NumThreads = numThreads;
+}
+
+void CWorkerPool::Stop() {
+	if (!m_NumThreads)
+		return;
+
+	{
+		std::lock_guard<std::mutex> lock(m_Mutex);
+		m_Stop = true;
+	}
+	m_WorkCond.notify_all();
+
+	for (int i = 0; i < m_NumThreads; i++) {
+		m_Threads[i].join();
+	}
+
+	m_NumThreads = 0;
+}
+
+void CWorkerPool::ProcessJobs(int worker) {
+	int index;
+	while ((index = m_NextIndex.fetch_add(1)) < m_Count) {
+		m_Job(index, worker, m_Ctx);
+	}
+}
+
+void CWorkerPool::ThreadMain(int worker, unsigned int generation) {
+	while (true) {
+		{
+			std::unique_lock<std::mutex> lock(m_Mutex);
+			m_WorkCond.wait(lock, [&] { return m_Stop || m_Generation != generation; });
+			if (m_Stop)
+				return;
+
+			generation = m_Generation;
+		}
+
+		ProcessJobs(worker);
+
+		std::lock_guard<std::mutex> lock(m_Mutex);
+		if (--m_Busy == 0)
+			m_DoneCond.notify_one();
+	}
+}
+
+void CWorkerPool::Run(int count, job_t job, void *ctx) {
+	if (count <= 0)
+		return;
+
+	// not worth waking anybody up for a single job
+	bool wakeWorkers = m_NumThreads && count != 1;
+
+	{
+		std::lock_guard<std::mutex> lock(m_Mutex);
+		m_Job = job;
+		m_Ctx = ctx;
+		m_Count = count;
+		m_NextIndex = 0;
+
+		if (wakeWorkers) {
+			m_Busy = m_NumThreads;
+			m_Generation++;
+		}
+	}
+
+	if (!wakeWorkers) {
+		ProcessJobs(0);
+		return;
+	}
+
+	m_WorkCond.notify_all();
+
+	ProcessJobs(0);
+
+	std::unique_lock<std::mutex> lock(m_Mutex);
+	m_DoneCond.wait(lock, [&] { return m_Busy == 0; });
+}
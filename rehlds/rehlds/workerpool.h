@@ -0,0 +1,47 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+const int MAX_WORKER_THREADS = 15;
+
+// Small fork/join pool: Run() splits [0, count) between the worker threads and the calling thread
+// and returns when every index has been processed. Worker 0 is always the calling thread.
+class CWorkerPool {
+public:
+	typedef void(*job_t)(int index, int worker, void *ctx);
+
+	CWorkerPool();
+	~CWorkerPool();
+
+	void Start(int numThreads);
+	void Stop();
+	int GetNumThreads() const { return m_NumThreads; }
+
+	// id of the thread running the jobs of a worker, worker 0 is the caller
+	std::thread::id GetThreadId(int worker) const { return worker ? m_Threads[worker - 1].get_id() : std::this_thread::get_id(); }
+
+	void Run(int count, job_t job, void *ctx);
+
+private:
+	void ThreadMain(int worker, unsigned int generation);
+	void ProcessJobs(int worker);
+
+private:
+	std::thread m_Threads[MAX_WORKER_THREADS];
+	int m_NumThreads;
+
+	std::mutex m_Mutex;
+	std::condition_variable m_WorkCond;
+	std::condition_variable m_DoneCond;
+	unsigned int m_Generation;
+	int m_Busy;
+	bool m_Stop;
+
+	job_t m_Job;
+	void *m_Ctx;
+	int m_Count;
+	std::atomic<int> m_NextIndex;
+};
@@ -523,6 +523,7 @@ void CAnonymizingEngExtInterceptor::Sleep(DWORD msec)
 	m_BasePlatform->Sleep(msec);
 }
 
+#ifdef _WIN32
 BOOL CAnonymizingEngExtInterceptor::QueryPerfCounter(LARGE_INTEGER* counter)
 {
 	BOOL res = m_BasePlatform->QueryPerfCounter(counter);
@@ -566,6 +567,13 @@ void CAnonymizingEngExtInterceptor::GetSystemTimeAsFileTime(LPFILETIME lpSystemT
 {
 	m_BasePlatform->GetSystemTimeAsFileTime(lpSystemTimeAsFileTime);
 }
+#else // _WIN32
+int CAnonymizingEngExtInterceptor::clock_gettime(clockid_t clk, struct timespec* ts)
+{
+	int res = m_BasePlatform->clock_gettime(clk, ts);
+	return res;
+}
+#endif // _WIN32
 
 SOCKET CAnonymizingEngExtInterceptor::socket(int af, int type, int protocol)
 {
@@ -605,6 +613,13 @@ int CAnonymizingEngExtInterceptor::recvfrom(SOCKET s, char* buf, int len, int fl
 	return res;
 }
 
+#ifndef _WIN32
+int CAnonymizingEngExtInterceptor::recvmmsg(SOCKET s, struct mmsghdr* msgvec, unsigned int vlen, int flags, struct timespec* timeout)
+{
+	return TestSuite_RecvMMsg(this, s, msgvec, vlen, flags);
+}
+#endif // _WIN32
+
 int CAnonymizingEngExtInterceptor::sendto(SOCKET s, const char* buf, int len, int flags, const struct sockaddr* to, int tolen)
 {
 
@@ -616,6 +631,13 @@ int CAnonymizingEngExtInterceptor::sendto(SOCKET s, const char* buf, int len, in
 	return res;
 }
 
+#ifndef _WIN32
+int CAnonymizingEngExtInterceptor::sendmmsg(SOCKET s, struct mmsghdr* msgvec, unsigned int vlen, int flags)
+{
+	return TestSuite_SendMMsg(this, s, msgvec, vlen, flags);
+}
+#endif // _WIN32
+
 int CAnonymizingEngExtInterceptor::bind(SOCKET s, const struct sockaddr* addr, int namelen)
 {
 	int res = m_BasePlatform->bind(s, addr, namelen);
@@ -1,5 +1,6 @@
 #include "precompiled.h"
 
+#ifdef _WIN32
 void PrintSystemTime(LPSYSTEMTIME t, std::stringstream &ss)
 {
 	ss << "{"
@@ -21,6 +22,7 @@ void PrintFileTime(LPFILETIME t, std::stringstream &ss)
 		<< " lowDate: " << t->dwLowDateTime
 		<< " }";
 }
+#endif // _WIN32
 
 void PrintTm(struct tm* t, std::stringstream &ss) {
 	ss << "{"
@@ -89,10 +91,10 @@ std::string CSleepExtCall::toString()
 
 bool CSleepExtCall::compareInputArgs(IEngExtCall* other, bool strict)
 {
-	CSleepExtCall* otherSleep = dynamic_cast<CSleepExtCall*>(other);
-	if (otherSleep == NULL)
+	if (other->getOpcode() != getOpcode())
 		return false;
 
+	CSleepExtCall* otherSleep = static_cast<CSleepExtCall*>(other);
 	return otherSleep->m_Time == this->m_Time;
 }
 
@@ -108,6 +110,7 @@ void CSleepExtCall::readPrologue(std::istream &stream)
 
 
 
+#ifdef _WIN32
 /* ============================================================================
 							   CQueryPerfFreqCall
 ============================================================================ */
@@ -123,8 +126,7 @@ std::string CQueryPerfFreqCall::toString()
 
 bool CQueryPerfFreqCall::compareInputArgs(IEngExtCall* other, bool strict)
 {
-	CQueryPerfFreqCall* otherPerfFreq = dynamic_cast<CQueryPerfFreqCall*>(other);
-	if (otherPerfFreq == NULL)
+	if (other->getOpcode() != getOpcode())
 		return false;
 
 	return true;
@@ -156,8 +158,7 @@ std::string CQueryPerfCounterCall::toString()
 
 bool CQueryPerfCounterCall::compareInputArgs(IEngExtCall* other, bool strict)
 {
-	CQueryPerfCounterCall* otherPerfFreq = dynamic_cast<CQueryPerfCounterCall*>(other);
-	if (otherPerfFreq == NULL)
+	if (other->getOpcode() != getOpcode())
 		return false;
 
 	return true;
@@ -187,8 +188,7 @@ std::string CGetTickCountCall::toString()
 
 bool CGetTickCountCall::compareInputArgs(IEngExtCall* other, bool strict)
 {
-	CGetTickCountCall* otherCall = dynamic_cast<CGetTickCountCall*>(other);
-	if (otherCall == NULL)
+	if (other->getOpcode() != getOpcode())
 		return false;
 
 	return true;
@@ -220,8 +220,7 @@ std::string CGetLocalTimeCall::toString()
 
 bool CGetLocalTimeCall::compareInputArgs(IEngExtCall* other, bool strict)
 {
-	CGetLocalTimeCall* otherCall = dynamic_cast<CGetLocalTimeCall*>(other);
-	if (otherCall == NULL)
+	if (other->getOpcode() != getOpcode())
 		return false;
 
 	return true;
@@ -251,8 +250,7 @@ std::string CGetSystemTimeCall::toString()
 
 bool CGetSystemTimeCall::compareInputArgs(IEngExtCall* other, bool strict)
 {
-	CGetSystemTimeCall* otherCall = dynamic_cast<CGetSystemTimeCall*>(other);
-	if (otherCall == NULL)
+	if (other->getOpcode() != getOpcode())
 		return false;
 
 	return true;
@@ -290,8 +288,7 @@ std::string CGetTimeZoneInfoCall::toString()
 
 bool CGetTimeZoneInfoCall::compareInputArgs(IEngExtCall* other, bool strict)
 {
-	CGetTimeZoneInfoCall* otherCall = dynamic_cast<CGetTimeZoneInfoCall*>(other);
-	if (otherCall == NULL)
+	if (other->getOpcode() != getOpcode())
 		return false;
 
 	return true;
@@ -304,6 +301,7 @@ void CGetTimeZoneInfoCall::writeEpilogue(std::ostream &stream) {
 void CGetTimeZoneInfoCall::readEpilogue(std::istream &stream) {
 	stream.read((char*)&m_Res, sizeof(m_Res));
 }
+#endif // _WIN32
 
 
 
@@ -328,10 +326,10 @@ std::string CSocketCall::toString()
 
 bool CSocketCall::compareInputArgs(IEngExtCall* other, bool strict)
 {
-	CSocketCall* otherCall = dynamic_cast<CSocketCall*>(other);
-	if (otherCall == NULL)
+	if (other->getOpcode() != getOpcode())
 		return false;
 
+	CSocketCall* otherCall = static_cast<CSocketCall*>(other);
 	if (otherCall->m_Af != m_Af)
 		return false;
 
@@ -383,10 +381,10 @@ std::string CIoCtlSocketCall::toString()
 
 bool CIoCtlSocketCall::compareInputArgs(IEngExtCall* other, bool strict)
 {
-	CIoCtlSocketCall* otherCall = dynamic_cast<CIoCtlSocketCall*>(other);
-	if (otherCall == NULL)
+	if (other->getOpcode() != getOpcode())
 		return false;
 
+	CIoCtlSocketCall* otherCall = static_cast<CIoCtlSocketCall*>(other);
 	if (otherCall->m_Socket != m_Socket)
 		return false;
 
@@ -455,10 +453,10 @@ std::string CSetSockOptCall::toString()
 
 bool CSetSockOptCall::compareInputArgs(IEngExtCall* other, bool strict)
 {
-	CSetSockOptCall* otherCall = dynamic_cast<CSetSockOptCall*>(other);
-	if (otherCall == NULL)
+	if (other->getOpcode() != getOpcode())
 		return false;
 
+	CSetSockOptCall* otherCall = static_cast<CSetSockOptCall*>(other);
 	if (otherCall->m_Socket != m_Socket)
 		return false;
 
@@ -525,10 +523,10 @@ std::string CCloseSocketCall::toString()
 
 bool CCloseSocketCall::compareInputArgs(IEngExtCall* other, bool strict)
 {
-	CCloseSocketCall* otherCall = dynamic_cast<CCloseSocketCall*>(other);
-	if (otherCall == NULL)
+	if (other->getOpcode() != getOpcode())
 		return false;
 
+	CCloseSocketCall* otherCall = static_cast<CCloseSocketCall*>(other);
 	if (otherCall->m_Socket != m_Socket)
 		return false;
 
@@ -577,10 +575,10 @@ std::string CRecvFromCall::toString()
 
 bool CRecvFromCall::compareInputArgs(IEngExtCall* other, bool strict)
 {
-	CRecvFromCall* otherCall = dynamic_cast<CRecvFromCall*>(other);
-	if (otherCall == NULL)
+	if (other->getOpcode() != getOpcode())
 		return false;
 
+	CRecvFromCall* otherCall = static_cast<CRecvFromCall*>(other);
 	if (otherCall->m_Socket != m_Socket)
 		return false;
 
@@ -685,10 +683,10 @@ std::string CSendToCall::toString()
 
 bool CSendToCall::compareInputArgs(IEngExtCall* other, bool strict)
 {
-	CSendToCall* otherCall = dynamic_cast<CSendToCall*>(other);
-	if (otherCall == NULL)
+	if (other->getOpcode() != getOpcode())
 		return false;
 
+	CSendToCall* otherCall = static_cast<CSendToCall*>(other);
 	if (otherCall->m_Socket != m_Socket)
 		return false;
 
@@ -790,10 +788,10 @@ std::string CBindCall::toString()
 
 bool CBindCall::compareInputArgs(IEngExtCall* other, bool strict)
 {
-	CBindCall* otherCall = dynamic_cast<CBindCall*>(other);
-	if (otherCall == NULL)
+	if (other->getOpcode() != getOpcode())
 		return false;
 
+	CBindCall* otherCall = static_cast<CBindCall*>(other);
 	if (otherCall->m_Socket != m_Socket)
 		return false;
 
@@ -864,10 +862,10 @@ void CGetSockNameCall::setResult(const void* addr, int addrlen, int res)
 
 bool CGetSockNameCall::compareInputArgs(IEngExtCall* other, bool strict)
 {
-	CGetSockNameCall* otherCall = dynamic_cast<CGetSockNameCall*>(other);
-	if (otherCall == NULL)
+	if (other->getOpcode() != getOpcode())
 		return false;
 
+	CGetSockNameCall* otherCall = static_cast<CGetSockNameCall*>(other);
 	if (otherCall->m_Socket != m_Socket)
 		return false;
 
@@ -967,10 +965,10 @@ std::string CSteamCallbackCall1::toString()
 
 bool CSteamCallbackCall1::compareInputArgs(IEngExtCall* other, bool strict)
 {
-	CSteamCallbackCall1* otherCall = dynamic_cast<CSteamCallbackCall1*>(other);
-	if (otherCall == NULL)
+	if (other->getOpcode() != getOpcode())
 		return false;
 
+	CSteamCallbackCall1* otherCall = static_cast<CSteamCallbackCall1*>(other);
 	if (otherCall->m_InState.m_iCallback != m_InState.m_iCallback) return false;
 	if (otherCall->m_InState.m_nCallbackFlags != m_InState.m_nCallbackFlags) return false;
 
@@ -1032,10 +1030,10 @@ std::string CSteamCallbackCall2::toString()
 
 bool CSteamCallbackCall2::compareInputArgs(IEngExtCall* other, bool strict)
 {
-	CSteamCallbackCall2* otherCall = dynamic_cast<CSteamCallbackCall2*>(other);
-	if (otherCall == NULL)
+	if (other->getOpcode() != getOpcode())
 		return false;
 
+	CSteamCallbackCall2* otherCall = static_cast<CSteamCallbackCall2*>(other);
 	if (otherCall->m_InState.m_iCallback != m_InState.m_iCallback) return false;
 	if (otherCall->m_InState.m_nCallbackFlags != m_InState.m_nCallbackFlags) return false;
 
@@ -1093,10 +1091,10 @@ std::string CSteamApiRegisterCallbackCall::toString()
 
 bool CSteamApiRegisterCallbackCall::compareInputArgs(IEngExtCall* other, bool strict)
 {
-	CSteamApiRegisterCallbackCall* otherCall = dynamic_cast<CSteamApiRegisterCallbackCall*>(other);
-	if (otherCall == NULL)
+	if (other->getOpcode() != getOpcode())
 		return false;
 
+	CSteamApiRegisterCallbackCall* otherCall = static_cast<CSteamApiRegisterCallbackCall*>(other);
 	if (otherCall->m_iSteamCallbackId != m_iSteamCallbackId)
 		return false;
 
@@ -1147,8 +1145,7 @@ std::string CSteamApiInitCall::toString()
 
 bool CSteamApiInitCall::compareInputArgs(IEngExtCall* other, bool strict)
 {
-	CSteamApiInitCall* otherCall = dynamic_cast<CSteamApiInitCall*>(other);
-	if (otherCall == NULL)
+	if (other->getOpcode() != getOpcode())
 		return false;
 
 	return true;
@@ -1188,10 +1185,10 @@ std::string CSteamApiUnrigestierCallResultCall::toString()
 
 bool CSteamApiUnrigestierCallResultCall::compareInputArgs(IEngExtCall* other, bool strict)
 {
-	CSteamApiUnrigestierCallResultCall* otherCall = dynamic_cast<CSteamApiUnrigestierCallResultCall*>(other);
-	if (otherCall == NULL)
+	if (other->getOpcode() != getOpcode())
 		return false;
 
+	CSteamApiUnrigestierCallResultCall* otherCall = static_cast<CSteamApiUnrigestierCallResultCall*>(other);
 	if (otherCall->m_SteamApiCall != m_SteamApiCall)
 		return false;
 
@@ -1240,8 +1237,7 @@ std::string CSteamAppsCall::toString()
 
 bool CSteamAppsCall::compareInputArgs(IEngExtCall* other, bool strict)
 {
-	CSteamAppsCall* otherCall = dynamic_cast<CSteamAppsCall*>(other);
-	if (otherCall == NULL)
+	if (other->getOpcode() != getOpcode())
 		return false;
 
 	return true;
@@ -1284,8 +1280,7 @@ void CSteamAppGetCurrentGameLanguageCall::setResult(const char* res)
 
 bool CSteamAppGetCurrentGameLanguageCall::compareInputArgs(IEngExtCall* other, bool strict)
 {
-	CSteamAppGetCurrentGameLanguageCall* otherCall = dynamic_cast<CSteamAppGetCurrentGameLanguageCall*>(other);
-	if (otherCall == NULL)
+	if (other->getOpcode() != getOpcode())
 		return false;
 
 	return true;
@@ -1338,10 +1333,10 @@ std::string CSteamGameServerInitCall::toString()
 
 bool CSteamGameServerInitCall::compareInputArgs(IEngExtCall* other, bool strict)
 {
-	CSteamGameServerInitCall* otherCall = dynamic_cast<CSteamGameServerInitCall*>(other);
-	if (otherCall == NULL)
+	if (other->getOpcode() != getOpcode())
 		return false;
 
+	CSteamGameServerInitCall* otherCall = static_cast<CSteamGameServerInitCall*>(other);
 	if (otherCall->m_VersionLen != m_VersionLen)
 		return false;
 
@@ -1413,8 +1408,7 @@ std::string CSteamGameServerCall::toString()
 
 bool CSteamGameServerCall::compareInputArgs(IEngExtCall* other, bool strict)
 {
-	CSteamGameServerCall* otherCall = dynamic_cast<CSteamGameServerCall*>(other);
-	if (otherCall == NULL)
+	if (other->getOpcode() != getOpcode())
 		return false;
 
 	return true;
@@ -1457,10 +1451,10 @@ std::string CGameServerSetProductCall::toString()
 
 bool CGameServerSetProductCall::compareInputArgs(IEngExtCall* other, bool strict)
 {
-	CGameServerSetProductCall* otherCall = dynamic_cast<CGameServerSetProductCall*>(other);
-	if (otherCall == NULL)
+	if (other->getOpcode() != getOpcode())
 		return false;
 
+	CGameServerSetProductCall* otherCall = static_cast<CGameServerSetProductCall*>(other);
 	if (otherCall->m_ProductLen != m_ProductLen)
 		return false;
 
@@ -1509,10 +1503,10 @@ std::string CGameServerSetModDirCall::toString()
 
 bool CGameServerSetModDirCall::compareInputArgs(IEngExtCall* other, bool strict)
 {
-	CGameServerSetModDirCall* otherCall = dynamic_cast<CGameServerSetModDirCall*>(other);
-	if (otherCall == NULL)
+	if (other->getOpcode() != getOpcode())
 		return false;
 
+	CGameServerSetModDirCall* otherCall = static_cast<CGameServerSetModDirCall*>(other);
 	if (otherCall->m_DirLen != m_DirLen)
 		return false;
 
@@ -1554,10 +1548,10 @@ std::string CGameServerSetDedicatedServerCall::toString()
 
 bool CGameServerSetDedicatedServerCall::compareInputArgs(IEngExtCall* other, bool strict)
 {
-	CGameServerSetDedicatedServerCall* otherCall = dynamic_cast<CGameServerSetDedicatedServerCall*>(other);
-	if (otherCall == NULL)
+	if (other->getOpcode() != getOpcode())
 		return false;
 
+	CGameServerSetDedicatedServerCall* otherCall = static_cast<CGameServerSetDedicatedServerCall*>(other);
 	if (otherCall->m_Dedicated != m_Dedicated)
 		return false;
 
@@ -1601,10 +1595,10 @@ std::string CGameServerSetGameDescCall::toString()
 
 bool CGameServerSetGameDescCall::compareInputArgs(IEngExtCall* other, bool strict)
 {
-	CGameServerSetGameDescCall* otherCall = dynamic_cast<CGameServerSetGameDescCall*>(other);
-	if (otherCall == NULL)
+	if (other->getOpcode() != getOpcode())
 		return false;
 
+	CGameServerSetGameDescCall* otherCall = static_cast<CGameServerSetGameDescCall*>(other);
 	if (otherCall->m_DescLen != m_DescLen)
 		return false;
 
@@ -1640,8 +1634,7 @@ std::string CGameServerLogOnAnonymousCall::toString()
 
 bool CGameServerLogOnAnonymousCall::compareInputArgs(IEngExtCall* other, bool strict)
 {
-	CGameServerLogOnAnonymousCall* otherCall = dynamic_cast<CGameServerLogOnAnonymousCall*>(other);
-	if (otherCall == NULL)
+	if (other->getOpcode() != getOpcode())
 		return false;
 
 	return true;
@@ -1668,10 +1661,10 @@ std::string CGameServerEnableHeartbeatsCall::toString()
 
 bool CGameServerEnableHeartbeatsCall::compareInputArgs(IEngExtCall* other, bool strict)
 {
-	CGameServerEnableHeartbeatsCall* otherCall = dynamic_cast<CGameServerEnableHeartbeatsCall*>(other);
-	if (otherCall == NULL)
+	if (other->getOpcode() != getOpcode())
 		return false;
 
+	CGameServerEnableHeartbeatsCall* otherCall = static_cast<CGameServerEnableHeartbeatsCall*>(other);
 	if (otherCall->m_Heartbeats != m_Heartbeats)
 		return false;
 
@@ -1708,10 +1701,10 @@ std::string CGameServerSetHeartbeatIntervalCall::toString()
 
 bool CGameServerSetHeartbeatIntervalCall::compareInputArgs(IEngExtCall* other, bool strict)
 {
-	CGameServerSetHeartbeatIntervalCall* otherCall = dynamic_cast<CGameServerSetHeartbeatIntervalCall*>(other);
-	if (otherCall == NULL)
+	if (other->getOpcode() != getOpcode())
 		return false;
 
+	CGameServerSetHeartbeatIntervalCall* otherCall = static_cast<CGameServerSetHeartbeatIntervalCall*>(other);
 	if (otherCall->m_Interval != m_Interval)
 		return false;
 
@@ -1746,10 +1739,10 @@ std::string CGameServerSetMaxPlayersCall::toString()
 
 bool CGameServerSetMaxPlayersCall::compareInputArgs(IEngExtCall* other, bool strict)
 {
-	CGameServerSetMaxPlayersCall* otherCall = dynamic_cast<CGameServerSetMaxPlayersCall*>(other);
-	if (otherCall == NULL)
+	if (other->getOpcode() != getOpcode())
 		return false;
 
+	CGameServerSetMaxPlayersCall* otherCall = static_cast<CGameServerSetMaxPlayersCall*>(other);
 	if (otherCall->m_MaxPlayers != m_MaxPlayers)
 		return false;
 
@@ -1785,10 +1778,10 @@ std::string CGameServerSetBotCountCall::toString()
 
 bool CGameServerSetBotCountCall::compareInputArgs(IEngExtCall* other, bool strict)
 {
-	CGameServerSetBotCountCall* otherCall = dynamic_cast<CGameServerSetBotCountCall*>(other);
-	if (otherCall == NULL)
+	if (other->getOpcode() != getOpcode())
 		return false;
 
+	CGameServerSetBotCountCall* otherCall = static_cast<CGameServerSetBotCountCall*>(other);
 	if (otherCall->m_NumBots != m_NumBots)
 		return false;
 
@@ -1831,10 +1824,10 @@ std::string CGameServerSetServerNameCall::toString()
 
 bool CGameServerSetServerNameCall::compareInputArgs(IEngExtCall* other, bool strict)
 {
-	CGameServerSetServerNameCall* otherCall = dynamic_cast<CGameServerSetServerNameCall*>(other);
-	if (otherCall == NULL)
+	if (other->getOpcode() != getOpcode())
 		return false;
 
+	CGameServerSetServerNameCall* otherCall = static_cast<CGameServerSetServerNameCall*>(other);
 	if (otherCall->m_ServerNameLen != m_ServerNameLen)
 		return false;
 
@@ -1883,10 +1876,10 @@ std::string CGameServerSetMapNameCall::toString()
 
 bool CGameServerSetMapNameCall::compareInputArgs(IEngExtCall* other, bool strict)
 {
-	CGameServerSetMapNameCall* otherCall = dynamic_cast<CGameServerSetMapNameCall*>(other);
-	if (otherCall == NULL)
+	if (other->getOpcode() != getOpcode())
 		return false;
 
+	CGameServerSetMapNameCall* otherCall = static_cast<CGameServerSetMapNameCall*>(other);
 	if (otherCall->m_MapNameLen != m_MapNameLen)
 		return false;
 
@@ -1928,10 +1921,10 @@ std::string CGameServerSetPasswordProtectedCall::toString()
 
 bool CGameServerSetPasswordProtectedCall::compareInputArgs(IEngExtCall* other, bool strict)
 {
-	CGameServerSetPasswordProtectedCall* otherCall = dynamic_cast<CGameServerSetPasswordProtectedCall*>(other);
-	if (otherCall == NULL)
+	if (other->getOpcode() != getOpcode())
 		return false;
 
+	CGameServerSetPasswordProtectedCall* otherCall = static_cast<CGameServerSetPasswordProtectedCall*>(other);
 	if (otherCall->m_PasswordProtected != m_PasswordProtected)
 		return false;
 
@@ -1963,8 +1956,7 @@ std::string CGameServerClearAllKVsCall::toString()
 
 bool CGameServerClearAllKVsCall::compareInputArgs(IEngExtCall* other, bool strict)
 {
-	CGameServerClearAllKVsCall* otherCall = dynamic_cast<CGameServerClearAllKVsCall*>(other);
-	if (otherCall == NULL)
+	if (other->getOpcode() != getOpcode())
 		return false;
 
 	return true;
@@ -2007,10 +1999,10 @@ std::string CGameServerSetKeyValueCall::toString()
 
 bool CGameServerSetKeyValueCall::compareInputArgs(IEngExtCall* other, bool strict)
 {
-	CGameServerSetKeyValueCall* otherCall = dynamic_cast<CGameServerSetKeyValueCall*>(other);
-	if (otherCall == NULL)
+	if (other->getOpcode() != getOpcode())
 		return false;
 
+	CGameServerSetKeyValueCall* otherCall = static_cast<CGameServerSetKeyValueCall*>(other);
 	if (otherCall->m_KeyLen != m_KeyLen)
 		return false;
 
@@ -2064,10 +2056,10 @@ std::string CSteamApiSetBreakpadAppIdCall::toString()
 
 bool CSteamApiSetBreakpadAppIdCall::compareInputArgs(IEngExtCall* other, bool strict)
 {
-	CSteamApiSetBreakpadAppIdCall* otherCall = dynamic_cast<CSteamApiSetBreakpadAppIdCall*>(other);
-	if (otherCall == NULL)
+	if (other->getOpcode() != getOpcode())
 		return false;
 
+	CSteamApiSetBreakpadAppIdCall* otherCall = static_cast<CSteamApiSetBreakpadAppIdCall*>(other);
 	if (otherCall->m_AppId != m_AppId)
 		return false;
 
@@ -2099,8 +2091,7 @@ std::string CGameServerWasRestartRequestedCall::toString()
 
 bool CGameServerWasRestartRequestedCall::compareInputArgs(IEngExtCall* other, bool strict)
 {
-	CGameServerWasRestartRequestedCall* otherCall = dynamic_cast<CGameServerWasRestartRequestedCall*>(other);
-	if (otherCall == NULL)
+	if (other->getOpcode() != getOpcode())
 		return false;
 
 	return true;
@@ -2131,8 +2122,7 @@ std::string CSteamGameServerRunCallbacksCall::toString()
 
 bool CSteamGameServerRunCallbacksCall::compareInputArgs(IEngExtCall* other, bool strict)
 {
-	CSteamGameServerRunCallbacksCall* otherCall = dynamic_cast<CSteamGameServerRunCallbacksCall*>(other);
-	if (otherCall == NULL)
+	if (other->getOpcode() != getOpcode())
 		return false;
 
 	return true;
@@ -2183,10 +2173,10 @@ std::string CGameServerGetNextOutgoingPacketCall::toString()
 
 bool CGameServerGetNextOutgoingPacketCall::compareInputArgs(IEngExtCall* other, bool strict)
 {
-	CGameServerGetNextOutgoingPacketCall* otherCall = dynamic_cast<CGameServerGetNextOutgoingPacketCall*>(other);
-	if (otherCall == NULL)
+	if (other->getOpcode() != getOpcode())
 		return false;
 
+	CGameServerGetNextOutgoingPacketCall* otherCall = static_cast<CGameServerGetNextOutgoingPacketCall*>(other);
 	if (otherCall->m_MaxOut != this->m_MaxOut)
 		return false;
 
@@ -2236,8 +2226,7 @@ std::string CSteamApiRunCallbacksCall::toString()
 
 bool CSteamApiRunCallbacksCall::compareInputArgs(IEngExtCall* other, bool strict)
 {
-	CSteamApiRunCallbacksCall* otherCall = dynamic_cast<CSteamApiRunCallbacksCall*>(other);
-	if (otherCall == NULL)
+	if (other->getOpcode() != getOpcode())
 		return false;
 
 	return true;
@@ -2260,8 +2249,7 @@ std::string CGameServerGetSteamIdCall::toString()
 
 bool CGameServerGetSteamIdCall::compareInputArgs(IEngExtCall* other, bool strict)
 {
-	CGameServerGetSteamIdCall* otherCall = dynamic_cast<CGameServerGetSteamIdCall*>(other);
-	if (otherCall == NULL)
+	if (other->getOpcode() != getOpcode())
 		return false;
 
 	return true;
@@ -2291,8 +2279,7 @@ std::string CGameServerBSecureCall::toString()
 
 bool CGameServerBSecureCall::compareInputArgs(IEngExtCall* other, bool strict)
 {
-	CGameServerBSecureCall* otherCall = dynamic_cast<CGameServerBSecureCall*>(other);
-	if (otherCall == NULL)
+	if (other->getOpcode() != getOpcode())
 		return false;
 
 	return true;
@@ -2337,10 +2324,10 @@ std::string CGameServerHandleIncomingPacketCall::toString()
 
 bool CGameServerHandleIncomingPacketCall::compareInputArgs(IEngExtCall* other, bool strict)
 {
-	CGameServerHandleIncomingPacketCall* otherCall = dynamic_cast<CGameServerHandleIncomingPacketCall*>(other);
-	if (otherCall == NULL)
+	if (other->getOpcode() != getOpcode())
 		return false;
 
+	CGameServerHandleIncomingPacketCall* otherCall = static_cast<CGameServerHandleIncomingPacketCall*>(other);
 	if (m_Len != otherCall->m_Len)
 		return false;
 
@@ -2409,10 +2396,10 @@ std::string CGameServerSendUserConnectAndAuthenticateCall::toString()
 
 bool CGameServerSendUserConnectAndAuthenticateCall::compareInputArgs(IEngExtCall* other, bool strict)
 {
-	CGameServerSendUserConnectAndAuthenticateCall* otherCall = dynamic_cast<CGameServerSendUserConnectAndAuthenticateCall*>(other);
-	if (otherCall == NULL)
+	if (other->getOpcode() != getOpcode())
 		return false;
 
+	CGameServerSendUserConnectAndAuthenticateCall* otherCall = static_cast<CGameServerSendUserConnectAndAuthenticateCall*>(other);
 	if (m_AuthBlobLen != otherCall->m_AuthBlobLen)
 		return false;
 
@@ -2471,10 +2458,10 @@ std::string CGameServerSendUserDisconnectCall::toString()
 
 bool CGameServerSendUserDisconnectCall::compareInputArgs(IEngExtCall* other, bool strict)
 {
-	CGameServerSendUserDisconnectCall* otherCall = dynamic_cast<CGameServerSendUserDisconnectCall*>(other);
-	if (otherCall == NULL)
+	if (other->getOpcode() != getOpcode())
 		return false;
 
+	CGameServerSendUserDisconnectCall* otherCall = static_cast<CGameServerSendUserDisconnectCall*>(other);
 	if (m_SteamId != otherCall->m_SteamId)
 		return false;
 
@@ -2518,10 +2505,10 @@ std::string CGameServerBUpdateUserDataCall::toString()
 
 bool CGameServerBUpdateUserDataCall::compareInputArgs(IEngExtCall* other, bool strict)
 {
-	CGameServerBUpdateUserDataCall* otherCall = dynamic_cast<CGameServerBUpdateUserDataCall*>(other);
-	if (otherCall == NULL)
+	if (other->getOpcode() != getOpcode())
 		return false;
 
+	CGameServerBUpdateUserDataCall* otherCall = static_cast<CGameServerBUpdateUserDataCall*>(other);
 	if (m_PlayerNameLen != otherCall->m_PlayerNameLen)
 		return false;
 
@@ -2579,8 +2566,7 @@ std::string CGameServerCreateUnauthUserConnectionCall::toString()
 
 bool CGameServerCreateUnauthUserConnectionCall::compareInputArgs(IEngExtCall* other, bool strict)
 {
-	CGameServerCreateUnauthUserConnectionCall* otherCall = dynamic_cast<CGameServerCreateUnauthUserConnectionCall*>(other);
-	if (otherCall == NULL)
+	if (other->getOpcode() != getOpcode())
 		return false;
 
 	return true;
@@ -2612,10 +2598,10 @@ std::string CGetHostNameCall::toString()
 
 bool CGetHostNameCall::compareInputArgs(IEngExtCall* other, bool strict)
 {
-	CGetHostNameCall* otherCall = dynamic_cast<CGetHostNameCall*>(other);
-	if (otherCall == NULL)
+	if (other->getOpcode() != getOpcode())
 		return false;
 
+	CGetHostNameCall* otherCall = static_cast<CGetHostNameCall*>(other);
 	if (otherCall->m_NameLenIn != this->m_NameLenIn)
 		return false;
 
@@ -2680,10 +2666,10 @@ std::string CGetHostByNameCall::toString()
 
 bool CGetHostByNameCall::compareInputArgs(IEngExtCall* other, bool strict)
 {
-	CGetHostByNameCall* otherCall = dynamic_cast<CGetHostByNameCall*>(other);
-	if (otherCall == NULL)
+	if (other->getOpcode() != getOpcode())
 		return false;
 
+	CGetHostByNameCall* otherCall = static_cast<CGetHostByNameCall*>(other);
 	if (otherCall->m_NameLen != this->m_NameLen)
 		return false;
 
@@ -2787,6 +2773,7 @@ void CGetHostByNameCall::readEpilogue(std::istream &stream) {
 
 
 
+#ifdef _WIN32
 /* ============================================================================
 						   CGetProcessTimesCall
 ============================================================================ */
@@ -2804,8 +2791,7 @@ std::string CGetProcessTimesCall::toString()
 
 bool CGetProcessTimesCall::compareInputArgs(IEngExtCall* other, bool strict)
 {
-	CGetProcessTimesCall* otherCall = dynamic_cast<CGetProcessTimesCall*>(other);
-	if (otherCall == NULL)
+	if (other->getOpcode() != getOpcode())
 		return false;
 
 	return true;
@@ -2856,8 +2842,7 @@ std::string CGetSystemTimeAsFileTimeCall::toString()
 
 bool CGetSystemTimeAsFileTimeCall::compareInputArgs(IEngExtCall* other, bool strict)
 {
-	CGetSystemTimeAsFileTimeCall* otherCall = dynamic_cast<CGetSystemTimeAsFileTimeCall*>(other);
-	if (otherCall == NULL)
+	if (other->getOpcode() != getOpcode())
 		return false;
 
 	return true;
@@ -2875,6 +2860,7 @@ void CGetSystemTimeAsFileTimeCall::writeEpilogue(std::ostream &stream) {
 void CGetSystemTimeAsFileTimeCall::readEpilogue(std::istream &stream) {
 	stream.read((char*)&m_SystemTime, sizeof(m_SystemTime));
 }
+#endif // _WIN32
 
 
 
@@ -2898,10 +2884,10 @@ std::string CStdTimeCall::toString()
 
 bool CStdTimeCall::compareInputArgs(IEngExtCall* other, bool strict)
 {
-	CStdTimeCall* otherCall = dynamic_cast<CStdTimeCall*>(other);
-	if (otherCall == NULL)
+	if (other->getOpcode() != getOpcode())
 		return false;
 
+	CStdTimeCall* otherCall = static_cast<CStdTimeCall*>(other);
 	if (otherCall->m_InTimeNull != this->m_InTimeNull)
 		return false;
 
@@ -2953,10 +2939,10 @@ std::string CStdLocalTimeCall::toString()
 
 bool CStdLocalTimeCall::compareInputArgs(IEngExtCall* other, bool strict)
 {
-	CStdLocalTimeCall* otherCall = dynamic_cast<CStdLocalTimeCall*>(other);
-	if (otherCall == NULL)
+	if (other->getOpcode() != getOpcode())
 		return false;
 
+	CStdLocalTimeCall* otherCall = static_cast<CStdLocalTimeCall*>(other);
 	if (otherCall->m_Time != this->m_Time)
 		return false;
 
@@ -3001,10 +2987,10 @@ std::string CStdSrandCall::toString()
 
 bool CStdSrandCall::compareInputArgs(IEngExtCall* other, bool strict)
 {
-	CStdSrandCall* otherCall = dynamic_cast<CStdSrandCall*>(other);
-	if (otherCall == NULL)
+	if (other->getOpcode() != getOpcode())
 		return false;
 
+	CStdSrandCall* otherCall = static_cast<CStdSrandCall*>(other);
 	if (otherCall->m_Seed != this->m_Seed)
 		return false;
 
@@ -3036,8 +3022,7 @@ std::string CStdRandCall::toString()
 
 bool CStdRandCall::compareInputArgs(IEngExtCall* other, bool strict)
 {
-	CStdRandCall* otherCall = dynamic_cast<CStdRandCall*>(other);
-	if (otherCall == NULL)
+	if (other->getOpcode() != getOpcode())
 		return false;
 
 	return true;
@@ -3068,8 +3053,7 @@ std::string CGameServerLogOffCall::toString()
 
 bool CGameServerLogOffCall::compareInputArgs(IEngExtCall* other, bool strict)
 {
-	CGameServerLogOffCall* otherCall = dynamic_cast<CGameServerLogOffCall*>(other);
-	if (otherCall == NULL)
+	if (other->getOpcode() != getOpcode())
 		return false;
 
 	return true;
@@ -3091,8 +3075,7 @@ std::string CSteamGameServerShutdownCall::toString()
 
 bool CSteamGameServerShutdownCall::compareInputArgs(IEngExtCall* other, bool strict)
 {
-	CSteamGameServerShutdownCall* otherCall = dynamic_cast<CSteamGameServerShutdownCall*>(other);
-	if (otherCall == NULL)
+	if (other->getOpcode() != getOpcode())
 		return false;
 
 	return true;
@@ -3122,10 +3105,10 @@ std::string CSteamApiUnregisterCallbackCall::toString()
 
 bool CSteamApiUnregisterCallbackCall::compareInputArgs(IEngExtCall* other, bool strict)
 {
-	CSteamApiUnregisterCallbackCall* otherCall = dynamic_cast<CSteamApiUnregisterCallbackCall*>(other);
-	if (otherCall == NULL)
+	if (other->getOpcode() != getOpcode())
 		return false;
 
+	CSteamApiUnregisterCallbackCall* otherCall = static_cast<CSteamApiUnregisterCallbackCall*>(other);
 	if (otherCall->m_RehldsCallbackId != m_RehldsCallbackId)
 		return false;
 
@@ -3171,8 +3154,7 @@ std::string CGameServerBLoggedOnCall::toString()
 
 bool CGameServerBLoggedOnCall::compareInputArgs(IEngExtCall* other, bool strict)
 {
-	CGameServerBLoggedOnCall* otherCall = dynamic_cast<CGameServerBLoggedOnCall*>(other);
-	if (otherCall == NULL)
+	if (other->getOpcode() != getOpcode())
 		return false;
 
 	return true;
@@ -3187,6 +3169,62 @@ void CGameServerBLoggedOnCall::readEpilogue(std::istream &stream) {
 	stream.read((char*)&m_Res, 1);
 }
 
+
+
+
+/* ============================================================================
+						   CClockGetTimeCall
+============================================================================ */
+CClockGetTimeCall::CClockGetTimeCall(int clk)
+{
+	m_Clock = clk;
+	m_Sec = 0;
+	m_NSec = 0;
+	m_Res = 0;
+}
+
+std::string CClockGetTimeCall::toString()
+{
+	std::stringstream ss;
+	ss << "clock_gettime( clock: " << m_Clock << " ) => " << m_Res << " { tv_sec: " << m_Sec << " tv_nsec: " << m_NSec << " }";
+
+	return ss.str();
+}
+
+bool CClockGetTimeCall::compareInputArgs(IEngExtCall* other, bool strict)
+{
+	if (other->getOpcode() != getOpcode())
+		return false;
+
+	CClockGetTimeCall* otherCall = static_cast<CClockGetTimeCall*>(other);
+	if (otherCall->m_Clock != m_Clock)
+		return false;
+
+	return true;
+}
+
+void CClockGetTimeCall::writePrologue(std::ostream &stream) {
+	stream.write((char*)&m_Clock, 4);
+}
+
+void CClockGetTimeCall::readPrologue(std::istream &stream) {
+	stream.read((char*)&m_Clock, 4);
+}
+
+void CClockGetTimeCall::writeEpilogue(std::ostream &stream) {
+	stream
+		.write((char*)&m_Sec, 8)
+		.write((char*)&m_NSec, 8)
+		.write((char*)&m_Res, 4);
+}
+
+void CClockGetTimeCall::readEpilogue(std::istream &stream) {
+	stream
+		.read((char*)&m_Sec, 8)
+		.read((char*)&m_NSec, 8)
+		.read((char*)&m_Res, 4);
+}
+
 /*
 class CGameServerBLoggedOnCall : public IEngExtCall {
 public:
@@ -3211,12 +3249,14 @@ virtual void readEpilogue(std::istream &stream);
 IEngExtCall* IEngExtCallFactory::createByOpcode(ExtCallFuncs opc, void* buf, int ptrSize) {
 	switch (opc) {
 	case ECF_SLEEP:	IEngExtCallFactory_CreateFuncCall(CSleepExtCall, buf, ptrSize);
+#ifdef _WIN32
 	case ECF_QUERY_PERF_FREQ: IEngExtCallFactory_CreateFuncCall(CQueryPerfFreqCall, buf, ptrSize);
 	case ECF_QUERY_PERF_COUNTER: IEngExtCallFactory_CreateFuncCall(CQueryPerfCounterCall, buf, ptrSize);
 	case ECF_GET_TICK_COUNT: IEngExtCallFactory_CreateFuncCall(CGetTickCountCall, buf, ptrSize);
 	case ECF_GET_LOCAL_TIME: IEngExtCallFactory_CreateFuncCall(CGetLocalTimeCall, buf, ptrSize);
 	case ECF_GET_SYSTEM_TIME: IEngExtCallFactory_CreateFuncCall(CGetSystemTimeCall, buf, ptrSize);
 	case ECF_GET_TIMEZONE_INFO: IEngExtCallFactory_CreateFuncCall(CGetTimeZoneInfoCall, buf, ptrSize);
+#endif // _WIN32
 
 	case ECF_SOCKET: IEngExtCallFactory_CreateFuncCall(CSocketCall, buf, ptrSize);
 	case ECF_IOCTL_SOCKET: IEngExtCallFactory_CreateFuncCall(CIoCtlSocketCall, buf, ptrSize);
@@ -3268,8 +3308,10 @@ IEngExtCall* IEngExtCallFactory::createByOpcode(ExtCallFuncs opc, void* buf, int
 	case ECF_GET_HOST_BY_NAME: IEngExtCallFactory_CreateFuncCall(CGetHostByNameCall, buf, ptrSize);
 	case ECF_GET_HOST_NAME: IEngExtCallFactory_CreateFuncCall(CGetHostNameCall, buf, ptrSize);
 
+#ifdef _WIN32
 	case ECF_GET_PROCESS_TIMES: IEngExtCallFactory_CreateFuncCall(CGetProcessTimesCall, buf, ptrSize);
 	case ECF_GET_SYSTEM_TIME_AS_FILE_TIME: IEngExtCallFactory_CreateFuncCall(CGetSystemTimeAsFileTimeCall, buf, ptrSize);
+#endif // _WIN32
 
 	case ECF_CSTD_TIME: IEngExtCallFactory_CreateFuncCall(CStdTimeCall, buf, ptrSize);
 	case ECF_CSTD_LOCALTIME: IEngExtCallFactory_CreateFuncCall(CStdLocalTimeCall, buf, ptrSize);
@@ -3284,6 +3326,8 @@ IEngExtCall* IEngExtCallFactory::createByOpcode(ExtCallFuncs opc, void* buf, int
 
 	case ECF_GS_BLOGGEDON: IEngExtCallFactory_CreateFuncCall(CGameServerBLoggedOnCall, buf, ptrSize);
 
+	case ECF_CLOCK_GETTIME: IEngExtCallFactory_CreateFuncCall(CClockGetTimeCall, buf, ptrSize);
+
 
 	default:
 		rehlds_syserror("%s: unknown funccall opcode %d", __func__, opc);
@@ -1,5 +1,4 @@
 #pragma once
-#ifdef _WIN32
 
 #include "osconfig.h"
 
@@ -121,6 +120,8 @@ enum ExtCallFuncs {
 	ECF_STEAM_API_UNREGISTER_CALLBACK = 62,
 
 	ECF_GS_BLOGGEDON = 63,
+
+	ECF_CLOCK_GETTIME = 64,
 };
 
 struct CSteamCallbackState_t {
@@ -184,6 +185,7 @@ public:
 	virtual void readPrologue(std::istream &stream);
 };
 
+#ifdef _WIN32
 class CQueryPerfFreqCall : public IEngExtCall {
 public:
 	int64 m_Freq;
@@ -276,6 +278,7 @@ public:
 	virtual void writeEpilogue(std::ostream &stream);
 	virtual void readEpilogue(std::istream &stream);
 };
+#endif // _WIN32
 
 class CSocketCall : public IEngExtCall {
 public:
@@ -1102,6 +1105,7 @@ public:
 	virtual void readEpilogue(std::istream &stream);
 };
 
+#ifdef _WIN32
 class CGetProcessTimesCall : public IEngExtCall {
 public:
 	BOOL m_Res;
@@ -1141,6 +1145,7 @@ public:
 	virtual void writeEpilogue(std::ostream &stream);
 	virtual void readEpilogue(std::istream &stream);
 };
+#endif // _WIN32
 
 class CStdTimeCall : public IEngExtCall {
 public:
@@ -1269,4 +1274,24 @@ public:
 	virtual void readEpilogue(std::istream &stream);
 };
 
-#endif
+class CClockGetTimeCall : public IEngExtCall {
+public:
+	int m_Clock;
+
+	int64 m_Sec;
+	int64 m_NSec;
+	int m_Res;
+
+public:
+	CClockGetTimeCall() { m_Clock = 0; m_Sec = m_NSec = 0; m_Res = 0; }
+	CClockGetTimeCall(int clk);
+
+	void setResult(int64 sec, int64 nsec, int res) { m_Sec = sec; m_NSec = nsec; m_Res = res; }
+	virtual bool compareInputArgs(IEngExtCall* other, bool strict);
+	virtual std::string toString();
+	virtual ExtCallFuncs getOpcode() { return ECF_CLOCK_GETTIME; }
+	virtual void writePrologue(std::ostream &stream);
+	virtual void readPrologue(std::istream &stream);
+	virtual void writeEpilogue(std::ostream &stream);
+	virtual void readEpilogue(std::istream &stream);
+};
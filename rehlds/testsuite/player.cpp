@@ -1,6 +1,18 @@
 #include "precompiled.h"
 
-CPlayingEngExtInterceptor::CPlayingEngExtInterceptor(const char* fname, bool strictChecks)
+// Real time, the platform only returns the recorded one
+static DWORD TestPlayer_GetTickCount()
+{
+#ifdef _WIN32
+	return ::GetTickCount();
+#else
+	struct timespec ts;
+	::clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (DWORD)(ts.tv_sec * 1000 + ts.tv_nsec / 1000000);
+#endif
+}
+
+CPlayingEngExtInterceptor::CPlayingEngExtInterceptor(const char* fname, bool strictChecks, bool fastPlay)
 {
 	for (int i = 0; i < TESTPLAYER_FUNCTREE_DEPTH; i++)
 	{
@@ -17,6 +29,7 @@ CPlayingEngExtInterceptor::CPlayingEngExtInterceptor(const char* fname, bool str
 	m_bLastRead = false;
 
 	m_bStrictChecks = strictChecks;
+	m_bFastPlay = fastPlay;
 
 	m_ServerSocket = INVALID_SOCKET;
 	m_SteamCallbacksCounter = 0;
@@ -51,8 +64,11 @@ CPlayingEngExtInterceptor::CPlayingEngExtInterceptor(const char* fname, bool str
 	m_InStream.read(cmdLine, cmdlineLen);
 	printf("Playing testsuite\nrecorders's cmdline: %s\n", cmdLine);
 
-	m_StartTick = ::GetTickCount();
+	m_StartTick = TestPlayer_GetTickCount();
 	m_NumFrames = 0;
+
+	m_ReportTick = m_StartTick;
+	m_ReportFrames = 0;
 }
 
 void* CPlayingEngExtInterceptor::allocFuncCall()
@@ -147,20 +163,35 @@ IEngExtCall* CPlayingEngExtInterceptor::getNextCall(bool peek, bool processCallb
 	}
 
 	if (cmd->getOpcode() == ECF_NONE) {
-		DWORD endTick = ::GetTickCount();
+		DWORD endTick = TestPlayer_GetTickCount();
+		DWORD duration = endTick - m_StartTick;
+		double fps = duration ? m_NumFrames * 1000.0 / duration : 0.0;
 		FILE* fl = fopen("rehlds_demo_stats.xml", "w");
 		if (fl) {
 			fprintf(fl, "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n");
 			fprintf(fl, "<DemoStats>\n");
-			fprintf(fl, "  <Duration>%u</Duration>\n", (endTick - m_StartTick));
+			fprintf(fl, "  <Duration>%u</Duration>\n", duration);
 			fprintf(fl, "  <NumFrames>%u</NumFrames>\n", m_NumFrames);
+			fprintf(fl, "  <FramesPerSecond>%.1f</FramesPerSecond>\n", fps);
 			fprintf(fl, "</DemoStats>\n");
 			fclose(fl);
 		}
+
+		if (m_bFastPlay) {
+			printf("Playback finished: %d frames in %u ms, %.1f fps\n", m_NumFrames, duration, fps);
+			fflush(stdout);
+		}
+
+#ifdef _WIN32
 		TerminateProcess(GetCurrentProcess(), 777);
+#else
+		_exit(777);
+#endif
 	}
 
-	IEngCallbackCall* callback = dynamic_cast<IEngCallbackCall*>(cmd);
+	IEngCallbackCall* callback = NULL;
+	if (cmd->getOpcode() == ECF_STEAM_CALLBACK_CALL_1 || cmd->getOpcode() == ECF_STEAM_CALLBACK_CALL_2)
+		callback = static_cast<IEngCallbackCall*>(cmd);
 	if (callback != NULL && callback->m_Start) {
 		if (!processCallbacks) {
 			rehlds_syserror("%s: read a callback, but it's not allowed here", __func__);
@@ -252,17 +283,35 @@ int CPlayingEngExtInterceptor::getOrRegisterSteamCallback(CCallbackBase* cb) {
 }
 
 void CPlayingEngExtInterceptor::maybeHeartBeat(int readPos) {
+	if (m_bFastPlay)
+		return;
+
 	if (m_PrevHeartBeat + m_HeartBeatInterval <= readPos) {
 		m_PrevHeartBeat = readPos;
 		Con_Printf("%s: readPos=%u\n", __func__, readPos);
 	}
 }
 
+void CPlayingEngExtInterceptor::maybeReportFps() {
+	if (!m_bFastPlay || (m_NumFrames & 255))
+		return;
+
+	DWORD curTick = TestPlayer_GetTickCount();
+	if (curTick - m_ReportTick < TESTPLAYER_FPS_REPORT_INTERVAL)
+		return;
+
+	printf("%d frames, %.1f fps\n", m_NumFrames, (m_NumFrames - m_ReportFrames) * 1000.0 / (curTick - m_ReportTick));
+	fflush(stdout);
+
+	m_ReportTick = curTick;
+	m_ReportFrames = m_NumFrames;
+}
+
 uint32 CPlayingEngExtInterceptor::time(uint32* pTime)
 {
-	CStdTimeCall* playCall = dynamic_cast<CStdTimeCall*>(getNextCall(false, false, ECF_CSTD_TIME, true, __func__));
+	CStdTimeCall* playCall = static_cast<CStdTimeCall*>(getNextCall(false, false, ECF_CSTD_TIME, true, __func__));
 	CStdTimeCall(pTime).ensureArgsAreEqual(playCall, m_bStrictChecks, __func__);
-	CStdTimeCall* playEndCall = dynamic_cast<CStdTimeCall*>(getNextCall(false, true, ECF_CSTD_TIME, false, __func__));
+	CStdTimeCall* playEndCall = static_cast<CStdTimeCall*>(getNextCall(false, true, ECF_CSTD_TIME, false, __func__));
 
 	uint32 res = playEndCall->m_Res;
 	if (pTime != NULL) *pTime = res;
@@ -274,9 +323,9 @@ uint32 CPlayingEngExtInterceptor::time(uint32* pTime)
 
 struct tm* CPlayingEngExtInterceptor::localtime(uint32 time)
 {
-	CStdLocalTimeCall* playCall = dynamic_cast<CStdLocalTimeCall*>(getNextCall(false, false, ECF_CSTD_LOCALTIME, true, __func__));
+	CStdLocalTimeCall* playCall = static_cast<CStdLocalTimeCall*>(getNextCall(false, false, ECF_CSTD_LOCALTIME, true, __func__));
 	CStdLocalTimeCall(time).ensureArgsAreEqual(playCall, m_bStrictChecks, __func__);
-	CStdLocalTimeCall* playEndCall = dynamic_cast<CStdLocalTimeCall*>(getNextCall(false, true, ECF_CSTD_LOCALTIME, false, __func__));
+	CStdLocalTimeCall* playEndCall = static_cast<CStdLocalTimeCall*>(getNextCall(false, true, ECF_CSTD_LOCALTIME, false, __func__));
 
 	setCurrentTm(&playEndCall->m_Res);
 
@@ -287,17 +336,17 @@ struct tm* CPlayingEngExtInterceptor::localtime(uint32 time)
 
 void CPlayingEngExtInterceptor::srand(uint32 seed)
 {
-	CStdSrandCall* playCall = dynamic_cast<CStdSrandCall*>(getNextCall(false, false, ECF_CSTD_SRAND_CALL, true, __func__));
+	CStdSrandCall* playCall = static_cast<CStdSrandCall*>(getNextCall(false, false, ECF_CSTD_SRAND_CALL, true, __func__));
 	CStdSrandCall(seed).ensureArgsAreEqual(playCall, m_bStrictChecks, __func__);
-	CStdSrandCall* playEndCall = dynamic_cast<CStdSrandCall*>(getNextCall(false, true, ECF_CSTD_SRAND_CALL, false, __func__));
+	CStdSrandCall* playEndCall = static_cast<CStdSrandCall*>(getNextCall(false, true, ECF_CSTD_SRAND_CALL, false, __func__));
 
 	freeFuncCall(playCall); freeFuncCall(playEndCall);
 }
 
 int CPlayingEngExtInterceptor::rand()
 {
-	CStdRandCall* playCall = dynamic_cast<CStdRandCall*>(getNextCall(false, false, ECF_CSTD_RAND_CALL, true, __func__));
-	CStdRandCall* playEndCall = dynamic_cast<CStdRandCall*>(getNextCall(false, true, ECF_CSTD_RAND_CALL, false, __func__));
+	CStdRandCall* playCall = static_cast<CStdRandCall*>(getNextCall(false, false, ECF_CSTD_RAND_CALL, true, __func__));
+	CStdRandCall* playEndCall = static_cast<CStdRandCall*>(getNextCall(false, true, ECF_CSTD_RAND_CALL, false, __func__));
 
 	int res = playEndCall->m_Res;
 
@@ -307,16 +356,17 @@ int CPlayingEngExtInterceptor::rand()
 }
 
 void CPlayingEngExtInterceptor::Sleep(DWORD msec) {
-	CSleepExtCall* playCall = dynamic_cast<CSleepExtCall*>(getNextCall(false, false, ECF_SLEEP, true, __func__));
+	CSleepExtCall* playCall = static_cast<CSleepExtCall*>(getNextCall(false, false, ECF_SLEEP, true, __func__));
 	CSleepExtCall(msec).ensureArgsAreEqual(playCall, m_bStrictChecks, __func__);
-	CSleepExtCall* playEndCall = dynamic_cast<CSleepExtCall*>(getNextCall(false, true, ECF_SLEEP, false, __func__));
+	CSleepExtCall* playEndCall = static_cast<CSleepExtCall*>(getNextCall(false, true, ECF_SLEEP, false, __func__));
 
 	freeFuncCall(playCall); freeFuncCall(playEndCall);
 }
 
+#ifdef _WIN32
 BOOL CPlayingEngExtInterceptor::QueryPerfCounter(LARGE_INTEGER* counter) {
-	CQueryPerfCounterCall* playCall = dynamic_cast<CQueryPerfCounterCall*>(getNextCall(false, false, ECF_QUERY_PERF_COUNTER, true, __func__));
-	CQueryPerfCounterCall* playEndCall = dynamic_cast<CQueryPerfCounterCall*>(getNextCall(false, true, ECF_QUERY_PERF_COUNTER, false, __func__));
+	CQueryPerfCounterCall* playCall = static_cast<CQueryPerfCounterCall*>(getNextCall(false, false, ECF_QUERY_PERF_COUNTER, true, __func__));
+	CQueryPerfCounterCall* playEndCall = static_cast<CQueryPerfCounterCall*>(getNextCall(false, true, ECF_QUERY_PERF_COUNTER, false, __func__));
 	
 	counter->QuadPart = playEndCall->m_Counter;
 	BOOL res = playEndCall->m_Res;
@@ -326,8 +376,8 @@ BOOL CPlayingEngExtInterceptor::QueryPerfCounter(LARGE_INTEGER* counter) {
 }
 
 BOOL CPlayingEngExtInterceptor::QueryPerfFreq(LARGE_INTEGER* freq) {
-	CQueryPerfFreqCall* playCall = dynamic_cast<CQueryPerfFreqCall*>(getNextCall(false, false, ECF_QUERY_PERF_FREQ, true, __func__));
-	CQueryPerfFreqCall* playEndCall = dynamic_cast<CQueryPerfFreqCall*>(getNextCall(false, true, ECF_QUERY_PERF_FREQ, false, __func__));
+	CQueryPerfFreqCall* playCall = static_cast<CQueryPerfFreqCall*>(getNextCall(false, false, ECF_QUERY_PERF_FREQ, true, __func__));
+	CQueryPerfFreqCall* playEndCall = static_cast<CQueryPerfFreqCall*>(getNextCall(false, true, ECF_QUERY_PERF_FREQ, false, __func__));
 
 	freq->QuadPart = playEndCall->m_Freq;
 	BOOL res = playEndCall->m_Res;
@@ -337,8 +387,8 @@ BOOL CPlayingEngExtInterceptor::QueryPerfFreq(LARGE_INTEGER* freq) {
 }
 
 DWORD CPlayingEngExtInterceptor::GetTickCount() {
-	CGetTickCountCall* playCall = dynamic_cast<CGetTickCountCall*>(getNextCall(false, false, ECF_GET_TICK_COUNT, true, __func__));
-	CGetTickCountCall* playEndCall = dynamic_cast<CGetTickCountCall*>(getNextCall(false, true, ECF_GET_TICK_COUNT, false, __func__));
+	CGetTickCountCall* playCall = static_cast<CGetTickCountCall*>(getNextCall(false, false, ECF_GET_TICK_COUNT, true, __func__));
+	CGetTickCountCall* playEndCall = static_cast<CGetTickCountCall*>(getNextCall(false, true, ECF_GET_TICK_COUNT, false, __func__));
 
 	DWORD res = playEndCall->m_Res;
 	freeFuncCall(playCall); freeFuncCall(playEndCall);
@@ -347,24 +397,24 @@ DWORD CPlayingEngExtInterceptor::GetTickCount() {
 }
 
 void CPlayingEngExtInterceptor::GetLocalTime(LPSYSTEMTIME time) {
-	CGetLocalTimeCall* playCall = dynamic_cast<CGetLocalTimeCall*>(getNextCall(false, false, ECF_GET_LOCAL_TIME, true, __func__));
-	CGetLocalTimeCall* playEndCall = dynamic_cast<CGetLocalTimeCall*>(getNextCall(false, true, ECF_GET_LOCAL_TIME, false, __func__));
+	CGetLocalTimeCall* playCall = static_cast<CGetLocalTimeCall*>(getNextCall(false, false, ECF_GET_LOCAL_TIME, true, __func__));
+	CGetLocalTimeCall* playEndCall = static_cast<CGetLocalTimeCall*>(getNextCall(false, true, ECF_GET_LOCAL_TIME, false, __func__));
 
 	memcpy(time, &playEndCall->m_Res, sizeof(SYSTEMTIME));
 	freeFuncCall(playCall); freeFuncCall(playEndCall);
 }
 
 void CPlayingEngExtInterceptor::GetSystemTime(LPSYSTEMTIME time) {
-	CGetSystemTimeCall* playCall = dynamic_cast<CGetSystemTimeCall*>(getNextCall(false, false, ECF_GET_SYSTEM_TIME, true, __func__));
-	CGetSystemTimeCall* playEndCall = dynamic_cast<CGetSystemTimeCall*>(getNextCall(false, true, ECF_GET_SYSTEM_TIME, false, __func__));
+	CGetSystemTimeCall* playCall = static_cast<CGetSystemTimeCall*>(getNextCall(false, false, ECF_GET_SYSTEM_TIME, true, __func__));
+	CGetSystemTimeCall* playEndCall = static_cast<CGetSystemTimeCall*>(getNextCall(false, true, ECF_GET_SYSTEM_TIME, false, __func__));
 
 	memcpy(time, &playEndCall->m_Res, sizeof(SYSTEMTIME));
 	freeFuncCall(playCall); freeFuncCall(playEndCall);
 }
 
 void CPlayingEngExtInterceptor::GetTimeZoneInfo(LPTIME_ZONE_INFORMATION zinfo) {
-	CGetTimeZoneInfoCall* playCall = dynamic_cast<CGetTimeZoneInfoCall*>(getNextCall(false, false, ECF_GET_TIMEZONE_INFO, true, __func__));
-	CGetTimeZoneInfoCall* playEndCall = dynamic_cast<CGetTimeZoneInfoCall*>(getNextCall(false, true, ECF_GET_TIMEZONE_INFO, false, __func__));
+	CGetTimeZoneInfoCall* playCall = static_cast<CGetTimeZoneInfoCall*>(getNextCall(false, false, ECF_GET_TIMEZONE_INFO, true, __func__));
+	CGetTimeZoneInfoCall* playEndCall = static_cast<CGetTimeZoneInfoCall*>(getNextCall(false, true, ECF_GET_TIMEZONE_INFO, false, __func__));
 
 	memcpy(zinfo, &playEndCall->m_Res, sizeof(TIME_ZONE_INFORMATION));
 	freeFuncCall(playCall); freeFuncCall(playEndCall);
@@ -372,8 +422,8 @@ void CPlayingEngExtInterceptor::GetTimeZoneInfo(LPTIME_ZONE_INFORMATION zinfo) {
 
 BOOL CPlayingEngExtInterceptor::GetProcessTimes(HANDLE hProcess, LPFILETIME lpCreationTime, LPFILETIME lpExitTime, LPFILETIME lpKernelTime, LPFILETIME lpUserTime)
 {
-	CGetProcessTimesCall* playCall = dynamic_cast<CGetProcessTimesCall*>(getNextCall(false, false, ECF_GET_PROCESS_TIMES, true, __func__));
-	CGetProcessTimesCall* playEndCall = dynamic_cast<CGetProcessTimesCall*>(getNextCall(false, true, ECF_GET_PROCESS_TIMES, false, __func__));
+	CGetProcessTimesCall* playCall = static_cast<CGetProcessTimesCall*>(getNextCall(false, false, ECF_GET_PROCESS_TIMES, true, __func__));
+	CGetProcessTimesCall* playEndCall = static_cast<CGetProcessTimesCall*>(getNextCall(false, true, ECF_GET_PROCESS_TIMES, false, __func__));
 
 	BOOL res = playEndCall->m_Res;
 	memcpy(lpCreationTime, &playEndCall->m_CreationTime, sizeof(FILETIME));
@@ -387,18 +437,32 @@ BOOL CPlayingEngExtInterceptor::GetProcessTimes(HANDLE hProcess, LPFILETIME lpCr
 
 void CPlayingEngExtInterceptor::GetSystemTimeAsFileTime(LPFILETIME lpSystemTimeAsFileTime)
 {
-	CGetSystemTimeAsFileTimeCall* playCall = dynamic_cast<CGetSystemTimeAsFileTimeCall*>(getNextCall(false, false, ECF_GET_SYSTEM_TIME_AS_FILE_TIME, true, __func__));
-	CGetSystemTimeAsFileTimeCall* playEndCall = dynamic_cast<CGetSystemTimeAsFileTimeCall*>(getNextCall(false, true, ECF_GET_SYSTEM_TIME_AS_FILE_TIME, false, __func__));
+	CGetSystemTimeAsFileTimeCall* playCall = static_cast<CGetSystemTimeAsFileTimeCall*>(getNextCall(false, false, ECF_GET_SYSTEM_TIME_AS_FILE_TIME, true, __func__));
+	CGetSystemTimeAsFileTimeCall* playEndCall = static_cast<CGetSystemTimeAsFileTimeCall*>(getNextCall(false, true, ECF_GET_SYSTEM_TIME_AS_FILE_TIME, false, __func__));
 
 	memcpy(lpSystemTimeAsFileTime, &playEndCall->m_SystemTime, sizeof(FILETIME));
 	freeFuncCall(playCall); freeFuncCall(playEndCall);
 }
+#else // _WIN32
+int CPlayingEngExtInterceptor::clock_gettime(clockid_t clk, struct timespec* ts) {
+	CClockGetTimeCall* playCall = static_cast<CClockGetTimeCall*>(getNextCall(false, false, ECF_CLOCK_GETTIME, true, __func__));
+	CClockGetTimeCall(clk).ensureArgsAreEqual(playCall, m_bStrictChecks, __func__);
+	CClockGetTimeCall* playEndCall = static_cast<CClockGetTimeCall*>(getNextCall(false, true, ECF_CLOCK_GETTIME, false, __func__));
+
+	ts->tv_sec = (time_t)playEndCall->m_Sec;
+	ts->tv_nsec = (long)playEndCall->m_NSec;
+	int res = playEndCall->m_Res;
+	freeFuncCall(playCall); freeFuncCall(playEndCall);
+
+	return res;
+}
+#endif // _WIN32
 
 
 SOCKET CPlayingEngExtInterceptor::socket(int af, int type, int protocol) {
-	CSocketCall* playCall = dynamic_cast<CSocketCall*>(getNextCall(false, false, ECF_SOCKET, true, __func__));
+	CSocketCall* playCall = static_cast<CSocketCall*>(getNextCall(false, false, ECF_SOCKET, true, __func__));
 	CSocketCall(af, type, protocol).ensureArgsAreEqual(playCall, m_bStrictChecks, __func__);
-	CSocketCall* playEndCall = dynamic_cast<CSocketCall*>(getNextCall(false, true, ECF_SOCKET, false, __func__));
+	CSocketCall* playEndCall = static_cast<CSocketCall*>(getNextCall(false, true, ECF_SOCKET, false, __func__));
 
 	SOCKET res = playEndCall->m_Res;
 	freeFuncCall(playCall); freeFuncCall(playEndCall);
@@ -407,9 +471,9 @@ SOCKET CPlayingEngExtInterceptor::socket(int af, int type, int protocol) {
 }
 
 int CPlayingEngExtInterceptor::ioctlsocket(SOCKET s, long cmd, u_long *argp) {
-	CIoCtlSocketCall* playCall = dynamic_cast<CIoCtlSocketCall*>(getNextCall(false, false, ECF_IOCTL_SOCKET, true, __func__));
+	CIoCtlSocketCall* playCall = static_cast<CIoCtlSocketCall*>(getNextCall(false, false, ECF_IOCTL_SOCKET, true, __func__));
 	CIoCtlSocketCall(s, cmd, *argp).ensureArgsAreEqual(playCall, m_bStrictChecks, __func__);
-	CIoCtlSocketCall* playEndCall = dynamic_cast<CIoCtlSocketCall*>(getNextCall(false, true, ECF_IOCTL_SOCKET, false, __func__));
+	CIoCtlSocketCall* playEndCall = static_cast<CIoCtlSocketCall*>(getNextCall(false, true, ECF_IOCTL_SOCKET, false, __func__));
 
 	int res = playEndCall->m_Res;
 	*argp = playEndCall->m_OutValue;
@@ -419,9 +483,9 @@ int CPlayingEngExtInterceptor::ioctlsocket(SOCKET s, long cmd, u_long *argp) {
 }
 
 int CPlayingEngExtInterceptor::setsockopt(SOCKET s, int level, int optname, const char* optval, int optlen) {
-	CSetSockOptCall* playCall = dynamic_cast<CSetSockOptCall*>(getNextCall(false, false, ECF_SET_SOCK_OPT, true, __func__));
+	CSetSockOptCall* playCall = static_cast<CSetSockOptCall*>(getNextCall(false, false, ECF_SET_SOCK_OPT, true, __func__));
 	CSetSockOptCall(s, level, optname, optval, optlen).ensureArgsAreEqual(playCall, m_bStrictChecks, __func__);
-	CSetSockOptCall* playEndCall = dynamic_cast<CSetSockOptCall*>(getNextCall(false, true, ECF_SET_SOCK_OPT, false, __func__));
+	CSetSockOptCall* playEndCall = static_cast<CSetSockOptCall*>(getNextCall(false, true, ECF_SET_SOCK_OPT, false, __func__));
 
 	int res = playEndCall->m_Res;
 	freeFuncCall(playCall); freeFuncCall(playEndCall);
@@ -430,9 +494,9 @@ int CPlayingEngExtInterceptor::setsockopt(SOCKET s, int level, int optname, cons
 }
 
 int CPlayingEngExtInterceptor::closesocket(SOCKET s) {
-	CCloseSocketCall* playCall = dynamic_cast<CCloseSocketCall*>(getNextCall(false, false, ECF_CLOSE_SOCKET, true, __func__));
+	CCloseSocketCall* playCall = static_cast<CCloseSocketCall*>(getNextCall(false, false, ECF_CLOSE_SOCKET, true, __func__));
 	CCloseSocketCall(s).ensureArgsAreEqual(playCall, m_bStrictChecks, __func__);
-	CCloseSocketCall* playEndCall = dynamic_cast<CCloseSocketCall*>(getNextCall(false, true, ECF_CLOSE_SOCKET, false, __func__));
+	CCloseSocketCall* playEndCall = static_cast<CCloseSocketCall*>(getNextCall(false, true, ECF_CLOSE_SOCKET, false, __func__));
 
 	int res = playEndCall->m_Res;
 	freeFuncCall(playCall); freeFuncCall(playEndCall);
@@ -441,9 +505,9 @@ int CPlayingEngExtInterceptor::closesocket(SOCKET s) {
 }
 
 int CPlayingEngExtInterceptor::recvfrom(SOCKET s, char* buf, int len, int flags, struct sockaddr* from, socklen_t *fromlen) {
-	CRecvFromCall* playCall = dynamic_cast<CRecvFromCall*>(getNextCall(false, false, ECF_RECVFROM, true, __func__));
+	CRecvFromCall* playCall = static_cast<CRecvFromCall*>(getNextCall(false, false, ECF_RECVFROM, true, __func__));
 	CRecvFromCall(s, len, flags, *fromlen).ensureArgsAreEqual(playCall, m_bStrictChecks, __func__);
-	CRecvFromCall* playEndCall = dynamic_cast<CRecvFromCall*>(getNextCall(false, true, ECF_RECVFROM, false, __func__));
+	CRecvFromCall* playEndCall = static_cast<CRecvFromCall*>(getNextCall(false, true, ECF_RECVFROM, false, __func__));
 
 	int res = playEndCall->m_Res;
 	*fromlen = playEndCall->m_FromLenOut;
@@ -456,15 +520,22 @@ int CPlayingEngExtInterceptor::recvfrom(SOCKET s, char* buf, int len, int flags,
 
 	if (res == -1) {
 		m_NumFrames++;
+		maybeReportFps();
 	}
 
 	return res;
 }
 
+#ifndef _WIN32
+int CPlayingEngExtInterceptor::recvmmsg(SOCKET s, struct mmsghdr* msgvec, unsigned int vlen, int flags, struct timespec* timeout) {
+	return TestSuite_RecvMMsg(this, s, msgvec, vlen, flags);
+}
+#endif // _WIN32
+
 int CPlayingEngExtInterceptor::sendto(SOCKET s, const char* buf, int len, int flags, const struct sockaddr* to, int tolen) {
-	CSendToCall* playCall = dynamic_cast<CSendToCall*>(getNextCall(false, false, ECF_SENDTO, true, __func__));
+	CSendToCall* playCall = static_cast<CSendToCall*>(getNextCall(false, false, ECF_SENDTO, true, __func__));
 	CSendToCall(s, buf, len, flags, to, tolen).ensureArgsAreEqual(playCall, m_bStrictChecks, __func__);
-	CSendToCall* playEndCall = dynamic_cast<CSendToCall*>(getNextCall(false, true, ECF_SENDTO, false, __func__));
+	CSendToCall* playEndCall = static_cast<CSendToCall*>(getNextCall(false, true, ECF_SENDTO, false, __func__));
 
 	int res = playEndCall->m_Res;
 	freeFuncCall(playCall); freeFuncCall(playEndCall);
@@ -472,10 +543,16 @@ int CPlayingEngExtInterceptor::sendto(SOCKET s, const char* buf, int len, int fl
 	return res;
 }
 
+#ifndef _WIN32
+int CPlayingEngExtInterceptor::sendmmsg(SOCKET s, struct mmsghdr* msgvec, unsigned int vlen, int flags) {
+	return TestSuite_SendMMsg(this, s, msgvec, vlen, flags);
+}
+#endif // _WIN32
+
 int CPlayingEngExtInterceptor::bind(SOCKET s, const struct sockaddr* addr, int namelen) {
-	CBindCall* playCall = dynamic_cast<CBindCall*>(getNextCall(false, false, ECF_BIND, true, __func__));
+	CBindCall* playCall = static_cast<CBindCall*>(getNextCall(false, false, ECF_BIND, true, __func__));
 	CBindCall(s, addr, namelen).ensureArgsAreEqual(playCall, m_bStrictChecks, __func__);
-	CBindCall* playEndCall = dynamic_cast<CBindCall*>(getNextCall(false, true, ECF_BIND, false, __func__));
+	CBindCall* playEndCall = static_cast<CBindCall*>(getNextCall(false, true, ECF_BIND, false, __func__));
 
 	int res = playEndCall->m_Res;
 	freeFuncCall(playCall); freeFuncCall(playEndCall);
@@ -484,9 +561,9 @@ int CPlayingEngExtInterceptor::bind(SOCKET s, const struct sockaddr* addr, int n
 }
 
 int CPlayingEngExtInterceptor::getsockname(SOCKET s, struct sockaddr* name, socklen_t* namelen) {
-	CGetSockNameCall* playCall = dynamic_cast<CGetSockNameCall*>(getNextCall(false, false, ECF_GET_SOCK_NAME, true, __func__));
+	CGetSockNameCall* playCall = static_cast<CGetSockNameCall*>(getNextCall(false, false, ECF_GET_SOCK_NAME, true, __func__));
 	CGetSockNameCall(s, *namelen).ensureArgsAreEqual(playCall, m_bStrictChecks, __func__);
-	CGetSockNameCall* playEndCall = dynamic_cast<CGetSockNameCall*>(getNextCall(false, true, ECF_GET_SOCK_NAME, false, __func__));
+	CGetSockNameCall* playEndCall = static_cast<CGetSockNameCall*>(getNextCall(false, true, ECF_GET_SOCK_NAME, false, __func__));
 
 	int res = playEndCall->m_Res;
 	*namelen = playEndCall->m_AddrLenOut;
@@ -500,8 +577,8 @@ int CPlayingEngExtInterceptor::getsockname(SOCKET s, struct sockaddr* name, sock
 }
 
 int CPlayingEngExtInterceptor::WSAGetLastError() {
-	CWSAGetLastErrorCall* playCall = dynamic_cast<CWSAGetLastErrorCall*>(getNextCall(false, false, ECF_WSA_GET_LAST_ERROR, true, __func__));
-	CWSAGetLastErrorCall* playEndCall = dynamic_cast<CWSAGetLastErrorCall*>(getNextCall(false, true, ECF_WSA_GET_LAST_ERROR, false, __func__));
+	CWSAGetLastErrorCall* playCall = static_cast<CWSAGetLastErrorCall*>(getNextCall(false, false, ECF_WSA_GET_LAST_ERROR, true, __func__));
+	CWSAGetLastErrorCall* playEndCall = static_cast<CWSAGetLastErrorCall*>(getNextCall(false, true, ECF_WSA_GET_LAST_ERROR, false, __func__));
 
 	int res = playEndCall->m_Res;
 	freeFuncCall(playCall); freeFuncCall(playEndCall);
@@ -510,9 +587,9 @@ int CPlayingEngExtInterceptor::WSAGetLastError() {
 }
 
 struct hostent* CPlayingEngExtInterceptor::gethostbyname(const char *name) {
-	CGetHostByNameCall* playCall = dynamic_cast<CGetHostByNameCall*>(getNextCall(false, false, ECF_GET_HOST_BY_NAME, true, __func__));
+	CGetHostByNameCall* playCall = static_cast<CGetHostByNameCall*>(getNextCall(false, false, ECF_GET_HOST_BY_NAME, true, __func__));
 	CGetHostByNameCall(name).ensureArgsAreEqual(playCall, m_bStrictChecks, __func__);
-	CGetHostByNameCall* playEndCall = dynamic_cast<CGetHostByNameCall*>(getNextCall(false, true, ECF_GET_HOST_BY_NAME, false, __func__));
+	CGetHostByNameCall* playEndCall = static_cast<CGetHostByNameCall*>(getNextCall(false, true, ECF_GET_HOST_BY_NAME, false, __func__));
 
 	setCurrentHostent(&playEndCall->m_HostentData);
 
@@ -522,9 +599,9 @@ struct hostent* CPlayingEngExtInterceptor::gethostbyname(const char *name) {
 }
 
 int CPlayingEngExtInterceptor::gethostname(char *name, int namelen) {
-	CGetHostNameCall* playCall = dynamic_cast<CGetHostNameCall*>(getNextCall(false, false, ECF_GET_HOST_NAME, true, __func__));
+	CGetHostNameCall* playCall = static_cast<CGetHostNameCall*>(getNextCall(false, false, ECF_GET_HOST_NAME, true, __func__));
 	CGetHostNameCall(namelen).ensureArgsAreEqual(playCall, m_bStrictChecks, __func__);
-	CGetHostNameCall* playEndCall = dynamic_cast<CGetHostNameCall*>(getNextCall(false, true, ECF_GET_HOST_NAME, false, __func__));
+	CGetHostNameCall* playEndCall = static_cast<CGetHostNameCall*>(getNextCall(false, true, ECF_GET_HOST_NAME, false, __func__));
 
 	int res = playEndCall->m_Res;
 	strcpy(name, playEndCall->m_Name);
@@ -558,9 +635,9 @@ void CPlayingEngExtInterceptor::setCurrentTm(struct tm* t) {
 }
 
 void CPlayingEngExtInterceptor::SteamAPI_SetBreakpadAppID(uint32 unAppID) {
-	CSteamApiSetBreakpadAppIdCall* playCall = dynamic_cast<CSteamApiSetBreakpadAppIdCall*>(getNextCall(false, false, ECF_STEAM_API_SET_BREAKPAD_APP_ID, true, __func__));
+	CSteamApiSetBreakpadAppIdCall* playCall = static_cast<CSteamApiSetBreakpadAppIdCall*>(getNextCall(false, false, ECF_STEAM_API_SET_BREAKPAD_APP_ID, true, __func__));
 	CSteamApiSetBreakpadAppIdCall(unAppID).ensureArgsAreEqual(playCall, m_bStrictChecks, __func__);
-	CSteamApiSetBreakpadAppIdCall* playEndCall = dynamic_cast<CSteamApiSetBreakpadAppIdCall*>(getNextCall(false, true, ECF_STEAM_API_SET_BREAKPAD_APP_ID, false, __func__));
+	CSteamApiSetBreakpadAppIdCall* playEndCall = static_cast<CSteamApiSetBreakpadAppIdCall*>(getNextCall(false, true, ECF_STEAM_API_SET_BREAKPAD_APP_ID, false, __func__));
 
 	freeFuncCall(playCall); freeFuncCall(playEndCall);
 }
@@ -572,9 +649,9 @@ void CPlayingEngExtInterceptor::SteamAPI_UseBreakpadCrashHandler(char const *pch
 void CPlayingEngExtInterceptor::SteamAPI_RegisterCallback(CCallbackBase *pCallback, int iCallback) {
 	int rehldsId = getOrRegisterSteamCallback(pCallback);
 
-	CSteamApiRegisterCallbackCall* playCall = dynamic_cast<CSteamApiRegisterCallbackCall*>(getNextCall(false, false, ECF_STEAM_API_REGISTER_CALLBACK, true, __func__));
+	CSteamApiRegisterCallbackCall* playCall = static_cast<CSteamApiRegisterCallbackCall*>(getNextCall(false, false, ECF_STEAM_API_REGISTER_CALLBACK, true, __func__));
 	CSteamApiRegisterCallbackCall(rehldsId, iCallback, pCallback).ensureArgsAreEqual(playCall, m_bStrictChecks, __func__);
-	CSteamApiRegisterCallbackCall* playEndCall = dynamic_cast<CSteamApiRegisterCallbackCall*>(getNextCall(false, true, ECF_STEAM_API_REGISTER_CALLBACK, false, __func__));
+	CSteamApiRegisterCallbackCall* playEndCall = static_cast<CSteamApiRegisterCallbackCall*>(getNextCall(false, true, ECF_STEAM_API_REGISTER_CALLBACK, false, __func__));
 
 	pCallback->SetFlags(playEndCall->m_OutState.m_nCallbackFlags);
 	pCallback->SetICallback(playEndCall->m_OutState.m_iCallback);
@@ -582,8 +659,8 @@ void CPlayingEngExtInterceptor::SteamAPI_RegisterCallback(CCallbackBase *pCallba
 }
 
 bool CPlayingEngExtInterceptor::SteamAPI_Init() {
-	CSteamApiInitCall* playCall = dynamic_cast<CSteamApiInitCall*>(getNextCall(false, false, ECF_STEAM_API_INIT, true, __func__));
-	CSteamApiInitCall* playEndCall = dynamic_cast<CSteamApiInitCall*>(getNextCall(false, true, ECF_STEAM_API_INIT, false, __func__));
+	CSteamApiInitCall* playCall = static_cast<CSteamApiInitCall*>(getNextCall(false, false, ECF_STEAM_API_INIT, true, __func__));
+	CSteamApiInitCall* playEndCall = static_cast<CSteamApiInitCall*>(getNextCall(false, true, ECF_STEAM_API_INIT, false, __func__));
 
 	bool res = playEndCall->m_Res;
 	freeFuncCall(playCall); freeFuncCall(playEndCall);
@@ -594,9 +671,9 @@ bool CPlayingEngExtInterceptor::SteamAPI_Init() {
 void CPlayingEngExtInterceptor::SteamAPI_UnregisterCallResult(class CCallbackBase *pCallback, SteamAPICall_t hAPICall) {
 	int rehldsId = getOrRegisterSteamCallback(pCallback);
 
-	CSteamApiUnrigestierCallResultCall* playCall = dynamic_cast<CSteamApiUnrigestierCallResultCall*>(getNextCall(false, false, ECF_STEAM_API_UNREGISTER_CALL_RESULT, true, __func__));
+	CSteamApiUnrigestierCallResultCall* playCall = static_cast<CSteamApiUnrigestierCallResultCall*>(getNextCall(false, false, ECF_STEAM_API_UNREGISTER_CALL_RESULT, true, __func__));
 	CSteamApiUnrigestierCallResultCall(rehldsId, hAPICall, pCallback).ensureArgsAreEqual(playCall, m_bStrictChecks, __func__);
-	CSteamApiUnrigestierCallResultCall* playEndCall = dynamic_cast<CSteamApiUnrigestierCallResultCall*>(getNextCall(false, true, ECF_STEAM_API_UNREGISTER_CALL_RESULT, false, __func__));
+	CSteamApiUnrigestierCallResultCall* playEndCall = static_cast<CSteamApiUnrigestierCallResultCall*>(getNextCall(false, true, ECF_STEAM_API_UNREGISTER_CALL_RESULT, false, __func__));
 
 	pCallback->SetFlags(playEndCall->m_OutState.m_nCallbackFlags);
 	pCallback->SetICallback(playEndCall->m_OutState.m_iCallback);
@@ -618,9 +695,9 @@ ISteamApps* CPlayingEngExtInterceptor::SteamApps() {
 }
 
 bool CPlayingEngExtInterceptor::SteamGameServer_Init(uint32 unIP, uint16 usSteamPort, uint16 usGamePort, uint16 usQueryPort, EServerMode eServerMode, const char *pchVersionString) {
-	CSteamGameServerInitCall* playCall = dynamic_cast<CSteamGameServerInitCall*>(getNextCall(false, false, ECF_STEAMGAMESERVER_INIT, true, __func__));
+	CSteamGameServerInitCall* playCall = static_cast<CSteamGameServerInitCall*>(getNextCall(false, false, ECF_STEAMGAMESERVER_INIT, true, __func__));
 	CSteamGameServerInitCall(unIP, usSteamPort, usGamePort, usQueryPort, eServerMode, pchVersionString).ensureArgsAreEqual(playCall, m_bStrictChecks, __func__);
-	CSteamGameServerInitCall* playEndCall = dynamic_cast<CSteamGameServerInitCall*>(getNextCall(false, true, ECF_STEAMGAMESERVER_INIT, false, __func__));
+	CSteamGameServerInitCall* playEndCall = static_cast<CSteamGameServerInitCall*>(getNextCall(false, true, ECF_STEAMGAMESERVER_INIT, false, __func__));
 
 	bool res = playEndCall->m_Res;
 	freeFuncCall(playCall); freeFuncCall(playEndCall);
@@ -629,8 +706,8 @@ bool CPlayingEngExtInterceptor::SteamGameServer_Init(uint32 unIP, uint16 usSteam
 }
 
 ISteamGameServer* CPlayingEngExtInterceptor::SteamGameServer() {
-	CSteamGameServerCall* playCall = dynamic_cast<CSteamGameServerCall*>(getNextCall(false, false, ECF_STEAMGAMESERVER, true, __func__));
-	CSteamGameServerCall* playEndCall = dynamic_cast<CSteamGameServerCall*>(getNextCall(false, true, ECF_STEAMGAMESERVER, false, __func__));
+	CSteamGameServerCall* playCall = static_cast<CSteamGameServerCall*>(getNextCall(false, false, ECF_STEAMGAMESERVER, true, __func__));
+	CSteamGameServerCall* playEndCall = static_cast<CSteamGameServerCall*>(getNextCall(false, true, ECF_STEAMGAMESERVER, false, __func__));
 
 	ISteamGameServer* res = NULL;
 	if (!playEndCall->m_ReturnNull) {
@@ -643,23 +720,23 @@ ISteamGameServer* CPlayingEngExtInterceptor::SteamGameServer() {
 }
 
 void CPlayingEngExtInterceptor::SteamGameServer_RunCallbacks() {
-	CSteamGameServerRunCallbacksCall* playCall = dynamic_cast<CSteamGameServerRunCallbacksCall*>(getNextCall(false, false, ECF_STEAMGAMESERVER_RUN_CALLBACKS, true, __func__));
-	CSteamGameServerRunCallbacksCall* playEndCall = dynamic_cast<CSteamGameServerRunCallbacksCall*>(getNextCall(false, true, ECF_STEAMGAMESERVER_RUN_CALLBACKS, false, __func__));
+	CSteamGameServerRunCallbacksCall* playCall = static_cast<CSteamGameServerRunCallbacksCall*>(getNextCall(false, false, ECF_STEAMGAMESERVER_RUN_CALLBACKS, true, __func__));
+	CSteamGameServerRunCallbacksCall* playEndCall = static_cast<CSteamGameServerRunCallbacksCall*>(getNextCall(false, true, ECF_STEAMGAMESERVER_RUN_CALLBACKS, false, __func__));
 
 	freeFuncCall(playCall); freeFuncCall(playEndCall);
 }
 
 void CPlayingEngExtInterceptor::SteamAPI_RunCallbacks() {
-	CSteamApiRunCallbacksCall* playCall = dynamic_cast<CSteamApiRunCallbacksCall*>(getNextCall(false, false, ECF_STEAM_API_RUN_CALLBACKS, true, __func__));
-	CSteamApiRunCallbacksCall* playEndCall = dynamic_cast<CSteamApiRunCallbacksCall*>(getNextCall(false, true, ECF_STEAM_API_RUN_CALLBACKS, false, __func__));
+	CSteamApiRunCallbacksCall* playCall = static_cast<CSteamApiRunCallbacksCall*>(getNextCall(false, false, ECF_STEAM_API_RUN_CALLBACKS, true, __func__));
+	CSteamApiRunCallbacksCall* playEndCall = static_cast<CSteamApiRunCallbacksCall*>(getNextCall(false, true, ECF_STEAM_API_RUN_CALLBACKS, false, __func__));
 
 	freeFuncCall(playCall); freeFuncCall(playEndCall);
 }
 
 void CPlayingEngExtInterceptor::SteamGameServer_Shutdown()
 {
-	CSteamGameServerShutdownCall* playCall = dynamic_cast<CSteamGameServerShutdownCall*>(getNextCall(false, false, ECF_STEAMGAMESERVER_SHUTDOWN, true, __func__));
-	CSteamGameServerShutdownCall* playEndCall = dynamic_cast<CSteamGameServerShutdownCall*>(getNextCall(false, true, ECF_STEAMGAMESERVER_SHUTDOWN, false, __func__));
+	CSteamGameServerShutdownCall* playCall = static_cast<CSteamGameServerShutdownCall*>(getNextCall(false, false, ECF_STEAMGAMESERVER_SHUTDOWN, true, __func__));
+	CSteamGameServerShutdownCall* playEndCall = static_cast<CSteamGameServerShutdownCall*>(getNextCall(false, true, ECF_STEAMGAMESERVER_SHUTDOWN, false, __func__));
 
 	freeFuncCall(playCall); freeFuncCall(playEndCall);
 }
@@ -668,9 +745,9 @@ void CPlayingEngExtInterceptor::SteamGameServer_Shutdown()
 void CPlayingEngExtInterceptor::SteamAPI_UnregisterCallback(CCallbackBase *pCallback) {
 	int rehldsId = getOrRegisterSteamCallback(pCallback);
 
-	CSteamApiUnregisterCallbackCall* playCall = dynamic_cast<CSteamApiUnregisterCallbackCall*>(getNextCall(false, false, ECF_STEAM_API_UNREGISTER_CALLBACK, true, __func__));
+	CSteamApiUnregisterCallbackCall* playCall = static_cast<CSteamApiUnregisterCallbackCall*>(getNextCall(false, false, ECF_STEAM_API_UNREGISTER_CALLBACK, true, __func__));
 	CSteamApiUnregisterCallbackCall(rehldsId, pCallback).ensureArgsAreEqual(playCall, m_bStrictChecks, __func__);
-	CSteamApiUnregisterCallbackCall* playEndCall = dynamic_cast<CSteamApiUnregisterCallbackCall*>(getNextCall(false, true, ECF_STEAM_API_UNREGISTER_CALLBACK, false, __func__));
+	CSteamApiUnregisterCallbackCall* playEndCall = static_cast<CSteamApiUnregisterCallbackCall*>(getNextCall(false, true, ECF_STEAM_API_UNREGISTER_CALLBACK, false, __func__));
 
 	pCallback->SetFlags(playEndCall->m_OutState.m_nCallbackFlags);
 	pCallback->SetICallback(playEndCall->m_OutState.m_iCallback);
@@ -692,33 +769,33 @@ bool CSteamGameServerPlayingWrapper::InitGameServer(uint32 unIP, uint16 usGamePo
 }
 
 void CSteamGameServerPlayingWrapper::SetProduct(const char *pszProduct) {
-	CGameServerSetProductCall* playCall = dynamic_cast<CGameServerSetProductCall*>(m_Player->getNextCall(false, false, ECF_GS_SET_PRODUCT, true, __func__));
+	CGameServerSetProductCall* playCall = static_cast<CGameServerSetProductCall*>(m_Player->getNextCall(false, false, ECF_GS_SET_PRODUCT, true, __func__));
 	CGameServerSetProductCall(pszProduct).ensureArgsAreEqual(playCall, m_bStrictChecks, __func__);
-	CGameServerSetProductCall* playEndCall = dynamic_cast<CGameServerSetProductCall*>(m_Player->getNextCall(false, true, ECF_GS_SET_PRODUCT, false, __func__));
+	CGameServerSetProductCall* playEndCall = static_cast<CGameServerSetProductCall*>(m_Player->getNextCall(false, true, ECF_GS_SET_PRODUCT, false, __func__));
 
 	m_Player->freeFuncCall(playCall); m_Player->freeFuncCall(playEndCall);
 }
 
 void CSteamGameServerPlayingWrapper::SetGameDescription(const char *pszGameDescription) {
-	CGameServerSetGameDescCall* playCall = dynamic_cast<CGameServerSetGameDescCall*>(m_Player->getNextCall(false, false, ECF_GS_SET_GAME_DESC, true, __func__));
+	CGameServerSetGameDescCall* playCall = static_cast<CGameServerSetGameDescCall*>(m_Player->getNextCall(false, false, ECF_GS_SET_GAME_DESC, true, __func__));
 	CGameServerSetGameDescCall(pszGameDescription).ensureArgsAreEqual(playCall, m_bStrictChecks, __func__);
-	CGameServerSetGameDescCall* playEndCall = dynamic_cast<CGameServerSetGameDescCall*>(m_Player->getNextCall(false, true, ECF_GS_SET_GAME_DESC, false, __func__));
+	CGameServerSetGameDescCall* playEndCall = static_cast<CGameServerSetGameDescCall*>(m_Player->getNextCall(false, true, ECF_GS_SET_GAME_DESC, false, __func__));
 
 	m_Player->freeFuncCall(playCall); m_Player->freeFuncCall(playEndCall);
 }
 
 void CSteamGameServerPlayingWrapper::SetModDir(const char *pszModDir) {
-	CGameServerSetModDirCall* playCall = dynamic_cast<CGameServerSetModDirCall*>(m_Player->getNextCall(false, false, ECF_GS_SET_GAME_DIR, true, __func__));
+	CGameServerSetModDirCall* playCall = static_cast<CGameServerSetModDirCall*>(m_Player->getNextCall(false, false, ECF_GS_SET_GAME_DIR, true, __func__));
 	CGameServerSetModDirCall(pszModDir).ensureArgsAreEqual(playCall, m_bStrictChecks, __func__);
-	CGameServerSetModDirCall* playEndCall = dynamic_cast<CGameServerSetModDirCall*>(m_Player->getNextCall(false, true, ECF_GS_SET_GAME_DIR, false, __func__));
+	CGameServerSetModDirCall* playEndCall = static_cast<CGameServerSetModDirCall*>(m_Player->getNextCall(false, true, ECF_GS_SET_GAME_DIR, false, __func__));
 
 	m_Player->freeFuncCall(playCall); m_Player->freeFuncCall(playEndCall);
 }
 
 void CSteamGameServerPlayingWrapper::SetDedicatedServer(bool bDedicated) {
-	CGameServerSetDedicatedServerCall* playCall = dynamic_cast<CGameServerSetDedicatedServerCall*>(m_Player->getNextCall(false, false, ECF_GS_SET_DEDICATED_SERVER, true, __func__));
+	CGameServerSetDedicatedServerCall* playCall = static_cast<CGameServerSetDedicatedServerCall*>(m_Player->getNextCall(false, false, ECF_GS_SET_DEDICATED_SERVER, true, __func__));
 	CGameServerSetDedicatedServerCall(bDedicated).ensureArgsAreEqual(playCall, m_bStrictChecks, __func__);
-	CGameServerSetDedicatedServerCall* playEndCall = dynamic_cast<CGameServerSetDedicatedServerCall*>(m_Player->getNextCall(false, true, ECF_GS_SET_DEDICATED_SERVER, false, __func__));
+	CGameServerSetDedicatedServerCall* playEndCall = static_cast<CGameServerSetDedicatedServerCall*>(m_Player->getNextCall(false, true, ECF_GS_SET_DEDICATED_SERVER, false, __func__));
 
 	m_Player->freeFuncCall(playCall); m_Player->freeFuncCall(playEndCall);
 }
@@ -728,22 +805,22 @@ void CSteamGameServerPlayingWrapper::LogOn(const char *pszAccountName, const cha
 }
 
 void CSteamGameServerPlayingWrapper::LogOnAnonymous() {
-	CGameServerLogOnAnonymousCall* playCall = dynamic_cast<CGameServerLogOnAnonymousCall*>(m_Player->getNextCall(false, false, ECF_GS_LOG_ON_ANONYMOUS, true, __func__));
-	CGameServerLogOnAnonymousCall* playEndCall = dynamic_cast<CGameServerLogOnAnonymousCall*>(m_Player->getNextCall(false, true, ECF_GS_LOG_ON_ANONYMOUS, false, __func__));
+	CGameServerLogOnAnonymousCall* playCall = static_cast<CGameServerLogOnAnonymousCall*>(m_Player->getNextCall(false, false, ECF_GS_LOG_ON_ANONYMOUS, true, __func__));
+	CGameServerLogOnAnonymousCall* playEndCall = static_cast<CGameServerLogOnAnonymousCall*>(m_Player->getNextCall(false, true, ECF_GS_LOG_ON_ANONYMOUS, false, __func__));
 
 	m_Player->freeFuncCall(playCall); m_Player->freeFuncCall(playEndCall);
 }
 
 void CSteamGameServerPlayingWrapper::LogOff() {
-	CGameServerLogOffCall* playCall = dynamic_cast<CGameServerLogOffCall*>(m_Player->getNextCall(false, false, ECF_GS_LOGOFF, true, __func__));
-	CGameServerLogOffCall* playEndCall = dynamic_cast<CGameServerLogOffCall*>(m_Player->getNextCall(false, true, ECF_GS_LOGOFF, false, __func__));
+	CGameServerLogOffCall* playCall = static_cast<CGameServerLogOffCall*>(m_Player->getNextCall(false, false, ECF_GS_LOGOFF, true, __func__));
+	CGameServerLogOffCall* playEndCall = static_cast<CGameServerLogOffCall*>(m_Player->getNextCall(false, true, ECF_GS_LOGOFF, false, __func__));
 
 	m_Player->freeFuncCall(playCall); m_Player->freeFuncCall(playEndCall);
 }
 
 bool CSteamGameServerPlayingWrapper::BLoggedOn() {
-	CGameServerBLoggedOnCall* playCall = dynamic_cast<CGameServerBLoggedOnCall*>(m_Player->getNextCall(false, false, ECF_GS_BLOGGEDON, true, __func__));
-	CGameServerBLoggedOnCall* playEndCall = dynamic_cast<CGameServerBLoggedOnCall*>(m_Player->getNextCall(false, true, ECF_GS_BLOGGEDON, false, __func__));
+	CGameServerBLoggedOnCall* playCall = static_cast<CGameServerBLoggedOnCall*>(m_Player->getNextCall(false, false, ECF_GS_BLOGGEDON, true, __func__));
+	CGameServerBLoggedOnCall* playEndCall = static_cast<CGameServerBLoggedOnCall*>(m_Player->getNextCall(false, true, ECF_GS_BLOGGEDON, false, __func__));
 
 	bool res = playEndCall->m_Res;
 	m_Player->freeFuncCall(playCall); m_Player->freeFuncCall(playEndCall);
@@ -752,8 +829,8 @@ bool CSteamGameServerPlayingWrapper::BLoggedOn() {
 }
 
 bool CSteamGameServerPlayingWrapper::BSecure() {
-	CGameServerBSecureCall* playCall = dynamic_cast<CGameServerBSecureCall*>(m_Player->getNextCall(false, false, ECF_GS_BSECURE, true, __func__));
-	CGameServerBSecureCall* playEndCall = dynamic_cast<CGameServerBSecureCall*>(m_Player->getNextCall(false, true, ECF_GS_BSECURE, false, __func__));
+	CGameServerBSecureCall* playCall = static_cast<CGameServerBSecureCall*>(m_Player->getNextCall(false, false, ECF_GS_BSECURE, true, __func__));
+	CGameServerBSecureCall* playEndCall = static_cast<CGameServerBSecureCall*>(m_Player->getNextCall(false, true, ECF_GS_BSECURE, false, __func__));
 
 	bool res = playEndCall->m_Res;
 	m_Player->freeFuncCall(playCall); m_Player->freeFuncCall(playEndCall);
@@ -762,8 +839,8 @@ bool CSteamGameServerPlayingWrapper::BSecure() {
 }
 
 CSteamID CSteamGameServerPlayingWrapper::GetSteamID() {
-	CGameServerGetSteamIdCall* playCall = dynamic_cast<CGameServerGetSteamIdCall*>(m_Player->getNextCall(false, false, ECF_GS_GET_STEAM_ID, true, __func__));
-	CGameServerGetSteamIdCall* playEndCall = dynamic_cast<CGameServerGetSteamIdCall*>(m_Player->getNextCall(false, true, ECF_GS_GET_STEAM_ID, false, __func__));
+	CGameServerGetSteamIdCall* playCall = static_cast<CGameServerGetSteamIdCall*>(m_Player->getNextCall(false, false, ECF_GS_GET_STEAM_ID, true, __func__));
+	CGameServerGetSteamIdCall* playEndCall = static_cast<CGameServerGetSteamIdCall*>(m_Player->getNextCall(false, true, ECF_GS_GET_STEAM_ID, false, __func__));
 
 	CSteamID res(playEndCall->m_SteamId);
 	m_Player->freeFuncCall(playCall); m_Player->freeFuncCall(playEndCall);
@@ -772,8 +849,8 @@ CSteamID CSteamGameServerPlayingWrapper::GetSteamID() {
 }
 
 bool CSteamGameServerPlayingWrapper::WasRestartRequested() {
-	CGameServerWasRestartRequestedCall* playCall = dynamic_cast<CGameServerWasRestartRequestedCall*>(m_Player->getNextCall(false, false, ECF_GS_WAS_RESTART_REQUESTED, true, __func__));
-	CGameServerWasRestartRequestedCall* playEndCall = dynamic_cast<CGameServerWasRestartRequestedCall*>(m_Player->getNextCall(false, true, ECF_GS_WAS_RESTART_REQUESTED, false, __func__));
+	CGameServerWasRestartRequestedCall* playCall = static_cast<CGameServerWasRestartRequestedCall*>(m_Player->getNextCall(false, false, ECF_GS_WAS_RESTART_REQUESTED, true, __func__));
+	CGameServerWasRestartRequestedCall* playEndCall = static_cast<CGameServerWasRestartRequestedCall*>(m_Player->getNextCall(false, true, ECF_GS_WAS_RESTART_REQUESTED, false, __func__));
 
 	bool res = playEndCall->m_Result;
 	m_Player->freeFuncCall(playCall); m_Player->freeFuncCall(playEndCall);
@@ -782,41 +859,41 @@ bool CSteamGameServerPlayingWrapper::WasRestartRequested() {
 }
 
 void CSteamGameServerPlayingWrapper::SetMaxPlayerCount(int cPlayersMax) {
-	CGameServerSetMaxPlayersCall* playCall = dynamic_cast<CGameServerSetMaxPlayersCall*>(m_Player->getNextCall(false, false, ECF_GS_SET_MAX_PLAYERS_COUNT, true, __func__));
+	CGameServerSetMaxPlayersCall* playCall = static_cast<CGameServerSetMaxPlayersCall*>(m_Player->getNextCall(false, false, ECF_GS_SET_MAX_PLAYERS_COUNT, true, __func__));
 	CGameServerSetMaxPlayersCall(cPlayersMax).ensureArgsAreEqual(playCall, m_bStrictChecks, __func__);
-	CGameServerSetMaxPlayersCall* playEndCall = dynamic_cast<CGameServerSetMaxPlayersCall*>(m_Player->getNextCall(false, true, ECF_GS_SET_MAX_PLAYERS_COUNT, false, __func__));
+	CGameServerSetMaxPlayersCall* playEndCall = static_cast<CGameServerSetMaxPlayersCall*>(m_Player->getNextCall(false, true, ECF_GS_SET_MAX_PLAYERS_COUNT, false, __func__));
 
 	m_Player->freeFuncCall(playCall); m_Player->freeFuncCall(playEndCall);
 }
 
 void CSteamGameServerPlayingWrapper::SetBotPlayerCount(int cBotplayers) {
-	CGameServerSetBotCountCall* playCall = dynamic_cast<CGameServerSetBotCountCall*>(m_Player->getNextCall(false, false, ECF_GS_SET_BOT_PLAYERS_COUNT, true, __func__));
+	CGameServerSetBotCountCall* playCall = static_cast<CGameServerSetBotCountCall*>(m_Player->getNextCall(false, false, ECF_GS_SET_BOT_PLAYERS_COUNT, true, __func__));
 	CGameServerSetBotCountCall(cBotplayers).ensureArgsAreEqual(playCall, m_bStrictChecks, __func__);
-	CGameServerSetBotCountCall* playEndCall = dynamic_cast<CGameServerSetBotCountCall*>(m_Player->getNextCall(false, true, ECF_GS_SET_BOT_PLAYERS_COUNT, false, __func__));
+	CGameServerSetBotCountCall* playEndCall = static_cast<CGameServerSetBotCountCall*>(m_Player->getNextCall(false, true, ECF_GS_SET_BOT_PLAYERS_COUNT, false, __func__));
 
 	m_Player->freeFuncCall(playCall); m_Player->freeFuncCall(playEndCall);
 }
 
 void CSteamGameServerPlayingWrapper::SetServerName(const char *pszServerName) {
-	CGameServerSetServerNameCall* playCall = dynamic_cast<CGameServerSetServerNameCall*>(m_Player->getNextCall(false, false, ECF_GS_SET_SERVER_NAME, true, __func__));
+	CGameServerSetServerNameCall* playCall = static_cast<CGameServerSetServerNameCall*>(m_Player->getNextCall(false, false, ECF_GS_SET_SERVER_NAME, true, __func__));
 	CGameServerSetServerNameCall(pszServerName).ensureArgsAreEqual(playCall, m_bStrictChecks, __func__);
-	CGameServerSetServerNameCall* playEndCall = dynamic_cast<CGameServerSetServerNameCall*>(m_Player->getNextCall(false, true, ECF_GS_SET_SERVER_NAME, false, __func__));
+	CGameServerSetServerNameCall* playEndCall = static_cast<CGameServerSetServerNameCall*>(m_Player->getNextCall(false, true, ECF_GS_SET_SERVER_NAME, false, __func__));
 
 	m_Player->freeFuncCall(playCall); m_Player->freeFuncCall(playEndCall);
 }
 
 void CSteamGameServerPlayingWrapper::SetMapName(const char *pszMapName) {
-	CGameServerSetMapNameCall* playCall = dynamic_cast<CGameServerSetMapNameCall*>(m_Player->getNextCall(false, false, ECF_GS_SET_MAP_NAME, true, __func__));
+	CGameServerSetMapNameCall* playCall = static_cast<CGameServerSetMapNameCall*>(m_Player->getNextCall(false, false, ECF_GS_SET_MAP_NAME, true, __func__));
 	CGameServerSetMapNameCall(pszMapName).ensureArgsAreEqual(playCall, m_bStrictChecks, __func__);
-	CGameServerSetMapNameCall* playEndCall = dynamic_cast<CGameServerSetMapNameCall*>(m_Player->getNextCall(false, true, ECF_GS_SET_MAP_NAME, false, __func__));
+	CGameServerSetMapNameCall* playEndCall = static_cast<CGameServerSetMapNameCall*>(m_Player->getNextCall(false, true, ECF_GS_SET_MAP_NAME, false, __func__));
 
 	m_Player->freeFuncCall(playCall); m_Player->freeFuncCall(playEndCall);
 }
 
 void CSteamGameServerPlayingWrapper::SetPasswordProtected(bool bPasswordProtected) {
-	CGameServerSetPasswordProtectedCall* playCall = dynamic_cast<CGameServerSetPasswordProtectedCall*>(m_Player->getNextCall(false, false, ECF_GS_SET_PASSWORD_PROTECTED, true, __func__));
+	CGameServerSetPasswordProtectedCall* playCall = static_cast<CGameServerSetPasswordProtectedCall*>(m_Player->getNextCall(false, false, ECF_GS_SET_PASSWORD_PROTECTED, true, __func__));
 	CGameServerSetPasswordProtectedCall(bPasswordProtected).ensureArgsAreEqual(playCall, m_bStrictChecks, __func__);
-	CGameServerSetPasswordProtectedCall* playEndCall = dynamic_cast<CGameServerSetPasswordProtectedCall*>(m_Player->getNextCall(false, true, ECF_GS_SET_PASSWORD_PROTECTED, false, __func__));
+	CGameServerSetPasswordProtectedCall* playEndCall = static_cast<CGameServerSetPasswordProtectedCall*>(m_Player->getNextCall(false, true, ECF_GS_SET_PASSWORD_PROTECTED, false, __func__));
 
 	m_Player->freeFuncCall(playCall); m_Player->freeFuncCall(playEndCall);
 }
@@ -830,16 +907,16 @@ void CSteamGameServerPlayingWrapper::SetSpectatorServerName(const char *pszSpect
 }
 
 void CSteamGameServerPlayingWrapper::ClearAllKeyValues() {
-	CGameServerClearAllKVsCall* playCall = dynamic_cast<CGameServerClearAllKVsCall*>(m_Player->getNextCall(false, false, ECF_GS_CLEAR_ALL_KEY_VALUES, true, __func__));
-	CGameServerClearAllKVsCall* playEndCall = dynamic_cast<CGameServerClearAllKVsCall*>(m_Player->getNextCall(false, true, ECF_GS_CLEAR_ALL_KEY_VALUES, false, __func__));
+	CGameServerClearAllKVsCall* playCall = static_cast<CGameServerClearAllKVsCall*>(m_Player->getNextCall(false, false, ECF_GS_CLEAR_ALL_KEY_VALUES, true, __func__));
+	CGameServerClearAllKVsCall* playEndCall = static_cast<CGameServerClearAllKVsCall*>(m_Player->getNextCall(false, true, ECF_GS_CLEAR_ALL_KEY_VALUES, false, __func__));
 
 	m_Player->freeFuncCall(playCall); m_Player->freeFuncCall(playEndCall);
 }
 
 void CSteamGameServerPlayingWrapper::SetKeyValue(const char *pKey, const char *pValue) {
-	CGameServerSetKeyValueCall* playCall = dynamic_cast<CGameServerSetKeyValueCall*>(m_Player->getNextCall(false, false, ECF_GS_SET_KEY_VALUE, true, __func__));
+	CGameServerSetKeyValueCall* playCall = static_cast<CGameServerSetKeyValueCall*>(m_Player->getNextCall(false, false, ECF_GS_SET_KEY_VALUE, true, __func__));
 	CGameServerSetKeyValueCall(pKey, pValue).ensureArgsAreEqual(playCall, m_bStrictChecks, __func__);
-	CGameServerSetKeyValueCall* playEndCall = dynamic_cast<CGameServerSetKeyValueCall*>(m_Player->getNextCall(false, true, ECF_GS_SET_KEY_VALUE, false, __func__));
+	CGameServerSetKeyValueCall* playEndCall = static_cast<CGameServerSetKeyValueCall*>(m_Player->getNextCall(false, true, ECF_GS_SET_KEY_VALUE, false, __func__));
 
 	m_Player->freeFuncCall(playCall); m_Player->freeFuncCall(playEndCall);
 }
@@ -857,9 +934,9 @@ void CSteamGameServerPlayingWrapper::SetRegion(const char *pszRegion) {
 }
 
 bool CSteamGameServerPlayingWrapper::SendUserConnectAndAuthenticate(uint32 unIPClient, const void *pvAuthBlob, uint32 cubAuthBlobSize, CSteamID *pSteamIDUser) {
-	CGameServerSendUserConnectAndAuthenticateCall* playCall = dynamic_cast<CGameServerSendUserConnectAndAuthenticateCall*>(m_Player->getNextCall(false, false, ECF_GS_SEND_USER_CONNECT_AND_AUTHENTICATE, true, __func__));
+	CGameServerSendUserConnectAndAuthenticateCall* playCall = static_cast<CGameServerSendUserConnectAndAuthenticateCall*>(m_Player->getNextCall(false, false, ECF_GS_SEND_USER_CONNECT_AND_AUTHENTICATE, true, __func__));
 	CGameServerSendUserConnectAndAuthenticateCall(unIPClient, pvAuthBlob, cubAuthBlobSize).ensureArgsAreEqual(playCall, m_bStrictChecks, __func__);
-	CGameServerSendUserConnectAndAuthenticateCall* playEndCall = dynamic_cast<CGameServerSendUserConnectAndAuthenticateCall*>(m_Player->getNextCall(false, true, ECF_GS_SEND_USER_CONNECT_AND_AUTHENTICATE, false, __func__));
+	CGameServerSendUserConnectAndAuthenticateCall* playEndCall = static_cast<CGameServerSendUserConnectAndAuthenticateCall*>(m_Player->getNextCall(false, true, ECF_GS_SEND_USER_CONNECT_AND_AUTHENTICATE, false, __func__));
 
 	bool res = playEndCall->m_Res;
 	*pSteamIDUser = CSteamID(playEndCall->m_OutSteamId);
@@ -869,8 +946,8 @@ bool CSteamGameServerPlayingWrapper::SendUserConnectAndAuthenticate(uint32 unIPC
 }
 
 CSteamID CSteamGameServerPlayingWrapper::CreateUnauthenticatedUserConnection() {
-	CGameServerCreateUnauthUserConnectionCall* playCall = dynamic_cast<CGameServerCreateUnauthUserConnectionCall*>(m_Player->getNextCall(false, false, ECF_GS_CREATE_UNAUTH_USER_CONNECTION, true, __func__));
-	CGameServerCreateUnauthUserConnectionCall* playEndCall = dynamic_cast<CGameServerCreateUnauthUserConnectionCall*>(m_Player->getNextCall(false, true, ECF_GS_CREATE_UNAUTH_USER_CONNECTION, false, __func__));
+	CGameServerCreateUnauthUserConnectionCall* playCall = static_cast<CGameServerCreateUnauthUserConnectionCall*>(m_Player->getNextCall(false, false, ECF_GS_CREATE_UNAUTH_USER_CONNECTION, true, __func__));
+	CGameServerCreateUnauthUserConnectionCall* playEndCall = static_cast<CGameServerCreateUnauthUserConnectionCall*>(m_Player->getNextCall(false, true, ECF_GS_CREATE_UNAUTH_USER_CONNECTION, false, __func__));
 
 	CSteamID res = playEndCall->m_SteamId;
 	m_Player->freeFuncCall(playCall); m_Player->freeFuncCall(playEndCall);
@@ -879,17 +956,17 @@ CSteamID CSteamGameServerPlayingWrapper::CreateUnauthenticatedUserConnection() {
 }
 
 void CSteamGameServerPlayingWrapper::SendUserDisconnect(CSteamID steamIDUser) {
-	CGameServerSendUserDisconnectCall* playCall = dynamic_cast<CGameServerSendUserDisconnectCall*>(m_Player->getNextCall(false, false, ECF_GS_SEND_USER_DISCONNECT, true, __func__));
+	CGameServerSendUserDisconnectCall* playCall = static_cast<CGameServerSendUserDisconnectCall*>(m_Player->getNextCall(false, false, ECF_GS_SEND_USER_DISCONNECT, true, __func__));
 	CGameServerSendUserDisconnectCall(steamIDUser).ensureArgsAreEqual(playCall, m_bStrictChecks, __func__);
-	CGameServerSendUserDisconnectCall* playEndCall = dynamic_cast<CGameServerSendUserDisconnectCall*>(m_Player->getNextCall(false, true, ECF_GS_SEND_USER_DISCONNECT, false, __func__));
+	CGameServerSendUserDisconnectCall* playEndCall = static_cast<CGameServerSendUserDisconnectCall*>(m_Player->getNextCall(false, true, ECF_GS_SEND_USER_DISCONNECT, false, __func__));
 
 	m_Player->freeFuncCall(playCall); m_Player->freeFuncCall(playEndCall);
 }
 
 bool CSteamGameServerPlayingWrapper::BUpdateUserData(CSteamID steamIDUser, const char *pchPlayerName, uint32 uScore) {
-	CGameServerBUpdateUserDataCall* playCall = dynamic_cast<CGameServerBUpdateUserDataCall*>(m_Player->getNextCall(false, false, ECF_GS_BUPDATE_USER_DATA, true, __func__));
+	CGameServerBUpdateUserDataCall* playCall = static_cast<CGameServerBUpdateUserDataCall*>(m_Player->getNextCall(false, false, ECF_GS_BUPDATE_USER_DATA, true, __func__));
 	CGameServerBUpdateUserDataCall(steamIDUser, pchPlayerName, uScore).ensureArgsAreEqual(playCall, m_bStrictChecks, __func__);
-	CGameServerBUpdateUserDataCall* playEndCall = dynamic_cast<CGameServerBUpdateUserDataCall*>(m_Player->getNextCall(false, true, ECF_GS_BUPDATE_USER_DATA, false, __func__));
+	CGameServerBUpdateUserDataCall* playEndCall = static_cast<CGameServerBUpdateUserDataCall*>(m_Player->getNextCall(false, true, ECF_GS_BUPDATE_USER_DATA, false, __func__));
 
 	bool res = playEndCall->m_Res;
 	m_Player->freeFuncCall(playCall); m_Player->freeFuncCall(playEndCall);
@@ -940,9 +1017,9 @@ uint32 CSteamGameServerPlayingWrapper::GetPublicIP() {
 }
 
 bool CSteamGameServerPlayingWrapper::HandleIncomingPacket(const void *pData, int cbData, uint32 srcIP, uint16 srcPort) {
-	CGameServerHandleIncomingPacketCall* playCall = dynamic_cast<CGameServerHandleIncomingPacketCall*>(m_Player->getNextCall(false, false, ECF_GS_HANDLE_INCOMING_PACKET, true, __func__));
+	CGameServerHandleIncomingPacketCall* playCall = static_cast<CGameServerHandleIncomingPacketCall*>(m_Player->getNextCall(false, false, ECF_GS_HANDLE_INCOMING_PACKET, true, __func__));
 	CGameServerHandleIncomingPacketCall(pData, cbData, srcIP, srcPort).ensureArgsAreEqual(playCall, m_bStrictChecks, __func__);
-	CGameServerHandleIncomingPacketCall* playEndCall = dynamic_cast<CGameServerHandleIncomingPacketCall*>(m_Player->getNextCall(false, true, ECF_GS_HANDLE_INCOMING_PACKET, false, __func__));
+	CGameServerHandleIncomingPacketCall* playEndCall = static_cast<CGameServerHandleIncomingPacketCall*>(m_Player->getNextCall(false, true, ECF_GS_HANDLE_INCOMING_PACKET, false, __func__));
 
 	bool res = playEndCall->m_Res;
 	m_Player->freeFuncCall(playCall); m_Player->freeFuncCall(playEndCall);
@@ -951,9 +1028,9 @@ bool CSteamGameServerPlayingWrapper::HandleIncomingPacket(const void *pData, int
 }
 
 int CSteamGameServerPlayingWrapper::GetNextOutgoingPacket(void *pOut, int cbMaxOut, uint32 *pNetAdr, uint16 *pPort) {
-	CGameServerGetNextOutgoingPacketCall* playCall = dynamic_cast<CGameServerGetNextOutgoingPacketCall*>(m_Player->getNextCall(false, false, ECF_GS_GET_NEXT_OUTGOING_PACKET, true, __func__));
+	CGameServerGetNextOutgoingPacketCall* playCall = static_cast<CGameServerGetNextOutgoingPacketCall*>(m_Player->getNextCall(false, false, ECF_GS_GET_NEXT_OUTGOING_PACKET, true, __func__));
 	CGameServerGetNextOutgoingPacketCall(cbMaxOut).ensureArgsAreEqual(playCall, m_bStrictChecks, __func__);
-	CGameServerGetNextOutgoingPacketCall* playEndCall = dynamic_cast<CGameServerGetNextOutgoingPacketCall*>(m_Player->getNextCall(false, true, ECF_GS_GET_NEXT_OUTGOING_PACKET, false, __func__));
+	CGameServerGetNextOutgoingPacketCall* playEndCall = static_cast<CGameServerGetNextOutgoingPacketCall*>(m_Player->getNextCall(false, true, ECF_GS_GET_NEXT_OUTGOING_PACKET, false, __func__));
 
 	int res = playEndCall->m_Result;
 	*pNetAdr = playEndCall->m_Addr;
@@ -965,17 +1042,17 @@ int CSteamGameServerPlayingWrapper::GetNextOutgoingPacket(void *pOut, int cbMaxO
 }
 
 void CSteamGameServerPlayingWrapper::EnableHeartbeats(bool bActive) {
-	CGameServerEnableHeartbeatsCall* playCall = dynamic_cast<CGameServerEnableHeartbeatsCall*>(m_Player->getNextCall(false, false, ECF_GS_ENABLE_HEARTBEATS, true, __func__));
+	CGameServerEnableHeartbeatsCall* playCall = static_cast<CGameServerEnableHeartbeatsCall*>(m_Player->getNextCall(false, false, ECF_GS_ENABLE_HEARTBEATS, true, __func__));
 	CGameServerEnableHeartbeatsCall(bActive).ensureArgsAreEqual(playCall, m_bStrictChecks, __func__);
-	CGameServerEnableHeartbeatsCall* playEndCall = dynamic_cast<CGameServerEnableHeartbeatsCall*>(m_Player->getNextCall(false, true, ECF_GS_ENABLE_HEARTBEATS, false, __func__));
+	CGameServerEnableHeartbeatsCall* playEndCall = static_cast<CGameServerEnableHeartbeatsCall*>(m_Player->getNextCall(false, true, ECF_GS_ENABLE_HEARTBEATS, false, __func__));
 
 	m_Player->freeFuncCall(playCall); m_Player->freeFuncCall(playEndCall);
 }
 
 void CSteamGameServerPlayingWrapper::SetHeartbeatInterval(int iHeartbeatInterval) {
-	CGameServerSetHeartbeatIntervalCall* playCall = dynamic_cast<CGameServerSetHeartbeatIntervalCall*>(m_Player->getNextCall(false, false, ECF_GS_SET_HEARTBEATS_INTERVAL, true, __func__));
+	CGameServerSetHeartbeatIntervalCall* playCall = static_cast<CGameServerSetHeartbeatIntervalCall*>(m_Player->getNextCall(false, false, ECF_GS_SET_HEARTBEATS_INTERVAL, true, __func__));
 	CGameServerSetHeartbeatIntervalCall(iHeartbeatInterval).ensureArgsAreEqual(playCall, m_bStrictChecks, __func__);
-	CGameServerSetHeartbeatIntervalCall* playEndCall = dynamic_cast<CGameServerSetHeartbeatIntervalCall*>(m_Player->getNextCall(false, true, ECF_GS_SET_HEARTBEATS_INTERVAL, false, __func__));
+	CGameServerSetHeartbeatIntervalCall* playEndCall = static_cast<CGameServerSetHeartbeatIntervalCall*>(m_Player->getNextCall(false, true, ECF_GS_SET_HEARTBEATS_INTERVAL, false, __func__));
 
 	m_Player->freeFuncCall(playCall); m_Player->freeFuncCall(playEndCall);
 }
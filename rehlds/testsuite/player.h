@@ -1,8 +1,8 @@
 #pragma once
-#ifdef _WIN32
 
 const int TESTPLAYER_FUNCTREE_DEPTH = 8;
 const int TESTPLAYER_FUNCCALL_MAXSIZE = 17000;
+const int TESTPLAYER_FPS_REPORT_INTERVAL = 10000; // msec
 
 #include "osconfig.h"
 #include "funccalls.h"
@@ -121,6 +121,7 @@ private:
 	std::queue<IEngExtCall*> m_CommandsQueue;
 
 	bool m_bStrictChecks;
+	bool m_bFastPlay;
 
 	SOCKET m_ServerSocket;
 
@@ -138,6 +139,9 @@ private:
 	DWORD m_StartTick;
 	int m_NumFrames;
 
+	DWORD m_ReportTick;
+	int m_ReportFrames;
+
 	hostent_data_t m_CurrentHostentData;
 	struct hostent m_CurrentHostent;
 	void setCurrentHostent(hostent_data_t* data);
@@ -156,11 +160,12 @@ private:
 	int getOrRegisterSteamCallback(CCallbackBase* cb);
 
 	void maybeHeartBeat(int readPos);
+	void maybeReportFps();
 
 public:
 	void* allocFuncCall();
 	void freeFuncCall(void* fcall);
-	CPlayingEngExtInterceptor(const char* fname, bool strictChecks);
+	CPlayingEngExtInterceptor(const char* fname, bool strictChecks, bool fastPlay);
 
 	IEngExtCall* getNextCall(bool peek, bool processCallbacks, ExtCallFuncs expectedOpcode, bool needStart, const char* callSource);
 
@@ -170,6 +175,7 @@ public:
 	virtual int rand();
 
 	virtual void Sleep(DWORD msec);
+#ifdef _WIN32
 	virtual BOOL QueryPerfCounter(LARGE_INTEGER* counter);
 	virtual BOOL QueryPerfFreq(LARGE_INTEGER* freq);
 	virtual DWORD GetTickCount();
@@ -178,6 +184,9 @@ public:
 	virtual void GetTimeZoneInfo(LPTIME_ZONE_INFORMATION zinfo);
 	virtual BOOL GetProcessTimes(HANDLE hProcess, LPFILETIME lpCreationTime, LPFILETIME lpExitTime, LPFILETIME lpKernelTime, LPFILETIME lpUserTime);
 	virtual void GetSystemTimeAsFileTime(LPFILETIME lpSystemTimeAsFileTime);
+#else
+	virtual int clock_gettime(clockid_t clk, struct timespec* ts);
+#endif
 
 
 	virtual SOCKET socket(int af, int type, int protocol);
@@ -185,7 +194,13 @@ public:
 	virtual int setsockopt(SOCKET s, int level, int optname, const char* optval, int optlen);
 	virtual int closesocket(SOCKET s);
 	virtual int recvfrom(SOCKET s, char* buf, int len, int flags, struct sockaddr* from, socklen_t *fromlen);
+#ifndef _WIN32
+	virtual int recvmmsg(SOCKET s, struct mmsghdr* msgvec, unsigned int vlen, int flags, struct timespec* timeout);
+#endif
 	virtual int sendto(SOCKET s, const char* buf, int len, int flags, const struct sockaddr* to, int tolen);
+#ifndef _WIN32
+	virtual int sendmmsg(SOCKET s, struct mmsghdr* msgvec, unsigned int vlen, int flags);
+#endif
 	virtual int bind(SOCKET s, const struct sockaddr* addr, int namelen);
 	virtual int getsockname(SOCKET s, struct sockaddr* name, socklen_t* namelen);
 	virtual int WSAGetLastError();
@@ -205,5 +220,3 @@ public:
 	virtual void SteamGameServer_Shutdown();
 	virtual void SteamAPI_UnregisterCallback(CCallbackBase *pCallback);
 };
-
-#endif //_WIN32
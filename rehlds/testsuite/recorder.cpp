@@ -520,7 +520,7 @@ CRecordingEngExtInterceptor::CRecordingEngExtInterceptor(const char* fname, IReH
 	uint16 versionMinor = TESTSUITE_PROTOCOL_VERSION_MINOR;
 	m_OutStream.write((char*)&versionMinor, 2).write((char*)&versionMajor, 2);
 
-	const char* cmdLine = GetCommandLineA();
+	const char* cmdLine = TestSuite_GetCommandLine();
 	int cmdLineLength = strlen(cmdLine) + 1;
 
 	m_OutStream.write((char*)&cmdLineLength, 4);
@@ -529,6 +529,11 @@ CRecordingEngExtInterceptor::CRecordingEngExtInterceptor(const char* fname, IReH
 
 void CRecordingEngExtInterceptor::writeCall(bool start, bool end, IEngExtCall* fcall)
 {
+#ifndef _WIN32
+	// errno is the recorded WSAGetLastError() here, the stream must not change it
+	int savedErrno = errno;
+#endif
+
 	uint16 opc = fcall->getOpcode();
 	if (start)
 		opc |= (1 << 15);
@@ -544,6 +549,10 @@ void CRecordingEngExtInterceptor::writeCall(bool start, bool end, IEngExtCall* f
 		fcall->writeEpilogue(m_OutStream);
 
 	m_OutStream.flush();
+
+#ifndef _WIN32
+	errno = savedErrno;
+#endif
 }
 
 void CRecordingEngExtInterceptor::PushFunc(CRecorderFuncCall* func)
@@ -636,6 +645,7 @@ void CRecordingEngExtInterceptor::Sleep(DWORD msec)
 	PopFunc(&frec);
 }
 
+#ifdef _WIN32
 BOOL CRecordingEngExtInterceptor::QueryPerfCounter(LARGE_INTEGER* counter)
 {
 	CQueryPerfCounterCall fcall; CRecorderFuncCall frec(&fcall);
@@ -711,6 +721,17 @@ void CRecordingEngExtInterceptor::GetSystemTimeAsFileTime(LPFILETIME lpSystemTim
 	fcall.setResult(lpSystemTimeAsFileTime);
 	PopFunc(&frec);
 }
+#else // _WIN32
+int CRecordingEngExtInterceptor::clock_gettime(clockid_t clk, struct timespec* ts)
+{
+	CClockGetTimeCall fcall(clk); CRecorderFuncCall frec(&fcall);
+	PushFunc(&frec);
+	int res = m_BasePlatform->clock_gettime(clk, ts);
+	fcall.setResult(ts->tv_sec, ts->tv_nsec, res);
+	PopFunc(&frec);
+	return res;
+}
+#endif // _WIN32
 
 SOCKET CRecordingEngExtInterceptor::socket(int af, int type, int protocol)
 {
@@ -762,6 +783,13 @@ int CRecordingEngExtInterceptor::recvfrom(SOCKET s, char* buf, int len, int flag
 	return res;
 }
 
+#ifndef _WIN32
+int CRecordingEngExtInterceptor::recvmmsg(SOCKET s, struct mmsghdr* msgvec, unsigned int vlen, int flags, struct timespec* timeout)
+{
+	return TestSuite_RecvMMsg(this, s, msgvec, vlen, flags);
+}
+#endif // _WIN32
+
 int CRecordingEngExtInterceptor::sendto(SOCKET s, const char* buf, int len, int flags, const struct sockaddr* to, int tolen)
 {
 	CSendToCall fcall(s, buf, len, flags, to, tolen); CRecorderFuncCall frec(&fcall);
@@ -772,6 +800,13 @@ int CRecordingEngExtInterceptor::sendto(SOCKET s, const char* buf, int len, int
 	return res;
 }
 
+#ifndef _WIN32
+int CRecordingEngExtInterceptor::sendmmsg(SOCKET s, struct mmsghdr* msgvec, unsigned int vlen, int flags)
+{
+	return TestSuite_SendMMsg(this, s, msgvec, vlen, flags);
+}
+#endif // _WIN32
+
 int CRecordingEngExtInterceptor::bind(SOCKET s, const struct sockaddr* addr, int namelen)
 {
 	CBindCall fcall(s, addr, namelen); CRecorderFuncCall frec(&fcall);
@@ -1,5 +1,4 @@
 #pragma once
-#ifdef _WIN32
 
 #include "osconfig.h"
 #include "testsuite.h"
@@ -164,6 +163,7 @@ public:
 	virtual int rand();
 
 	virtual void Sleep(DWORD msec);
+#ifdef _WIN32
 	virtual BOOL QueryPerfCounter(LARGE_INTEGER* counter);
 	virtual BOOL QueryPerfFreq(LARGE_INTEGER* freq);
 	virtual DWORD GetTickCount();
@@ -172,13 +172,22 @@ public:
 	virtual void GetTimeZoneInfo(LPTIME_ZONE_INFORMATION zinfo);
 	virtual BOOL GetProcessTimes(HANDLE hProcess, LPFILETIME lpCreationTime, LPFILETIME lpExitTime, LPFILETIME lpKernelTime, LPFILETIME lpUserTime);
 	virtual void GetSystemTimeAsFileTime(LPFILETIME lpSystemTimeAsFileTime);
+#else
+	virtual int clock_gettime(clockid_t clk, struct timespec* ts);
+#endif
 
 	virtual SOCKET socket(int af, int type, int protocol);
 	virtual int ioctlsocket(SOCKET s, long cmd, u_long *argp);
 	virtual int setsockopt(SOCKET s, int level, int optname, const char* optval, int optlen);
 	virtual int closesocket(SOCKET s);
 	virtual int recvfrom(SOCKET s, char* buf, int len, int flags, struct sockaddr* from, socklen_t *fromlen);
+#ifndef _WIN32
+	virtual int recvmmsg(SOCKET s, struct mmsghdr* msgvec, unsigned int vlen, int flags, struct timespec* timeout);
+#endif
 	virtual int sendto(SOCKET s, const char* buf, int len, int flags, const struct sockaddr* to, int tolen);
+#ifndef _WIN32
+	virtual int sendmmsg(SOCKET s, struct mmsghdr* msgvec, unsigned int vlen, int flags);
+#endif
 	virtual int bind(SOCKET s, const struct sockaddr* addr, int namelen);
 	virtual int getsockname(SOCKET s, struct sockaddr* name, socklen_t* namelen);
 	virtual int WSAGetLastError();
@@ -198,4 +207,3 @@ public:
 	virtual void SteamGameServer_Shutdown();
 	virtual void SteamAPI_UnregisterCallback(CCallbackBase *pCallback);
 };
-#endif //_WIN32
\ No newline at end of file
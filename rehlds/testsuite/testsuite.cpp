@@ -1,5 +1,6 @@
 #include "precompiled.h"
 
+#ifdef _WIN32
 
 /* ============================================================================
 								external function hooks
@@ -485,6 +486,77 @@ void TestSuite_InstallCStdHooks(const AddressRef* funcRefs) {
 	}
 }
 
+#endif // _WIN32
+
+const char* TestSuite_GetCommandLine() {
+#ifdef _WIN32
+	return GetCommandLineA();
+#else
+	static char cmdLine[2048];
+	if (cmdLine[0])
+		return cmdLine;
+
+	// NUL separated arguments
+	FILE* fl = fopen("/proc/self/cmdline", "rb");
+	if (!fl)
+		return cmdLine;
+
+	size_t len = fread(cmdLine, 1, sizeof(cmdLine) - 1, fl);
+	fclose(fl);
+
+	for (size_t i = 0; i < len; i++) {
+		if (!cmdLine[i])
+			cmdLine[i] = ' ';
+	}
+
+	while (len > 0 && cmdLine[len - 1] == ' ')
+		len--;
+
+	cmdLine[len] = 0;
+	return cmdLine;
+#endif
+}
+
+#ifndef _WIN32
+// Batched socket calls are passed through the platform one message at a time,
+// recordings then don't depend on net_recvmmsg/net_sendmmsg
+int TestSuite_RecvMMsg(IReHLDSPlatform* platform, SOCKET s, struct mmsghdr* msgvec, unsigned int vlen, int flags) {
+	unsigned int i;
+	for (i = 0; i < vlen; i++) {
+		struct msghdr* hdr = &msgvec[i].msg_hdr;
+		if (hdr->msg_iovlen != 1)
+			rehlds_syserror("%s: scattered messages are not supported", __func__);
+
+		socklen_t fromlen = hdr->msg_namelen;
+		int res = platform->recvfrom(s, (char*)hdr->msg_iov[0].iov_base, (int)hdr->msg_iov[0].iov_len, flags & ~MSG_WAITFORONE, (struct sockaddr*)hdr->msg_name, &fromlen);
+		if (res < 0)
+			break;
+
+		hdr->msg_namelen = fromlen;
+		msgvec[i].msg_len = res;
+	}
+
+	return i ? (int)i : -1;
+}
+
+int TestSuite_SendMMsg(IReHLDSPlatform* platform, SOCKET s, struct mmsghdr* msgvec, unsigned int vlen, int flags) {
+	unsigned int i;
+	for (i = 0; i < vlen; i++) {
+		struct msghdr* hdr = &msgvec[i].msg_hdr;
+		if (hdr->msg_iovlen != 1)
+			rehlds_syserror("%s: scattered messages are not supported", __func__);
+
+		int res = platform->sendto(s, (const char*)hdr->msg_iov[0].iov_base, (int)hdr->msg_iov[0].iov_len, flags, (const struct sockaddr*)hdr->msg_name, hdr->msg_namelen);
+		if (res < 0)
+			break;
+
+		msgvec[i].msg_len = res;
+	}
+
+	return i ? (int)i : -1;
+}
+#endif // _WIN32
+
 void TestSuite_InitAnonymizer(CAnonymizingEngExtInterceptor& a) {
 
 }
@@ -499,14 +571,14 @@ void TestSuite_Init(const Module* engine, const Module* executable, const Addres
 	}
 	else if (g_RehldsRuntimeConfig.testPlayerMode == TPM_PLAY)
 	{
-		CRehldsPlatformHolder::set(new CPlayingEngExtInterceptor(g_RehldsRuntimeConfig.testRecordingFileName, true));
+		CRehldsPlatformHolder::set(new CPlayingEngExtInterceptor(g_RehldsRuntimeConfig.testRecordingFileName, true, g_RehldsRuntimeConfig.testPlayFast));
 		needInstallImportTableHooks = true;
 	}
 	else if (g_RehldsRuntimeConfig.testPlayerMode == TPM_ANONYMIZE)
 	{
 		char fname[260];
 		sprintf(fname, "%s.new", g_RehldsRuntimeConfig.testRecordingFileName);
-		CRehldsPlatformHolder::set(new CPlayingEngExtInterceptor(g_RehldsRuntimeConfig.testRecordingFileName, false));
+		CRehldsPlatformHolder::set(new CPlayingEngExtInterceptor(g_RehldsRuntimeConfig.testRecordingFileName, false, false));
 		auto anonymizer = new CAnonymizingEngExtInterceptor(CRehldsPlatformHolder::get());
 		CRehldsPlatformHolder::set(anonymizer);
 		CRehldsPlatformHolder::set(new CRecordingEngExtInterceptor(fname, CRehldsPlatformHolder::get()));
@@ -514,6 +586,7 @@ void TestSuite_Init(const Module* engine, const Module* executable, const Addres
 		needInstallImportTableHooks = true;
 	}
 
+#ifdef _WIN32
 	if (needInstallImportTableHooks) {
 		if (engine != NULL) {
 			TestSuite_InstallHooks(engine);
@@ -525,5 +598,6 @@ void TestSuite_Init(const Module* engine, const Module* executable, const Addres
 			TestSuite_InstallCStdHooks(funcRefs);
 		}
 	}
+#endif // _WIN32
 }
 
@@ -1,5 +1,4 @@
 #pragma once
-#ifdef _WIN32
 
 #include "osconfig.h"
 #include "memory.h"
@@ -10,9 +9,13 @@
 #include <fstream>
 #include <unordered_map>
 
-const int TESTSUITE_PROTOCOL_VERSION_MINOR = 5;
+const int TESTSUITE_PROTOCOL_VERSION_MINOR = 6;
 const int TESTSUITE_PROTOCOL_VERSION_MAJOR = 0;
 
 void TestSuite_Init(const Module* engine, const Module* executable, const AddressRef* funcRefs);
+const char* TestSuite_GetCommandLine();
 
+#ifndef _WIN32
+int TestSuite_RecvMMsg(IReHLDSPlatform* platform, SOCKET s, struct mmsghdr* msgvec, unsigned int vlen, int flags);
+int TestSuite_SendMMsg(IReHLDSPlatform* platform, SOCKET s, struct mmsghdr* msgvec, unsigned int vlen, int flags);
 #endif
@@ -148,3 +148,58 @@ TEST(BitsWritingReading, MSG, 1000)
 	MSG_EndBitReading(buf);
 
 }
+
+
+static void _WriteBitStream(bf_write_t* bw, uint32* state, int count)
+{
+	for (int i = 0; i < count; i++) {
+		uint32 x = *state = *state * 1103515245 + 12345;
+		int numbits = 1 + (x >> 8) % 32;
+		switch (x >> 28 & 3) {
+		case 0: MSG_WriteSBitsTo(bw, (int)(x >> 4) - (1 << 27), numbits < 2 ? 2 : numbits); break;
+		case 1: MSG_WriteBitStringTo(bw, (x & 1) ? "bit writer" : ""); break;
+		default: MSG_WriteBitsTo(bw, x, numbits); break;
+		}
+	}
+}
+
+TEST(BitWriterContexts, MSG, 1000)
+{
+	byte data[4][4096];
+	sizebuf_t bufs[4];
+
+	for (int i = 0; i < 4; i++) {
+		bufs[i].buffername = "bit writer test";
+		bufs[i].data = data[i];
+		bufs[i].maxsize = sizeof(data[i]);
+		bufs[i].cursize = 0;
+		bufs[i].flags = SIZEBUF_CHECK_OVERFLOW;
+	}
+
+	// two streams written one after another through the writer of the thread
+	uint32 state[2] = { 1, 2 };
+	for (int i = 0; i < 2; i++) {
+		MSG_StartBitWriting(&bufs[i]);
+		_WriteBitStream(MSG_GetBitWriter(), &state[i], 500);
+		MSG_EndBitWriting(&bufs[i]);
+	}
+
+	// the same streams interleaved through two separate writers
+	bf_write_t writers[2];
+	state[0] = 1;
+	state[1] = 2;
+	MSG_StartBitWritingTo(&writers[0], &bufs[2]);
+	MSG_StartBitWritingTo(&writers[1], &bufs[3]);
+	for (int i = 0; i < 500; i++) {
+		_WriteBitStream(&writers[0], &state[0], 1);
+		_WriteBitStream(&writers[1], &state[1], 1);
+	}
+	MSG_EndBitWritingTo(&writers[0]);
+	MSG_EndBitWritingTo(&writers[1]);
+
+	for (int i = 0; i < 2; i++) {
+		CHECK("Bit stream must not overflow", !(bufs[i].flags & SIZEBUF_OVERFLOWED));
+		LONGS_EQUAL("Bit stream size mismatch", bufs[i].cursize, bufs[i + 2].cursize);
+		MEM_EQUAL("Bit stream data mismatch", data[i], data[i + 2], bufs[i].cursize);
+	}
+}
@@ -2,6 +2,8 @@
 #include "rehlds_tests_shared.h"
 #include "cppunitlite/TestHarness.h"
 
+#include <chrono>
+
 #pragma pack(push, 1)
 struct delta_test_struct_t {
 	uint8 b_00;    // 0
@@ -369,3 +371,137 @@ TEST(TestDelta_Test, Delta, 1000) {
 		CHECK(va("TestDelta_Test: returned bitcount %i is not equal to true value %i on iter %i", tested, result[i], i), tested == result[i]);
 	}
 }
+
+#ifdef REHLDS_FIXES
+const int DELTA_BULK_TEST_PAIRS = 64;
+
+// Changes a few random bytes of dst, keeping strings terminated
+NOINLINE void _MutateTestDelta(delta_test_struct_t* dst, int changes) {
+	for (int i = 0; i < changes; i++) {
+		((uint8 *)dst)[rand() % sizeof(delta_test_struct_t)] = rand() & 0xFF;
+	}
+
+	dst->s_24[ARRAYSIZE(dst->s_24) - 1] = 0;
+	dst->s_53[ARRAYSIZE(dst->s_53) - 1] = 0;
+}
+
+NOINLINE uint64 _ScalarMarkedMask(void* src, void* dst, delta_t* delta) {
+	delta_marked_mask_t mask; mask.u64 = 0;
+
+	DELTA_ClearFlags(delta);
+	DELTA_MarkSendFieldsScalar((unsigned char*)src, (unsigned char*)dst, delta);
+	for (int i = 0; i < delta->fieldCount; i++) {
+		if (delta->pdd[i].flags & FDT_MARK)
+			mask.u32[i >> 5] |= (1 << (i & 31));
+	}
+
+	return mask.u64;
+}
+
+TEST(BulkCompare_MatchesScalar, Delta, 5000) {
+	EngineInitializer engInitGuard;
+
+	delta_t* delta = _CreateTestDeltaDesc();
+	const int kernels[] = { DELTABULK_KERNEL_GENERIC, DELTABULK_KERNEL_SSE2, DELTABULK_KERNEL_AVX2 };
+
+	srand(0x5EED);
+	for (int k = 0; k < ARRAYSIZE(kernels); k++) {
+		if (!DELTABulk_IsKernelSupported(kernels[k]))
+			continue;
+
+		g_DeltaBulkKernel = kernels[k];
+		for (int i = 0; i < 2000; i++) {
+			_FillTestDelta(&dst1, 'c');
+			_FillTestDelta(&dst2, 'c');
+			_MutateTestDelta(&dst2, i % 8);
+
+			uint64 expected = _ScalarMarkedMask(&dst1, &dst2, delta);
+			uint64 mask = DELTABulk_Compare(delta, (unsigned char*)&dst1, (unsigned char*)&dst2);
+			CHECK(va("BulkCompare: kernel %d returned mask %llX, expected %llX", kernels[k], mask, expected), mask == expected);
+
+			int expectedBits = DELTA_TestDeltaScalar((unsigned char*)&dst1, (unsigned char*)&dst2, delta);
+			int bits = DELTABulk_TestDelta((unsigned char*)&dst1, (unsigned char*)&dst2, delta);
+			LONGS_EQUAL("BulkCompare: TestDelta bitcount mismatch", expectedBits, bits);
+		}
+	}
+
+	g_DeltaBulkKernel = DELTABULK_KERNEL_AUTO;
+}
+
+// Scalar, JIT and bulk compare kernels, run with REHLDS_TEST_BENCHMARK=1
+TEST(BulkCompare_Benchmark, Delta, 60000) {
+	if (!Tests_BenchmarksEnabled())
+		return;
+
+	EngineInitializer engInitGuard;
+
+	delta_t* delta = _CreateTestDeltaDesc();
+
+	static delta_test_struct_t from[DELTA_BULK_TEST_PAIRS], to[DELTA_BULK_TEST_PAIRS];
+	srand(0xBE7C);
+	for (int i = 0; i < DELTA_BULK_TEST_PAIRS; i++) {
+		_FillTestDelta(&from[i], 'c');
+		_FillTestDelta(&to[i], 'c');
+		_MutateTestDelta(&to[i], i % 4);
+	}
+
+	const int numIterations = 20000;
+	volatile int sink = 0;
+
+	auto bench = [&](const char* name, int kernel, bool useJit, bool useBulk) {
+		g_DeltaBulkKernel = kernel;
+
+		auto start = std::chrono::high_resolution_clock::now();
+		for (int n = 0; n < numIterations; n++) {
+			for (int i = 0; i < DELTA_BULK_TEST_PAIRS; i++) {
+				unsigned char* f = (unsigned char*)&from[i];
+				unsigned char* t = (unsigned char*)&to[i];
+#ifdef REHLDS_JIT
+				if (useJit) {
+					sink += DELTAJit_Fields_Clear_Mark_Check(f, t, delta, NULL);
+					continue;
+				}
+#endif
+				DELTA_ClearFlags(delta);
+				if (useBulk)
+					DELTABulk_MarkSendFields(f, t, delta);
+				else
+					DELTA_MarkSendFieldsScalar(f, t, delta);
+				sink += DELTA_CountSendFields(delta);
+			}
+		}
+		auto mid = std::chrono::high_resolution_clock::now();
+		for (int n = 0; n < numIterations; n++) {
+			for (int i = 0; i < DELTA_BULK_TEST_PAIRS; i++) {
+				unsigned char* f = (unsigned char*)&from[i];
+				unsigned char* t = (unsigned char*)&to[i];
+#ifdef REHLDS_JIT
+				if (useJit) {
+					sink += DELTAJit_TestDelta(f, t, delta);
+					continue;
+				}
+#endif
+				sink += useBulk ? DELTABulk_TestDelta(f, t, delta) : DELTA_TestDeltaScalar(f, t, delta);
+			}
+		}
+		auto end = std::chrono::high_resolution_clock::now();
+
+		double calls = (double)numIterations * DELTA_BULK_TEST_PAIRS;
+		printf("Delta compare: %-8s mark %6.1f ns/call, testdelta %6.1f ns/call\n", name,
+			std::chrono::duration<double, std::nano>(mid - start).count() / calls,
+			std::chrono::duration<double, std::nano>(end - mid).count() / calls);
+	};
+
+	bench("scalar", DELTABULK_KERNEL_AUTO, false, false);
+#ifdef REHLDS_JIT
+	bench("jit", DELTABULK_KERNEL_AUTO, true, false);
+#endif
+	bench("generic", DELTABULK_KERNEL_GENERIC, false, true);
+	if (DELTABulk_IsKernelSupported(DELTABULK_KERNEL_SSE2))
+		bench("sse2", DELTABULK_KERNEL_SSE2, false, true);
+	if (DELTABulk_IsKernelSupported(DELTABULK_KERNEL_AVX2))
+		bench("avx2", DELTABULK_KERNEL_AVX2, false, true);
+
+	g_DeltaBulkKernel = DELTABULK_KERNEL_AUTO;
+}
+#endif // REHLDS_FIXES
@@ -30,3 +30,9 @@ void Tests_ShutdownEngine() {
 
 	SV_Shutdown();
 }
+
+// Benchmarks are skipped, and print nothing, unless REHLDS_TEST_BENCHMARK is set
+bool Tests_BenchmarksEnabled() {
+	const char* env = getenv("REHLDS_TEST_BENCHMARK");
+	return env && env[0] && strcmp(env, "0");
+}
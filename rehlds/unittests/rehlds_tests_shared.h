@@ -5,6 +5,7 @@
 
 extern void Tests_InitEngine();
 extern void Tests_ShutdownEngine();
+extern bool Tests_BenchmarksEnabled();
 
 class EngineInitializer {
 public:
@@ -0,0 +1,560 @@
+#include "precompiled.h"
+#include "rehlds_tests_shared.h"
+#include "cppunitlite/TestHarness.h"
+#include <chrono>
+
+#ifdef REHLDS_FIXES
+
+const int SNAPSHOT_TEST_EDICTS = 1200;
+const int SNAPSHOT_TEST_VISIBLE = 120;
+
+static delta_description_t g_SnapshotTestFields[10];
+static int g_SnapshotTestFrameField;
+
+NOINLINE void _InitSnapshotField(delta_description_t* fieldDesc, int type, const char* name, int off, int bits, float preMult) {
+	fieldDesc->fieldType = type;
+	strcpy(fieldDesc->fieldName, name);
+	fieldDesc->fieldOffset = off;
+	fieldDesc->fieldSize = 1;
+	fieldDesc->significant_bits = bits;
+	fieldDesc->premultiply = preMult;
+	fieldDesc->postmultiply = 1.0f;
+	fieldDesc->flags = 0;
+	memset(&fieldDesc->stats, 0, sizeof(fieldDesc->stats));
+}
+
+// stands in for the game dll's Entity_Encode, modifies the send flags of the delta it was called for
+void _SnapshotTestEncoder(delta_t *pFields, const unsigned char *from, const unsigned char *to) {
+	const entity_state_t* t = (const entity_state_t*)to;
+	if (t->sequence & 1) {
+		DELTA_UnsetFieldByIndex(pFields, g_SnapshotTestFrameField);
+	}
+}
+
+// stands in for the game dll's Player_Encode, the own player of the receiving client is encoded differently
+void _SnapshotTestPlayerEncoder(delta_t *pFields, const unsigned char *from, const unsigned char *to) {
+	const entity_state_t* t = (const entity_state_t*)to;
+	if (t->number - 1 == PF_GetCurrentPlayer()) {
+		DELTA_UnsetFieldByIndex(pFields, g_SnapshotTestFrameField);
+	}
+}
+
+NOINLINE delta_t* _CreateSnapshotTestDelta() {
+	delta_description_t* f = g_SnapshotTestFields;
+
+	_InitSnapshotField(f++, DT_FLOAT | DT_SIGNED, "origin[0]", offsetof(entity_state_t, origin[0]), 24, 8.0f);
+	_InitSnapshotField(f++, DT_FLOAT | DT_SIGNED, "origin[1]", offsetof(entity_state_t, origin[1]), 24, 8.0f);
+	_InitSnapshotField(f++, DT_FLOAT | DT_SIGNED, "origin[2]", offsetof(entity_state_t, origin[2]), 24, 8.0f);
+	_InitSnapshotField(f++, DT_ANGLE, "angles[0]", offsetof(entity_state_t, angles[0]), 16, 1.0f);
+	_InitSnapshotField(f++, DT_ANGLE, "angles[1]", offsetof(entity_state_t, angles[1]), 16, 1.0f);
+	_InitSnapshotField(f++, DT_ANGLE, "angles[2]", offsetof(entity_state_t, angles[2]), 16, 1.0f);
+	_InitSnapshotField(f++, DT_INTEGER, "modelindex", offsetof(entity_state_t, modelindex), 10, 1.0f);
+	_InitSnapshotField(f++, DT_INTEGER, "sequence", offsetof(entity_state_t, sequence), 8, 1.0f);
+	_InitSnapshotField(f++, DT_FLOAT, "frame", offsetof(entity_state_t, frame), 8, 1.0f);
+	_InitSnapshotField(f++, DT_TIMEWINDOW_8, "animtime", offsetof(entity_state_t, animtime), 8, 1.0f);
+
+	delta_t* delta = (delta_t*)Mem_ZeroMalloc(sizeof(delta_t));
+	delta->dynamic = false;
+	delta->fieldCount = ARRAYSIZE(g_SnapshotTestFields);
+	delta->pdd = g_SnapshotTestFields;
+	delta->conditionalencode = _SnapshotTestEncoder;
+
+	delta_info_t* dinfo = (delta_info_t*)Mem_ZeroMalloc(sizeof(delta_info_t));
+	dinfo->delta = delta;
+	dinfo->loadfile = Mem_Strdup("__fake_entity_state_t");
+	dinfo->name = Mem_Strdup("entity_state_t");
+
+	dinfo->next = g_sv_delta;
+	g_sv_delta = dinfo;
+
+#ifdef REHLDS_JIT
+	g_DeltaJitRegistry.CreateAndRegisterDeltaJIT(delta);
+#endif
+
+	g_SnapshotTestFrameField = DELTA_FindFieldIndex(delta, "frame");
+	return delta;
+}
+
+NOINLINE void _SetupSnapshotTestServer(client_t* clients, edict_t* edicts, entity_state_t* baselines) {
+	g_psvs.clients = clients;
+	g_psvs.maxclients = MAX_CLIENTS;
+
+	g_psv.edicts = edicts;
+	g_psv.num_edicts = SNAPSHOT_TEST_EDICTS;
+	g_psv.max_edicts = SNAPSHOT_TEST_EDICTS;
+	g_psv.baselines = baselines;
+	g_psv.instance_baselines = &g_sv_instance_baselines;
+	g_sv_instance_baselines.number = 0;
+
+	for (int i = 0; i < SNAPSHOT_TEST_EDICTS; i++) {
+		baselines[i].number = i;
+		baselines[i].entityType = ENTITY_NORMAL;
+		baselines[i].modelindex = i % 100;
+	}
+
+	for (int i = 0; i < MAX_CLIENTS; i++) {
+		clients[i].delta_sequence = -1;
+	}
+}
+
+// every client sees all players and a window of the other entities
+NOINLINE void _FillSnapshotTestFrame(packet_entities_t* packs, int numPlayers, int frame) {
+	for (int c = 0; c < numPlayers; c++) {
+		packet_entities_t* pack = &packs[c];
+		pack->num_entities = 0;
+
+		int first = MAX_CLIENTS + 1 + c * 27 % (SNAPSHOT_TEST_EDICTS - SNAPSHOT_TEST_VISIBLE - MAX_CLIENTS - 1);
+		for (int e = 1; e < first + SNAPSHOT_TEST_VISIBLE; e++) {
+			if (e > numPlayers && e < first)
+				continue;
+
+			entity_state_t* s = &pack->entities[pack->num_entities++];
+			memset(s, 0, sizeof(*s));
+			s->number = e;
+			s->entityType = ENTITY_NORMAL;
+			s->modelindex = e % 100;
+			s->origin[0] = (float)(e * 3 + frame);
+			s->origin[1] = (float)(e * 7 - frame);
+			s->origin[2] = (float)(e & 31);
+			s->angles[1] = (float)((e * 13 + frame) % 360);
+			s->sequence = (e + frame) & 7;
+			s->frame = (float)((e + frame) & 255);
+			s->animtime = 0.1f * frame;
+		}
+	}
+}
+
+TEST(ParallelSnapshots_MatchSerial, Snapshot, 60000) {
+	EngineInitializer engInitGuard;
+
+	delta_t* delta = _CreateSnapshotTestDelta();
+	g_pentitydelta = g_pplayerdelta = g_pcustomentitydelta = delta;
+
+	client_t* clients = (client_t*)Mem_ZeroMalloc(sizeof(client_t) * MAX_CLIENTS);
+	edict_t* edicts = (edict_t*)Mem_ZeroMalloc(sizeof(edict_t) * SNAPSHOT_TEST_EDICTS);
+	entity_state_t* baselines = (entity_state_t*)Mem_ZeroMalloc(sizeof(entity_state_t) * SNAPSHOT_TEST_EDICTS);
+	_SetupSnapshotTestServer(clients, edicts, baselines);
+
+	packet_entities_t packs[MAX_CLIENTS];
+	for (int i = 0; i < MAX_CLIENTS; i++) {
+		packs[i].entities = (entity_state_t*)Mem_ZeroMalloc(sizeof(entity_state_t) * MAX_PACKET_ENTITIES);
+	}
+
+	static sv_snapshot_t serial[MAX_CLIENTS], parallel[MAX_CLIENTS];
+	const int numFrames = 50;
+	const int playerCounts[] = { 1, 8, 16, 32 };
+
+	sv_rehlds_parallel_snapshots.value = 3.0f;
+
+	for (int p = 0; p < ARRAYSIZE(playerCounts); p++) {
+		int numPlayers = playerCounts[p];
+
+		for (int frame = 0; frame < numFrames; frame++) {
+			_FillSnapshotTestFrame(packs, numPlayers, frame);
+
+			for (int c = 0; c < numPlayers; c++) {
+				sv_snapshot_t* snapshots[] = { &serial[c], &parallel[c] };
+				for (int k = 0; k < 2; k++) {
+					sv_snapshot_t* s = snapshots[k];
+					s->client = &clients[c];
+					s->pack = &packs[c];
+					s->msg.buffername = "Snapshot Test";
+					s->msg.data = s->buf;
+					s->msg.maxsize = sizeof(s->buf);
+					s->msg.cursize = 0;
+					s->msg.flags = SIZEBUF_ALLOW_OVERFLOW;
+				}
+			}
+
+			for (int c = 0; c < numPlayers; c++) {
+				SV_CreatePacketEntities_internal(sv_packet_nodelta, serial[c].client, serial[c].pack, &serial[c].msg);
+			}
+			SV_EmitPacketEntitiesParallel(parallel, numPlayers);
+
+			for (int c = 0; c < numPlayers; c++) {
+				CHECK("Snapshot must not overflow", !(serial[c].msg.flags & SIZEBUF_OVERFLOWED));
+				LONGS_EQUAL("Parallel snapshot size mismatch", serial[c].msg.cursize, parallel[c].msg.cursize);
+				MEM_EQUAL("Parallel snapshot data mismatch", serial[c].buf, parallel[c].buf, serial[c].msg.cursize);
+			}
+		}
+	}
+
+	sv_rehlds_parallel_snapshots.value = 0.0f;
+
+	for (int i = 0; i < MAX_CLIENTS; i++) {
+		Mem_Free(packs[i].entities);
+	}
+
+	Mem_Free(baselines);
+	Mem_Free(edicts);
+	Mem_Free(clients);
+
+	g_psvs.clients = NULL;
+	g_psvs.maxclients = 0;
+	Q_memset(&g_psv, 0, sizeof(g_psv));
+	g_pentitydelta = g_pplayerdelta = g_pcustomentitydelta = NULL;
+}
+
+// Frame time of the snapshots against the player count, run with REHLDS_TEST_BENCHMARK=1
+TEST(ParallelSnapshots_Benchmark, Snapshot, 60000) {
+	if (!Tests_BenchmarksEnabled())
+		return;
+
+	EngineInitializer engInitGuard;
+
+	delta_t* delta = _CreateSnapshotTestDelta();
+	g_pentitydelta = g_pplayerdelta = g_pcustomentitydelta = delta;
+
+	client_t* clients = (client_t*)Mem_ZeroMalloc(sizeof(client_t) * MAX_CLIENTS);
+	edict_t* edicts = (edict_t*)Mem_ZeroMalloc(sizeof(edict_t) * SNAPSHOT_TEST_EDICTS);
+	entity_state_t* baselines = (entity_state_t*)Mem_ZeroMalloc(sizeof(entity_state_t) * SNAPSHOT_TEST_EDICTS);
+	_SetupSnapshotTestServer(clients, edicts, baselines);
+
+	packet_entities_t packs[MAX_CLIENTS];
+	for (int i = 0; i < MAX_CLIENTS; i++) {
+		packs[i].entities = (entity_state_t*)Mem_ZeroMalloc(sizeof(entity_state_t) * MAX_PACKET_ENTITIES);
+	}
+
+	static sv_snapshot_t snapshots[MAX_CLIENTS];
+	const int numFrames = 200;
+	const int playerCounts[] = { 1, 8, 16, 32 };
+	const int threadCounts[] = { 0, 1, 3, 7 };
+
+	for (int p = 0; p < ARRAYSIZE(playerCounts); p++) {
+		int numPlayers = playerCounts[p];
+
+		for (int t = 0; t < ARRAYSIZE(threadCounts); t++) {
+			sv_rehlds_parallel_snapshots.value = (float)threadCounts[t];
+			double frameTime = 0.0;
+
+			for (int frame = 0; frame < numFrames; frame++) {
+				_FillSnapshotTestFrame(packs, numPlayers, frame);
+
+				for (int c = 0; c < numPlayers; c++) {
+					sv_snapshot_t* s = &snapshots[c];
+					s->client = &clients[c];
+					s->pack = &packs[c];
+					s->msg.buffername = "Snapshot Test";
+					s->msg.data = s->buf;
+					s->msg.maxsize = sizeof(s->buf);
+					s->msg.cursize = 0;
+					s->msg.flags = SIZEBUF_ALLOW_OVERFLOW;
+				}
+
+				auto start = std::chrono::high_resolution_clock::now();
+				if (threadCounts[t]) {
+					SV_EmitPacketEntitiesParallel(snapshots, numPlayers);
+				}
+				else {
+					for (int c = 0; c < numPlayers; c++) {
+						SV_CreatePacketEntities_internal(sv_packet_nodelta, snapshots[c].client, snapshots[c].pack, &snapshots[c].msg);
+					}
+				}
+				auto end = std::chrono::high_resolution_clock::now();
+
+				frameTime += std::chrono::duration<double, std::milli>(end - start).count();
+			}
+
+			printf("Snapshots: %2d players, %d visible ents, %d worker threads: %.3f ms/frame\n",
+				numPlayers, SNAPSHOT_TEST_VISIBLE, threadCounts[t], frameTime / numFrames);
+		}
+	}
+
+	sv_rehlds_parallel_snapshots.value = 0.0f;
+
+	for (int i = 0; i < MAX_CLIENTS; i++) {
+		Mem_Free(packs[i].entities);
+	}
+
+	Mem_Free(baselines);
+	Mem_Free(edicts);
+	Mem_Free(clients);
+
+	g_psvs.clients = NULL;
+	g_psvs.maxclients = 0;
+	Q_memset(&g_psv, 0, sizeof(g_psv));
+	g_pentitydelta = g_pplayerdelta = g_pcustomentitydelta = NULL;
+}
+
+TEST(ParallelSnapshots_CurrentPlayer, Snapshot, 60000) {
+	EngineInitializer engInitGuard;
+
+	delta_t* delta = _CreateSnapshotTestDelta();
+	delta->conditionalencode = _SnapshotTestPlayerEncoder;
+	g_pentitydelta = g_pplayerdelta = g_pcustomentitydelta = delta;
+
+	client_t* clients = (client_t*)Mem_ZeroMalloc(sizeof(client_t) * MAX_CLIENTS);
+	edict_t* edicts = (edict_t*)Mem_ZeroMalloc(sizeof(edict_t) * SNAPSHOT_TEST_EDICTS);
+	entity_state_t* baselines = (entity_state_t*)Mem_ZeroMalloc(sizeof(entity_state_t) * SNAPSHOT_TEST_EDICTS);
+	_SetupSnapshotTestServer(clients, edicts, baselines);
+
+	packet_entities_t packs[MAX_CLIENTS];
+	for (int i = 0; i < MAX_CLIENTS; i++) {
+		packs[i].entities = (entity_state_t*)Mem_ZeroMalloc(sizeof(entity_state_t) * MAX_PACKET_ENTITIES);
+	}
+
+	static sv_snapshot_t serial[MAX_CLIENTS], parallel[MAX_CLIENTS];
+	const int numFrames = 5;
+	const int numPlayers = 16;
+
+	for (int frame = 0; frame < numFrames; frame++) {
+		_FillSnapshotTestFrame(packs, numPlayers, frame);
+
+		for (int c = 0; c < numPlayers; c++) {
+			sv_snapshot_t* snapshots[] = { &serial[c], &parallel[c] };
+			for (int k = 0; k < 2; k++) {
+				sv_snapshot_t* s = snapshots[k];
+				s->client = &clients[c];
+				s->pack = &packs[c];
+				s->msg.buffername = "Current Player Test";
+				s->msg.data = s->buf;
+				s->msg.maxsize = sizeof(s->buf);
+				s->msg.cursize = 0;
+				s->msg.flags = SIZEBUF_ALLOW_OVERFLOW;
+			}
+		}
+
+		for (int c = 0; c < numPlayers; c++) {
+			host_client = &clients[c];
+			SV_CreatePacketEntities_internal(sv_packet_nodelta, serial[c].client, serial[c].pack, &serial[c].msg);
+		}
+
+		// left at the last client by the serial part of the frame, as in SV_SendClientDatagramsParallel
+		sv_rehlds_parallel_snapshots.value = 3.0f;
+		SV_EmitPacketEntitiesParallel(parallel, numPlayers);
+		sv_rehlds_parallel_snapshots.value = 0.0f;
+
+		for (int c = 0; c < numPlayers; c++) {
+			LONGS_EQUAL("Parallel snapshot size mismatch", serial[c].msg.cursize, parallel[c].msg.cursize);
+			MEM_EQUAL("Parallel snapshot data mismatch", serial[c].buf, parallel[c].buf, serial[c].msg.cursize);
+		}
+	}
+
+	SV_ShutdownSnapshotWorkers();
+	host_client = NULL;
+
+	for (int i = 0; i < MAX_CLIENTS; i++) {
+		Mem_Free(packs[i].entities);
+	}
+
+	Mem_Free(baselines);
+	Mem_Free(edicts);
+	Mem_Free(clients);
+
+	g_psvs.clients = NULL;
+	g_psvs.maxclients = 0;
+	Q_memset(&g_psv, 0, sizeof(g_psv));
+	g_pentitydelta = g_pplayerdelta = g_pcustomentitydelta = NULL;
+}
+
+TEST(DeltaCache_MatchesEncoder, Snapshot, 60000) {
+	EngineInitializer engInitGuard;
+
+	delta_t* delta = _CreateSnapshotTestDelta();
+	g_pentitydelta = g_pplayerdelta = g_pcustomentitydelta = delta;
+
+	client_t* clients = (client_t*)Mem_ZeroMalloc(sizeof(client_t) * MAX_CLIENTS);
+	edict_t* edicts = (edict_t*)Mem_ZeroMalloc(sizeof(edict_t) * SNAPSHOT_TEST_EDICTS);
+	entity_state_t* baselines = (entity_state_t*)Mem_ZeroMalloc(sizeof(entity_state_t) * SNAPSHOT_TEST_EDICTS);
+	_SetupSnapshotTestServer(clients, edicts, baselines);
+
+	packet_entities_t packs[MAX_CLIENTS];
+	for (int i = 0; i < MAX_CLIENTS; i++) {
+		packs[i].entities = (entity_state_t*)Mem_ZeroMalloc(sizeof(entity_state_t) * MAX_PACKET_ENTITIES);
+	}
+
+	static sv_snapshot_t plain[MAX_CLIENTS], cached[MAX_CLIENTS], parallel[MAX_CLIENTS];
+	const int numFrames = 20;
+	const int numPlayers = 32;
+
+	for (int frame = 0; frame < numFrames; frame++) {
+		_FillSnapshotTestFrame(packs, numPlayers, frame);
+
+		for (int c = 0; c < numPlayers; c++) {
+			sv_snapshot_t* snapshots[] = { &plain[c], &cached[c], &parallel[c] };
+			for (int k = 0; k < ARRAYSIZE(snapshots); k++) {
+				sv_snapshot_t* s = snapshots[k];
+				s->client = &clients[c];
+				s->pack = &packs[c];
+				s->msg.buffername = "Delta Cache Test";
+				s->msg.data = s->buf;
+				s->msg.maxsize = sizeof(s->buf);
+				s->msg.cursize = 0;
+				s->msg.flags = SIZEBUF_ALLOW_OVERFLOW;
+			}
+		}
+
+		sv_rehlds_delta_cache.value = 0.0f;
+		SV_ClearDeltaCache();
+
+		for (int c = 0; c < numPlayers; c++) {
+			SV_CreatePacketEntities_internal(sv_packet_nodelta, plain[c].client, plain[c].pack, &plain[c].msg);
+		}
+
+		sv_rehlds_delta_cache.value = 1.0f;
+		SV_ClearDeltaCache();
+
+		for (int c = 0; c < numPlayers; c++) {
+			SV_CreatePacketEntities_internal(sv_packet_nodelta, cached[c].client, cached[c].pack, &cached[c].msg);
+		}
+
+		// the workers share the entries written above
+		sv_rehlds_parallel_snapshots.value = 3.0f;
+		SV_EmitPacketEntitiesParallel(parallel, numPlayers);
+		sv_rehlds_parallel_snapshots.value = 0.0f;
+
+		for (int c = 0; c < numPlayers; c++) {
+			LONGS_EQUAL("Cached snapshot size mismatch", plain[c].msg.cursize, cached[c].msg.cursize);
+			MEM_EQUAL("Cached snapshot data mismatch", plain[c].buf, cached[c].buf, plain[c].msg.cursize);
+			LONGS_EQUAL("Parallel cached snapshot size mismatch", plain[c].msg.cursize, parallel[c].msg.cursize);
+			MEM_EQUAL("Parallel cached snapshot data mismatch", plain[c].buf, parallel[c].buf, plain[c].msg.cursize);
+		}
+	}
+
+	CHECK("Delta cache must be hit", delta->cachehits > 0);
+
+	sv_rehlds_delta_cache.value = 0.0f;
+	SV_FreeDeltaCache();
+	SV_ShutdownSnapshotWorkers();
+
+	for (int i = 0; i < MAX_CLIENTS; i++) {
+		Mem_Free(packs[i].entities);
+	}
+
+	Mem_Free(baselines);
+	Mem_Free(edicts);
+	Mem_Free(clients);
+
+	g_psvs.clients = NULL;
+	g_psvs.maxclients = 0;
+	Q_memset(&g_psv, 0, sizeof(g_psv));
+	g_pentitydelta = g_pplayerdelta = g_pcustomentitydelta = NULL;
+}
+
+TEST(DeltaCache_CurrentPlayer, Snapshot, 60000) {
+	EngineInitializer engInitGuard;
+
+	delta_t* delta = _CreateSnapshotTestDelta();
+	delta->conditionalencode = _SnapshotTestPlayerEncoder;
+	g_pentitydelta = g_pplayerdelta = g_pcustomentitydelta = delta;
+
+	client_t* clients = (client_t*)Mem_ZeroMalloc(sizeof(client_t) * MAX_CLIENTS);
+	edict_t* edicts = (edict_t*)Mem_ZeroMalloc(sizeof(edict_t) * SNAPSHOT_TEST_EDICTS);
+	entity_state_t* baselines = (entity_state_t*)Mem_ZeroMalloc(sizeof(entity_state_t) * SNAPSHOT_TEST_EDICTS);
+	_SetupSnapshotTestServer(clients, edicts, baselines);
+
+	packet_entities_t packs[MAX_CLIENTS];
+	for (int i = 0; i < MAX_CLIENTS; i++) {
+		packs[i].entities = (entity_state_t*)Mem_ZeroMalloc(sizeof(entity_state_t) * MAX_PACKET_ENTITIES);
+	}
+
+	static sv_snapshot_t plain[MAX_CLIENTS], cached[MAX_CLIENTS];
+	const int numFrames = 5;
+	const int numPlayers = 16;
+
+	for (int frame = 0; frame < numFrames; frame++) {
+		_FillSnapshotTestFrame(packs, numPlayers, frame);
+
+		for (int c = 0; c < numPlayers; c++) {
+			sv_snapshot_t* snapshots[] = { &plain[c], &cached[c] };
+			for (int k = 0; k < ARRAYSIZE(snapshots); k++) {
+				sv_snapshot_t* s = snapshots[k];
+				s->client = &clients[c];
+				s->pack = &packs[c];
+				s->msg.buffername = "Delta Cache Test";
+				s->msg.data = s->buf;
+				s->msg.maxsize = sizeof(s->buf);
+				s->msg.cursize = 0;
+				s->msg.flags = SIZEBUF_ALLOW_OVERFLOW;
+			}
+		}
+
+		sv_rehlds_delta_cache.value = 0.0f;
+		SV_ClearDeltaCache();
+
+		for (int c = 0; c < numPlayers; c++) {
+			host_client = &clients[c];
+			SV_CreatePacketEntities_internal(sv_packet_nodelta, plain[c].client, plain[c].pack, &plain[c].msg);
+		}
+
+		sv_rehlds_delta_cache.value = 1.0f;
+		SV_ClearDeltaCache();
+
+		for (int c = 0; c < numPlayers; c++) {
+			host_client = &clients[c];
+			SV_CreatePacketEntities_internal(sv_packet_nodelta, cached[c].client, cached[c].pack, &cached[c].msg);
+		}
+
+		for (int c = 0; c < numPlayers; c++) {
+			LONGS_EQUAL("Cached snapshot size mismatch", plain[c].msg.cursize, cached[c].msg.cursize);
+			MEM_EQUAL("Cached snapshot data mismatch", plain[c].buf, cached[c].buf, plain[c].msg.cursize);
+		}
+	}
+
+	sv_rehlds_delta_cache.value = 0.0f;
+	SV_FreeDeltaCache();
+	host_client = NULL;
+
+	for (int i = 0; i < MAX_CLIENTS; i++) {
+		Mem_Free(packs[i].entities);
+	}
+
+	Mem_Free(baselines);
+	Mem_Free(edicts);
+	Mem_Free(clients);
+
+	g_psvs.clients = NULL;
+	g_psvs.maxclients = 0;
+	Q_memset(&g_psv, 0, sizeof(g_psv));
+	g_pentitydelta = g_pplayerdelta = g_pcustomentitydelta = NULL;
+}
+
+struct workerpool_test_t {
+	std::atomic<int> hits[64];
+	std::atomic<int> lateHits;
+	std::atomic<bool> returned;
+};
+
+void _WorkerPoolTestJob(int index, int worker, void *ctx) {
+	workerpool_test_t* t = (workerpool_test_t*)ctx;
+	std::this_thread::sleep_for(std::chrono::microseconds(200));
+	if (t->returned)
+		t->lateHits++;
+	t->hits[index]++;
+}
+
+// restarting the pool between runs must not replay the previous run on the new threads
+TEST(WorkerPool_Restart, Snapshot, 60000) {
+	static workerpool_test_t runs[2];
+	const int threadCounts[] = { 2, 3, 1, 4, 0, 2 };
+	const int numJobs = 64;
+
+	CWorkerPool pool;
+	for (int i = 0; i < ARRAYSIZE(threadCounts) * 4; i++) {
+		workerpool_test_t* t = &runs[i & 1];
+		for (int j = 0; j < numJobs; j++) {
+			t->hits[j] = 0;
+		}
+		t->lateHits = 0;
+		t->returned = false;
+
+		pool.Start(threadCounts[i % ARRAYSIZE(threadCounts)]);
+		pool.Run(numJobs, _WorkerPoolTestJob, t);
+		t->returned = true;
+
+		for (int j = 0; j < numJobs; j++) {
+			LONGS_EQUAL("Every job must run exactly once", 1, (int)t->hits[j]);
+		}
+	}
+
+	pool.Stop();
+
+	for (int k = 0; k < 2; k++) {
+		LONGS_EQUAL("No job may run after Run() returned", 0, (int)runs[k].lateHits);
+		for (int j = 0; j < numJobs; j++) {
+			LONGS_EQUAL("No job may run twice", 1, (int)runs[k].hits[j]);
+		}
+	}
+}
+
+#endif // REHLDS_FIXES
@@ -0,0 +1,602 @@
+#include "precompiled.h"
+#include "rehlds_tests_shared.h"
+#include "cppunitlite/TestHarness.h"
+
+#include <chrono>
+
+#ifdef REHLDS_FIXES
+
+const int WORLD_TEST_EDICTS = 1500;
+const int WORLD_TEST_TRACES = 4000;
+const float WORLD_TEST_SIZE = 4096.0f;
+
+static uint32 g_WorldTestSeed;
+
+static float _WorldTestRandom(float lo, float hi) {
+	g_WorldTestSeed = g_WorldTestSeed * 1103515245 + 12345;
+	return lo + (hi - lo) * ((g_WorldTestSeed >> 8) & 0xFFFF) / 65535.0f;
+}
+
+// stands in for the game dll's SetAbsBox
+void _WorldTestSetAbsBox(edict_t *ent) {
+	VectorAdd(ent->v.origin, ent->v.mins, ent->v.absmin);
+	VectorAdd(ent->v.origin, ent->v.maxs, ent->v.absmax);
+}
+
+NOINLINE void _PlaceWorldTestEdict(edict_t *ent, int num) {
+	float size = (num % 10) ? 16.0f : 64.0f;
+
+	ent->v.origin[0] = _WorldTestRandom(-WORLD_TEST_SIZE, WORLD_TEST_SIZE);
+	ent->v.origin[1] = _WorldTestRandom(-WORLD_TEST_SIZE, WORLD_TEST_SIZE);
+	ent->v.origin[2] = _WorldTestRandom(-512.0f, 512.0f);
+
+	for (int j = 0; j < 3; j++) {
+		ent->v.mins[j] = -size;
+		ent->v.maxs[j] = size;
+	}
+	ent->v.solid = (num % 7) ? SOLID_BBOX : SOLID_SLIDEBOX;
+	ent->v.flags = (num % 3) ? 0 : FL_MONSTER;
+}
+
+NOINLINE void _RunWorldTestTrace(const vec_t *start, const vec_t *end, const vec_t *mins, const vec_t *maxs, int type, edict_t *passedict, trace_t *out) {
+	moveclip_t clip;
+	Q_memset(&clip, 0, sizeof(clip));
+
+	clip.trace.fraction = 1.0f;
+	VectorCopy(end, clip.trace.endpos);
+	clip.start = start;
+	clip.end = end;
+	clip.type = type;
+	clip.passedict = passedict;
+	clip.mins = mins;
+	clip.maxs = maxs;
+	VectorCopy(mins, clip.mins2);
+	VectorCopy(maxs, clip.maxs2);
+
+	SV_MoveBounds(start, clip.mins2, clip.maxs2, end, clip.boxmins, clip.boxmaxs);
+	SV_ClipToLinks(sv_areanodes, &clip);
+
+	*out = clip.trace;
+}
+
+typedef struct world_test_trace_s {
+	vec3_t start, end, mins, maxs;
+	int type;
+	int pass;
+} world_test_trace_t;
+
+NOINLINE void _MakeWorldTestTraces(world_test_trace_t *traces) {
+	for (int i = 0; i < WORLD_TEST_TRACES; i++) {
+		world_test_trace_t *t = &traces[i];
+		float len = (i % 4) ? 256.0f : 2048.0f;
+
+		for (int j = 0; j < 3; j++) {
+			t->start[j] = _WorldTestRandom(-WORLD_TEST_SIZE, WORLD_TEST_SIZE);
+			t->end[j] = t->start[j] + _WorldTestRandom(-len, len);
+		}
+
+		t->start[2] = _WorldTestRandom(-512.0f, 512.0f);
+		t->end[2] = t->start[2] + _WorldTestRandom(-64.0f, 64.0f);
+
+		for (int j = 0; j < 3; j++) {
+			t->mins[j] = (i % 3) ? -16.0f : 0.0f;
+			t->maxs[j] = (i % 3) ? 16.0f : 0.0f;
+		}
+
+		t->type = (i % 5 == 0) ? MOVE_NOMONSTERS : MOVE_NORMAL;
+		t->pass = 1 + i % (WORLD_TEST_EDICTS - 1);
+	}
+}
+
+TEST(TraceIndex_MatchesLinks, World, 60000) {
+	EngineInitializer engInitGuard;
+
+	static model_t worldmodel;
+	for (int j = 0; j < 3; j++) {
+		worldmodel.mins[j] = -WORLD_TEST_SIZE;
+		worldmodel.maxs[j] = WORLD_TEST_SIZE;
+	}
+
+	edict_t *edicts = (edict_t *)Mem_ZeroMalloc(sizeof(edict_t) * WORLD_TEST_EDICTS);
+	world_test_trace_t *traces = (world_test_trace_t *)Mem_ZeroMalloc(sizeof(world_test_trace_t) * WORLD_TEST_TRACES);
+	trace_t *indexed = (trace_t *)Mem_ZeroMalloc(sizeof(trace_t) * WORLD_TEST_TRACES);
+
+	g_psv.worldmodel = &worldmodel;
+	g_psv.edicts = edicts;
+	g_psv.num_edicts = WORLD_TEST_EDICTS;
+	g_psv.max_edicts = WORLD_TEST_EDICTS;
+	gEntityInterface.pfnSetAbsBox = _WorldTestSetAbsBox;
+	gNewDLLFunctions.pfnShouldCollide = nullptr;
+	g_WorldTestSeed = 1;
+
+	SV_ClearWorld();
+	sv_rehlds_trace_index.value = 1.0f;
+
+	for (int i = 1; i < WORLD_TEST_EDICTS; i++) {
+		_PlaceWorldTestEdict(&edicts[i], i);
+		SV_LinkEdict(&edicts[i], FALSE);
+	}
+
+	_MakeWorldTestTraces(traces);
+
+	double linksTime = 0.0, indexTime = 0.0;
+	const int numRounds = 8;
+
+	for (int round = 0; round < numRounds; round++) {
+		// move some of the edicts around so the index has to follow the links
+		if (round) {
+			for (int i = 1; i < WORLD_TEST_EDICTS; i++) {
+				if ((i + round) % 3)
+					continue;
+
+				if ((i + round) % 11 == 0) {
+					SV_UnlinkEdict(&edicts[i]);
+					continue;
+				}
+
+				_PlaceWorldTestEdict(&edicts[i], i);
+				SV_LinkEdict(&edicts[i], FALSE);
+			}
+		}
+
+		sv_rehlds_trace_index.value = 1.0f;
+		auto start = std::chrono::high_resolution_clock::now();
+		for (int i = 0; i < WORLD_TEST_TRACES; i++) {
+			world_test_trace_t *t = &traces[i];
+			_RunWorldTestTrace(t->start, t->end, t->mins, t->maxs, t->type, &edicts[t->pass], &indexed[i]);
+		}
+		indexTime += std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+
+		sv_rehlds_trace_index.value = 0.0f;
+		start = std::chrono::high_resolution_clock::now();
+		for (int i = 0; i < WORLD_TEST_TRACES; i++) {
+			world_test_trace_t *t = &traces[i];
+			trace_t linked;
+			_RunWorldTestTrace(t->start, t->end, t->mins, t->maxs, t->type, &edicts[t->pass], &linked);
+
+			LONGS_EQUAL("allsolid mismatch", linked.allsolid, indexed[i].allsolid);
+			LONGS_EQUAL("startsolid mismatch", linked.startsolid, indexed[i].startsolid);
+			CHECK("Hit entity mismatch", linked.ent == indexed[i].ent);
+			MEM_EQUAL("Fraction mismatch", &linked.fraction, &indexed[i].fraction, sizeof(float));
+			MEM_EQUAL("Endpos mismatch", linked.endpos, indexed[i].endpos, sizeof(vec3_t));
+		}
+		linksTime += std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+	}
+
+	// run with REHLDS_TEST_BENCHMARK=1
+	if (Tests_BenchmarksEnabled()) {
+		printf("Traces: %d edicts, %d traces/round: links %.3f ms/round, index %.3f ms/round\n",
+			WORLD_TEST_EDICTS - 1, WORLD_TEST_TRACES, linksTime / numRounds, indexTime / numRounds);
+	}
+
+	// bounds written without a relink, the next frame has to stop using the index
+	for (int i = 1; i < WORLD_TEST_EDICTS; i += 5) {
+		for (int j = 0; j < 3; j++) {
+			edicts[i].v.absmin[j] += 24.0f;
+			edicts[i].v.absmax[j] += 24.0f;
+		}
+	}
+
+	g_psv.time = 1.0;
+	sv_rehlds_trace_index.value = 1.0f;
+	for (int i = 0; i < WORLD_TEST_TRACES; i++) {
+		world_test_trace_t *t = &traces[i];
+		_RunWorldTestTrace(t->start, t->end, t->mins, t->maxs, t->type, &edicts[t->pass], &indexed[i]);
+	}
+
+	CHECK("Index used after the bounds changed", !SV_AreaIndexUsable());
+
+	sv_rehlds_trace_index.value = 0.0f;
+	for (int i = 0; i < WORLD_TEST_TRACES; i++) {
+		world_test_trace_t *t = &traces[i];
+		trace_t linked;
+		_RunWorldTestTrace(t->start, t->end, t->mins, t->maxs, t->type, &edicts[t->pass], &linked);
+
+		CHECK("Hit entity mismatch", linked.ent == indexed[i].ent);
+		MEM_EQUAL("Fraction mismatch", &linked.fraction, &indexed[i].fraction, sizeof(float));
+	}
+
+	sv_rehlds_trace_index.value = 0.0f;
+	gEntityInterface.pfnSetAbsBox = nullptr;
+
+	Mem_Free(indexed);
+	Mem_Free(traces);
+	Mem_Free(edicts);
+
+	Q_memset(&g_psv, 0, sizeof(g_psv));
+}
+
+const int SPHERE_TEST_QUERIES = 1000;
+
+typedef struct sphere_test_query_s {
+	vec3_t org;
+	float rad;
+} sphere_test_query_t;
+
+// Walks FindEntityInSphere the way game dlls do, returns the number of entities found and a hash of them
+NOINLINE int _RunSphereTestQuery(const sphere_test_query_t *q, uint32 *hash) {
+	int count = 0;
+	edict_t *ent = nullptr;
+
+	*hash = 2166136261u;
+	while (true) {
+		ent = FindEntityInSphere(ent, q->org, q->rad);
+		if (ent == g_psv.edicts)
+			break;
+
+		*hash = (*hash ^ (ent - g_psv.edicts)) * 16777619u;
+		count++;
+	}
+
+	return count;
+}
+
+TEST(SphereIndex_MatchesScan, World, 60000) {
+	EngineInitializer engInitGuard;
+
+	static model_t worldmodel;
+	for (int j = 0; j < 3; j++) {
+		worldmodel.mins[j] = -WORLD_TEST_SIZE;
+		worldmodel.maxs[j] = WORLD_TEST_SIZE;
+	}
+
+	edict_t *edicts = (edict_t *)Mem_ZeroMalloc(sizeof(edict_t) * WORLD_TEST_EDICTS);
+	sphere_test_query_t *queries = (sphere_test_query_t *)Mem_ZeroMalloc(sizeof(sphere_test_query_t) * SPHERE_TEST_QUERIES);
+	int indexedCount[SPHERE_TEST_QUERIES];
+	uint32 indexedHash[SPHERE_TEST_QUERIES];
+
+	int maxclients = g_psvs.maxclients;
+	g_psvs.maxclients = 0;
+	g_psv.worldmodel = &worldmodel;
+	g_psv.edicts = edicts;
+	g_psv.num_edicts = WORLD_TEST_EDICTS;
+	g_psv.max_edicts = WORLD_TEST_EDICTS;
+	gEntityInterface.pfnSetAbsBox = _WorldTestSetAbsBox;
+	g_WorldTestSeed = 2;
+
+	SV_ClearWorld();
+
+	for (int i = 1; i < WORLD_TEST_EDICTS; i++) {
+		_PlaceWorldTestEdict(&edicts[i], i);
+		edicts[i].v.classname = 1;
+
+		// a few big brush entities and a few never linked ones
+		if (i % 97 == 0) {
+			for (int j = 0; j < 2; j++) {
+				edicts[i].v.mins[j] = -2048.0f;
+				edicts[i].v.maxs[j] = 2048.0f;
+			}
+		}
+
+		if (i % 50 != 0)
+			SV_LinkEdict(&edicts[i], FALSE);
+	}
+
+	for (int i = 0; i < SPHERE_TEST_QUERIES; i++) {
+		for (int j = 0; j < 3; j++)
+			queries[i].org[j] = _WorldTestRandom(-WORLD_TEST_SIZE, WORLD_TEST_SIZE);
+
+		queries[i].org[2] = _WorldTestRandom(-512.0f, 512.0f);
+		queries[i].rad = (i % 4) ? _WorldTestRandom(32.0f, 400.0f) : _WorldTestRandom(400.0f, 1200.0f);
+	}
+
+	double scanTime = 0.0, indexTime = 0.0;
+	const int numRounds = 4;
+
+	for (int round = 0; round < numRounds; round++) {
+		// move and free some of the edicts so the grid has to follow
+		if (round) {
+			for (int i = 1; i < WORLD_TEST_EDICTS; i++) {
+				if ((i + round) % 4)
+					continue;
+
+				if ((i + round) % 13 == 0) {
+					edicts[i].free = !edicts[i].free;
+					continue;
+				}
+
+				_PlaceWorldTestEdict(&edicts[i], i);
+				SV_LinkEdict(&edicts[i], FALSE);
+			}
+		}
+
+		sv_rehlds_sphere_index.value = 1.0f;
+		auto start = std::chrono::high_resolution_clock::now();
+		for (int i = 0; i < SPHERE_TEST_QUERIES; i++)
+			indexedCount[i] = _RunSphereTestQuery(&queries[i], &indexedHash[i]);
+		indexTime += std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+
+		sv_rehlds_sphere_index.value = 0.0f;
+		start = std::chrono::high_resolution_clock::now();
+		for (int i = 0; i < SPHERE_TEST_QUERIES; i++) {
+			uint32 hash;
+			int count = _RunSphereTestQuery(&queries[i], &hash);
+
+			LONGS_EQUAL("Found count mismatch", count, indexedCount[i]);
+			LONGS_EQUAL("Found entities mismatch", hash, indexedHash[i]);
+		}
+		scanTime += std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+	}
+
+	// run with REHLDS_TEST_BENCHMARK=1
+	if (Tests_BenchmarksEnabled()) {
+		printf("Spheres: %d edicts, %d queries/round: scan %.3f ms/round, grid %.3f ms/round\n",
+			WORLD_TEST_EDICTS - 1, SPHERE_TEST_QUERIES, scanTime / numRounds, indexTime / numRounds);
+	}
+
+	// bounds written without a relink, the next frame has to fall back to the scan
+	for (int i = 1; i < WORLD_TEST_EDICTS; i += 5) {
+		for (int j = 0; j < 2; j++) {
+			edicts[i].v.absmin[j] += 300.0f;
+			edicts[i].v.absmax[j] += 300.0f;
+		}
+	}
+
+	g_psv.time = 1.0;
+	sv_rehlds_sphere_index.value = 1.0f;
+	for (int i = 0; i < SPHERE_TEST_QUERIES; i++)
+		indexedCount[i] = _RunSphereTestQuery(&queries[i], &indexedHash[i]);
+
+	edict_t *found;
+	CHECK("Grid used after the bounds changed", !SV_SphereGridFind(0, queries[0].org, queries[0].rad, &found));
+
+	sv_rehlds_sphere_index.value = 0.0f;
+	for (int i = 0; i < SPHERE_TEST_QUERIES; i++) {
+		uint32 hash;
+		int count = _RunSphereTestQuery(&queries[i], &hash);
+
+		LONGS_EQUAL("Found count mismatch", count, indexedCount[i]);
+		LONGS_EQUAL("Found entities mismatch", hash, indexedHash[i]);
+	}
+
+	sv_rehlds_sphere_index.value = 0.0f;
+	gEntityInterface.pfnSetAbsBox = nullptr;
+	g_psvs.maxclients = maxclients;
+
+	Mem_Free(queries);
+	Mem_Free(edicts);
+
+	Q_memset(&g_psv, 0, sizeof(g_psv));
+}
+
+const int FIND_TEST_EDICTS = 600;
+
+// string_t offsets into g_FindTestStrings
+const int FIND_TEST_ALPHA = 1;
+const int FIND_TEST_BETA = 7;
+const int FIND_TEST_GAMMA = 12;
+const int FIND_TEST_LATE = 18;
+
+static char g_FindTestStrings[] = "\0alpha\0beta\0gamma\0late";
+
+// numbers of all the edicts found by iterating the search, -1 terminated
+NOINLINE int _RunFindTestSearch(const char *value, int *found) {
+	int count = 0;
+	edict_t *ed = g_psv.edicts;
+	for (;;) {
+		ed = PF_find_Shared(ed - g_psv.edicts, offsetof(entvars_t, targetname), value);
+		if (ed == g_psv.edicts)
+			break;
+
+		found[count++] = ed - g_psv.edicts;
+	}
+
+	found[count] = -1;
+	return count;
+}
+
+TEST(FindIndex_FieldWrittenBehindIndex, World, 60000) {
+	EngineInitializer engInitGuard;
+
+	static const char *values[] = { "alpha", "beta", "gamma", "late", "none" };
+	static int indexedFound[FIND_TEST_EDICTS + 1];
+	static int scannedFound[FIND_TEST_EDICTS + 1];
+
+	edict_t *edicts = (edict_t *)Mem_ZeroMalloc(sizeof(edict_t) * FIND_TEST_EDICTS);
+	char *strings = pr_strings;
+
+	pr_strings = g_FindTestStrings;
+	g_psv.edicts = edicts;
+	g_psv.num_edicts = FIND_TEST_EDICTS;
+	g_psv.max_edicts = FIND_TEST_EDICTS;
+
+	for (int i = 1; i < FIND_TEST_EDICTS; i++) {
+		static const int names[] = { 0, FIND_TEST_ALPHA, FIND_TEST_BETA, FIND_TEST_GAMMA };
+		edicts[i].v.targetname = names[i % 4];
+	}
+
+	// the first search after a change scans, the second one builds the index
+	sv_rehlds_find_index.value = 1.0f;
+	ED_InvalidateFindIndex();
+	_RunFindTestSearch("alpha", indexedFound);
+	_RunFindTestSearch("alpha", indexedFound);
+
+	// the game dll sets fields to its own strings, the engine doesn't see it
+	edicts[300].v.targetname = FIND_TEST_LATE;
+	edicts[450].v.targetname = FIND_TEST_LATE;
+	edicts[301].v.targetname = FIND_TEST_GAMMA;
+
+	int count = _RunFindTestSearch("late", indexedFound);
+	LONGS_EQUAL("Found count mismatch", 2, count);
+	LONGS_EQUAL("Found entity mismatch", 300, indexedFound[0]);
+	LONGS_EQUAL("Found entity mismatch", 450, indexedFound[1]);
+
+	// once more with the index rebuilt, then with fields written behind that one,
+	// 2 and 40 between indexed matches of the same value
+	for (int round = 0; round < 3; round++) {
+		if (round == 2) {
+			edicts[500].v.targetname = FIND_TEST_LATE;
+			edicts[21].v.targetname = 0;
+			edicts[599].v.targetname = FIND_TEST_BETA;
+			edicts[2].v.targetname = FIND_TEST_ALPHA;
+			edicts[40].v.targetname = FIND_TEST_ALPHA;
+		}
+
+		for (int v = 0; v < ARRAYSIZE(values); v++) {
+			sv_rehlds_find_index.value = 1.0f;
+			int indexedCount = _RunFindTestSearch(values[v], indexedFound);
+
+			sv_rehlds_find_index.value = 0.0f;
+			int scannedCount = _RunFindTestSearch(values[v], scannedFound);
+
+			LONGS_EQUAL("Found count mismatch", scannedCount, indexedCount);
+			for (int i = 0; i < scannedCount; i++)
+				LONGS_EQUAL("Found entity mismatch", scannedFound[i], indexedFound[i]);
+		}
+	}
+
+	sv_rehlds_find_index.value = 0.0f;
+	ED_FreeFindIndex();
+	pr_strings = strings;
+
+	Mem_Free(edicts);
+
+	Q_memset(&g_psv, 0, sizeof(g_psv));
+}
+
+const int WORLDBOX_TEST_BOXES = 2000;
+const int WORLDBOX_TEST_TRACES = 16;
+
+// A floor at z = 0, a slanted wall along x + y = 1024 and a wall at x = -2048,
+// written as a clip hull the way the bsp loader leaves it
+static mplane_t g_WorldBoxTestPlanes[3];
+static dclipnode_t g_WorldBoxTestNodes[3];
+
+NOINLINE void _MakeWorldBoxTestHull(model_t *worldmodel) {
+	Q_memset(g_WorldBoxTestPlanes, 0, sizeof(g_WorldBoxTestPlanes));
+
+	g_WorldBoxTestPlanes[0].normal[2] = 1.0f;
+	g_WorldBoxTestPlanes[0].dist = 0.0f;
+	g_WorldBoxTestPlanes[0].type = 2;
+
+	g_WorldBoxTestPlanes[1].normal[0] = 0.70710678f;
+	g_WorldBoxTestPlanes[1].normal[1] = 0.70710678f;
+	g_WorldBoxTestPlanes[1].dist = 1024.0f * 0.70710678f;
+	g_WorldBoxTestPlanes[1].type = PLANE_ANYZ;
+
+	g_WorldBoxTestPlanes[2].normal[0] = 1.0f;
+	g_WorldBoxTestPlanes[2].dist = -2048.0f;
+	g_WorldBoxTestPlanes[2].type = 0;
+
+	g_WorldBoxTestNodes[0].planenum = 0;
+	g_WorldBoxTestNodes[0].children[0] = 1;
+	g_WorldBoxTestNodes[0].children[1] = CONTENTS_SOLID;
+
+	g_WorldBoxTestNodes[1].planenum = 1;
+	g_WorldBoxTestNodes[1].children[0] = CONTENTS_SOLID;
+	g_WorldBoxTestNodes[1].children[1] = 2;
+
+	g_WorldBoxTestNodes[2].planenum = 2;
+	g_WorldBoxTestNodes[2].children[0] = CONTENTS_EMPTY;
+	g_WorldBoxTestNodes[2].children[1] = CONTENTS_SOLID;
+
+	Q_memset(worldmodel, 0, sizeof(model_t));
+	worldmodel->type = mod_brush;
+
+	for (int i = 0; i < MAX_MAP_HULLS; i++) {
+		hull_t *hull = &worldmodel->hulls[i];
+		hull->clipnodes = g_WorldBoxTestNodes;
+		hull->planes = g_WorldBoxTestPlanes;
+		hull->firstclipnode = 0;
+		hull->lastclipnode = 2;
+	}
+
+	for (int j = 0; j < 3; j++) {
+		worldmodel->mins[j] = -WORLD_TEST_SIZE;
+		worldmodel->maxs[j] = WORLD_TEST_SIZE;
+	}
+}
+
+TEST(WorldBox_MatchesHullTrace, World, 60000) {
+	EngineInitializer engInitGuard;
+
+	static model_t worldmodel;
+	_MakeWorldBoxTestHull(&worldmodel);
+
+	edict_t *edicts = (edict_t *)Mem_ZeroMalloc(sizeof(edict_t) * WORLD_TEST_EDICTS);
+	edicts[0].v.modelindex = 1;
+	edicts[0].v.solid = SOLID_BSP;
+	edicts[0].v.movetype = MOVETYPE_PUSH;
+
+	g_psv.worldmodel = &worldmodel;
+	g_psv.models[1] = &worldmodel;
+	g_psv.edicts = edicts;
+	g_psv.num_edicts = WORLD_TEST_EDICTS;
+	g_psv.max_edicts = WORLD_TEST_EDICTS;
+	g_WorldTestSeed = 3;
+
+	SV_ClearWorld();
+	sv_rehlds_batch_projectiles.value = 1.0f;
+	CHECK("World boxes usable", SV_WorldBoxUsable());
+
+	int numEmpty = 0, numShortcuts = 0;
+
+	for (int i = 0; i < WORLDBOX_TEST_BOXES; i++) {
+		edict_t *ent = &edicts[1 + i % (WORLD_TEST_EDICTS - 1)];
+		vec3_t mins, maxs, offset;
+
+		float size = (i % 2) ? 4.0f : 0.0f;
+		for (int j = 0; j < 3; j++) {
+			ent->v.mins[j] = -size;
+			ent->v.maxs[j] = size;
+		}
+
+		hull_t *hull = SV_HullForEntity(&edicts[0], ent->v.mins, ent->v.maxs, offset);
+
+		// boxes around the walls, a few of them crossing one
+		for (int j = 0; j < 3; j++) {
+			mins[j] = _WorldTestRandom(-2200.0f, 1200.0f);
+			maxs[j] = mins[j] + _WorldTestRandom(0.0f, 200.0f);
+		}
+		mins[2] = _WorldTestRandom(-100.0f, 400.0f);
+		maxs[2] = mins[2] + _WorldTestRandom(0.0f, 100.0f);
+
+		if (SV_WorldBoxUpdate(ent - edicts, hull, mins, maxs, (i % 3) ? 16.0f : 0.0f))
+			numEmpty++;
+
+		for (int k = 0; k < WORLDBOX_TEST_TRACES; k++) {
+			vec3_t start, end;
+
+			// mostly inside the requested box, sometimes leaving it
+			float spill = (k % 4) ? 0.0f : 64.0f;
+			for (int j = 0; j < 3; j++) {
+				start[j] = _WorldTestRandom(mins[j], maxs[j]) + offset[j];
+				end[j] = _WorldTestRandom(mins[j] - spill, maxs[j] + spill) + offset[j];
+			}
+
+			trace_t shortcut;
+			if (!SV_WorldBoxTrace(ent, start, ent->v.mins, ent->v.maxs, end, &shortcut))
+				continue;
+
+			numShortcuts++;
+			trace_t full = SV_ClipMoveToEntity(&edicts[0], start, ent->v.mins, ent->v.maxs, end);
+
+			LONGS_EQUAL("allsolid mismatch", full.allsolid, shortcut.allsolid);
+			LONGS_EQUAL("startsolid mismatch", full.startsolid, shortcut.startsolid);
+			LONGS_EQUAL("inopen mismatch", full.inopen, shortcut.inopen);
+			LONGS_EQUAL("inwater mismatch", full.inwater, shortcut.inwater);
+			CHECK("Hit entity mismatch", full.ent == shortcut.ent);
+			MEM_EQUAL("Fraction mismatch", &full.fraction, &shortcut.fraction, sizeof(float));
+			MEM_EQUAL("Endpos mismatch", full.endpos, shortcut.endpos, sizeof(vec3_t));
+		}
+	}
+
+	CHECK("Some boxes are empty", numEmpty > 0 && numEmpty < WORLDBOX_TEST_BOXES);
+	CHECK("Some traces take the shortcut", numShortcuts > 0);
+
+	// a new map drops the boxes
+	SV_ClearWorld();
+	CHECK("World boxes usable", SV_WorldBoxUsable());
+
+	vec3_t start = { 0.0f, 0.0f, 64.0f };
+	trace_t shortcut;
+	CHECK("Boxes dropped", !SV_WorldBoxTrace(&edicts[1], start, edicts[1].v.mins, edicts[1].v.maxs, start, &shortcut));
+
+	sv_rehlds_batch_projectiles.value = 0.0f;
+	SV_WorldBoxFree();
+	Mem_Free(edicts);
+
+	Q_memset(&g_psv, 0, sizeof(g_psv));
+}
+
+#endif // REHLDS_FIXES